@@ -180,6 +180,61 @@ int Compression::decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p
 	ERR_FAIL_V(-1);
 }
 
+// Dictionary compression is done block by block, possibly from several threads,
+// so each thread keeps its contexts around instead of allocating them per block.
+struct ZstdThreadContexts {
+	ZSTD_CCtx *cctx = nullptr;
+	ZSTD_DCtx *dctx = nullptr;
+
+	~ZstdThreadContexts() {
+		ZSTD_freeCCtx(cctx);
+		ZSTD_freeDCtx(dctx);
+	}
+};
+
+static thread_local ZstdThreadContexts zstd_thread_contexts;
+
+ZSTD_CDict_s *Compression::create_zstd_compression_dictionary(const Vector<uint8_t> &p_dictionary) {
+	ERR_FAIL_COND_V(p_dictionary.is_empty(), nullptr);
+	return ZSTD_createCDict(p_dictionary.ptr(), p_dictionary.size(), zstd_level);
+}
+
+ZSTD_DDict_s *Compression::create_zstd_decompression_dictionary(const Vector<uint8_t> &p_dictionary) {
+	ERR_FAIL_COND_V(p_dictionary.is_empty(), nullptr);
+	return ZSTD_createDDict(p_dictionary.ptr(), p_dictionary.size());
+}
+
+void Compression::free_zstd_dictionary(ZSTD_CDict_s *p_dictionary) {
+	ZSTD_freeCDict(p_dictionary);
+}
+
+void Compression::free_zstd_dictionary(ZSTD_DDict_s *p_dictionary) {
+	ZSTD_freeDDict(p_dictionary);
+}
+
+int Compression::compress_zstd_with_dictionary(uint8_t *p_dst, const uint8_t *p_src, int p_src_size, const ZSTD_CDict_s *p_dictionary) {
+	ERR_FAIL_COND_V(!p_dictionary, -1);
+	if (!zstd_thread_contexts.cctx) {
+		zstd_thread_contexts.cctx = ZSTD_createCCtx();
+		ERR_FAIL_COND_V(!zstd_thread_contexts.cctx, -1);
+	}
+	int max_dst_size = get_max_compressed_buffer_size(p_src_size, MODE_ZSTD);
+	size_t ret = ZSTD_compress_usingCDict(zstd_thread_contexts.cctx, p_dst, max_dst_size, p_src, p_src_size, p_dictionary);
+	ERR_FAIL_COND_V(ZSTD_isError(ret), -1);
+	return ret;
+}
+
+int Compression::decompress_zstd_with_dictionary(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, const ZSTD_DDict_s *p_dictionary) {
+	ERR_FAIL_COND_V(!p_dictionary, -1);
+	if (!zstd_thread_contexts.dctx) {
+		zstd_thread_contexts.dctx = ZSTD_createDCtx();
+		ERR_FAIL_COND_V(!zstd_thread_contexts.dctx, -1);
+	}
+	size_t ret = ZSTD_decompress_usingDDict(zstd_thread_contexts.dctx, p_dst, p_dst_max_size, p_src, p_src_size, p_dictionary);
+	ERR_FAIL_COND_V(ZSTD_isError(ret), -1);
+	return ret;
+}
+
 /**
 	This will handle both Gzip and Deflate streams. It will automatically allocate the output buffer into the provided p_dst_vect Vector.
 	This is required for compressed data whose final uncompressed size is unknown, as is the case for HTTP response bodies.
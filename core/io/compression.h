@@ -34,6 +34,10 @@
 #include "core/templates/vector.h"
 #include "core/typedefs.h"
 
+// Digested Zstandard dictionaries, opaque outside of compression.cpp.
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
 class Compression {
 public:
 	static int zlib_level;
@@ -55,6 +59,15 @@ public:
 	static int decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, Mode p_mode = MODE_ZSTD);
 	static int decompress_dynamic(Vector<uint8_t> *p_dst_vect, int p_max_dst_size, const uint8_t *p_src, int p_src_size, Mode p_mode);
 
+	// Zstandard with a raw content dictionary, which must be the same when decompressing.
+	// Digesting the dictionary is expensive, so it's done once and reused for every block.
+	static ZSTD_CDict_s *create_zstd_compression_dictionary(const Vector<uint8_t> &p_dictionary);
+	static ZSTD_DDict_s *create_zstd_decompression_dictionary(const Vector<uint8_t> &p_dictionary);
+	static void free_zstd_dictionary(ZSTD_CDict_s *p_dictionary);
+	static void free_zstd_dictionary(ZSTD_DDict_s *p_dictionary);
+	static int compress_zstd_with_dictionary(uint8_t *p_dst, const uint8_t *p_src, int p_src_size, const ZSTD_CDict_s *p_dictionary);
+	static int decompress_zstd_with_dictionary(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, const ZSTD_DDict_s *p_dictionary);
+
 	Compression() {}
 };
 
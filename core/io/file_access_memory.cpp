@@ -31,6 +31,7 @@
 #include "file_access_memory.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/marshalls.h"
 #include "core/os/copymem.h"
 #include "core/os/dir_access.h"
 #include "core/templates/map.h"
@@ -137,6 +138,36 @@ uint8_t FileAccessMemory::get_8() const {
 	return ret;
 }
 
+uint16_t FileAccessMemory::get_16() const {
+	if (pos < 0 || pos + 2 > length) {
+		return FileAccess::get_16();
+	}
+
+	uint16_t res = decode_uint16(&data[pos]);
+	pos += 2;
+	return endian_swap ? BSWAP16(res) : res;
+}
+
+uint32_t FileAccessMemory::get_32() const {
+	if (pos < 0 || pos + 4 > length) {
+		return FileAccess::get_32();
+	}
+
+	uint32_t res = decode_uint32(&data[pos]);
+	pos += 4;
+	return endian_swap ? BSWAP32(res) : res;
+}
+
+uint64_t FileAccessMemory::get_64() const {
+	if (pos < 0 || pos + 8 > length) {
+		return FileAccess::get_64();
+	}
+
+	uint64_t res = decode_uint64(&data[pos]);
+	pos += 8;
+	return endian_swap ? BSWAP64(res) : res;
+}
+
 int FileAccessMemory::get_buffer(uint8_t *p_dst, int p_length) const {
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 	ERR_FAIL_COND_V(p_length < 0, -1);
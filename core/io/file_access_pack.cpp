@@ -30,8 +30,11 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/compression.h"
 #include "core/io/file_access_encrypted.h"
+#include "core/io/marshalls.h"
 #include "core/object/script_language.h"
+#include "core/templates/thread_work_pool.h"
 #include "core/version.h"
 
 #include <stdio.h>
@@ -46,7 +49,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, size_t p_
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted) {
+void PackedData::add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_compressed, const ZSTD_DDict_s *p_dictionary) {
 	PathMD5 pmd5(path.md5_buffer());
 	//printf("adding path %s, %lli, %lli\n", path.utf8().get_data(), pmd5.a, pmd5.b);
 
@@ -54,6 +57,8 @@ void PackedData::add_path(const String &pkg_path, const String &path, uint64_t o
 
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
+	pf.compressed = p_compressed;
+	pf.dictionary = p_dictionary;
 	pf.pack = pkg_path;
 	pf.offset = ofs;
 	pf.size = size;
@@ -117,11 +122,44 @@ void PackedData::_free_packed_dirs(PackedDir *p_dir) {
 	memdelete(p_dir);
 }
 
+const uint8_t *PackedData::get_mapped_pack(const String &p_pack, uint64_t &r_size) {
+	MutexLock lock(mapped_packs_mutex);
+
+	Map<String, MappedPack>::Element *E = mapped_packs.find(p_pack);
+	if (E) {
+		r_size = E->get().size;
+		return E->get().data;
+	}
+
+	// Keep the pack open for as long as its files may be read from the mapping.
+	// A null entry is cached too, so platforms without mapping don't retry each time.
+	MappedPack mp;
+	mp.file = FileAccess::open(p_pack, FileAccess::READ);
+	if (mp.file) {
+		mp.data = mp.file->get_mapped_buffer();
+		mp.size = mp.file->get_len();
+		if (!mp.data) {
+			memdelete(mp.file);
+			mp.file = nullptr;
+		}
+	}
+
+	mapped_packs.insert(p_pack, mp);
+	r_size = mp.size;
+	return mp.data;
+}
+
 PackedData::~PackedData() {
 	for (int i = 0; i < sources.size(); i++) {
 		memdelete(sources[i]);
 	}
 	_free_packed_dirs(root);
+
+	for (Map<String, MappedPack>::Element *E = mapped_packs.front(); E; E = E->next()) {
+		if (E->get().file) {
+			memdelete(E->get().file);
+		}
+	}
 }
 
 //////////////////////////////////////////////////////////////////
@@ -171,7 +209,8 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // patch number, not used for validation.
 
-	if (version != PACK_FORMAT_VERSION) {
+	// Version 3 only adds compressed files, which version 2 packs simply don't have.
+	if (version != PACK_FORMAT_VERSION && version != 2) {
 		f->close();
 		memdelete(f);
 		ERR_FAIL_V_MSG(false, "Pack version unsupported: " + itos(version) + ".");
@@ -187,11 +226,33 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
 
-	for (int i = 0; i < 16; i++) {
+	// Dictionary for compressed files, relative to the files base. Reserved (zero) in version 2.
+	uint64_t dictionary_ofs = f->get_64();
+	uint64_t dictionary_size = f->get_64();
+
+	for (int i = 0; i < 12; i++) {
 		//reserved
 		f->get_32();
 	}
 
+	ZSTD_DDict_s *dictionary = nullptr;
+	if (dictionary_size) {
+		uint64_t directory_pos = f->get_position();
+		Vector<uint8_t> dictionary_data;
+		dictionary_data.resize(dictionary_size);
+		f->seek(file_base + dictionary_ofs + p_offset);
+		f->get_buffer(dictionary_data.ptrw(), dictionary_size);
+		f->seek(directory_pos);
+
+		dictionary = Compression::create_zstd_decompression_dictionary(dictionary_data);
+		if (!dictionary) {
+			f->close();
+			memdelete(f);
+			ERR_FAIL_V_MSG(false, "Can't load the compression dictionary of pack: " + p_path + ".");
+		}
+		dictionaries.push_back(dictionary);
+	}
+
 	int file_count = f->get_32();
 
 	if (enc_directory) {
@@ -234,7 +295,8 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
 
-		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
+		bool compressed = (flags & PACK_FILE_COMPRESSED);
+		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), compressed, compressed ? dictionary : nullptr);
 	}
 
 	f->close();
@@ -246,18 +308,173 @@ FileAccess *PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFi
 	return memnew(FileAccessPack(p_path, *p_file));
 }
 
+PackedSourcePCK::~PackedSourcePCK() {
+	for (int i = 0; i < dictionaries.size(); i++) {
+		Compression::free_zstd_dictionary(dictionaries[i]);
+	}
+}
+
 //////////////////////////////////////////////////////////////////
 
+void FileAccessPack::_open_compressed() {
+	Vector<uint8_t> buffer;
+	const uint8_t *header = _get_raw(0, 8, buffer);
+	ERR_FAIL_COND_MSG(!header, "Truncated compressed pack-referenced file '" + String(pf.pack) + "'.");
+	block_size = decode_uint32(header);
+	uint32_t block_count = decode_uint32(header + 4);
+	ERR_FAIL_COND_MSG(block_size == 0 || block_size > MAX_BLOCK_SIZE || block_count != (pf.size + block_size - 1) / block_size, "Corrupt compressed pack-referenced file '" + String(pf.pack) + "'.");
+
+	const uint8_t *sizes = _get_raw(8, uint64_t(block_count) * 4, buffer);
+	ERR_FAIL_COND_MSG(!sizes, "Truncated compressed pack-referenced file '" + String(pf.pack) + "'.");
+	block_offsets.resize(block_count + 1);
+	uint64_t *w = block_offsets.ptrw();
+	w[0] = 8 + uint64_t(block_count) * 4;
+	for (uint32_t i = 0; i < block_count; i++) {
+		w[i + 1] = w[i] + decode_uint32(sizes + i * 4);
+	}
+
+	block_cache.resize(block_size);
+}
+
+const uint8_t *FileAccessPack::_get_raw(uint64_t p_ofs, uint64_t p_len, Vector<uint8_t> &r_buffer) const {
+	if (data) {
+		if (p_ofs > data_size || p_len > data_size - p_ofs) {
+			return nullptr; // Past the end of the mapped pack.
+		}
+		return data + p_ofs;
+	}
+
+	if (p_len > INT32_MAX) {
+		return nullptr;
+	}
+	r_buffer.resize(p_len);
+	f->seek(off + p_ofs);
+	if (f->get_buffer(r_buffer.ptrw(), p_len) != int(p_len)) {
+		return nullptr;
+	}
+	return r_buffer.ptr();
+}
+
+uint32_t FileAccessPack::_get_block_len(uint32_t p_block) const {
+	return MIN(uint64_t(block_size), pf.size - uint64_t(p_block) * block_size);
+}
+
+bool FileAccessPack::_decompress_block(uint32_t p_block, const uint8_t *p_src, uint8_t *p_dst) const {
+	uint32_t len = _get_block_len(p_block);
+	uint32_t compressed_len = block_offsets[p_block + 1] - block_offsets[p_block];
+
+	if (compressed_len == len) {
+		copymem(p_dst, p_src, len); // Stored as is.
+		return true;
+	}
+
+	int ret;
+	if (!pf.dictionary) {
+		ret = Compression::decompress(p_dst, len, p_src, compressed_len, Compression::MODE_ZSTD);
+	} else {
+		ret = Compression::decompress_zstd_with_dictionary(p_dst, len, p_src, compressed_len, pf.dictionary);
+	}
+	ERR_FAIL_COND_V_MSG(ret != int(len), false, "Corrupt compressed block in pack-referenced file '" + String(pf.pack) + "'.");
+	return true;
+}
+
+void FileAccessPack::_decompress_block_task(uint32_t p_index, DecompressTask *p_task) const {
+	uint32_t block = p_task->first_block + p_index;
+	const uint8_t *src = p_task->src + (block_offsets[block] - block_offsets[p_task->first_block]);
+	uint8_t *dst = p_task->dst + uint64_t(p_index) * block_size;
+	if (!_decompress_block(block, src, dst)) {
+		p_task->failed.set();
+	}
+}
+
+bool FileAccessPack::_decompress_blocks(uint32_t p_from, uint32_t p_to, uint8_t *p_dst) const {
+	Vector<uint8_t> buffer;
+	DecompressTask task;
+	task.first_block = p_from;
+	task.src = _get_raw(block_offsets[p_from], block_offsets[p_to] - block_offsets[p_from], buffer);
+	task.dst = p_dst;
+	ERR_FAIL_COND_V_MSG(!task.src, false, "Truncated compressed pack-referenced file '" + String(pf.pack) + "'.");
+
+	ThreadWorkPool *pool = nullptr;
+	if (p_to - p_from >= PARALLEL_DECOMPRESS_MIN_BLOCKS) {
+		pool = ThreadWorkPool::try_lock_shared();
+	}
+
+	if (pool) {
+		pool->do_work(p_to - p_from, this, &FileAccessPack::_decompress_block_task, &task);
+		ThreadWorkPool::unlock_shared();
+	} else {
+		for (uint32_t i = 0; i < p_to - p_from; i++) {
+			_decompress_block_task(i, &task);
+		}
+	}
+
+	return !task.failed.is_set();
+}
+
+bool FileAccessPack::_read_compressed(uint64_t p_pos, uint8_t *p_dst, uint64_t p_len) const {
+	ERR_FAIL_COND_V_MSG(block_offsets.is_empty(), false, "File must be opened before use.");
+
+	uint64_t end = p_pos + p_len;
+	uint32_t first = p_pos / block_size;
+	uint32_t last = (end - 1) / block_size;
+
+	// Blocks read whole are decompressed straight into the destination, and only the
+	// ones read partially at either end go through the cache.
+	uint32_t whole_from = first;
+	uint32_t whole_to = last + 1;
+	if (p_pos > uint64_t(first) * block_size) {
+		whole_from++;
+	}
+	if (end < uint64_t(last) * block_size + _get_block_len(last)) {
+		whole_to--;
+	}
+
+	for (uint32_t block = first; block <= last; block++) {
+		if (block >= whole_from && block < whole_to) {
+			continue;
+		}
+
+		if (cached_block != block) {
+			Vector<uint8_t> buffer;
+			const uint8_t *src = _get_raw(block_offsets[block], block_offsets[block + 1] - block_offsets[block], buffer);
+			cached_block = -1;
+			ERR_FAIL_COND_V_MSG(!src, false, "Truncated compressed pack-referenced file '" + String(pf.pack) + "'.");
+			if (!_decompress_block(block, src, block_cache.ptrw())) {
+				return false;
+			}
+			cached_block = block;
+		}
+
+		uint64_t block_start = uint64_t(block) * block_size;
+		uint64_t from = MAX(block_start, p_pos);
+		uint64_t to = MIN(block_start + _get_block_len(block), end);
+		copymem(p_dst + (from - p_pos), block_cache.ptr() + (from - block_start), to - from);
+	}
+
+	if (whole_from < whole_to) {
+		return _decompress_blocks(whole_from, whole_to, p_dst + (uint64_t(whole_from) * block_size - p_pos));
+	}
+	return true;
+}
+
 Error FileAccessPack::_open(const String &p_path, int p_mode_flags) {
 	ERR_FAIL_V(ERR_UNAVAILABLE);
 	return ERR_UNAVAILABLE;
 }
 
 void FileAccessPack::close() {
+	if (data) {
+		data = nullptr;
+		return;
+	}
 	f->close();
 }
 
 bool FileAccessPack::is_open() const {
+	if (!f) {
+		return data != nullptr;
+	}
 	return f->is_open();
 }
 
@@ -268,7 +485,9 @@ void FileAccessPack::seek(size_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (f && !pf.compressed) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -294,6 +513,18 @@ uint8_t FileAccessPack::get_8() const {
 		return 0;
 	}
 
+	if (pf.compressed) {
+		uint8_t b = 0;
+		_read_compressed(pos, &b, 1);
+		pos++;
+		return b;
+	}
+
+	if (!f) {
+		ERR_FAIL_COND_V_MSG(!data, 0, "File must be opened before use.");
+		return data[pos++];
+	}
+
 	pos++;
 	return f->get_8();
 }
@@ -312,19 +543,41 @@ int FileAccessPack::get_buffer(uint8_t *p_dst, int p_length) const {
 		to_read = int64_t(pf.size) - int64_t(pos);
 	}
 
+	size_t read_pos = pos;
 	pos += p_length;
 
 	if (to_read <= 0) {
 		return 0;
 	}
+
+	if (pf.compressed) {
+		ERR_FAIL_COND_V(!_read_compressed(read_pos, p_dst, to_read), -1);
+		return to_read;
+	}
+
+	if (!f) {
+		ERR_FAIL_COND_V_MSG(!data, -1, "File must be opened before use.");
+		copymem(p_dst, data + read_pos, to_read);
+		return to_read;
+	}
+
 	f->get_buffer(p_dst, to_read);
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_mapped_buffer() const {
+	if (pf.compressed) {
+		return nullptr; // The mapping holds compressed data.
+	}
+	return data;
+}
+
 void FileAccessPack::set_endian_swap(bool p_swap) {
 	FileAccess::set_endian_swap(p_swap);
-	f->set_endian_swap(p_swap);
+	if (f) {
+		f->set_endian_swap(p_swap);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -351,8 +604,35 @@ bool FileAccessPack::file_exists(const String &p_name) {
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+		pf(p_file) {
+	if (!pf.encrypted) {
+		// Read straight from the mapped pack when the platform supports it,
+		// instead of opening the pack again and going through seek and read calls.
+		uint64_t pack_size = 0;
+		const uint8_t *pack_data = PackedData::get_singleton()->get_mapped_pack(pf.pack, pack_size);
+		if (pack_data && pf.offset < pack_size) {
+			data = pack_data + pf.offset;
+			data_size = pack_size - pf.offset;
+			off = pf.offset;
+			pos = 0;
+			eof = false;
+
+			uint64_t len = pf.size;
+			if (pf.compressed) {
+				_open_compressed();
+				len = block_offsets.is_empty() ? 0 : block_offsets[block_offsets.size() - 1];
+			}
+			if (pf.offset + len <= pack_size) {
+				return;
+			}
+
+			// Truncated pack, let reads from the file fail instead.
+			data = nullptr;
+			block_offsets.clear();
+		}
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(!f, "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
@@ -380,6 +660,10 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 	}
 	pos = 0;
 	eof = false;
+
+	if (pf.compressed) {
+		_open_compressed();
+	}
 }
 
 FileAccessPack::~FileAccessPack() {
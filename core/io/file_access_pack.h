@@ -33,25 +33,30 @@
 
 #include "core/os/dir_access.h"
 #include "core/os/file_access.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/list.h"
 #include "core/templates/map.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/set.h"
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
 // The current packed file format version number.
-#define PACK_FORMAT_VERSION 2
+#define PACK_FORMAT_VERSION 3
 
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0
 };
 
 enum PackFileFlags {
-	PACK_FILE_ENCRYPTED = 1 << 0
+	PACK_FILE_ENCRYPTED = 1 << 0,
+	// Stored as independently compressed Zstandard blocks, see FileAccessPack.
+	PACK_FILE_COMPRESSED = 1 << 1
 };
 
 class PackSource;
+struct ZSTD_DDict_s;
 
 class PackedData {
 	friend class FileAccessPack;
@@ -66,6 +71,8 @@ public:
 		uint8_t md5[16];
 		PackSource *src;
 		bool encrypted;
+		bool compressed;
+		const ZSTD_DDict_s *dictionary = nullptr; // Shared by all the compressed files of the pack, owned by its source.
 	};
 
 private:
@@ -105,6 +112,15 @@ private:
 
 	PackedDir *root;
 
+	struct MappedPack {
+		FileAccess *file = nullptr;
+		const uint8_t *data = nullptr;
+		uint64_t size = 0;
+	};
+
+	Map<String, MappedPack> mapped_packs;
+	Mutex mapped_packs_mutex;
+
 	static PackedData *singleton;
 	bool disabled = false;
 
@@ -112,7 +128,7 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false); // for PackSource
+	void add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_compressed = false, const ZSTD_DDict_s *p_dictionary = nullptr); // for PackSource
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
@@ -126,6 +142,8 @@ public:
 	_FORCE_INLINE_ DirAccess *try_open_directory(const String &p_path);
 	_FORCE_INLINE_ bool has_directory(const String &p_path);
 
+	const uint8_t *get_mapped_pack(const String &p_pack, uint64_t &r_size);
+
 	PackedData();
 	~PackedData();
 };
@@ -138,9 +156,12 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	Vector<ZSTD_DDict_s *> dictionaries; // One per opened pack that has one.
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, size_t p_offset);
 	virtual FileAccess *get_file(const String &p_path, PackedData::PackedFile *p_file);
+	virtual ~PackedSourcePCK();
 };
 
 class FileAccessPack : public FileAccess {
@@ -150,7 +171,37 @@ class FileAccessPack : public FileAccess {
 	mutable bool eof;
 	uint64_t off;
 
-	FileAccess *f;
+	FileAccess *f = nullptr;
+	const uint8_t *data = nullptr; // Start of the file within the mapped pack, if mapped.
+	uint64_t data_size = 0; // Bytes of the mapped pack from data onwards.
+
+	// Compressed files start with the uncompressed block size, the block count and the compressed
+	// size of each block, followed by the blocks. Blocks that didn't compress are stored as is.
+	enum {
+		PARALLEL_DECOMPRESS_MIN_BLOCKS = 4,
+		MAX_BLOCK_SIZE = 65536, // What PCKPacker writes, larger ones come from corrupt files.
+	};
+
+	struct DecompressTask {
+		uint32_t first_block = 0;
+		const uint8_t *src = nullptr;
+		uint8_t *dst = nullptr;
+		SafeFlag failed;
+	};
+
+	uint32_t block_size = 0;
+	Vector<uint64_t> block_offsets; // Start of each compressed block within the file, plus the end of the last one.
+	mutable Vector<uint8_t> block_cache;
+	mutable int64_t cached_block = -1;
+
+	void _open_compressed();
+	const uint8_t *_get_raw(uint64_t p_ofs, uint64_t p_len, Vector<uint8_t> &r_buffer) const;
+	uint32_t _get_block_len(uint32_t p_block) const;
+	bool _decompress_block(uint32_t p_block, const uint8_t *p_src, uint8_t *p_dst) const;
+	void _decompress_block_task(uint32_t p_index, DecompressTask *p_task) const;
+	bool _decompress_blocks(uint32_t p_from, uint32_t p_to, uint8_t *p_dst) const;
+	bool _read_compressed(uint64_t p_pos, uint8_t *p_dst, uint64_t p_len) const;
+
 	virtual Error _open(const String &p_path, int p_mode_flags);
 	virtual uint64_t _get_modified_time(const String &p_file) { return 0; }
 	virtual uint32_t _get_unix_permissions(const String &p_file) { return 0; }
@@ -170,6 +221,7 @@ public:
 	virtual uint8_t get_8() const;
 
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
+	virtual const uint8_t *get_mapped_buffer() const;
 
 	virtual void set_endian_swap(bool p_swap);
 
@@ -37,9 +37,18 @@
 #include "core/os/copymem.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/thread_work_pool.h"
 
 #include <stdio.h>
 
+#if defined(__SSE2__)
+#define IMAGE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define IMAGE_NEON
+#include <arm_neon.h>
+#endif
+
 const char *Image::format_names[Image::FORMAT_MAX] = {
 	"Lum8", //luminance
 	"LumAlpha8", //luminance-alpha
@@ -462,12 +471,52 @@ int Image::get_mipmap_count() const {
 	}
 }
 
+// Large images are processed in bands of rows spread over the shared thread pool.
+// Small images, and images processed while the pool is busy (from another thread,
+// from within a band, or by another job), are processed on the calling thread
+// instead. Each row runs the same code either way, so results don't depend on
+// how work was split.
+#define IMAGE_PROCESS_MIN_PIXELS (256 * 256)
+#define IMAGE_PROCESS_BAND_ROWS 16
+
+template <class F>
+struct ImageRowBands {
+	const F *func = nullptr;
+	uint32_t rows = 0;
+
+	void process_band(uint32_t p_band, void *p_userdata) {
+		uint32_t from = p_band * IMAGE_PROCESS_BAND_ROWS;
+		(*func)(from, MIN(from + IMAGE_PROCESS_BAND_ROWS, rows));
+	}
+};
+
+// Calls p_func(from_row, to_row) over all rows, p_pixels is the amount of work they hold.
+template <class F>
+static void _process_rows(uint32_t p_rows, uint64_t p_pixels, const F &p_func) {
+	uint32_t bands = (p_rows + IMAGE_PROCESS_BAND_ROWS - 1) / IMAGE_PROCESS_BAND_ROWS;
+	ThreadWorkPool *pool = nullptr;
+	if (p_pixels >= IMAGE_PROCESS_MIN_PIXELS && bands >= 2) {
+		pool = ThreadWorkPool::try_lock_shared();
+	}
+	if (!pool) {
+		p_func(0, p_rows);
+		return;
+	}
+
+	ImageRowBands<F> row_bands;
+	row_bands.func = &p_func;
+	row_bands.rows = p_rows;
+	pool->do_work(bands, &row_bands, &ImageRowBands<F>::process_band, (void *)nullptr);
+
+	ThreadWorkPool::unlock_shared();
+}
+
 //using template generates perfectly optimized code due to constant expression reduction and unused variable removal present in all compilers
 template <uint32_t read_bytes, bool read_alpha, uint32_t write_bytes, bool write_alpha, bool read_gray, bool write_gray>
-static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
+static void _convert_rows(int p_width, const uint8_t *p_src, uint8_t *p_dst, uint32_t p_from_row, uint32_t p_to_row) {
 	uint32_t max_bytes = MAX(read_bytes, write_bytes);
 
-	for (int y = 0; y < p_height; y++) {
+	for (int y = p_from_row; y < (int)p_to_row; y++) {
 		for (int x = 0; x < p_width; x++) {
 			const uint8_t *rofs = &p_src[((y * p_width) + x) * (read_bytes + (read_alpha ? 1 : 0))];
 			uint8_t *wofs = &p_dst[((y * p_width) + x) * (write_bytes + (write_alpha ? 1 : 0))];
@@ -504,6 +553,13 @@ static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p
 	}
 }
 
+template <uint32_t read_bytes, bool read_alpha, uint32_t write_bytes, bool write_alpha, bool read_gray, bool write_gray>
+static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
+	_process_rows(p_height, uint64_t(p_width) * p_height, [&](uint32_t p_from_row, uint32_t p_to_row) {
+		_convert_rows<read_bytes, read_alpha, write_bytes, write_alpha, read_gray, write_gray>(p_width, p_src, p_dst, p_from_row, p_to_row);
+	});
+}
+
 void Image::convert(Format p_new_format) {
 	if (data.size() == 0) {
 		return;
@@ -663,7 +719,7 @@ static double _bicubic_interp_kernel(double x) {
 }
 
 template <int CC, class T>
-static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_cubic_rows(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
 	// get source image size
 	int width = p_src_width;
 	int height = p_src_height;
@@ -678,7 +734,7 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 	int xmax = width - 1;
 	// temporary pointer
 
-	for (uint32_t y = 0; y < p_dst_height; y++) {
+	for (uint32_t y = p_from_row; y < p_to_row; y++) {
 		// Y coordinates
 		oy = (double)y * yfac - 0.5f;
 		oy1 = (int)oy;
@@ -750,7 +806,14 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 }
 
 template <int CC, class T>
-static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	_process_rows(p_dst_height, uint64_t(p_dst_width) * p_dst_height, [&](uint32_t p_from_row, uint32_t p_to_row) {
+		_scale_cubic_rows<CC, T>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height, p_from_row, p_to_row);
+	});
+}
+
+template <int CC, class T>
+static void _scale_bilinear_rows(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
 	enum {
 		FRAC_BITS = 8,
 		FRAC_LEN = (1 << FRAC_BITS),
@@ -758,7 +821,7 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 		FRAC_MASK = FRAC_LEN - 1
 	};
 
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
 		// Add 0.5 in order to interpolate based on pixel center
 		uint32_t src_yofs_up_fp = (i + 0.5) * p_src_height * FRAC_LEN / p_dst_height;
 		// Calculate nearest src pixel center above current, and truncate to get y index
@@ -840,8 +903,15 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 }
 
 template <int CC, class T>
-static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	_process_rows(p_dst_height, uint64_t(p_dst_width) * p_dst_height, [&](uint32_t p_from_row, uint32_t p_to_row) {
+		_scale_bilinear_rows<CC, T>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height, p_from_row, p_to_row);
+	});
+}
+
+template <int CC, class T>
+static void _scale_nearest_rows(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
 		uint32_t src_yofs = i * p_src_height / p_dst_height;
 		uint32_t y_ofs = src_yofs * p_src_width * CC;
 
@@ -860,6 +930,13 @@ static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict
 	}
 }
 
+template <int CC, class T>
+static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	_process_rows(p_dst_height, uint64_t(p_dst_width) * p_dst_height, [&](uint32_t p_from_row, uint32_t p_to_row) {
+		_scale_nearest_rows<CC, T>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height, p_from_row, p_to_row);
+	});
+}
+
 #define LANCZOS_TYPE 3
 
 static float _lanczos(float p_x) {
@@ -883,47 +960,50 @@ static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict
 		float scale_factor = MAX(x_scale, 1); // A larger kernel is required only when downscaling
 		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
 
-		float *kernel = memnew_arr(float, half_kernel * 2);
+		// Bands are made of columns here, each one with its own kernel buffer.
+		_process_rows(dst_width, uint64_t(src_height) * dst_width, [&](uint32_t p_from_column, uint32_t p_to_column) {
+			float *kernel = memnew_arr(float, half_kernel * 2);
 
-		for (int32_t buffer_x = 0; buffer_x < dst_width; buffer_x++) {
-			// The corresponding point on the source image
-			float src_x = (buffer_x + 0.5f) * x_scale; // Offset by 0.5 so it uses the pixel's center
-			int32_t start_x = MAX(0, int32_t(src_x) - half_kernel + 1);
-			int32_t end_x = MIN(src_width - 1, int32_t(src_x) + half_kernel);
+			for (int32_t buffer_x = p_from_column; buffer_x < (int32_t)p_to_column; buffer_x++) {
+				// The corresponding point on the source image
+				float src_x = (buffer_x + 0.5f) * x_scale; // Offset by 0.5 so it uses the pixel's center
+				int32_t start_x = MAX(0, int32_t(src_x) - half_kernel + 1);
+				int32_t end_x = MIN(src_width - 1, int32_t(src_x) + half_kernel);
 
-			// Create the kernel used by all the pixels of the column
-			for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
-				kernel[target_x - start_x] = _lanczos((target_x + 0.5f - src_x) / scale_factor);
-			}
+				// Create the kernel used by all the pixels of the column
+				for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
+					kernel[target_x - start_x] = _lanczos((target_x + 0.5f - src_x) / scale_factor);
+				}
 
-			for (int32_t buffer_y = 0; buffer_y < src_height; buffer_y++) {
-				float pixel[CC] = { 0 };
-				float weight = 0;
+				for (int32_t buffer_y = 0; buffer_y < src_height; buffer_y++) {
+					float pixel[CC] = { 0 };
+					float weight = 0;
 
-				for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
-					float lanczos_val = kernel[target_x - start_x];
-					weight += lanczos_val;
+					for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
+						float lanczos_val = kernel[target_x - start_x];
+						weight += lanczos_val;
 
-					const T *__restrict src_data = ((const T *)p_src) + (buffer_y * src_width + target_x) * CC;
+						const T *__restrict src_data = ((const T *)p_src) + (buffer_y * src_width + target_x) * CC;
 
-					for (uint32_t i = 0; i < CC; i++) {
-						if (sizeof(T) == 2) { //half float
-							pixel[i] += Math::half_to_float(src_data[i]) * lanczos_val;
-						} else {
-							pixel[i] += src_data[i] * lanczos_val;
+						for (uint32_t i = 0; i < CC; i++) {
+							if (sizeof(T) == 2) { //half float
+								pixel[i] += Math::half_to_float(src_data[i]) * lanczos_val;
+							} else {
+								pixel[i] += src_data[i] * lanczos_val;
+							}
 						}
 					}
-				}
 
-				float *dst_data = ((float *)buffer) + (buffer_y * dst_width + buffer_x) * CC;
+					float *dst_data = ((float *)buffer) + (buffer_y * dst_width + buffer_x) * CC;
 
-				for (uint32_t i = 0; i < CC; i++) {
-					dst_data[i] = pixel[i] / weight; // Normalize the sum of all the samples
+					for (uint32_t i = 0; i < CC; i++) {
+						dst_data[i] = pixel[i] / weight; // Normalize the sum of all the samples
+					}
 				}
 			}
-		}
 
-		memdelete_arr(kernel);
+			memdelete_arr(kernel);
+		});
 	} // End of first pass
 
 	{ // SECOND PASS (vertical + result)
@@ -933,49 +1013,51 @@ static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict
 		float scale_factor = MAX(y_scale, 1);
 		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
 
-		float *kernel = memnew_arr(float, half_kernel * 2);
+		_process_rows(dst_height, uint64_t(dst_width) * dst_height, [&](uint32_t p_from_row, uint32_t p_to_row) {
+			float *kernel = memnew_arr(float, half_kernel * 2);
 
-		for (int32_t dst_y = 0; dst_y < dst_height; dst_y++) {
-			float buffer_y = (dst_y + 0.5f) * y_scale;
-			int32_t start_y = MAX(0, int32_t(buffer_y) - half_kernel + 1);
-			int32_t end_y = MIN(src_height - 1, int32_t(buffer_y) + half_kernel);
+			for (int32_t dst_y = p_from_row; dst_y < (int32_t)p_to_row; dst_y++) {
+				float buffer_y = (dst_y + 0.5f) * y_scale;
+				int32_t start_y = MAX(0, int32_t(buffer_y) - half_kernel + 1);
+				int32_t end_y = MIN(src_height - 1, int32_t(buffer_y) + half_kernel);
 
-			for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
-				kernel[target_y - start_y] = _lanczos((target_y + 0.5f - buffer_y) / scale_factor);
-			}
+				for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
+					kernel[target_y - start_y] = _lanczos((target_y + 0.5f - buffer_y) / scale_factor);
+				}
 
-			for (int32_t dst_x = 0; dst_x < dst_width; dst_x++) {
-				float pixel[CC] = { 0 };
-				float weight = 0;
+				for (int32_t dst_x = 0; dst_x < dst_width; dst_x++) {
+					float pixel[CC] = { 0 };
+					float weight = 0;
 
-				for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
-					float lanczos_val = kernel[target_y - start_y];
-					weight += lanczos_val;
+					for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
+						float lanczos_val = kernel[target_y - start_y];
+						weight += lanczos_val;
 
-					float *buffer_data = ((float *)buffer) + (target_y * dst_width + dst_x) * CC;
+						float *buffer_data = ((float *)buffer) + (target_y * dst_width + dst_x) * CC;
 
-					for (uint32_t i = 0; i < CC; i++) {
-						pixel[i] += buffer_data[i] * lanczos_val;
+						for (uint32_t i = 0; i < CC; i++) {
+							pixel[i] += buffer_data[i] * lanczos_val;
+						}
 					}
-				}
 
-				T *dst_data = ((T *)p_dst) + (dst_y * dst_width + dst_x) * CC;
+					T *dst_data = ((T *)p_dst) + (dst_y * dst_width + dst_x) * CC;
 
-				for (uint32_t i = 0; i < CC; i++) {
-					pixel[i] /= weight;
-
-					if (sizeof(T) == 1) { //byte
-						dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 255);
-					} else if (sizeof(T) == 2) { //half float
-						dst_data[i] = Math::make_half_float(pixel[i]);
-					} else { // float
-						dst_data[i] = pixel[i];
+					for (uint32_t i = 0; i < CC; i++) {
+						pixel[i] /= weight;
+
+						if (sizeof(T) == 1) { //byte
+							dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 255);
+						} else if (sizeof(T) == 2) { //half float
+							dst_data[i] = Math::make_half_float(pixel[i]);
+						} else { // float
+							dst_data[i] = pixel[i];
+						}
 					}
 				}
 			}
-		}
 
-		memdelete_arr(kernel);
+			memdelete_arr(kernel);
+		});
 	} // End of second pass
 
 	memdelete_arr(buffer);
@@ -1489,15 +1571,14 @@ bool Image::_can_modify(Format p_format) const {
 template <class Component, int CC, bool renormalize,
 		void (*average_func)(Component &, const Component &, const Component &, const Component &, const Component &),
 		void (*renormalize_func)(Component *)>
-static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height) {
+static void _generate_po2_mipmap_rows(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height, uint32_t p_from_row, uint32_t p_to_row) {
 	//fast power of 2 mipmap generation
 	uint32_t dst_w = MAX(p_width >> 1, 1);
-	uint32_t dst_h = MAX(p_height >> 1, 1);
 
 	int right_step = (p_width == 1) ? 0 : CC;
 	int down_step = (p_height == 1) ? 0 : (p_width * CC);
 
-	for (uint32_t i = 0; i < dst_h; i++) {
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
 		const Component *rup_ptr = &p_src[i * 2 * down_step];
 		const Component *rdown_ptr = rup_ptr + down_step;
 		Component *dst_ptr = &p_dst[i * dst_w * CC];
@@ -1520,6 +1601,18 @@ static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint3
 	}
 }
 
+template <class Component, int CC, bool renormalize,
+		void (*average_func)(Component &, const Component &, const Component &, const Component &, const Component &),
+		void (*renormalize_func)(Component *)>
+static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height) {
+	uint32_t dst_w = MAX(p_width >> 1, 1);
+	uint32_t dst_h = MAX(p_height >> 1, 1);
+
+	_process_rows(dst_h, uint64_t(dst_w) * dst_h, [&](uint32_t p_from_row, uint32_t p_to_row) {
+		_generate_po2_mipmap_rows<Component, CC, renormalize, average_func, renormalize_func>(p_src, p_dst, p_width, p_height, p_from_row, p_to_row);
+	});
+}
+
 void Image::shrink_x2() {
 	ERR_FAIL_COND(data.size() == 0);
 
@@ -2343,7 +2436,9 @@ int Image::get_image_mipmap_offset_and_dimensions(int p_width, int p_height, For
 		return 0;
 	}
 	int mm;
-	return _get_dst_image_size(p_width, p_height, p_format, mm, p_mipmap - 1, &r_w, &r_h);
+	int ofs = _get_dst_image_size(p_width, p_height, p_format, mm, p_mipmap - 1);
+	_get_dst_image_size(p_width, p_height, p_format, mm, p_mipmap, &r_w, &r_h);
+	return ofs;
 }
 
 bool Image::is_compressed() const {
@@ -2607,21 +2702,34 @@ void Image::blend_rect(const Ref<Image> &p_src, const Rect2 &p_src_rect, const P
 
 	Ref<Image> img = p_src;
 
-	for (int i = 0; i < dest_rect.size.y; i++) {
-		for (int j = 0; j < dest_rect.size.x; j++) {
-			int src_x = clipped_src_rect.position.x + j;
-			int src_y = clipped_src_rect.position.y + i;
+	uint8_t *dst_data_ptr = data.ptrw();
+	const uint8_t *src_data_ptr = img->data.ptr();
 
-			int dst_x = dest_rect.position.x + j;
-			int dst_y = dest_rect.position.y + i;
+	auto blend_rows = [&](uint32_t p_from_row, uint32_t p_to_row) {
+		for (int i = p_from_row; i < (int)p_to_row; i++) {
+			for (int j = 0; j < dest_rect.size.x; j++) {
+				int src_x = clipped_src_rect.position.x + j;
+				int src_y = clipped_src_rect.position.y + i;
+
+				int dst_x = dest_rect.position.x + j;
+				int dst_y = dest_rect.position.y + i;
 
-			Color sc = img->get_pixel(src_x, src_y);
-			if (sc.a != 0) {
-				Color dc = get_pixel(dst_x, dst_y);
-				dc = dc.blend(sc);
-				set_pixel(dst_x, dst_y, dc);
+				Color sc = img->_get_color_at_ofs(src_data_ptr, src_y * img->width + src_x);
+				if (sc.a != 0) {
+					uint32_t dst_ofs = dst_y * width + dst_x;
+					Color dc = _get_color_at_ofs(dst_data_ptr, dst_ofs);
+					dc = dc.blend(sc);
+					_set_color_at_ofs(dst_data_ptr, dst_ofs, dc);
+				}
 			}
 		}
+	};
+
+	if (img.ptr() == this) {
+		// Source and destination rows may overlap, keep the row order.
+		blend_rows(0, dest_rect.size.y);
+	} else {
+		_process_rows(dest_rect.size.y, uint64_t(dest_rect.size.x) * dest_rect.size.y, blend_rows);
 	}
 }
 
@@ -3365,26 +3473,22 @@ void Image::srgb_to_linear() {
 
 	ERR_FAIL_COND(format != FORMAT_RGB8 && format != FORMAT_RGBA8);
 
-	if (format == FORMAT_RGBA8) {
-		int len = data.size() / 4;
-		uint8_t *data_ptr = data.ptrw();
-
-		for (int i = 0; i < len; i++) {
-			data_ptr[(i << 2) + 0] = srgb2lin[data_ptr[(i << 2) + 0]];
-			data_ptr[(i << 2) + 1] = srgb2lin[data_ptr[(i << 2) + 1]];
-			data_ptr[(i << 2) + 2] = srgb2lin[data_ptr[(i << 2) + 2]];
-		}
+	// Mipmaps are converted too, so split the whole buffer in rows of the base level width.
+	uint32_t pixel_size = format == FORMAT_RGBA8 ? 4 : 3;
+	uint32_t len = data.size() / pixel_size;
+	uint32_t rows = (len + width - 1) / width;
+	uint8_t *data_ptr = data.ptrw();
 
-	} else if (format == FORMAT_RGB8) {
-		int len = data.size() / 3;
-		uint8_t *data_ptr = data.ptrw();
+	_process_rows(rows, len, [&](uint32_t p_from_row, uint32_t p_to_row) {
+		uint8_t *ptr = &data_ptr[p_from_row * width * pixel_size];
+		uint8_t *end = &data_ptr[MIN(p_to_row * width, len) * pixel_size];
 
-		for (int i = 0; i < len; i++) {
-			data_ptr[(i * 3) + 0] = srgb2lin[data_ptr[(i * 3) + 0]];
-			data_ptr[(i * 3) + 1] = srgb2lin[data_ptr[(i * 3) + 1]];
-			data_ptr[(i * 3) + 2] = srgb2lin[data_ptr[(i * 3) + 2]];
+		for (; ptr < end; ptr += pixel_size) {
+			ptr[0] = srgb2lin[ptr[0]];
+			ptr[1] = srgb2lin[ptr[1]];
+			ptr[2] = srgb2lin[ptr[2]];
 		}
-	}
+	});
 }
 
 void Image::premultiply_alpha() {
@@ -3398,15 +3502,46 @@ void Image::premultiply_alpha() {
 
 	uint8_t *data_ptr = data.ptrw();
 
-	for (int i = 0; i < height; i++) {
-		for (int j = 0; j < width; j++) {
-			uint8_t *ptr = &data_ptr[(i * width + j) * 4];
+	_process_rows(height, uint64_t(width) * height, [&](uint32_t p_from_row, uint32_t p_to_row) {
+		uint8_t *__restrict ptr = &data_ptr[p_from_row * width * 4];
+		uint32_t count = (p_to_row - p_from_row) * width;
+		uint32_t i = 0;
+
+#if defined(IMAGE_SSE2)
+		// Four pixels at a time, each channel widened to 16 bits and multiplied by its alpha.
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i alpha_mask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+		for (; i + 4 <= count; i += 4) {
+			__m128i pixels = _mm_loadu_si128((const __m128i *)&ptr[i * 4]);
+			__m128i lo = _mm_unpacklo_epi8(pixels, zero);
+			__m128i hi = _mm_unpackhi_epi8(pixels, zero);
+			__m128i lo_alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+			__m128i hi_alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+			__m128i lo_mul = _mm_srli_epi16(_mm_mullo_epi16(lo, lo_alpha), 8);
+			__m128i hi_mul = _mm_srli_epi16(_mm_mullo_epi16(hi, hi_alpha), 8);
+			// Keep alpha itself unchanged.
+			lo = _mm_or_si128(_mm_andnot_si128(alpha_mask, lo_mul), _mm_and_si128(alpha_mask, lo));
+			hi = _mm_or_si128(_mm_andnot_si128(alpha_mask, hi_mul), _mm_and_si128(alpha_mask, hi));
+			_mm_storeu_si128((__m128i *)&ptr[i * 4], _mm_packus_epi16(lo, hi));
+		}
+#elif defined(IMAGE_NEON)
+		// Eight pixels at a time, split in channels.
+		for (; i + 8 <= count; i += 8) {
+			uint8x8x4_t pixels = vld4_u8(&ptr[i * 4]);
+			pixels.val[0] = vshrn_n_u16(vmull_u8(pixels.val[0], pixels.val[3]), 8);
+			pixels.val[1] = vshrn_n_u16(vmull_u8(pixels.val[1], pixels.val[3]), 8);
+			pixels.val[2] = vshrn_n_u16(vmull_u8(pixels.val[2], pixels.val[3]), 8);
+			vst4_u8(&ptr[i * 4], pixels);
+		}
+#endif
 
-			ptr[0] = (uint16_t(ptr[0]) * uint16_t(ptr[3])) >> 8;
-			ptr[1] = (uint16_t(ptr[1]) * uint16_t(ptr[3])) >> 8;
-			ptr[2] = (uint16_t(ptr[2]) * uint16_t(ptr[3])) >> 8;
+		for (; i < count; i++) {
+			uint16_t a = ptr[i * 4 + 3];
+			ptr[i * 4 + 0] = (uint16_t(ptr[i * 4 + 0]) * a) >> 8;
+			ptr[i * 4 + 1] = (uint16_t(ptr[i * 4 + 1]) * a) >> 8;
+			ptr[i * 4 + 2] = (uint16_t(ptr[i * 4 + 2]) * a) >> 8;
 		}
-	}
+	});
 }
 
 void Image::fix_alpha_edges() {
@@ -3427,52 +3562,54 @@ void Image::fix_alpha_edges() {
 	const int alpha_threshold = 20;
 	const int max_dist = 0x7FFFFFFF;
 
-	for (int i = 0; i < height; i++) {
-		for (int j = 0; j < width; j++) {
-			const uint8_t *rptr = &srcptr[(i * width + j) * 4];
-			uint8_t *wptr = &data_ptr[(i * width + j) * 4];
+	_process_rows(height, uint64_t(width) * height, [&](uint32_t p_from_row, uint32_t p_to_row) {
+		for (int i = p_from_row; i < (int)p_to_row; i++) {
+			for (int j = 0; j < width; j++) {
+				const uint8_t *rptr = &srcptr[(i * width + j) * 4];
+				uint8_t *wptr = &data_ptr[(i * width + j) * 4];
 
-			if (rptr[3] >= alpha_threshold) {
-				continue;
-			}
+				if (rptr[3] >= alpha_threshold) {
+					continue;
+				}
 
-			int closest_dist = max_dist;
-			uint8_t closest_color[3];
-
-			int from_x = MAX(0, j - max_radius);
-			int to_x = MIN(width - 1, j + max_radius);
-			int from_y = MAX(0, i - max_radius);
-			int to_y = MIN(height - 1, i + max_radius);
-
-			for (int k = from_y; k <= to_y; k++) {
-				for (int l = from_x; l <= to_x; l++) {
-					int dy = i - k;
-					int dx = j - l;
-					int dist = dy * dy + dx * dx;
-					if (dist >= closest_dist) {
-						continue;
-					}
+				int closest_dist = max_dist;
+				uint8_t closest_color[3];
+
+				int from_x = MAX(0, j - max_radius);
+				int to_x = MIN(width - 1, j + max_radius);
+				int from_y = MAX(0, i - max_radius);
+				int to_y = MIN(height - 1, i + max_radius);
+
+				for (int k = from_y; k <= to_y; k++) {
+					for (int l = from_x; l <= to_x; l++) {
+						int dy = i - k;
+						int dx = j - l;
+						int dist = dy * dy + dx * dx;
+						if (dist >= closest_dist) {
+							continue;
+						}
 
-					const uint8_t *rp2 = &srcptr[(k * width + l) << 2];
+						const uint8_t *rp2 = &srcptr[(k * width + l) << 2];
 
-					if (rp2[3] < alpha_threshold) {
-						continue;
-					}
+						if (rp2[3] < alpha_threshold) {
+							continue;
+						}
 
-					closest_dist = dist;
-					closest_color[0] = rp2[0];
-					closest_color[1] = rp2[1];
-					closest_color[2] = rp2[2];
+						closest_dist = dist;
+						closest_color[0] = rp2[0];
+						closest_color[1] = rp2[1];
+						closest_color[2] = rp2[2];
+					}
 				}
-			}
 
-			if (closest_dist != max_dist) {
-				wptr[0] = closest_color[0];
-				wptr[1] = closest_color[1];
-				wptr[2] = closest_color[2];
+				if (closest_dist != max_dist) {
+					wptr[0] = closest_color[0];
+					wptr[1] = closest_color[1];
+					wptr[2] = closest_color[2];
+				}
 			}
 		}
-	}
+	});
 }
 
 String Image::get_format_name(Format p_format) {
@@ -33,6 +33,7 @@
 #include "core/object/reference.h"
 #include "core/os/keyboard.h"
 #include "core/string/print_string.h"
+#include "core/variant/variant_internal.h"
 
 #include <limits.h>
 #include <stdio.h>
@@ -59,6 +60,22 @@ ObjectID EncodedObjectAsID::get_object_id() const {
 #define ENCODE_MASK 0xFF
 #define ENCODE_FLAG_64 1 << 16
 #define ENCODE_FLAG_OBJECT_AS_ID 1 << 16
+#define ENCODE_FLAG_TYPED_ARRAY 1 << 16
+
+// Typed arrays of these types store their element type once, followed by the elements without their own headers.
+static bool _is_array_schema_type(uint32_t p_type) {
+	switch (p_type) {
+		case Variant::NIL:
+		case Variant::RID:
+		case Variant::OBJECT:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL:
+		case Variant::ARRAY:
+			return false;
+		default:
+			return p_type < Variant::VARIANT_MAX;
+	}
+}
 
 static Error _decode_string(const uint8_t *&buf, int &len, int *r_len, String &r_string) {
 	ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
@@ -78,9 +95,7 @@ static Error _decode_string(const uint8_t *&buf, int &len, int *r_len, String &r
 	ERR_FAIL_ADD_OF(strlen, pad, ERR_FILE_EOF);
 	ERR_FAIL_COND_V(strlen < 0 || strlen + pad > len, ERR_FILE_EOF);
 
-	String str;
-	ERR_FAIL_COND_V(str.parse_utf8((const char *)buf, strlen), ERR_INVALID_DATA);
-	r_string = str;
+	ERR_FAIL_COND_V(r_string.parse_utf8((const char *)buf, strlen), ERR_INVALID_DATA);
 
 	// Add padding
 	strlen += pad;
@@ -95,22 +110,18 @@ static Error _decode_string(const uint8_t *&buf, int &len, int *r_len, String &r
 	return OK;
 }
 
-Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects) {
+template <class T>
+static Vector<T> &_get_packed_array_storage(Variant &r_variant, Variant::Type p_type, bool p_reuse_storage) {
+	if (!p_reuse_storage || r_variant.get_type() != p_type) {
+		r_variant = Vector<T>();
+	}
+	return *VariantGetInternalPtr<Vector<T>>::get_ptr(&r_variant);
+}
+
+static Error _decode_variant_payload(Variant &r_variant, uint32_t type, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, bool p_reuse_storage) {
 	const uint8_t *buf = p_buffer;
 	int len = p_len;
 
-	ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
-
-	uint32_t type = decode_uint32(buf);
-
-	ERR_FAIL_COND_V((type & ENCODE_MASK) >= Variant::VARIANT_MAX, ERR_INVALID_DATA);
-
-	buf += 4;
-	len -= 4;
-	if (r_len) {
-		*r_len = 4;
-	}
-
 	switch (type & ENCODE_MASK) {
 		case Variant::NIL: {
 			r_variant = Variant();
@@ -161,12 +172,19 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 		} break;
 		case Variant::STRING: {
-			String str;
-			Error err = _decode_string(buf, len, r_len, str);
-			if (err) {
-				return err;
+			if (p_reuse_storage && r_variant.get_type() == Variant::STRING) {
+				Error err = _decode_string(buf, len, r_len, *VariantInternal::get_string(&r_variant));
+				if (err) {
+					return err;
+				}
+			} else {
+				String str;
+				Error err = _decode_string(buf, len, r_len, str);
+				if (err) {
+					return err;
+				}
+				r_variant = str;
 			}
-			r_variant = str;
 
 		} break;
 
@@ -562,16 +580,45 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				(*r_len) += 4;
 			}
 
+			uint32_t element_type = Variant::NIL;
+			if (type & ENCODE_FLAG_TYPED_ARRAY) {
+				ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
+				element_type = decode_uint32(buf);
+				ERR_FAIL_COND_V(!_is_array_schema_type(element_type), ERR_INVALID_DATA);
+
+				buf += 4;
+				len -= 4;
+
+				if (r_len) {
+					(*r_len) += 4;
+				}
+			}
+
+			// Every element takes at least 4 bytes, so the count can be checked before resizing.
+			ERR_FAIL_COND_V(count > len / 4, ERR_INVALID_DATA);
+
 			Array varr;
+			if (p_reuse_storage && r_variant.get_type() == Variant::ARRAY && VariantInternal::get_array(&r_variant)->get_typed_builtin() == element_type) {
+				varr = *VariantInternal::get_array(&r_variant);
+			} else if (element_type != Variant::NIL) {
+				varr.set_typed(element_type, StringName(), Variant());
+			}
+			varr.resize(count);
+
+			// INT and FLOAT elements of typed arrays are always stored with 64 bits.
+			uint32_t element_flags = (element_type == Variant::INT || element_type == Variant::FLOAT) ? ENCODE_FLAG_64 : 0;
 
 			for (int i = 0; i < count; i++) {
 				int used = 0;
-				Variant v;
-				Error err = decode_variant(v, buf, len, &used, p_allow_objects);
+				Error err;
+				if (element_type != Variant::NIL) {
+					err = _decode_variant_payload(varr[i], element_type | element_flags, buf, len, &used, p_allow_objects, p_reuse_storage);
+				} else {
+					err = decode_variant(varr[i], buf, len, &used, p_allow_objects, p_reuse_storage);
+				}
 				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 				buf += used;
 				len -= used;
-				varr.push_back(v);
 				if (r_len) {
 					(*r_len) += used;
 				}
@@ -589,18 +636,16 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			len -= 4;
 			ERR_FAIL_COND_V(count < 0 || count > len, ERR_INVALID_DATA);
 
-			Vector<uint8_t> data;
+			Vector<uint8_t> &data = _get_packed_array_storage<uint8_t>(r_variant, Variant::PACKED_BYTE_ARRAY, p_reuse_storage);
 
+			data.resize(count);
 			if (count) {
-				data.resize(count);
 				uint8_t *w = data.ptrw();
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = buf[i];
 				}
 			}
 
-			r_variant = data;
-
 			if (r_len) {
 				if (count % 4) {
 					(*r_len) += 4 - count % 4;
@@ -617,17 +662,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 4, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 4 > len, ERR_INVALID_DATA);
 
-			Vector<int32_t> data;
+			Vector<int32_t> &data = _get_packed_array_storage<int32_t>(r_variant, Variant::PACKED_INT32_ARRAY, p_reuse_storage);
 
+			data.resize(count);
 			if (count) {
-				//const int*rbuf=(const int*)buf;
-				data.resize(count);
 				int32_t *w = data.ptrw();
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_uint32(&buf[i * 4]);
 				}
 			}
-			r_variant = Variant(data);
 			if (r_len) {
 				(*r_len) += 4 + count * sizeof(int32_t);
 			}
@@ -641,17 +684,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 8, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 8 > len, ERR_INVALID_DATA);
 
-			Vector<int64_t> data;
+			Vector<int64_t> &data = _get_packed_array_storage<int64_t>(r_variant, Variant::PACKED_INT64_ARRAY, p_reuse_storage);
 
+			data.resize(count);
 			if (count) {
-				//const int*rbuf=(const int*)buf;
-				data.resize(count);
 				int64_t *w = data.ptrw();
 				for (int64_t i = 0; i < count; i++) {
 					w[i] = decode_uint64(&buf[i * 8]);
 				}
 			}
-			r_variant = Variant(data);
 			if (r_len) {
 				(*r_len) += 4 + count * sizeof(int64_t);
 			}
@@ -665,17 +706,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 4, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 4 > len, ERR_INVALID_DATA);
 
-			Vector<float> data;
+			Vector<float> &data = _get_packed_array_storage<float>(r_variant, Variant::PACKED_FLOAT32_ARRAY, p_reuse_storage);
 
+			data.resize(count);
 			if (count) {
-				//const float*rbuf=(const float*)buf;
-				data.resize(count);
 				float *w = data.ptrw();
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_float(&buf[i * 4]);
 				}
 			}
-			r_variant = data;
 
 			if (r_len) {
 				(*r_len) += 4 + count * sizeof(float);
@@ -690,17 +729,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 8, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 8 > len, ERR_INVALID_DATA);
 
-			Vector<double> data;
+			Vector<double> &data = _get_packed_array_storage<double>(r_variant, Variant::PACKED_FLOAT64_ARRAY, p_reuse_storage);
 
+			data.resize(count);
 			if (count) {
-				//const double*rbuf=(const double*)buf;
-				data.resize(count);
 				double *w = data.ptrw();
 				for (int64_t i = 0; i < count; i++) {
 					w[i] = decode_double(&buf[i * 8]);
 				}
 			}
-			r_variant = data;
 
 			if (r_len) {
 				(*r_len) += 4 + count * sizeof(double);
@@ -741,14 +778,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			ERR_FAIL_MUL_OF(count, 4 * 2, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 4 * 2 > len, ERR_INVALID_DATA);
-			Vector<Vector2> varray;
+			Vector<Vector2> &varray = _get_packed_array_storage<Vector2>(r_variant, Variant::PACKED_VECTOR2_ARRAY, p_reuse_storage);
 
 			if (r_len) {
 				(*r_len) += 4;
 			}
 
+			varray.resize(count);
 			if (count) {
-				varray.resize(count);
 				Vector2 *w = varray.ptrw();
 
 				for (int32_t i = 0; i < count; i++) {
@@ -763,8 +800,6 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				}
 			}
 
-			r_variant = varray;
-
 		} break;
 		case Variant::PACKED_VECTOR3_ARRAY: {
 			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
@@ -775,14 +810,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 4 * 3, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 4 * 3 > len, ERR_INVALID_DATA);
 
-			Vector<Vector3> varray;
+			Vector<Vector3> &varray = _get_packed_array_storage<Vector3>(r_variant, Variant::PACKED_VECTOR3_ARRAY, p_reuse_storage);
 
 			if (r_len) {
 				(*r_len) += 4;
 			}
 
+			varray.resize(count);
 			if (count) {
-				varray.resize(count);
 				Vector3 *w = varray.ptrw();
 
 				for (int32_t i = 0; i < count; i++) {
@@ -798,8 +833,6 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				}
 			}
 
-			r_variant = varray;
-
 		} break;
 		case Variant::PACKED_COLOR_ARRAY: {
 			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
@@ -810,14 +843,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 4 * 4, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 4 * 4 > len, ERR_INVALID_DATA);
 
-			Vector<Color> carray;
+			Vector<Color> &carray = _get_packed_array_storage<Color>(r_variant, Variant::PACKED_COLOR_ARRAY, p_reuse_storage);
 
 			if (r_len) {
 				(*r_len) += 4;
 			}
 
+			carray.resize(count);
 			if (count) {
-				carray.resize(count);
 				Color *w = carray.ptrw();
 
 				for (int32_t i = 0; i < count; i++) {
@@ -834,8 +867,6 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				}
 			}
 
-			r_variant = carray;
-
 		} break;
 		default: {
 			ERR_FAIL_V(ERR_BUG);
@@ -845,17 +876,33 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 	return OK;
 }
 
+Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, bool p_reuse_storage) {
+	ERR_FAIL_COND_V(p_len < 4, ERR_INVALID_DATA);
+
+	uint32_t type = decode_uint32(p_buffer);
+
+	ERR_FAIL_COND_V((type & ENCODE_MASK) >= Variant::VARIANT_MAX, ERR_INVALID_DATA);
+
+	if (r_len) {
+		*r_len = 4;
+	}
+
+	return _decode_variant_payload(r_variant, type, p_buffer + 4, p_len - 4, r_len, p_allow_objects, p_reuse_storage);
+}
+
 static void _encode_string(const String &p_string, uint8_t *&buf, int &r_len) {
-	CharString utf8 = p_string.utf8();
+	int utf8_len = p_string.utf8_length();
 
 	if (buf) {
-		encode_uint32(utf8.length(), buf);
+		encode_uint32(utf8_len, buf);
 		buf += 4;
-		copymem(buf, utf8.get_data(), utf8.length());
-		buf += utf8.length();
+		if (utf8_len) {
+			p_string.utf8_write(buf);
+		}
+		buf += utf8_len;
 	}
 
-	r_len += 4 + utf8.length();
+	r_len += 4 + utf8_len;
 	while (r_len % 4) {
 		r_len++; //pad
 		if (buf) {
@@ -864,53 +911,9 @@ static void _encode_string(const String &p_string, uint8_t *&buf, int &r_len) {
 	}
 }
 
-Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects) {
+static Error _encode_variant_payload(const Variant &p_variant, uint32_t p_flags, uint8_t *r_buffer, int &r_len, bool p_full_objects) {
 	uint8_t *buf = r_buffer;
 
-	r_len = 0;
-
-	uint32_t flags = 0;
-
-	switch (p_variant.get_type()) {
-		case Variant::INT: {
-			int64_t val = p_variant;
-			if (val > (int64_t)INT_MAX || val < (int64_t)INT_MIN) {
-				flags |= ENCODE_FLAG_64;
-			}
-		} break;
-		case Variant::FLOAT: {
-			double d = p_variant;
-			float f = d;
-			if (double(f) != d) {
-				flags |= ENCODE_FLAG_64; //always encode real as double
-			}
-		} break;
-		case Variant::OBJECT: {
-			// Test for potential wrong values sent by the debugger when it breaks.
-			Object *obj = p_variant.get_validated_object();
-			if (!obj) {
-				// Object is invalid, send a nullptr  instead.
-				if (buf) {
-					encode_uint32(Variant::NIL, buf);
-				}
-				r_len += 4;
-				return OK;
-			}
-
-			if (!p_full_objects) {
-				flags |= ENCODE_FLAG_OBJECT_AS_ID;
-			}
-		} break;
-		default: {
-		} // nothing to do at this stage
-	}
-
-	if (buf) {
-		encode_uint32(p_variant.get_type() | flags, buf);
-		buf += 4;
-	}
-	r_len += 4;
-
 	switch (p_variant.get_type()) {
 		case Variant::NIL: {
 			//nothing to do
@@ -924,7 +927,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 		} break;
 		case Variant::INT: {
-			if (flags & ENCODE_FLAG_64) {
+			if (p_flags & ENCODE_FLAG_64) {
 				//64 bits
 				if (buf) {
 					encode_uint64(p_variant.operator int64_t(), buf);
@@ -940,7 +943,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			}
 		} break;
 		case Variant::FLOAT: {
-			if (flags & ENCODE_FLAG_64) {
+			if (p_flags & ENCODE_FLAG_64) {
 				if (buf) {
 					encode_double(p_variant.operator double(), buf);
 				}
@@ -984,22 +987,24 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 					str = np.get_subname(i - np.get_name_count());
 				}
 
-				CharString utf8 = str.utf8();
+				int utf8_len = str.utf8_length();
 
 				int pad = 0;
 
-				if (utf8.length() % 4) {
-					pad = 4 - utf8.length() % 4;
+				if (utf8_len % 4) {
+					pad = 4 - utf8_len % 4;
 				}
 
 				if (buf) {
-					encode_uint32(utf8.length(), buf);
+					encode_uint32(utf8_len, buf);
 					buf += 4;
-					copymem(buf, utf8.get_data(), utf8.length());
-					buf += pad + utf8.length();
+					if (utf8_len) {
+						str.utf8_write(buf);
+					}
+					buf += pad + utf8_len;
 				}
 
-				r_len += 4 + utf8.length() + pad;
+				r_len += 4 + utf8_len + pad;
 			}
 
 		} break;
@@ -1248,10 +1253,8 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			}
 			r_len += 4;
 
-			List<Variant> keys;
-			d.get_key_list(&keys);
-
-			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+			const Variant *K = nullptr;
+			while ((K = d.next(K))) {
 				/*
 				CharString utf8 = E->->utf8();
 
@@ -1266,13 +1269,13 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 					r_len++; //pad
 				*/
 				int len;
-				encode_variant(E->get(), buf, len, p_full_objects);
+				encode_variant(*K, buf, len, p_full_objects);
 				ERR_FAIL_COND_V(len % 4, ERR_BUG);
 				r_len += len;
 				if (buf) {
 					buf += len;
 				}
-				Variant *v = d.getptr(E->get());
+				const Variant *v = d.getptr(*K);
 				ERR_FAIL_COND_V(!v, ERR_BUG);
 				encode_variant(*v, buf, len, p_full_objects);
 				ERR_FAIL_COND_V(len % 4, ERR_BUG);
@@ -1293,13 +1296,39 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 			r_len += 4;
 
-			for (int i = 0; i < v.size(); i++) {
-				int len;
-				encode_variant(v.get(i), buf, len, p_full_objects);
-				ERR_FAIL_COND_V(len % 4, ERR_BUG);
-				r_len += len;
+			if (p_flags & ENCODE_FLAG_TYPED_ARRAY) {
+				uint32_t element_type = v.get_typed_builtin();
+				// There is no per element header to tell 32 and 64 bit values apart, so always use 64 bits.
+				uint32_t element_flags = (element_type == Variant::INT || element_type == Variant::FLOAT) ? ENCODE_FLAG_64 : 0;
+
 				if (buf) {
-					buf += len;
+					encode_uint32(element_type, buf);
+					buf += 4;
+				}
+
+				r_len += 4;
+
+				for (int i = 0; i < v.size(); i++) {
+					int len = 0;
+					Error err = _encode_variant_payload(v.get(i), element_flags, buf, len, p_full_objects);
+					if (err) {
+						return err;
+					}
+					ERR_FAIL_COND_V(len % 4, ERR_BUG);
+					r_len += len;
+					if (buf) {
+						buf += len;
+					}
+				}
+			} else {
+				for (int i = 0; i < v.size(); i++) {
+					int len;
+					encode_variant(v.get(i), buf, len, p_full_objects);
+					ERR_FAIL_COND_V(len % 4, ERR_BUG);
+					r_len += len;
+					if (buf) {
+						buf += len;
+					}
 				}
 			}
 
@@ -1407,16 +1436,20 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			for (int i = 0; i < len; i++) {
-				CharString utf8 = data.get(i).utf8();
+				const String &str = data[i];
+				int utf8_len = str.utf8_length();
 
 				if (buf) {
-					encode_uint32(utf8.length() + 1, buf);
+					encode_uint32(utf8_len + 1, buf);
 					buf += 4;
-					copymem(buf, utf8.get_data(), utf8.length() + 1);
-					buf += utf8.length() + 1;
+					if (utf8_len) {
+						str.utf8_write(buf);
+					}
+					buf[utf8_len] = 0;
+					buf += utf8_len + 1;
 				}
 
-				r_len += 4 + utf8.length() + 1;
+				r_len += 4 + utf8_len + 1;
 				while (r_len % 4) {
 					r_len++; //pad
 					if (buf) {
@@ -1508,3 +1541,78 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 	return OK;
 }
+
+Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects) {
+	uint8_t *buf = r_buffer;
+
+	r_len = 0;
+
+	uint32_t flags = 0;
+
+	switch (p_variant.get_type()) {
+		case Variant::INT: {
+			int64_t val = p_variant;
+			if (val > (int64_t)INT_MAX || val < (int64_t)INT_MIN) {
+				flags |= ENCODE_FLAG_64;
+			}
+		} break;
+		case Variant::FLOAT: {
+			double d = p_variant;
+			float f = d;
+			if (double(f) != d) {
+				flags |= ENCODE_FLAG_64; //always encode real as double
+			}
+		} break;
+		case Variant::OBJECT: {
+			// Test for potential wrong values sent by the debugger when it breaks.
+			Object *obj = p_variant.get_validated_object();
+			if (!obj) {
+				// Object is invalid, send a nullptr  instead.
+				if (buf) {
+					encode_uint32(Variant::NIL, buf);
+				}
+				r_len += 4;
+				return OK;
+			}
+
+			if (!p_full_objects) {
+				flags |= ENCODE_FLAG_OBJECT_AS_ID;
+			}
+		} break;
+		case Variant::ARRAY: {
+			const Array *array = VariantInternal::get_array(&p_variant);
+			if (array->is_typed() && _is_array_schema_type(array->get_typed_builtin())) {
+				flags |= ENCODE_FLAG_TYPED_ARRAY;
+			}
+		} break;
+		default: {
+		} // nothing to do at this stage
+	}
+
+	if (buf) {
+		encode_uint32(p_variant.get_type() | flags, buf);
+		buf += 4;
+	}
+	r_len += 4;
+
+	return _encode_variant_payload(p_variant, flags, buf, r_len, p_full_objects);
+}
+
+Error encode_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer, int p_offset, int &r_len, bool p_full_objects) {
+	ERR_FAIL_COND_V(p_offset < 0, ERR_INVALID_PARAMETER);
+
+	Error err = encode_variant(p_variant, nullptr, r_len, p_full_objects);
+	if (err) {
+		return err;
+	}
+
+	ERR_FAIL_COND_V(r_len > INT_MAX - p_offset, ERR_OUT_OF_MEMORY);
+	if (r_buffer.size() < p_offset + r_len) {
+		err = r_buffer.resize(p_offset + r_len);
+		if (err) {
+			return err;
+		}
+	}
+
+	return encode_variant(p_variant, r_buffer.ptrw() + p_offset, r_len, p_full_objects);
+}
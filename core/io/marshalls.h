@@ -180,7 +180,10 @@ public:
 	EncodedObjectAsID() {}
 };
 
-Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false);
+// With p_reuse_storage, strings, arrays and packed arrays already held by r_variant are decoded into in place.
+Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false, bool p_reuse_storage = false);
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false);
+// Encodes at p_offset, growing r_buffer only when it is too small. r_len is the encoded size, not the buffer size.
+Error encode_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer, int p_offset, int &r_len, bool p_full_objects = false);
 
 #endif // MARSHALLS_H
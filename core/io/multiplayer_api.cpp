@@ -135,6 +135,7 @@ void MultiplayerAPI::clear() {
 	path_get_cache.clear();
 	path_send_cache.clear();
 	packet_cache.clear();
+	received_args_cache.clear();
 	last_send_cache_id = 1;
 }
 
@@ -392,7 +393,10 @@ void MultiplayerAPI::_process_rpc(Node *p_node, const uint16_t p_rpc_method_id,
 		p_offset += 1;
 	}
 
-	Vector<Variant> args;
+	// Decode into the arguments of the last call, unless they are still used by a call that is running.
+	Vector<Variant> call_args;
+	const bool reuse_args = !received_args_cache_in_use;
+	Vector<Variant> &args = reuse_args ? received_args_cache : call_args;
 	Vector<const Variant *> argp;
 	args.resize(argc);
 	argp.resize(argc);
@@ -414,7 +418,7 @@ void MultiplayerAPI::_process_rpc(Node *p_node, const uint16_t p_rpc_method_id,
 			ERR_FAIL_COND_MSG(p_offset >= p_packet_len, "Invalid packet received. Size too small.");
 
 			int vlen;
-			Error err = _decode_and_decompress_variant(args.write[i], &p_packet[p_offset], p_packet_len - p_offset, &vlen);
+			Error err = _decode_and_decompress_variant(args.write[i], &p_packet[p_offset], p_packet_len - p_offset, &vlen, reuse_args);
 			ERR_FAIL_COND_MSG(err != OK, "Invalid packet received. Unable to decode RPC argument.");
 
 			argp.write[i] = &args[i];
@@ -424,7 +428,11 @@ void MultiplayerAPI::_process_rpc(Node *p_node, const uint16_t p_rpc_method_id,
 
 	Callable::CallError ce;
 
+	received_args_cache_in_use = reuse_args;
 	p_node->call(name, (const Variant **)argp.ptr(), argc, ce);
+	if (reuse_args) {
+		received_args_cache_in_use = false;
+	}
 	if (ce.error != Callable::CallError::CALL_OK) {
 		String error = Variant::get_call_error_text(p_node, name, (const Variant **)argp.ptr(), argc, ce);
 		error = "RPC - " + error;
@@ -451,14 +459,24 @@ void MultiplayerAPI::_process_rset(Node *p_node, const uint16_t p_rpc_property_i
 	_profile_node_data("in_rset", p_node->get_instance_id());
 #endif
 
-	Variant value;
-	Error err = _decode_and_decompress_variant(value, &p_packet[p_offset], p_packet_len - p_offset, nullptr);
+	// Decode into the arguments of the last call, unless they are still used by a call that is running.
+	Variant set_value;
+	const bool reuse_value = !received_args_cache_in_use;
+	if (reuse_value) {
+		received_args_cache.resize(1);
+	}
+	Variant &value = reuse_value ? received_args_cache.write[0] : set_value;
+	Error err = _decode_and_decompress_variant(value, &p_packet[p_offset], p_packet_len - p_offset, nullptr, reuse_value);
 
 	ERR_FAIL_COND_MSG(err != OK, "Invalid packet received. Unable to decode RSET value.");
 
 	bool valid;
 
+	received_args_cache_in_use = reuse_value;
 	p_node->set(name, value, &valid);
+	if (reuse_value) {
+		received_args_cache_in_use = false;
+	}
 	if (!valid) {
 		String error = "Error setting remote property '" + String(name) + "', not found in object of type " + p_node->get_class() + ".";
 		ERR_PRINT(error);
@@ -609,82 +627,72 @@ bool MultiplayerAPI::_send_confirm_path(Node *p_node, NodePath p_path, PathSentC
 #define ENCODE_16 1 << 5
 #define ENCODE_32 2 << 5
 #define ENCODE_64 3 << 5
-Error MultiplayerAPI::_encode_and_compress_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len) {
+Error MultiplayerAPI::_encode_and_compress_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer, int p_offset, int &r_len) {
 	// Unreachable because `VARIANT_MAX` == 27 and `ENCODE_VARIANT_MASK` == 31
 	CRASH_COND(p_variant.get_type() > VARIANT_META_TYPE_MASK);
 
-	uint8_t *buf = r_buffer;
+	// The meta, followed by up to 64 bits of value.
+	uint8_t buf[9];
 	r_len = 0;
 	uint8_t encode_mode = 0;
 
 	switch (p_variant.get_type()) {
 		case Variant::BOOL: {
-			if (buf) {
-				// We still have 1 free bit in the meta, so let's use it.
-				buf[0] = (p_variant.operator bool()) ? (1 << 7) : 0;
-				buf[0] |= encode_mode | p_variant.get_type();
-			}
+			// We still have 1 free bit in the meta, so let's use it.
+			buf[0] = (p_variant.operator bool()) ? (1 << 7) : 0;
+			buf[0] |= encode_mode | p_variant.get_type();
 			r_len += 1;
 		} break;
 		case Variant::INT: {
-			if (buf) {
-				// Reserve the first byte for the meta.
-				buf += 1;
-			}
+			// Reserve the first byte for the meta.
 			r_len += 1;
 			int64_t val = p_variant;
 			if (val <= (int64_t)INT8_MAX && val >= (int64_t)INT8_MIN) {
 				// Use 8 bit
 				encode_mode = ENCODE_8;
-				if (buf) {
-					buf[0] = val;
-				}
+				buf[1] = val;
 				r_len += 1;
 			} else if (val <= (int64_t)INT16_MAX && val >= (int64_t)INT16_MIN) {
 				// Use 16 bit
 				encode_mode = ENCODE_16;
-				if (buf) {
-					encode_uint16(val, buf);
-				}
+				encode_uint16(val, &buf[1]);
 				r_len += 2;
 			} else if (val <= (int64_t)INT32_MAX && val >= (int64_t)INT32_MIN) {
 				// Use 32 bit
 				encode_mode = ENCODE_32;
-				if (buf) {
-					encode_uint32(val, buf);
-				}
+				encode_uint32(val, &buf[1]);
 				r_len += 4;
 			} else {
 				// Use 64 bit
 				encode_mode = ENCODE_64;
-				if (buf) {
-					encode_uint64(val, buf);
-				}
+				encode_uint64(val, &buf[1]);
 				r_len += 8;
 			}
 			// Store the meta
-			if (buf) {
-				buf -= 1;
-				buf[0] = encode_mode | p_variant.get_type();
-			}
+			buf[0] = encode_mode | p_variant.get_type();
 		} break;
-		default:
+		default: {
 			// Any other case is not yet compressed.
-			Error err = encode_variant(p_variant, r_buffer, r_len, allow_object_decoding);
+			Error err = encode_variant(p_variant, r_buffer, p_offset, r_len, allow_object_decoding);
 			if (err != OK) {
 				return err;
 			}
-			if (r_buffer) {
-				// The first byte is not used by the marshalling, so store the type
-				// so we know how to decompress and decode this variant.
-				r_buffer[0] = p_variant.get_type();
-			}
+			// The first byte is not used by the marshalling, so store the type
+			// so we know how to decompress and decode this variant.
+			r_buffer.write[p_offset] = p_variant.get_type();
+			return OK;
+		}
+	}
+
+	if (r_buffer.size() < p_offset + r_len) {
+		r_buffer.resize(p_offset + r_len);
 	}
+	copymem(r_buffer.ptrw() + p_offset, buf, r_len);
 
 	return OK;
 }
 
-Error MultiplayerAPI::_decode_and_decompress_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len) {
+Error MultiplayerAPI::_decode_and_decompress_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_reuse_storage) {
 	const uint8_t *buf = p_buffer;
 	int len = p_len;
 
@@ -743,7 +751,11 @@ Error MultiplayerAPI::_decode_and_decompress_variant(Variant &r_variant, const u
 			}
 		} break;
 		default:
-			Error err = decode_variant(r_variant, p_buffer, p_len, r_len, allow_object_decoding);
+			if (p_reuse_storage && r_variant.get_type() == Variant::ARRAY) {
+				// Arrays are shared by reference, the node that got it last time may have kept it.
+				r_variant = Variant();
+			}
+			Error err = decode_variant(r_variant, p_buffer, p_len, r_len, allow_object_decoding, p_reuse_storage);
 			if (err != OK) {
 				return err;
 			}
@@ -861,10 +873,8 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 
 		// Set argument.
 		int len(0);
-		Error err = _encode_and_compress_variant(*p_arg[0], nullptr, len);
+		Error err = _encode_and_compress_variant(*p_arg[0], packet_cache, ofs, len);
 		ERR_FAIL_COND_MSG(err != OK, "Unable to encode RSET value. THIS IS LIKELY A BUG IN THE ENGINE!");
-		MAKE_ROOM(ofs + len);
-		_encode_and_compress_variant(*p_arg[0], &(packet_cache.write[ofs]), len);
 		ofs += len;
 
 	} else {
@@ -906,10 +916,8 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 			ofs += 1;
 			for (int i = 0; i < p_argcount; i++) {
 				int len(0);
-				Error err = _encode_and_compress_variant(*p_arg[i], nullptr, len);
+				Error err = _encode_and_compress_variant(*p_arg[i], packet_cache, ofs, len);
 				ERR_FAIL_COND_MSG(err != OK, "Unable to encode RPC argument. THIS IS LIKELY A BUG IN THE ENGINE!");
-				MAKE_ROOM(ofs + len);
-				_encode_and_compress_variant(*p_arg[i], &(packet_cache.write[ofs]), len);
 				ofs += len;
 			}
 		}
@@ -61,6 +61,8 @@ private:
 	Map<int, PathGetCache> path_get_cache;
 	int last_send_cache_id;
 	Vector<uint8_t> packet_cache;
+	Vector<Variant> received_args_cache; // Storage reused to decode RPC arguments and RSET values.
+	bool received_args_cache_in_use = false;
 	Node *root_node = nullptr;
 	bool allow_object_decoding = false;
 
@@ -78,8 +80,9 @@ protected:
 	void _send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p_set, const StringName &p_name, const Variant **p_arg, int p_argcount);
 	bool _send_confirm_path(Node *p_node, NodePath p_path, PathSentCache *psc, int p_target);
 
-	Error _encode_and_compress_variant(const Variant &p_variant, uint8_t *p_buffer, int &r_len);
-	Error _decode_and_decompress_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len);
+	// Encodes at p_offset, growing r_buffer when it is too small.
+	Error _encode_and_compress_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer, int p_offset, int &r_len);
+	Error _decode_and_decompress_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_reuse_storage = false);
 
 public:
 	enum NetworkCommands {
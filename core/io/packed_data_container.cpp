@@ -239,9 +239,7 @@ uint32_t PackedDataContainer::_pack(const Variant &p_data, Vector<uint8_t> &tmpd
 		case Variant::NODE_PATH: {
 			uint32_t pos = tmpdata.size();
 			int len;
-			encode_variant(p_data, nullptr, len, false);
-			tmpdata.resize(tmpdata.size() + len);
-			encode_variant(p_data, &tmpdata.write[pos], len, false);
+			encode_variant(p_data, tmpdata, pos, len, false);
 			return pos;
 
 		} break;
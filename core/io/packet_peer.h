@@ -63,7 +63,8 @@ public:
 	virtual Error get_packet_buffer(Vector<uint8_t> &r_buffer);
 	virtual Error put_packet_buffer(const Vector<uint8_t> &p_buffer);
 
-	virtual Error get_var(Variant &r_variant, bool p_allow_objects = false);
+	// With p_reuse_storage, r_variant is decoded into in place, see decode_variant().
+	virtual Error get_var(Variant &r_variant, bool p_allow_objects = false, bool p_reuse_storage = false);
 	virtual Error put_var(const Variant &p_packet, bool p_full_objects = false);
 
 	void set_encode_buffer_max_size(int p_max_size);
@@ -31,12 +31,18 @@
 #include "pck_packer.h"
 
 #include "core/crypto/crypto_core.h"
+#include "core/io/compression.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/marshalls.h"
 #include "core/os/file_access.h"
 #include "core/version.h"
 
 static int _get_pad(int p_alignment, int p_n) {
+	if (p_alignment <= 0) {
+		return 0; // No alignment, the default.
+	}
+
 	int rest = p_n % p_alignment;
 	int pad = 0;
 	if (rest > 0) {
@@ -48,7 +54,9 @@ static int _get_pad(int p_alignment, int p_n) {
 
 void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_name", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(0), DEFVAL(String()), DEFVAL(false));
-	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("set_compression_dictionary", "dictionary"), &PCKPacker::set_compression_dictionary);
+	ClassDB::bind_method(D_METHOD("build_compression_dictionary", "sample_paths", "max_size"), &PCKPacker::build_compression_dictionary, DEFVAL(COMPRESSION_DICTIONARY_MAX_SIZE));
+	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt", "compress"), &PCKPacker::add_file, DEFVAL(false), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
 }
 
@@ -105,12 +113,101 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 	file->store_32(pack_flags); // flags
 
 	files.clear();
+	dictionary.clear();
+	if (compression_dictionary) {
+		Compression::free_zstd_dictionary(compression_dictionary);
+		compression_dictionary = nullptr;
+	}
 	ofs = 0;
 
 	return OK;
 }
 
-Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encrypt) {
+Error PCKPacker::set_compression_dictionary(const Vector<uint8_t> &p_dictionary) {
+	ERR_FAIL_COND_V_MSG(!file, ERR_INVALID_PARAMETER, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(files.size(), ERR_ALREADY_IN_USE, "The compression dictionary must be set before adding files.");
+
+	if (compression_dictionary) {
+		Compression::free_zstd_dictionary(compression_dictionary);
+		compression_dictionary = nullptr;
+	}
+	if (!p_dictionary.is_empty()) {
+		compression_dictionary = Compression::create_zstd_compression_dictionary(p_dictionary);
+		ERR_FAIL_COND_V(!compression_dictionary, ERR_OUT_OF_MEMORY);
+	}
+
+	// The dictionary is stored first, files come after it.
+	dictionary = p_dictionary;
+	ofs = dictionary.size() + _get_pad(alignment, dictionary.size());
+
+	return OK;
+}
+
+Error PCKPacker::build_compression_dictionary(const Vector<String> &p_sample_paths, int p_max_size) {
+	ERR_FAIL_COND_V(p_sample_paths.is_empty(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_max_size <= 0, ERR_INVALID_PARAMETER);
+
+	// A raw content dictionary made of the start of each sample, which is where
+	// files of the same type tend to share the most (headers, property names...).
+	int sample_size = MAX(p_max_size / p_sample_paths.size(), 1);
+	Vector<uint8_t> dict;
+
+	for (int i = 0; i < p_sample_paths.size() && dict.size() < p_max_size; i++) {
+		FileAccess *f = FileAccess::open(p_sample_paths[i], FileAccess::READ);
+		ERR_CONTINUE_MSG(!f, "Can't open compression dictionary sample: " + p_sample_paths[i] + ".");
+
+		int len = MIN(MIN(uint64_t(sample_size), f->get_len()), uint64_t(p_max_size - dict.size()));
+		int dict_ofs = dict.size();
+		dict.resize(dict_ofs + len);
+		f->get_buffer(dict.ptrw() + dict_ofs, len);
+
+		f->close();
+		memdelete(f);
+	}
+
+	return set_compression_dictionary(dict);
+}
+
+Vector<uint8_t> PCKPacker::_compress_blocks(const Vector<uint8_t> &p_data) const {
+	uint32_t block_count = (p_data.size() + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE;
+
+	Vector<uint8_t> compressed;
+	compressed.resize(8 + block_count * 4);
+	uint8_t *header = compressed.ptrw();
+	encode_uint32(COMPRESSION_BLOCK_SIZE, header);
+	encode_uint32(block_count, header + 4);
+
+	Vector<uint8_t> buffer;
+	buffer.resize(Compression::get_max_compressed_buffer_size(COMPRESSION_BLOCK_SIZE, Compression::MODE_ZSTD));
+
+	for (uint32_t i = 0; i < block_count; i++) {
+		const uint8_t *src = p_data.ptr() + uint64_t(i) * COMPRESSION_BLOCK_SIZE;
+		int len = MIN(COMPRESSION_BLOCK_SIZE, p_data.size() - int(i * COMPRESSION_BLOCK_SIZE));
+
+		int compressed_len;
+		if (!compression_dictionary) {
+			compressed_len = Compression::compress(buffer.ptrw(), src, len, Compression::MODE_ZSTD);
+		} else {
+			compressed_len = Compression::compress_zstd_with_dictionary(buffer.ptrw(), src, len, compression_dictionary);
+		}
+
+		// Blocks that don't shrink are stored as is, which the reader recognizes by their size.
+		if (compressed_len < 0 || compressed_len >= len) {
+			compressed_len = len;
+		} else {
+			src = buffer.ptr();
+		}
+
+		int block_ofs = compressed.size();
+		compressed.resize(block_ofs + compressed_len);
+		encode_uint32(compressed_len, compressed.ptrw() + 8 + i * 4);
+		copymem(compressed.ptrw() + block_ofs, src, compressed_len);
+	}
+
+	return compressed;
+}
+
+Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encrypt, bool p_compress) {
 	FileAccess *f = FileAccess::open(p_src, FileAccess::READ);
 	if (!f) {
 		return ERR_FILE_CANT_OPEN;
@@ -133,7 +230,14 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 	}
 	pf.encrypted = p_encrypt;
 
-	uint64_t _size = pf.size;
+	if (p_compress && data.size()) {
+		pf.compressed = _compress_blocks(data);
+		if (pf.compressed.size() >= data.size()) {
+			pf.compressed.clear(); // Not worth it.
+		}
+	}
+
+	uint64_t _size = pf.compressed.is_empty() ? pf.size : pf.compressed.size();
 	if (p_encrypt) { // Add encryption overhead.
 		if (_size % 16) { // Pad to encryption block size.
 			_size += 16 - (_size % 16);
@@ -160,7 +264,10 @@ Error PCKPacker::flush(bool p_verbose) {
 	int64_t file_base_ofs = file->get_position();
 	file->store_64(0); // files base
 
-	for (int i = 0; i < 16; i++) {
+	file->store_64(0); // compression dictionary, relative to files base
+	file->store_64(dictionary.size());
+
+	for (int i = 0; i < 12; i++) {
 		file->store_32(0); // reserved
 	}
 
@@ -198,6 +305,9 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (!files[i].compressed.is_empty()) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -216,6 +326,14 @@ Error PCKPacker::flush(bool p_verbose) {
 	file->store_64(file_base); // update files base
 	file->seek(file_base);
 
+	if (dictionary.size()) {
+		file->store_buffer(dictionary.ptr(), dictionary.size());
+		int pad = _get_pad(alignment, file->get_position());
+		for (int j = 0; j < pad; j++) {
+			file->store_8(Math::rand() % 256);
+		}
+	}
+
 	const uint32_t buf_max = 65536;
 	uint8_t *buf = memnew_arr(uint8_t, buf_max);
 
@@ -235,6 +353,11 @@ Error PCKPacker::flush(bool p_verbose) {
 			ftmp = fae;
 		}
 
+		if (!files[i].compressed.is_empty()) {
+			ftmp->store_buffer(files[i].compressed.ptr(), files[i].compressed.size());
+			to_write = 0;
+		}
+
 		while (to_write > 0) {
 			int read = src->get_buffer(buf, MIN(to_write, buf_max));
 			ftmp->store_buffer(buf, read);
@@ -278,4 +401,8 @@ PCKPacker::~PCKPacker() {
 		memdelete(file);
 	}
 	file = nullptr;
+
+	if (compression_dictionary) {
+		Compression::free_zstd_dictionary(compression_dictionary);
+	}
 }
@@ -34,6 +34,7 @@
 #include "core/object/reference.h"
 
 class FileAccess;
+struct ZSTD_CDict_s;
 
 class PCKPacker : public Reference {
 	GDCLASS(PCKPacker, Reference);
@@ -45,6 +46,14 @@ class PCKPacker : public Reference {
 	Vector<uint8_t> key;
 	bool enc_dir = false;
 
+	enum {
+		COMPRESSION_BLOCK_SIZE = 65536,
+		COMPRESSION_DICTIONARY_MAX_SIZE = 112640,
+	};
+
+	Vector<uint8_t> dictionary;
+	ZSTD_CDict_s *compression_dictionary = nullptr; // Digested from dictionary.
+
 	static void _bind_methods();
 
 	struct File {
@@ -54,12 +63,17 @@ class PCKPacker : public Reference {
 		uint64_t size = 0;
 		bool encrypted = false;
 		Vector<uint8_t> md5;
+		Vector<uint8_t> compressed; // Empty if stored uncompressed.
 	};
 	Vector<File> files;
 
+	Vector<uint8_t> _compress_blocks(const Vector<uint8_t> &p_data) const;
+
 public:
 	Error pck_start(const String &p_file, int p_alignment = 0, const String &p_key = String(), bool p_encrypt_directory = false);
-	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false);
+	Error set_compression_dictionary(const Vector<uint8_t> &p_dictionary);
+	Error build_compression_dictionary(const Vector<String> &p_sample_paths, int p_max_size = COMPRESSION_DICTIONARY_MAX_SIZE);
+	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false, bool p_compress = false);
 	Error flush(bool p_verbose = false);
 
 	PCKPacker() {}
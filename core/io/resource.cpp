@@ -52,29 +52,22 @@ void Resource::set_path(const String &p_path, bool p_take_over) {
 	}
 
 	if (path_cache != "") {
-		ResourceCache::lock.write_lock();
-		ResourceCache::resources.erase(path_cache);
-		ResourceCache::lock.write_unlock();
+		ResourceCache::_erase(path_cache);
 	}
 
 	path_cache = "";
 
-	ResourceCache::lock.read_lock();
-	bool has_path = ResourceCache::resources.has(p_path);
-	ResourceCache::lock.read_unlock();
-
-	if (has_path) {
+	if (ResourceCache::has(p_path)) {
 		if (p_take_over) {
-			ResourceCache::lock.write_lock();
-			Resource **res = ResourceCache::resources.getptr(p_path);
+			ResourceCache::Shard &shard = ResourceCache::_get_shard(p_path);
+			ResourceCache::_write_lock(shard);
+			Resource **res = shard.resources.getptr(p_path);
 			if (res) {
 				(*res)->set_name("");
 			}
-			ResourceCache::lock.write_unlock();
+			shard.lock.write_unlock();
 		} else {
-			ResourceCache::lock.read_lock();
-			bool exists = ResourceCache::resources.has(p_path);
-			ResourceCache::lock.read_unlock();
+			bool exists = ResourceCache::has(p_path);
 
 			ERR_FAIL_COND_MSG(exists, "Another resource is loaded from path '" + p_path + "' (possible cyclic resource inclusion).");
 		}
@@ -82,9 +75,7 @@ void Resource::set_path(const String &p_path, bool p_take_over) {
 	path_cache = p_path;
 
 	if (path_cache != "") {
-		ResourceCache::lock.write_lock();
-		ResourceCache::resources[path_cache] = this;
-		ResourceCache::lock.write_unlock();
+		ResourceCache::_set(path_cache, this);
 	}
 
 	_resource_path_changed();
@@ -326,7 +317,7 @@ void Resource::set_as_translation_remapped(bool p_remapped) {
 		return;
 	}
 
-	ResourceCache::lock.write_lock();
+	ResourceCache::remapped_list_lock.write_lock();
 
 	if (p_remapped) {
 		ResourceLoader::remapped_list.add(&remapped_list);
@@ -334,7 +325,7 @@ void Resource::set_as_translation_remapped(bool p_remapped) {
 		ResourceLoader::remapped_list.remove(&remapped_list);
 	}
 
-	ResourceCache::lock.write_unlock();
+	ResourceCache::remapped_list_lock.write_unlock();
 }
 
 bool Resource::is_translation_remapped() const {
@@ -344,27 +335,32 @@ bool Resource::is_translation_remapped() const {
 #ifdef TOOLS_ENABLED
 //helps keep IDs same number when loading/saving scenes. -1 clears ID and it Returns -1 when no id stored
 void Resource::set_id_for_path(const String &p_path, int p_id) {
+	ResourceCache::Shard &shard = ResourceCache::_get_shard(p_path);
+	ResourceCache::_write_lock(shard);
 	if (p_id == -1) {
-		ResourceCache::path_cache_lock.write_lock();
-		ResourceCache::resource_path_cache[p_path].erase(get_path());
-		ResourceCache::path_cache_lock.write_unlock();
+		HashMap<String, int> *ids = shard.path_cache.getptr(p_path);
+		if (ids) {
+			ids->erase(get_path());
+		}
 	} else {
-		ResourceCache::path_cache_lock.write_lock();
-		ResourceCache::resource_path_cache[p_path][get_path()] = p_id;
-		ResourceCache::path_cache_lock.write_unlock();
+		shard.path_cache[p_path][get_path()] = p_id;
 	}
+	shard.lock.write_unlock();
 }
 
 int Resource::get_id_for_path(const String &p_path) const {
-	ResourceCache::path_cache_lock.read_lock();
-	if (ResourceCache::resource_path_cache[p_path].has(get_path())) {
-		int result = ResourceCache::resource_path_cache[p_path][get_path()];
-		ResourceCache::path_cache_lock.read_unlock();
-		return result;
-	} else {
-		ResourceCache::path_cache_lock.read_unlock();
-		return -1;
+	ResourceCache::Shard &shard = ResourceCache::_get_shard(p_path);
+	ResourceCache::_read_lock(shard);
+	int result = -1;
+	const HashMap<String, int> *ids = shard.path_cache.getptr(p_path);
+	if (ids) {
+		const int *id = ids->getptr(get_path());
+		if (id) {
+			result = *id;
+		}
 	}
+	shard.lock.read_unlock();
+	return result;
 }
 #endif
 
@@ -396,87 +392,136 @@ Resource::Resource() :
 
 Resource::~Resource() {
 	if (path_cache != "") {
-		ResourceCache::lock.write_lock();
-		ResourceCache::resources.erase(path_cache);
-		ResourceCache::lock.write_unlock();
+		ResourceCache::_erase(path_cache);
 	}
 	if (owners.size()) {
 		WARN_PRINT("Resource is still owned.");
 	}
 }
 
-HashMap<String, Resource *> ResourceCache::resources;
-#ifdef TOOLS_ENABLED
-HashMap<String, HashMap<String, int>> ResourceCache::resource_path_cache;
-#endif
+ResourceCache::Shard ResourceCache::shards[ResourceCache::SHARD_COUNT];
+SafeNumeric<uint64_t> ResourceCache::lock_contentions;
+RWLock ResourceCache::remapped_list_lock;
 
-RWLock ResourceCache::lock;
-#ifdef TOOLS_ENABLED
-RWLock ResourceCache::path_cache_lock;
-#endif
+void ResourceCache::_read_lock(Shard &p_shard) {
+	if (p_shard.lock.read_try_lock() != OK) {
+		lock_contentions.increment();
+		p_shard.lock.read_lock();
+	}
+}
+
+void ResourceCache::_write_lock(Shard &p_shard) {
+	if (p_shard.lock.write_try_lock() != OK) {
+		lock_contentions.increment();
+		p_shard.lock.write_lock();
+	}
+}
+
+void ResourceCache::_set(const String &p_path, Resource *p_resource) {
+	Shard &shard = _get_shard(p_path);
+	_write_lock(shard);
+	shard.resources[p_path] = p_resource;
+	shard.lock.write_unlock();
+}
+
+void ResourceCache::_erase(const String &p_path) {
+	Shard &shard = _get_shard(p_path);
+	_write_lock(shard);
+	shard.resources.erase(p_path);
+	shard.lock.write_unlock();
+}
+
+Ref<Resource> ResourceCache::_get_ref(const String &p_path) {
+	Shard &shard = _get_shard(p_path);
+	_read_lock(shard);
+
+	Ref<Resource> res;
+	Resource **rptr = shard.resources.getptr(p_path);
+	if (rptr) {
+		//it is possible this resource was just freed in a thread. If so, this referencing will not work and resource is considered not cached
+		res = Ref<Resource>(*rptr);
+	}
+
+	shard.lock.read_unlock();
+
+	return res;
+}
 
 void ResourceCache::clear() {
-	if (resources.size()) {
+	if (get_cached_resource_count()) {
 		ERR_PRINT("Resources still in use at exit (run with --verbose for details).");
 		if (OS::get_singleton()->is_stdout_verbose()) {
-			const String *K = nullptr;
-			while ((K = resources.next(K))) {
-				Resource *r = resources[*K];
-				print_line(vformat("Resource still in use: %s (%s)", *K, r->get_class()));
+			for (int i = 0; i < SHARD_COUNT; i++) {
+				const String *K = nullptr;
+				while ((K = shards[i].resources.next(K))) {
+					Resource *r = shards[i].resources[*K];
+					print_line(vformat("Resource still in use: %s (%s)", *K, r->get_class()));
+				}
 			}
 		}
 	}
 
-	resources.clear();
+	for (int i = 0; i < SHARD_COUNT; i++) {
+		shards[i].resources.clear();
+#ifdef TOOLS_ENABLED
+		shards[i].path_cache.clear();
+#endif
+	}
 }
 
 void ResourceCache::reload_externals() {
 }
 
 bool ResourceCache::has(const String &p_path) {
-	lock.read_lock();
-	bool b = resources.has(p_path);
-	lock.read_unlock();
+	Shard &shard = _get_shard(p_path);
+	_read_lock(shard);
+	bool b = shard.resources.has(p_path);
+	shard.lock.read_unlock();
 
 	return b;
 }
 
 Resource *ResourceCache::get(const String &p_path) {
-	lock.read_lock();
-
-	Resource **res = resources.getptr(p_path);
+	Shard &shard = _get_shard(p_path);
+	_read_lock(shard);
 
-	lock.read_unlock();
+	Resource **res = shard.resources.getptr(p_path);
+	Resource *r = res ? *res : nullptr;
 
-	if (!res) {
-		return nullptr;
-	}
+	shard.lock.read_unlock();
 
-	return *res;
+	return r;
 }
 
 void ResourceCache::get_cached_resources(List<Ref<Resource>> *p_resources) {
-	lock.read_lock();
-	const String *K = nullptr;
-	while ((K = resources.next(K))) {
-		Resource *r = resources[*K];
-		p_resources->push_back(Ref<Resource>(r));
+	for (int i = 0; i < SHARD_COUNT; i++) {
+		_read_lock(shards[i]);
+		const String *K = nullptr;
+		while ((K = shards[i].resources.next(K))) {
+			Resource *r = shards[i].resources[*K];
+			p_resources->push_back(Ref<Resource>(r));
+		}
+		shards[i].lock.read_unlock();
 	}
-	lock.read_unlock();
 }
 
 int ResourceCache::get_cached_resource_count() {
-	lock.read_lock();
-	int rc = resources.size();
-	lock.read_unlock();
+	int rc = 0;
+	for (int i = 0; i < SHARD_COUNT; i++) {
+		_read_lock(shards[i]);
+		rc += shards[i].resources.size();
+		shards[i].lock.read_unlock();
+	}
 
 	return rc;
 }
 
+uint64_t ResourceCache::get_lock_contention_count() {
+	return lock_contentions.get();
+}
+
 void ResourceCache::dump(const char *p_file, bool p_short) {
 #ifdef DEBUG_ENABLED
-	lock.read_lock();
-
 	Map<String, int> type_count;
 
 	FileAccess *f = nullptr;
@@ -485,21 +530,27 @@ void ResourceCache::dump(const char *p_file, bool p_short) {
 		ERR_FAIL_COND_MSG(!f, "Cannot create file at path '" + String(p_file) + "'.");
 	}
 
-	const String *K = nullptr;
-	while ((K = resources.next(K))) {
-		Resource *r = resources[*K];
+	for (int i = 0; i < SHARD_COUNT; i++) {
+		_read_lock(shards[i]);
 
-		if (!type_count.has(r->get_class())) {
-			type_count[r->get_class()] = 0;
-		}
+		const String *K = nullptr;
+		while ((K = shards[i].resources.next(K))) {
+			Resource *r = shards[i].resources[*K];
 
-		type_count[r->get_class()]++;
+			if (!type_count.has(r->get_class())) {
+				type_count[r->get_class()] = 0;
+			}
+
+			type_count[r->get_class()]++;
 
-		if (!p_short) {
-			if (f) {
-				f->store_line(r->get_class() + ": " + r->get_path());
+			if (!p_short) {
+				if (f) {
+					f->store_line(r->get_class() + ": " + r->get_path());
+				}
 			}
 		}
+
+		shards[i].lock.read_unlock();
 	}
 
 	for (Map<String, int>::Element *E = type_count.front(); E; E = E->next()) {
@@ -508,10 +559,9 @@ void ResourceCache::dump(const char *p_file, bool p_short) {
 		}
 	}
 	if (f) {
+		f->store_line("Cache lock contentions: " + itos(get_lock_contention_count()));
 		f->close();
 		memdelete(f);
 	}
-
-	lock.read_unlock();
 #endif
 }
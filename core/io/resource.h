@@ -151,12 +151,32 @@ typedef Ref<Resource> RES;
 class ResourceCache {
 	friend class Resource;
 	friend class ResourceLoader; //need the lock
-	static RWLock lock;
-	static HashMap<String, Resource *> resources;
+	friend class ResourceCacheTester;
+
+	// Resources are spread over several independently locked shards by path hash,
+	// so threads loading or freeing unrelated resources don't serialize on one lock.
+	enum {
+		SHARD_COUNT = 16,
+	};
+
+	struct Shard {
+		RWLock lock;
+		HashMap<String, Resource *> resources;
 #ifdef TOOLS_ENABLED
-	static HashMap<String, HashMap<String, int>> resource_path_cache; // each tscn has a set of resource paths and IDs
-	static RWLock path_cache_lock;
-#endif // TOOLS_ENABLED
+		HashMap<String, HashMap<String, int>> path_cache; // each tscn has a set of resource paths and IDs
+#endif
+	};
+
+	static Shard shards[SHARD_COUNT];
+	static SafeNumeric<uint64_t> lock_contentions;
+	static RWLock remapped_list_lock;
+
+	_FORCE_INLINE_ static Shard &_get_shard(const String &p_path) { return shards[p_path.hash() & (SHARD_COUNT - 1)]; }
+	static void _read_lock(Shard &p_shard);
+	static void _write_lock(Shard &p_shard);
+	static void _set(const String &p_path, Resource *p_resource);
+	static void _erase(const String &p_path);
+	static Ref<Resource> _get_ref(const String &p_path);
 	friend void unregister_core_types();
 	static void clear();
 	friend void register_core_types();
@@ -168,6 +188,7 @@ public:
 	static void dump(const char *p_file = nullptr, bool p_short = false);
 	static void get_cached_resources(List<Ref<Resource>> *p_resources);
 	static int get_cached_resource_count();
+	static uint64_t get_lock_contention_count();
 };
 
 #endif // RESOURCE_H
@@ -32,9 +32,11 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/image.h"
 #include "core/io/marshalls.h"
 #include "core/os/dir_access.h"
+#include "core/os/os.h"
 #include "core/version.h"
 
 //#define print_bl(m_what) print_line(m_what)
@@ -91,6 +93,47 @@ enum {
 	FORMAT_VERSION_NO_NODEPATH_PROPERTY = 3,
 };
 
+// Packed arrays are read and written as a whole, in the byte order of the file.
+// The swap loops are kept simple so the compiler can vectorize them.
+
+static _FORCE_INLINE_ bool _packed_array_needs_swap(const FileAccess *p_file) {
+#ifdef BIG_ENDIAN_ENABLED
+	return !p_file->get_endian_swap();
+#else
+	return p_file->get_endian_swap();
+#endif
+}
+
+static void _swap_packed_words(void *p_words, uint32_t p_count, uint32_t p_word_size) {
+	if (p_word_size == 8) {
+		uint64_t *words = (uint64_t *)p_words;
+		for (uint32_t i = 0; i < p_count; i++) {
+			words[i] = BSWAP64(words[i]);
+		}
+	} else {
+		uint32_t *words = (uint32_t *)p_words;
+		for (uint32_t i = 0; i < p_count; i++) {
+			words[i] = BSWAP32(words[i]);
+		}
+	}
+}
+
+static void _store_packed_words(FileAccess *f, const void *p_words, uint32_t p_count, uint32_t p_word_size) {
+	if (p_count == 0) {
+		return;
+	}
+	if (!_packed_array_needs_swap(f)) {
+		f->store_buffer((const uint8_t *)p_words, p_count * p_word_size);
+		return;
+	}
+
+	Vector<uint8_t> swapped;
+	swapped.resize(p_count * p_word_size);
+	copymem(swapped.ptrw(), p_words, p_count * p_word_size);
+	_swap_packed_words(swapped.ptrw(), p_count, p_word_size);
+	f->store_buffer(swapped.ptr(), swapped.size());
+}
+
 void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
 	uint32_t extra = 4 - (p_len % 4);
 	if (extra < 4) {
@@ -119,6 +162,38 @@ StringName ResourceLoaderBinary::_get_string() {
 	return string_map[id];
 }
 
+void ResourceLoaderBinary::_buffer_file() {
+	// Resources are decoded one field at a time, so read from memory instead of going
+	// through the file backend for each of them. Offsets stay the same as in the file.
+	uint64_t len = f->get_len();
+	if (len == 0 || len > (uint64_t)INT32_MAX) {
+		return;
+	}
+
+	uint64_t pos = f->get_position();
+	const uint8_t *data = f->get_mapped_buffer();
+	if (!data) {
+		if (file_buffer.resize(len) != OK) {
+			return;
+		}
+		f->seek(0);
+		if (f->get_buffer(file_buffer.ptrw(), len) != (int)len) {
+			file_buffer.clear();
+			f->seek(pos);
+			return;
+		}
+		data = file_buffer.ptr();
+	}
+
+	FileAccessMemory *fam = memnew(FileAccessMemory);
+	fam->open_custom(data, len);
+	fam->seek(pos);
+	fam->set_endian_swap(f->get_endian_swap());
+
+	source_f = f;
+	f = fam;
+}
+
 Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 	uint32_t type = f->get_32();
 	print_bl("find property of type: " + itos(type));
@@ -435,16 +510,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			array.resize(len);
 			int32_t *w = array.ptrw();
 			f->get_buffer((uint8_t *)w, len * sizeof(int32_t));
-#ifdef BIG_ENDIAN_ENABLED
-			{
-				uint32_t *ptr = (uint32_t *)w.ptr();
-				for (int i = 0; i < len; i++) {
-					ptr[i] = BSWAP32(ptr[i]);
-				}
+			if (_packed_array_needs_swap(f)) {
+				_swap_packed_words(w, len, sizeof(int32_t));
 			}
 
-#endif
-
 			r_v = array;
 		} break;
 		case VARIANT_INT64_ARRAY: {
@@ -454,16 +523,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			array.resize(len);
 			int64_t *w = array.ptrw();
 			f->get_buffer((uint8_t *)w, len * sizeof(int64_t));
-#ifdef BIG_ENDIAN_ENABLED
-			{
-				uint64_t *ptr = (uint64_t *)w.ptr();
-				for (int i = 0; i < len; i++) {
-					ptr[i] = BSWAP64(ptr[i]);
-				}
+			if (_packed_array_needs_swap(f)) {
+				_swap_packed_words(w, len, sizeof(int64_t));
 			}
 
-#endif
-
 			r_v = array;
 		} break;
 		case VARIANT_FLOAT32_ARRAY: {
@@ -473,16 +536,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			array.resize(len);
 			float *w = array.ptrw();
 			f->get_buffer((uint8_t *)w, len * sizeof(float));
-#ifdef BIG_ENDIAN_ENABLED
-			{
-				uint32_t *ptr = (uint32_t *)w.ptr();
-				for (int i = 0; i < len; i++) {
-					ptr[i] = BSWAP32(ptr[i]);
-				}
+			if (_packed_array_needs_swap(f)) {
+				_swap_packed_words(w, len, sizeof(float));
 			}
 
-#endif
-
 			r_v = array;
 		} break;
 		case VARIANT_FLOAT64_ARRAY: {
@@ -492,16 +549,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			array.resize(len);
 			double *w = array.ptrw();
 			f->get_buffer((uint8_t *)w, len * sizeof(double));
-#ifdef BIG_ENDIAN_ENABLED
-			{
-				uint64_t *ptr = (uint64_t *)w.ptr();
-				for (int i = 0; i < len; i++) {
-					ptr[i] = BSWAP64(ptr[i]);
-				}
+			if (_packed_array_needs_swap(f)) {
+				_swap_packed_words(w, len, sizeof(double));
 			}
 
-#endif
-
 			r_v = array;
 		} break;
 		case VARIANT_STRING_ARRAY: {
@@ -524,16 +575,9 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector2 *w = array.ptrw();
 			if (sizeof(Vector2) == 8) {
 				f->get_buffer((uint8_t *)w, len * sizeof(real_t) * 2);
-#ifdef BIG_ENDIAN_ENABLED
-				{
-					uint32_t *ptr = (uint32_t *)w.ptr();
-					for (int i = 0; i < len * 2; i++) {
-						ptr[i] = BSWAP32(ptr[i]);
-					}
+				if (_packed_array_needs_swap(f)) {
+					_swap_packed_words(w, len * 2, sizeof(real_t));
 				}
-
-#endif
-
 			} else {
 				ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Vector2 size is NOT 8!");
 			}
@@ -549,16 +593,9 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector3 *w = array.ptrw();
 			if (sizeof(Vector3) == 12) {
 				f->get_buffer((uint8_t *)w, len * sizeof(real_t) * 3);
-#ifdef BIG_ENDIAN_ENABLED
-				{
-					uint32_t *ptr = (uint32_t *)w.ptr();
-					for (int i = 0; i < len * 3; i++) {
-						ptr[i] = BSWAP32(ptr[i]);
-					}
+				if (_packed_array_needs_swap(f)) {
+					_swap_packed_words(w, len * 3, sizeof(real_t));
 				}
-
-#endif
-
 			} else {
 				ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Vector3 size is NOT 12!");
 			}
@@ -573,17 +610,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			array.resize(len);
 			Color *w = array.ptrw();
 			if (sizeof(Color) == 16) {
-				f->get_buffer((uint8_t *)w, len * sizeof(real_t) * 4);
-#ifdef BIG_ENDIAN_ENABLED
-				{
-					uint32_t *ptr = (uint32_t *)w.ptr();
-					for (int i = 0; i < len * 4; i++) {
-						ptr[i] = BSWAP32(ptr[i]);
-					}
+				f->get_buffer((uint8_t *)w, len * sizeof(float) * 4);
+				if (_packed_array_needs_swap(f)) {
+					_swap_packed_words(w, len * 4, sizeof(float));
 				}
-
-#endif
-
 			} else {
 				ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Color size is NOT 16!");
 			}
@@ -611,6 +641,8 @@ Error ResourceLoaderBinary::load() {
 		return error;
 	}
 
+	_buffer_file();
+
 	int stage = 0;
 
 	for (int i = 0; i < external_resources.size(); i++) {
@@ -626,14 +658,59 @@ Error ResourceLoaderBinary::load() {
 		}
 
 		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
+	}
+
+	// Dependencies that are not cached yet are loaded in parallel on the ResourceLoader
+	// threads, a few ahead of the one being waited for. Deduplication happens there, and
+	// their own dependencies get scheduled the same way. Scripts are kept on this thread.
+	Vector<int> parallel_loads;
+	if (!use_sub_threads && ResourceLoader::is_parallel_dependency_loading_enabled()) {
+		for (int i = 0; i < external_resources.size(); i++) {
+			if (!ResourceCache::has(external_resources[i].path) && !ClassDB::is_parent_class(external_resources[i].type, "Script")) {
+				parallel_loads.push_back(i);
+			}
+		}
+		if (parallel_loads.size() < 2) {
+			parallel_loads.clear();
+		}
+	}
+
+	int max_parallel_loads = MAX(OS::get_singleton()->get_processor_count(), 1);
+	int next_parallel_load = 0;
+	int parallel_loads_in_flight = 0;
+
+	for (int i = 0; i < external_resources.size(); i++) {
+		String path = external_resources[i].path;
 
 		if (!use_sub_threads) {
-			external_resources.write[i].cache = ResourceLoader::load(path, external_resources[i].type);
+			while (next_parallel_load < parallel_loads.size() && parallel_loads_in_flight < max_parallel_loads) {
+				ExtResource &er = external_resources.write[parallel_loads[next_parallel_load++]];
+				if (ResourceLoader::load_threaded_request(er.path, er.type) == OK) {
+					er.requested = true;
+					parallel_loads_in_flight++;
+				}
+			}
+
+			if (external_resources[i].requested) {
+				external_resources.write[i].cache = ResourceLoader::load_threaded_get(path);
+				external_resources.write[i].requested = false;
+				parallel_loads_in_flight--;
+			} else {
+				external_resources.write[i].cache = ResourceLoader::load(path, external_resources[i].type);
+			}
 
 			if (external_resources[i].cache.is_null()) {
 				if (!ResourceLoader::get_abort_on_missing_resources()) {
 					ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
 				} else {
+					// Release the loads still in flight before bailing out.
+					for (int j = i + 1; j < external_resources.size(); j++) {
+						if (external_resources[j].requested) {
+							ResourceLoader::load_threaded_get(external_resources[j].path);
+							external_resources.write[j].requested = false;
+						}
+					}
+
 					error = ERR_FILE_MISSING_DEPENDENCIES;
 					ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
 				}
@@ -968,6 +1045,9 @@ ResourceLoaderBinary::~ResourceLoaderBinary() {
 	if (f) {
 		memdelete(f);
 	}
+	if (source_f) {
+		memdelete(source_f);
+	}
 }
 
 RES ResourceFormatLoaderBinary::load(const String &p_path, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode) {
@@ -1555,10 +1635,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			Vector<int32_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const int32_t *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_32(r[i]);
-			}
+			_store_packed_words(f, arr.ptr(), len, sizeof(int32_t));
 
 		} break;
 		case Variant::PACKED_INT64_ARRAY: {
@@ -1566,10 +1643,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			Vector<int64_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const int64_t *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_64(r[i]);
-			}
+			_store_packed_words(f, arr.ptr(), len, sizeof(int64_t));
 
 		} break;
 		case Variant::PACKED_FLOAT32_ARRAY: {
@@ -1577,10 +1651,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			Vector<float> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const float *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i]);
-			}
+			_store_packed_words(f, arr.ptr(), len, sizeof(float));
 
 		} break;
 		case Variant::PACKED_FLOAT64_ARRAY: {
@@ -1588,10 +1659,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			Vector<double> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const double *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_double(r[i]);
-			}
+			_store_packed_words(f, arr.ptr(), len, sizeof(double));
 
 		} break;
 		case Variant::PACKED_STRING_ARRAY: {
@@ -1610,12 +1678,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			Vector<Vector3> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const Vector3 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
-				f->store_real(r[i].z);
-			}
+			_store_packed_words(f, arr.ptr(), len * 3, sizeof(real_t));
 
 		} break;
 		case Variant::PACKED_VECTOR2_ARRAY: {
@@ -1623,11 +1686,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			Vector<Vector2> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const Vector2 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
-			}
+			_store_packed_words(f, arr.ptr(), len * 2, sizeof(real_t));
 
 		} break;
 		case Variant::PACKED_COLOR_ARRAY: {
@@ -1635,13 +1694,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			Vector<Color> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const Color *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].r);
-				f->store_real(r[i].g);
-				f->store_real(r[i].b);
-				f->store_real(r[i].a);
-			}
+			_store_packed_words(f, arr.ptr(), len * 4, sizeof(float));
 
 		} break;
 		default: {
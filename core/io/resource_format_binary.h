@@ -44,6 +44,8 @@ class ResourceLoaderBinary {
 	uint32_t ver_format = 0;
 
 	FileAccess *f = nullptr;
+	FileAccess *source_f = nullptr; // The real file, when f reads from a copy in memory.
+	Vector<uint8_t> file_buffer;
 
 	uint64_t importmd_ofs = 0;
 
@@ -53,11 +55,13 @@ class ResourceLoaderBinary {
 	Vector<StringName> string_map;
 
 	StringName _get_string();
+	void _buffer_file();
 
 	struct ExtResource {
 		String path;
 		String type;
 		RES cache;
+		bool requested = false; // Being loaded in parallel by a ResourceLoader thread.
 	};
 
 	bool use_sub_threads = false;
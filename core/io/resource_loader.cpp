@@ -214,11 +214,13 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 	ThreadLoadTask &load_task = *(ThreadLoadTask *)p_userdata;
 	load_task.loader_id = Thread::get_caller_id();
 
-	if (load_task.semaphore) {
+	if (load_task.thread) {
 		//this is an actual thread, so wait for Ok from semaphore
 		thread_load_semaphore->wait(); //wait until its ok to start loading
 	}
+	uint64_t load_begin = OS::get_singleton()->get_ticks_usec();
 	load_task.resource = _load(load_task.remapped_path, load_task.remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, load_task.cache_mode, &load_task.error, load_task.use_sub_threads, &load_task.progress);
+	print_verbose(vformat("Loaded resource: %s (%.2f ms, including dependencies).", load_task.local_path, (OS::get_singleton()->get_ticks_usec() - load_begin) / 1000.0));
 
 	load_task.progress = 1.0; //it was fully loaded at this point, so force progress to 1.0
 
@@ -229,15 +231,17 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 		load_task.status = THREAD_LOAD_LOADED;
 	}
 	if (load_task.semaphore) {
-		if (load_task.start_next && thread_waiting_count > 0) {
-			thread_waiting_count--;
-			//thread loading count remains constant, this ends but another one begins
-			thread_load_semaphore->post();
-		} else {
-			thread_loading_count--; //no threads waiting, just reduce loading count
-		}
+		if (load_task.thread) {
+			if (load_task.start_next && thread_waiting_count > 0) {
+				thread_waiting_count--;
+				//thread loading count remains constant, this ends but another one begins
+				thread_load_semaphore->post();
+			} else {
+				thread_loading_count--; //no threads waiting, just reduce loading count
+			}
 
-		print_lt("END: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
+			print_lt("END: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
+		}
 
 		for (int i = 0; i < load_task.poll_requests; i++) {
 			load_task.semaphore->post();
@@ -268,9 +272,26 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 		}
 	}
 
+	if (load_task.requests == 0) {
+		// Abandoned by load_threaded_get() to break a dependency cycle, nobody will collect it.
+		// The thread can't wait for itself, so it's freed later.
+		if (load_task.thread) {
+			thread_load_abandoned_threads.push_back(load_task.thread);
+		}
+		thread_load_tasks.erase(load_task.local_path);
+	}
+
 	thread_load_mutex->unlock();
 }
 
+void ResourceLoader::_free_abandoned_threads() {
+	for (uint32_t i = 0; i < thread_load_abandoned_threads.size(); i++) {
+		thread_load_abandoned_threads[i]->wait_to_finish();
+		memdelete(thread_load_abandoned_threads[i]);
+	}
+	thread_load_abandoned_threads.clear();
+}
+
 Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads, ResourceFormatLoader::CacheMode p_cache_mode, const String &p_source_resource) {
 	String local_path;
 	if (p_path.is_rel_path()) {
@@ -281,6 +302,8 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 
 	thread_load_mutex->lock();
 
+	_free_abandoned_threads();
+
 	if (p_source_resource != String()) {
 		//must be loading from this resource
 		if (!thread_load_tasks.has(p_source_resource)) {
@@ -322,28 +345,14 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 		load_task.use_sub_threads = p_use_sub_threads;
 
 		{ //must check if resource is already loaded before attempting to load it in a thread
-
-			if (load_task.loader_id == Thread::get_caller_id()) {
-				thread_load_mutex->unlock();
-				ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Attempted to load a resource already being loaded from this thread, cyclic reference?");
-			}
-			//lock first if possible
-			ResourceCache::lock.read_lock();
-
-			//get ptr
-			Resource **rptr = ResourceCache::resources.getptr(local_path);
-
-			if (rptr) {
-				RES res(*rptr);
-				//it is possible this resource was just freed in a thread. If so, this referencing will not work and resource is considered not cached
-				if (res.is_valid()) {
-					//referencing is fine
-					load_task.resource = res;
-					load_task.status = THREAD_LOAD_LOADED;
-					load_task.progress = 1.0;
-				}
+			// Cyclic references are caught by load_threaded_get(), see _thread_load_would_deadlock().
+			RES res = ResourceCache::_get_ref(local_path);
+			if (res.is_valid()) {
+				//referencing is fine
+				load_task.resource = res;
+				load_task.status = THREAD_LOAD_LOADED;
+				load_task.progress = 1.0;
 			}
-			ResourceCache::lock.read_unlock();
 		}
 
 		if (p_source_resource != String()) {
@@ -377,6 +386,26 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 	return OK;
 }
 
+bool ResourceLoader::_thread_load_would_deadlock(const ThreadLoadTask &p_task) {
+	// Follow the chain of threads waiting on each other, starting from the one loading
+	// this task. If it leads back to the caller, this is a cyclic dependency.
+	Thread::ID caller_id = Thread::get_caller_id();
+	Thread::ID loader_id = p_task.loader_id;
+	int steps = 0;
+	while (loader_id != caller_id) {
+		String *waiting_on = thread_load_waiting_on.getptr(loader_id);
+		if (!waiting_on || steps++ > thread_load_waiting_on.size()) {
+			return false;
+		}
+		ThreadLoadTask *task = thread_load_tasks.getptr(*waiting_on);
+		if (!task) {
+			return false;
+		}
+		loader_id = task->loader_id;
+	}
+	return true;
+}
+
 float ResourceLoader::_dependency_get_progress(const String &p_path) {
 	if (thread_load_tasks.has(p_path)) {
 		ThreadLoadTask &load_task = thread_load_tasks[p_path];
@@ -444,11 +473,12 @@ RES ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
 	ThreadLoadTask &load_task = thread_load_tasks[local_path];
 
 	//semaphore still exists, meaning it's still loading, request poll
+	//(unless waiting would never end because this thread is the one it depends on)
 	Semaphore *semaphore = load_task.semaphore;
-	if (semaphore) {
+	if (semaphore && !_thread_load_would_deadlock(load_task)) {
 		load_task.poll_requests++;
 
-		{
+		if (load_task.thread) {
 			// As we got a semaphore, this means we are going to have to wait
 			// until the sub-resource is done loading
 			//
@@ -465,16 +495,19 @@ RES ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
 
 				load_task.start_next = false; //do not start next since we are doing it here
 			}
+		}
 
-			thread_suspended_count++;
+		thread_suspended_count++;
 
-			print_lt("GET: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
-		}
+		print_lt("GET: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
+
+		thread_load_waiting_on[Thread::get_caller_id()] = local_path;
 
 		thread_load_mutex->unlock();
 		semaphore->wait();
 		thread_load_mutex->lock();
 
+		thread_load_waiting_on.erase(Thread::get_caller_id());
 		thread_suspended_count--;
 
 		if (!thread_load_tasks.has(local_path)) { //may have been erased during unlock and this was always an invalid call
@@ -493,7 +526,10 @@ RES ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
 
 	load_task.requests--;
 
-	if (load_task.requests == 0) {
+	// A task still loading (left early to break a dependency cycle) is kept, so its thread
+	// isn't waited for here. Requesting it again later picks up the result, otherwise it
+	// removes itself when done.
+	if (load_task.requests == 0 && !load_task.semaphore) {
 		if (load_task.thread) { //thread may not have been used
 			load_task.thread->wait_to_finish();
 			memdelete(load_task.thread);
@@ -537,27 +573,16 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, Resour
 		}
 
 		//Is it cached?
-		ResourceCache::lock.read_lock();
-
-		Resource **rptr = ResourceCache::resources.getptr(local_path);
-
-		if (rptr) {
-			RES res(*rptr);
-
-			//it is possible this resource was just freed in a thread. If so, this referencing will not work and resource is considered not cached
-			if (res.is_valid()) {
-				ResourceCache::lock.read_unlock();
-				thread_load_mutex->unlock();
-
-				if (r_error) {
-					*r_error = OK;
-				}
+		RES res = ResourceCache::_get_ref(local_path);
+		if (res.is_valid()) {
+			thread_load_mutex->unlock();
 
-				return res; //use cached
+			if (r_error) {
+				*r_error = OK;
 			}
-		}
 
-		ResourceCache::lock.read_unlock();
+			return res; //use cached
+		}
 
 		//load using task (but this thread)
 		ThreadLoadTask load_task;
@@ -568,6 +593,10 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, Resour
 		load_task.type_hint = p_type_hint;
 		load_task.cache_mode = p_cache_mode; //ignore
 		load_task.loader_id = Thread::get_caller_id();
+		if (parallel_dependency_loading) {
+			// Loaded on this thread, but other threads loading dependencies in parallel may need to wait for it.
+			load_task.semaphore = memnew(Semaphore);
+		}
 
 		thread_load_tasks[local_path] = load_task;
 
@@ -952,7 +981,7 @@ String ResourceLoader::path_remap(const String &p_path) {
 }
 
 void ResourceLoader::reload_translation_remaps() {
-	ResourceCache::lock.read_lock();
+	ResourceCache::remapped_list_lock.read_lock();
 
 	List<Resource *> to_reload;
 	SelfList<Resource> *E = remapped_list.first();
@@ -962,7 +991,7 @@ void ResourceLoader::reload_translation_remaps() {
 		E = E->next();
 	}
 
-	ResourceCache::lock.read_unlock();
+	ResourceCache::remapped_list_lock.read_unlock();
 
 	//now just make sure to not delete any of these resources while changing locale..
 	while (to_reload.front()) {
@@ -1106,6 +1135,22 @@ void ResourceLoader::initialize() {
 }
 
 void ResourceLoader::finalize() {
+	// Abandoned loads may still be running, they must be done before the mutex goes away.
+	LocalVector<Thread *> running_threads;
+	thread_load_mutex->lock();
+	for (const String *E = thread_load_tasks.next(nullptr); E; E = thread_load_tasks.next(E)) {
+		const ThreadLoadTask &load_task = thread_load_tasks[*E];
+		if (load_task.thread && load_task.semaphore && load_task.requests == 0) {
+			running_threads.push_back(load_task.thread);
+		}
+	}
+	thread_load_mutex->unlock();
+
+	for (uint32_t i = 0; i < running_threads.size(); i++) {
+		running_threads[i]->wait_to_finish();
+	}
+	_free_abandoned_threads();
+
 	memdelete(thread_load_mutex);
 	memdelete(thread_load_semaphore);
 }
@@ -1117,10 +1162,13 @@ DependencyErrorNotify ResourceLoader::dep_err_notify = nullptr;
 void *ResourceLoader::dep_err_notify_ud = nullptr;
 
 bool ResourceLoader::abort_on_missing_resource = true;
+bool ResourceLoader::parallel_dependency_loading = false;
 bool ResourceLoader::timestamp_on_load = false;
 
 Mutex *ResourceLoader::thread_load_mutex = nullptr;
 HashMap<String, ResourceLoader::ThreadLoadTask> ResourceLoader::thread_load_tasks;
+HashMap<Thread::ID, String> ResourceLoader::thread_load_waiting_on;
+LocalVector<Thread *> ResourceLoader::thread_load_abandoned_threads;
 Semaphore *ResourceLoader::thread_load_semaphore = nullptr;
 
 int ResourceLoader::thread_loading_count = 0;
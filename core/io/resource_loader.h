@@ -34,6 +34,7 @@
 #include "core/io/resource.h"
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
+#include "core/templates/local_vector.h"
 
 class ResourceFormatLoader : public Reference {
 	GDCLASS(ResourceFormatLoader, Reference);
@@ -97,6 +98,7 @@ private:
 	static void *dep_err_notify_ud;
 	static DependencyErrorNotify dep_err_notify;
 	static bool abort_on_missing_resource;
+	static bool parallel_dependency_loading;
 	static HashMap<String, Vector<String>> translation_remaps;
 	static HashMap<String, String> path_remaps;
 
@@ -107,6 +109,7 @@ private:
 
 	friend class ResourceFormatImporter;
 	friend class ResourceInteractiveLoader;
+	friend class ResourceLoaderTester;
 	//internal load function
 	static RES _load(const String &p_path, const String &p_original_path, const String &p_type_hint, ResourceFormatLoader::CacheMode p_cache_mode, Error *r_error, bool p_use_sub_threads, float *r_progress);
 
@@ -135,8 +138,12 @@ private:
 	};
 
 	static void _thread_load_function(void *p_userdata);
+	static bool _thread_load_would_deadlock(const ThreadLoadTask &p_task);
 	static Mutex *thread_load_mutex;
 	static HashMap<String, ThreadLoadTask> thread_load_tasks;
+	static HashMap<Thread::ID, String> thread_load_waiting_on; // Task each blocked thread waits for.
+	static LocalVector<Thread *> thread_load_abandoned_threads; // Finished, but not waited for yet.
+	static void _free_abandoned_threads();
 	static Semaphore *thread_load_semaphore;
 	static int thread_waiting_count;
 	static int thread_loading_count;
@@ -190,6 +197,9 @@ public:
 	static void set_abort_on_missing_resources(bool p_abort) { abort_on_missing_resource = p_abort; }
 	static bool get_abort_on_missing_resources() { return abort_on_missing_resource; }
 
+	static void set_parallel_dependency_loading(bool p_enable) { parallel_dependency_loading = p_enable; }
+	static bool is_parallel_dependency_loading_enabled() { return parallel_dependency_loading; }
+
 	static String path_remap(const String &p_path);
 	static String import_remap(const String &p_path);
 
@@ -157,58 +157,31 @@ String FileAccess::fix_path(const String &p_path) const {
 
 /* these are all implemented for ease of porting, then can later be optimized */
 
-uint16_t FileAccess::get_16() const {
-	uint16_t res;
-	uint8_t a, b;
-
-	a = get_8();
-	b = get_8();
+// These read the whole value with a single get_buffer() call, rather than
+// one virtual get_8() call per byte.
 
-	if (endian_swap) {
-		SWAP(a, b);
-	}
-
-	res = b;
-	res <<= 8;
-	res |= a;
+uint16_t FileAccess::get_16() const {
+	uint8_t buf[2] = {};
+	get_buffer(buf, 2);
 
-	return res;
+	uint16_t res = decode_uint16(buf);
+	return endian_swap ? BSWAP16(res) : res;
 }
 
 uint32_t FileAccess::get_32() const {
-	uint32_t res;
-	uint16_t a, b;
-
-	a = get_16();
-	b = get_16();
-
-	if (endian_swap) {
-		SWAP(a, b);
-	}
+	uint8_t buf[4] = {};
+	get_buffer(buf, 4);
 
-	res = b;
-	res <<= 16;
-	res |= a;
-
-	return res;
+	uint32_t res = decode_uint32(buf);
+	return endian_swap ? BSWAP32(res) : res;
 }
 
 uint64_t FileAccess::get_64() const {
-	uint64_t res;
-	uint32_t a, b;
-
-	a = get_32();
-	b = get_32();
-
-	if (endian_swap) {
-		SWAP(a, b);
-	}
-
-	res = b;
-	res <<= 32;
-	res |= a;
+	uint8_t buf[8] = {};
+	get_buffer(buf, 8);
 
-	return res;
+	uint64_t res = decode_uint64(buf);
+	return endian_swap ? BSWAP64(res) : res;
 }
 
 float FileAccess::get_float() const {
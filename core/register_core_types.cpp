@@ -70,6 +70,7 @@
 #include "core/os/main_loop.h"
 #include "core/string/optimized_translation.h"
 #include "core/string/translation.h"
+#include "core/templates/thread_work_pool.h"
 
 static Ref<ResourceFormatSaverBinary> resource_saver_binary;
 static Ref<ResourceFormatLoaderBinary> resource_loader_binary;
@@ -314,6 +315,7 @@ void unregister_core_types() {
 	}
 
 	ResourceLoader::finalize();
+	ThreadWorkPool::finish_shared();
 
 	ClassDB::cleanup_defaults();
 	ObjectDB::cleanup();
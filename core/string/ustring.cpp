@@ -1839,10 +1839,10 @@ bool String::parse_utf8(const char *p_utf8, int p_len) {
 #undef _UNICERROR
 }
 
-CharString String::utf8() const {
+int String::utf8_length() const {
 	int l = length();
 	if (!l) {
-		return CharString();
+		return 0;
 	}
 
 	const char32_t *d = &operator[](0);
@@ -1859,23 +1859,26 @@ CharString String::utf8() const {
 			fl += 4;
 		} else {
 			print_error("Unicode parsing error: Invalid unicode codepoint " + num_int64(c, 16) + ".");
-			return CharString();
+			return 0;
 		}
 		if (c >= 0xd800 && c <= 0xdfff) {
 			print_error("Unicode parsing error: Invalid unicode codepoint " + num_int64(c, 16) + ".");
-			return CharString();
+			return 0;
 		}
 	}
 
-	CharString utf8s;
-	if (fl == 0) {
-		return utf8s;
+	return fl;
+}
+
+void String::utf8_write(uint8_t *p_buffer) const {
+	int l = length();
+	if (!l) {
+		return;
 	}
 
-	utf8s.resize(fl + 1);
-	uint8_t *cdst = (uint8_t *)utf8s.get_data();
+	const char32_t *d = &operator[](0);
 
-#define APPEND_CHAR(m_c) *(cdst++) = m_c
+#define APPEND_CHAR(m_c) *(p_buffer++) = m_c
 
 	for (int i = 0; i < l; i++) {
 		uint32_t c = d[i];
@@ -1897,7 +1900,20 @@ CharString String::utf8() const {
 		}
 	}
 #undef APPEND_CHAR
-	*cdst = 0; //trailing zero
+}
+
+CharString String::utf8() const {
+	int fl = utf8_length();
+
+	CharString utf8s;
+	if (fl == 0) {
+		return utf8s;
+	}
+
+	utf8s.resize(fl + 1);
+	uint8_t *cdst = (uint8_t *)utf8s.get_data();
+	utf8_write(cdst);
+	cdst[fl] = 0; //trailing zero
 
 	return utf8s;
 }
@@ -372,6 +372,10 @@ public:
 
 	CharString ascii(bool p_allow_extended = false) const;
 	CharString utf8() const;
+	// Size of utf8() without the trailing zero, 0 when the string can't be encoded.
+	int utf8_length() const;
+	// Writes utf8_length() bytes of UTF-8, without a trailing zero. Only call it when utf8_length() is not 0.
+	void utf8_write(uint8_t *p_buffer) const;
 	bool parse_utf8(const char *p_utf8, int p_len = -1); //return true on error
 	static String utf8(const char *p_utf8, int p_len = -1);
 
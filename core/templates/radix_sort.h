@@ -0,0 +1,147 @@
+/*************************************************************************/
+/*  radix_sort.h                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include "core/templates/local_vector.h"
+#include "core/templates/thread_work_pool.h"
+#include "core/typedefs.h"
+
+// Stable LSD radix sort over keys of KeyWords 64 bit words, one byte per pass.
+// KeyGetter::get_key(element, word) returns the word of the key, word 0 being
+// the least significant. Bytes that are equal for all elements are skipped.
+// Passing a ThreadWorkPool splits the histogram and scatter of each pass
+// between its threads.
+template <class T, class KeyGetter, uint32_t KeyWords = 1>
+class RadixSortArray {
+	enum {
+		DIGITS = KeyWords * 8,
+		BUCKETS = 256,
+	};
+
+	LocalVector<T> buffer;
+	LocalVector<uint32_t> histograms; // threads * BUCKETS
+	T *src = nullptr;
+	T *dst = nullptr;
+	uint32_t count = 0;
+	uint32_t threads = 1;
+
+	static _FORCE_INLINE_ uint32_t _get_digit(const T &p_element, uint32_t p_digit) {
+		return (KeyGetter::get_key(p_element, p_digit / 8) >> ((p_digit & 7) * 8)) & 0xFF;
+	}
+
+	void _histogram(uint32_t p_thread, uint32_t *p_digit) {
+		uint32_t from = p_thread * count / threads;
+		uint32_t to = (p_thread + 1 == threads) ? count : ((p_thread + 1) * count / threads);
+
+		uint32_t *histogram = &histograms[p_thread * BUCKETS];
+		memset(histogram, 0, sizeof(uint32_t) * BUCKETS);
+		for (uint32_t i = from; i < to; i++) {
+			histogram[_get_digit(src[i], *p_digit)]++;
+		}
+	}
+
+	void _scatter(uint32_t p_thread, uint32_t *p_digit) {
+		uint32_t from = p_thread * count / threads;
+		uint32_t to = (p_thread + 1 == threads) ? count : ((p_thread + 1) * count / threads);
+
+		uint32_t *offsets = &histograms[p_thread * BUCKETS];
+		for (uint32_t i = from; i < to; i++) {
+			dst[offsets[_get_digit(src[i], *p_digit)]++] = src[i];
+		}
+	}
+
+public:
+	void sort(T *p_array, uint32_t p_size, ThreadWorkPool *p_work_pool = nullptr) {
+		if (p_size < 2) {
+			return;
+		}
+
+		count = p_size;
+		threads = p_work_pool ? MAX(p_work_pool->get_thread_count(), 1) : 1;
+		histograms.resize(threads * BUCKETS);
+		buffer.resize(p_size);
+
+		src = p_array;
+		dst = buffer.ptr();
+
+		//find the bits that actually differ, bytes that are equal for all elements need no pass
+		uint64_t diff[KeyWords];
+		for (uint32_t w = 0; w < KeyWords; w++) {
+			uint64_t and_key = ~uint64_t(0);
+			uint64_t or_key = 0;
+			for (uint32_t i = 0; i < p_size; i++) {
+				uint64_t key = KeyGetter::get_key(src[i], w);
+				and_key &= key;
+				or_key |= key;
+			}
+			diff[w] = and_key ^ or_key;
+		}
+
+		for (uint32_t digit = 0; digit < DIGITS; digit++) {
+			if (((diff[digit / 8] >> ((digit & 7) * 8)) & 0xFF) == 0) {
+				continue;
+			}
+
+			if (threads > 1) {
+				p_work_pool->do_work(threads, this, &RadixSortArray::_histogram, &digit);
+			} else {
+				_histogram(0, &digit);
+			}
+
+			//turn counts into write offsets, bucket major and thread minor so the sort stays stable
+			uint32_t offset = 0;
+			for (uint32_t b = 0; b < BUCKETS; b++) {
+				for (uint32_t t = 0; t < threads; t++) {
+					uint32_t &h = histograms[t * BUCKETS + b];
+					uint32_t bucket_count = h;
+					h = offset;
+					offset += bucket_count;
+				}
+			}
+
+			if (threads > 1) {
+				p_work_pool->do_work(threads, this, &RadixSortArray::_scatter, &digit);
+			} else {
+				_scatter(0, &digit);
+			}
+
+			SWAP(src, dst);
+		}
+
+		if (src != p_array) {
+			for (uint32_t i = 0; i < p_size; i++) {
+				p_array[i] = src[i];
+			}
+		}
+	}
+};
+
+#endif // RADIX_SORT_H
@@ -30,8 +30,12 @@
 
 #include "thread_work_pool.h"
 
+#include "core/os/mutex.h"
 #include "core/os/os.h"
 
+static ThreadWorkPool *shared_pool = nullptr;
+static BinaryMutex shared_pool_mutex;
+
 void ThreadWorkPool::_thread_function(void *p_user) {
 	ThreadData *thread = static_cast<ThreadData *>(p_user);
 	while (true) {
@@ -76,6 +80,32 @@ void ThreadWorkPool::finish() {
 	threads = nullptr;
 }
 
+ThreadWorkPool *ThreadWorkPool::try_lock_shared() {
+	if (shared_pool_mutex.try_lock() != OK) {
+		return nullptr;
+	}
+
+	if (!shared_pool) {
+		shared_pool = memnew(ThreadWorkPool);
+		shared_pool->init();
+	}
+	return shared_pool;
+}
+
+void ThreadWorkPool::unlock_shared() {
+	shared_pool_mutex.unlock();
+}
+
+void ThreadWorkPool::finish_shared() {
+	MutexLock lock(shared_pool_mutex);
+
+	if (shared_pool) {
+		shared_pool->finish();
+		memdelete(shared_pool);
+		shared_pool = nullptr;
+	}
+}
+
 ThreadWorkPool::~ThreadWorkPool() {
 	finish();
 }
@@ -135,6 +135,14 @@ public:
 	_FORCE_INLINE_ int get_thread_count() const { return thread_count; }
 	void init(int p_thread_count = -1);
 	void finish();
+
+	// Pool shared by short jobs in core and modules (image processing, texture compression,
+	// pack decompression), started on first use. Returns nullptr while another job holds it,
+	// the caller then does the work on its own thread. Release it with unlock_shared().
+	static ThreadWorkPool *try_lock_shared();
+	static void unlock_shared();
+	static void finish_shared();
+
 	~ThreadWorkPool();
 };
 
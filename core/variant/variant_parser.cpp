@@ -35,36 +35,75 @@
 #include "core/os/keyboard.h"
 #include "core/string/string_buffer.h"
 
-char32_t VariantParser::StreamFile::get_char() {
-	return f->get_8();
+char32_t VariantParser::Stream::get_char() {
+	if (readahead_pointer < readahead_filled) {
+		return readahead_chars[readahead_pointer++];
+	}
+
+	readahead_filled = _read_chars(readahead_chars, readahead_enabled ? READAHEAD_SIZE : 1);
+	if (!readahead_filled) {
+		// Keep returning 0 once the end is reached, like reading past the end of a file does.
+		readahead_pointer = 0;
+		eof = true;
+		return 0;
+	}
+
+	readahead_pointer = 1;
+	return readahead_chars[0];
+}
+
+bool VariantParser::Stream::is_eof() const {
+	if (readahead_enabled) {
+		return eof;
+	}
+	return _is_eof();
+}
+
+uint32_t VariantParser::StreamFile::_read_chars(const char32_t *&r_chars, uint32_t p_max_chars) {
+	if (readahead_buffer.size() < p_max_chars) {
+		readahead_buffer.resize(p_max_chars);
+	}
+	char32_t *buffer = readahead_buffer.ptr();
+
+	// Read the bytes into the start of the buffer, then widen them from the last one,
+	// so no byte is overwritten before it is widened.
+	int num_read = f->get_buffer((uint8_t *)buffer, p_max_chars);
+	for (int i = num_read - 1; i >= 0; i--) {
+		buffer[i] = ((const uint8_t *)buffer)[i];
+	}
+
+	r_chars = buffer;
+	return MAX(num_read, 0);
 }
 
 bool VariantParser::StreamFile::is_utf8() const {
 	return true;
 }
 
-bool VariantParser::StreamFile::is_eof() const {
+bool VariantParser::StreamFile::_is_eof() const {
 	return f->eof_reached();
 }
 
-char32_t VariantParser::StreamString::get_char() {
-	if (pos > s.length()) {
+uint32_t VariantParser::StreamString::_read_chars(const char32_t *&r_chars, uint32_t p_max_chars) {
+	int available = s.length() - pos;
+	if (available <= 0) {
+		// Like files, EOF is only reported after trying to read past the end.
+		pos = s.length() + 1;
 		return 0;
-	} else if (pos == s.length()) {
-		// You need to try to read again when you have reached the end for EOF to be reported,
-		// so this works the same as files (like StreamFile does)
-		pos++;
-		return 0;
-	} else {
-		return s[pos++];
 	}
+
+	int num_read = MIN(available, int(p_max_chars));
+	readahead_source = s;
+	r_chars = readahead_source.ptr() + pos;
+	pos += num_read;
+	return num_read;
 }
 
 bool VariantParser::StreamString::is_utf8() const {
 	return false;
 }
 
-bool VariantParser::StreamString::is_eof() const {
+bool VariantParser::StreamString::_is_eof() const {
 	return pos > s.length();
 }
 
@@ -202,7 +241,8 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 				[[fallthrough]];
 			}
 			case '"': {
-				String str;
+				StringBuffer<> str_buf;
+				bool ascii = true;
 				while (true) {
 					char32_t ch = p_stream->get_char();
 
@@ -276,17 +316,24 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 							} break;
 						}
 
-						str += res;
+						if (res >= 0x80) {
+							ascii = false;
+						}
+						str_buf += res;
 
 					} else {
 						if (ch == '\n') {
 							line++;
+						} else if (ch >= 0x80) {
+							ascii = false;
 						}
-						str += ch;
+						str_buf += ch;
 					}
 				}
 
-				if (p_stream->is_utf8()) {
+				String str = str_buf.as_string();
+				if (p_stream->is_utf8() && !ascii) {
+					// ASCII is already valid UTF-8, only re-decode strings that need it.
 					str.parse_utf8(str.ascii(true).get_data());
 				}
 				if (string_name) {
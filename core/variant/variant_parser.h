@@ -33,38 +33,74 @@
 
 #include "core/io/resource.h"
 #include "core/os/file_access.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/variant.h"
 
 class VariantParser {
 public:
 	struct Stream {
-		virtual char32_t get_char() = 0;
-		virtual bool is_utf8() const = 0;
-		virtual bool is_eof() const = 0;
+	protected:
+		enum {
+			READAHEAD_SIZE = 2048
+		};
+
+	private:
+		const char32_t *readahead_chars = nullptr;
+		uint32_t readahead_pointer = 0;
+		uint32_t readahead_filled = 0;
+		bool eof = false;
+
+	protected:
+		// Points r_chars to up to p_max_chars next characters and returns how many there are, 0 at the end.
+		// They must stay valid until the next call.
+		virtual uint32_t _read_chars(const char32_t *&r_chars, uint32_t p_max_chars) = 0;
+		virtual bool _is_eof() const = 0;
+
+	public:
+		// Characters are read ahead in blocks. Disable it when the source is also read directly.
+		bool readahead_enabled = true;
 
 		char32_t saved = 0;
 
+		char32_t get_char();
+		virtual bool is_utf8() const = 0;
+		bool is_eof() const;
+
 		Stream() {}
 		virtual ~Stream() {}
 	};
 
 	struct StreamFile : public Stream {
+	private:
+		// Allocated on the first read, streams are often declared on the stack.
+		LocalVector<char32_t> readahead_buffer;
+
+	protected:
+		virtual uint32_t _read_chars(const char32_t *&r_chars, uint32_t p_max_chars);
+		virtual bool _is_eof() const;
+
+	public:
 		FileAccess *f = nullptr;
 
-		virtual char32_t get_char();
 		virtual bool is_utf8() const;
-		virtual bool is_eof() const;
 
 		StreamFile() {}
 	};
 
+	// Reads straight from the characters of s, without copying them.
 	struct StreamString : public Stream {
+	private:
+		String readahead_source; // Keeps the characters that were read alive if s is assigned again.
+
+	protected:
+		virtual uint32_t _read_chars(const char32_t *&r_chars, uint32_t p_max_chars);
+		virtual bool _is_eof() const;
+
+	public:
 		String s;
 		int pos = 0;
 
-		virtual char32_t get_char();
 		virtual bool is_utf8() const;
-		virtual bool is_eof() const;
 
 		StreamString() {}
 	};
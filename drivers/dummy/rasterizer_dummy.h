@@ -195,12 +195,10 @@ public:
 
 	TypedArray<Image> bake_render_uv2(RID p_base, const Vector<RID> &p_material_overrides, const Size2i &p_image_size) override { return TypedArray<Image>(); }
 
-	bool free(RID p_rid) override { return true; }
+	bool free(RID p_rid) override { return false; }
 	void update() override {}
 	void sdfgi_set_debug_probe_select(const Vector3 &p_position, const Vector3 &p_dir) override {}
 
-	bool is_low_end() const override { return true; }
-
 	RasterizerSceneDummy() {}
 	~RasterizerSceneDummy() {}
 };
@@ -247,7 +245,15 @@ public:
 	Ref<Image> texture_2d_layer_get(RID p_texture, int p_layer) const override { return Ref<Image>(); }
 	Vector<Ref<Image>> texture_3d_get(RID p_texture) const override { return Vector<Ref<Image>>(); }
 
-	void texture_replace(RID p_texture, RID p_by_texture) override {}
+	void texture_replace(RID p_texture, RID p_by_texture) override {
+		DummyTexture *t = texture_owner.getornull(p_texture);
+		ERR_FAIL_COND(!t);
+		DummyTexture *by_t = texture_owner.getornull(p_by_texture);
+		ERR_FAIL_COND(!by_t);
+		t->image = by_t->image;
+		texture_owner.free(p_by_texture);
+		memdelete(by_t);
+	}
 	void texture_set_size_override(RID p_texture, int p_width, int p_height) override {}
 
 	void texture_set_path(RID p_texture, const String &p_path) override {}
@@ -307,7 +313,17 @@ public:
 
 	/* MESH API */
 
-	RID mesh_allocate() override { return RID(); }
+	// Surfaces are kept so mesh data can still be read back, e.g. to generate collision shapes on a headless server.
+	struct DummyMesh {
+		Vector<RS::SurfaceData> surfaces;
+	};
+	mutable RID_PtrOwner<DummyMesh> mesh_owner;
+
+	RID mesh_allocate() override {
+		DummyMesh *mesh = memnew(DummyMesh);
+		ERR_FAIL_COND_V(!mesh, RID());
+		return mesh_owner.make_rid(mesh);
+	}
 	void mesh_initialize(RID p_rid) override {}
 	void mesh_set_blend_shape_count(RID p_mesh, int p_blend_shape_count) override {}
 	bool mesh_needs_instance(RID p_mesh, bool p_has_skeleton) override { return false; }
@@ -319,7 +335,11 @@ public:
 	void reflection_probe_set_lod_threshold(RID p_probe, float p_ratio) override {}
 	float reflection_probe_get_lod_threshold(RID p_probe) const override { return 0.0; }
 
-	void mesh_add_surface(RID p_mesh, const RS::SurfaceData &p_surface) override {}
+	void mesh_add_surface(RID p_mesh, const RS::SurfaceData &p_surface) override {
+		DummyMesh *m = mesh_owner.getornull(p_mesh);
+		ERR_FAIL_COND(!m);
+		m->surfaces.push_back(p_surface);
+	}
 
 	int mesh_get_blend_shape_count(RID p_mesh) const override { return 0; }
 
@@ -331,15 +351,28 @@ public:
 	void mesh_surface_set_material(RID p_mesh, int p_surface, RID p_material) override {}
 	RID mesh_surface_get_material(RID p_mesh, int p_surface) const override { return RID(); }
 
-	RS::SurfaceData mesh_get_surface(RID p_mesh, int p_surface) const override { return RS::SurfaceData(); }
-	int mesh_get_surface_count(RID p_mesh) const override { return 0; }
+	RS::SurfaceData mesh_get_surface(RID p_mesh, int p_surface) const override {
+		DummyMesh *m = mesh_owner.getornull(p_mesh);
+		ERR_FAIL_COND_V(!m, RS::SurfaceData());
+		ERR_FAIL_INDEX_V(p_surface, m->surfaces.size(), RS::SurfaceData());
+		return m->surfaces[p_surface];
+	}
+	int mesh_get_surface_count(RID p_mesh) const override {
+		DummyMesh *m = mesh_owner.getornull(p_mesh);
+		ERR_FAIL_COND_V(!m, 0);
+		return m->surfaces.size();
+	}
 
 	void mesh_set_custom_aabb(RID p_mesh, const AABB &p_aabb) override {}
 	AABB mesh_get_custom_aabb(RID p_mesh) const override { return AABB(); }
 
 	AABB mesh_get_aabb(RID p_mesh, RID p_skeleton = RID()) override { return AABB(); }
 	void mesh_set_shadow_mesh(RID p_mesh, RID p_shadow_mesh) override {}
-	void mesh_clear(RID p_mesh) override {}
+	void mesh_clear(RID p_mesh) override {
+		DummyMesh *m = mesh_owner.getornull(p_mesh);
+		ERR_FAIL_COND(!m);
+		m->surfaces.clear();
+	}
 
 	/* MULTIMESH API */
 
@@ -653,13 +686,25 @@ public:
 	void render_target_set_sdf_size_and_scale(RID p_render_target, RS::ViewportSDFOversize p_size, RS::ViewportSDFScale p_scale) override {}
 	Rect2i render_target_get_sdf_rect(RID p_render_target) const override { return Rect2i(); }
 
-	RS::InstanceType get_base_type(RID p_rid) const override { return RS::INSTANCE_NONE; }
+	RS::InstanceType get_base_type(RID p_rid) const override {
+		if (mesh_owner.owns(p_rid)) {
+			return RS::INSTANCE_MESH;
+		}
+		return RS::INSTANCE_NONE;
+	}
 	bool free(RID p_rid) override {
 		if (texture_owner.owns(p_rid)) {
 			// delete the texture
 			DummyTexture *texture = texture_owner.getornull(p_rid);
 			texture_owner.free(p_rid);
 			memdelete(texture);
+		} else if (mesh_owner.owns(p_rid)) {
+			DummyMesh *mesh = mesh_owner.getornull(p_rid);
+			mesh_owner.free(p_rid);
+			memdelete(mesh);
+		} else {
+			// Not ours, let the rest of the server free it.
+			return false;
 		}
 		return true;
 	}
@@ -41,6 +41,7 @@
 #include <errno.h>
 
 #if defined(UNIX_ENABLED)
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
@@ -70,7 +71,19 @@ void FileAccessUnix::check_errors() const {
 	}
 }
 
+void FileAccessUnix::_unmap() {
+#if defined(UNIX_ENABLED)
+	if (mapped) {
+		munmap(mapped, mapped_len);
+	}
+#endif
+	mapped = nullptr;
+	mapped_len = 0;
+	map_failed = false;
+}
+
 Error FileAccessUnix::_open(const String &p_path, int p_mode_flags) {
+	_unmap();
 	if (f) {
 		fclose(f);
 	}
@@ -153,6 +166,7 @@ void FileAccessUnix::close() {
 		return;
 	}
 
+	_unmap();
 	fclose(f);
 	f = nullptr;
 
@@ -248,6 +262,39 @@ int FileAccessUnix::get_buffer(uint8_t *p_dst, int p_length) const {
 	return read;
 };
 
+const uint8_t *FileAccessUnix::get_mapped_buffer() const {
+	ERR_FAIL_COND_V_MSG(!f, nullptr, "File must be opened before use.");
+
+#if defined(UNIX_ENABLED)
+	if (mapped || map_failed) {
+		return mapped;
+	}
+
+	// Only map files opened read-only, so the contents can't change under the mapping.
+	map_failed = true;
+	if (flags != READ) {
+		return nullptr;
+	}
+
+	struct stat st;
+	if (fstat(fileno(f), &st) != 0 || st.st_size <= 0 || uint64_t(st.st_size) > uint64_t(SIZE_MAX)) {
+		return nullptr;
+	}
+
+	void *ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+	if (ptr == MAP_FAILED) {
+		return nullptr;
+	}
+
+	mapped = (uint8_t *)ptr;
+	mapped_len = st.st_size;
+	map_failed = false;
+	return mapped;
+#else
+	return nullptr;
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -49,6 +49,11 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	mutable uint8_t *mapped = nullptr;
+	mutable size_t mapped_len = 0;
+	mutable bool map_failed = false;
+	void _unmap();
+
 	static FileAccess *create_libc();
 
 public:
@@ -70,6 +75,7 @@ public:
 
 	virtual uint8_t get_8() const; ///< get a byte
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
+	virtual const uint8_t *get_mapped_buffer() const;
 
 	virtual Error get_error() const; ///< get last error
 
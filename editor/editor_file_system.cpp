@@ -1943,6 +1943,7 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 
 	importing = true;
 	EditorProgress pr("reimport", TTR("(Re)Importing Assets"), p_files.size());
+	uint64_t reimport_start_time = OS::get_singleton()->get_ticks_usec();
 
 	Vector<ImportFile> reimport_files;
 
@@ -2037,6 +2038,10 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 
 	_save_filesystem_cache();
 	importing = false;
+
+	double reimport_seconds = MAX(OS::get_singleton()->get_ticks_usec() - reimport_start_time, 1) / 1000000.0;
+	print_verbose(vformat("Reimported %d files in %.2f s (%.1f files/s).", p_files.size(), reimport_seconds, p_files.size() / reimport_seconds));
+
 	if (!is_scanning()) {
 		emit_signal("filesystem_changed");
 	}
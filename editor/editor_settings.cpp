@@ -485,6 +485,10 @@ void EditorSettings::_load_defaults(Ref<ConfigFile> p_extra_config) {
 	_initial_set("filesystem/file_dialog/thumbnail_size", 64);
 	hints["filesystem/file_dialog/thumbnail_size"] = PropertyInfo(Variant::INT, "filesystem/file_dialog/thumbnail_size", PROPERTY_HINT_RANGE, "32,128,16");
 
+	// Import
+	_initial_set("filesystem/import/vram_texture_cache_max_size_mb", 1024);
+	hints["filesystem/import/vram_texture_cache_max_size_mb"] = PropertyInfo(Variant::INT, "filesystem/import/vram_texture_cache_max_size_mb", PROPERTY_HINT_RANGE, "1,16384,1,or_greater");
+
 	/* Docks */
 
 	// SceneTree
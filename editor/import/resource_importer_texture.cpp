@@ -30,11 +30,16 @@
 
 #include "resource_importer_texture.h"
 
+#include "core/crypto/crypto_core.h"
 #include "core/io/config_file.h"
 #include "core/io/image_loader.h"
+#include "core/os/dir_access.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/version.h"
 #include "editor/editor_file_system.h"
 #include "editor/editor_node.h"
+#include "editor/editor_settings.h"
 
 void ResourceImporterTexture::_texture_reimport_roughness(const Ref<StreamTexture2D> &p_tex, const String &p_normal_path, RS::TextureDetectRoughnessChannel p_channel) {
 	MutexLock lock(singleton->mutex);
@@ -215,6 +220,277 @@ void ResourceImporterTexture::get_import_options(List<ImportOption> *r_options,
 	r_options->push_back(ImportOption(PropertyInfo(Variant::FLOAT, "svg/scale", PROPERTY_HINT_RANGE, "0.001,100,0.001"), 1.0));
 }
 
+String ResourceImporterTexture::_get_vram_cache_path(const Ref<Image> &p_image, Image::UsedChannels p_channels, Image::CompressMode p_compress_format, float p_lossy_quality) {
+	if (!EditorSettings::get_singleton()) {
+		return String();
+	}
+
+	// The engine version is part of the key, so compressor updates don't reuse stale data.
+	String key = vformat("%s %dx%d", VERSION_FULL_CONFIG, p_image->get_width(), p_image->get_height());
+	key += vformat(" %d %d %d %d %f", p_image->get_format(), int(p_image->has_mipmaps()), p_compress_format, p_channels, p_lossy_quality);
+	CharString settings = key.utf8();
+	Vector<uint8_t> data = p_image->get_data();
+
+	CryptoCore::SHA256Context ctx;
+	ctx.start();
+	ctx.update((const uint8_t *)settings.get_data(), settings.length());
+	ctx.update(data.ptr(), data.size());
+	unsigned char hash[32];
+	ctx.finish(hash);
+
+	return EditorSettings::get_singleton()->get_cache_dir().plus_file("vram_textures").plus_file(String::hex_encode_buffer(hash, 32) + ".vtex");
+}
+
+// Recency index of a cache directory, built from its files on first use and saved
+// to VRAM_CACHE_INDEX_FILE on shutdown. Loading an entry only updates the index,
+// cache files are never rewritten to mark them as used.
+#define VRAM_CACHE_INDEX_FILE "index"
+
+struct VRAMCacheIndex {
+	struct Entry {
+		uint64_t size = 0;
+		uint64_t last_used = 0;
+	};
+
+	HashMap<String, Entry> entries; // Keyed by file name.
+	uint64_t size = 0; // Bytes held by all entries.
+	uint64_t tick = 0;
+};
+
+static HashMap<String, VRAMCacheIndex> vram_cache_indices; // Keyed by directory.
+static Mutex vram_cache_mutex;
+
+// Must be called with vram_cache_mutex locked.
+static VRAMCacheIndex &_get_vram_cache_index(const String &p_dir) {
+	VRAMCacheIndex *index = vram_cache_indices.getptr(p_dir);
+	if (index) {
+		return *index;
+	}
+
+	struct CacheFile {
+		String name;
+		int order = 0; // Position in the saved index, files missing from it come after.
+		uint64_t modified_time = 0;
+		uint64_t size = 0;
+
+		bool operator<(const CacheFile &p_file) const {
+			if (order != p_file.order) {
+				return order < p_file.order;
+			}
+			return modified_time < p_file.modified_time;
+		}
+	};
+
+	HashMap<String, int> saved_order;
+	FileAccessRef saved_index = FileAccess::open(p_dir.plus_file(VRAM_CACHE_INDEX_FILE), FileAccess::READ);
+	if (saved_index) {
+		while (!saved_index->eof_reached()) {
+			String n = saved_index->get_line();
+			if (!n.is_empty()) {
+				saved_order[n] = saved_order.size();
+			}
+		}
+	}
+
+	LocalVector<CacheFile> files;
+	DirAccessRef d = DirAccess::open(p_dir);
+	if (d) {
+		d->list_dir_begin();
+		for (String n = d->get_next(); !n.is_empty(); n = d->get_next()) {
+			if (d->current_is_dir() || n.get_extension() != "vtex") {
+				continue;
+			}
+			CacheFile file;
+			file.name = n;
+			const int *order = saved_order.getptr(n);
+			file.order = order ? *order : saved_order.size();
+			// Files saved after the index was written are ordered by the time they were saved.
+			file.modified_time = FileAccess::get_modified_time(p_dir.plus_file(n));
+			FileAccessRef f = FileAccess::open(p_dir.plus_file(n), FileAccess::READ);
+			if (f) {
+				file.size = f->get_len();
+			}
+			files.push_back(file);
+		}
+		d->list_dir_end();
+	}
+	files.sort();
+
+	VRAMCacheIndex &new_index = vram_cache_indices[p_dir];
+	for (uint32_t i = 0; i < files.size(); i++) {
+		VRAMCacheIndex::Entry &entry = new_index.entries[files[i].name];
+		entry.size = files[i].size;
+		entry.last_used = ++new_index.tick;
+		new_index.size += files[i].size;
+	}
+	return new_index;
+}
+
+// Entry names from the least to the most recently used.
+static LocalVector<String> _get_vram_cache_files_by_recency(const VRAMCacheIndex &p_index) {
+	struct CacheFile {
+		String name;
+		uint64_t last_used = 0;
+
+		bool operator<(const CacheFile &p_file) const { return last_used < p_file.last_used; }
+	};
+
+	LocalVector<CacheFile> files;
+	for (const String *k = p_index.entries.next(nullptr); k; k = p_index.entries.next(k)) {
+		CacheFile file;
+		file.name = *k;
+		file.last_used = p_index.entries.getptr(*k)->last_used;
+		files.push_back(file);
+	}
+	files.sort();
+
+	LocalVector<String> names;
+	names.resize(files.size());
+	for (uint32_t i = 0; i < files.size(); i++) {
+		names[i] = files[i].name;
+	}
+	return names;
+}
+
+// Evicts the least recently used entries until the directory fits in p_max_size.
+// Must be called with vram_cache_mutex locked.
+static void _evict_vram_cache(const String &p_dir, VRAMCacheIndex &p_index, uint64_t p_max_size, const String &p_keep) {
+	if (p_index.size <= p_max_size) {
+		return;
+	}
+
+	LocalVector<String> files = _get_vram_cache_files_by_recency(p_index);
+
+	DirAccessRef d = DirAccess::open(p_dir);
+	ERR_FAIL_COND(!d);
+
+	// Evict the least recently used entries first, but never the one that was just saved.
+	uint32_t evicted = 0;
+	for (uint32_t i = 0; i < files.size() && p_index.size > p_max_size; i++) {
+		if (files[i] == p_keep) {
+			continue;
+		}
+		if (d->remove(files[i]) != OK && d->file_exists(files[i])) {
+			continue;
+		}
+		p_index.size -= p_index.entries[files[i]].size;
+		p_index.entries.erase(files[i]);
+		evicted++;
+	}
+
+	print_verbose("VRAM texture cache: evicted " + itos(evicted) + " files, " + itos(p_index.size / 1024) + " KiB left.");
+}
+
+Ref<Image> ResourceImporterTexture::_load_vram_cache(const String &p_path) {
+	FileAccessRef f = FileAccess::open(p_path, FileAccess::READ);
+	if (!f) {
+		MutexLock lock(vram_cache_mutex);
+		VRAMCacheIndex &index = _get_vram_cache_index(p_path.get_base_dir());
+		const VRAMCacheIndex::Entry *entry = index.entries.getptr(p_path.get_file());
+		if (entry) {
+			// Removed from outside the editor.
+			index.size -= entry->size;
+			index.entries.erase(p_path.get_file());
+		}
+		return Ref<Image>();
+	}
+
+	uint8_t header[4];
+	f->get_buffer(header, 4);
+	if (header[0] != 'G' || header[1] != 'V' || header[2] != 'T' || header[3] != 'C') {
+		return Ref<Image>();
+	}
+
+	Image::Format format = Image::Format(f->get_32());
+	int width = f->get_32();
+	int height = f->get_32();
+	bool mipmaps = f->get_32();
+	if (format >= Image::FORMAT_MAX || width <= 0 || width > Image::MAX_WIDTH || height <= 0 || height > Image::MAX_HEIGHT) {
+		return Ref<Image>();
+	}
+
+	int size = Image::get_image_data_size(width, height, format, mipmaps);
+	if (f->get_len() - f->get_position() != (uint64_t)size) {
+		return Ref<Image>(); // Truncated.
+	}
+
+	Vector<uint8_t> data;
+	data.resize(size);
+	f->get_buffer(data.ptrw(), size);
+	uint64_t file_size = f->get_len();
+	f->close();
+
+	{
+		MutexLock lock(vram_cache_mutex);
+		VRAMCacheIndex &index = _get_vram_cache_index(p_path.get_base_dir());
+		VRAMCacheIndex::Entry *entry = index.entries.getptr(p_path.get_file());
+		if (!entry) {
+			// Saved by another editor instance since the index was built.
+			entry = &index.entries[p_path.get_file()];
+			entry->size = file_size;
+			index.size += file_size;
+		}
+		entry->last_used = ++index.tick;
+	}
+
+	Ref<Image> image;
+	image.instance();
+	image->create(width, height, mipmaps, format, data);
+	return image;
+}
+
+void ResourceImporterTexture::_save_vram_cache(const String &p_path, const Ref<Image> &p_image, uint64_t p_max_size) {
+	DirAccessRef da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	da->make_dir_recursive(p_path.get_base_dir());
+
+	FileAccessRef f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(!f, "Cannot write compressed texture cache file '" + p_path + "'.");
+
+	f->store_8('G');
+	f->store_8('V');
+	f->store_8('T');
+	f->store_8('C');
+	f->store_32(p_image->get_format());
+	f->store_32(p_image->get_width());
+	f->store_32(p_image->get_height());
+	f->store_32(p_image->has_mipmaps());
+
+	Vector<uint8_t> data = p_image->get_data();
+	f->store_buffer(data.ptr(), data.size());
+	uint64_t size = f->get_position();
+	f->close();
+
+	MutexLock lock(vram_cache_mutex);
+	VRAMCacheIndex &index = _get_vram_cache_index(p_path.get_base_dir());
+	VRAMCacheIndex::Entry &entry = index.entries[p_path.get_file()];
+	index.size = index.size - entry.size + size; // Replaced entries no longer count.
+	entry.size = size;
+	entry.last_used = ++index.tick;
+	_evict_vram_cache(p_path.get_base_dir(), index, p_max_size, p_path.get_file());
+}
+
+uint64_t ResourceImporterTexture::_vram_cache_cleanup(const String &p_dir, uint64_t p_max_size) {
+	MutexLock lock(vram_cache_mutex);
+	VRAMCacheIndex &index = _get_vram_cache_index(p_dir);
+	_evict_vram_cache(p_dir, index, p_max_size, String());
+	return index.size;
+}
+
+void ResourceImporterTexture::_save_vram_cache_indices() {
+	MutexLock lock(vram_cache_mutex);
+	for (const String *k = vram_cache_indices.next(nullptr); k; k = vram_cache_indices.next(k)) {
+		FileAccessRef f = FileAccess::open(k->plus_file(VRAM_CACHE_INDEX_FILE), FileAccess::WRITE);
+		if (!f) {
+			continue;
+		}
+		LocalVector<String> files = _get_vram_cache_files_by_recency(vram_cache_indices[*k]);
+		for (uint32_t i = 0; i < files.size(); i++) {
+			f->store_line(files[i]);
+		}
+	}
+	vram_cache_indices.clear();
+}
+
 void ResourceImporterTexture::save_to_stex_format(FileAccess *f, const Ref<Image> &p_image, CompressMode p_compress_mode, Image::UsedChannels p_channels, Image::CompressMode p_compress_format, float p_lossy_quality) {
 	switch (p_compress_mode) {
 		case COMPRESS_LOSSLESS: {
@@ -251,9 +527,27 @@ void ResourceImporterTexture::save_to_stex_format(FileAccess *f, const Ref<Image
 			}
 		} break;
 		case COMPRESS_VRAM_COMPRESSED: {
-			Ref<Image> image = p_image->duplicate();
+			// Compressing is by far the slowest part of importing, so unchanged
+			// images compressed with the same settings reuse the cached result.
+			String cache_path = _get_vram_cache_path(p_image, p_channels, p_compress_format, p_lossy_quality);
+			Ref<Image> image = cache_path.is_empty() ? Ref<Image>() : _load_vram_cache(cache_path);
 
-			image->compress_from_channels(p_compress_format, p_channels, p_lossy_quality);
+			if (image.is_valid()) {
+				print_verbose(vformat("Reused cached VRAM compression for %dx%d image.", p_image->get_width(), p_image->get_height()));
+			} else {
+				uint64_t start_time = OS::get_singleton()->get_ticks_usec();
+
+				image = p_image->duplicate();
+				image->compress_from_channels(p_compress_format, p_channels, p_lossy_quality);
+
+				double seconds = MAX(OS::get_singleton()->get_ticks_usec() - start_time, 1) / 1000000.0;
+				double megapixels = Image::get_image_data_size(p_image->get_width(), p_image->get_height(), Image::FORMAT_L8, p_image->has_mipmaps()) / 1000000.0;
+				print_verbose(vformat("VRAM compressed %dx%d image to %s in %.3f s (%.1f Mpixel/s).", p_image->get_width(), p_image->get_height(), Image::get_format_name(image->get_format()), seconds, megapixels / seconds));
+
+				if (!cache_path.is_empty() && image->is_compressed()) {
+					_save_vram_cache(cache_path, image, uint64_t(int(EDITOR_GET("filesystem/import/vram_texture_cache_max_size_mb"))) * 1024 * 1024);
+				}
+			}
 
 			f->store_32(StreamTexture2D::DATA_FORMAT_IMAGE);
 			f->store_16(image->get_width());
@@ -630,4 +924,5 @@ ResourceImporterTexture::ResourceImporterTexture() {
 }
 
 ResourceImporterTexture::~ResourceImporterTexture() {
+	_save_vram_cache_indices();
 }
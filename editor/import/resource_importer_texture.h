@@ -74,8 +74,17 @@ protected:
 	static ResourceImporterTexture *singleton;
 	static const char *compression_formats[];
 
+	static String _get_vram_cache_path(const Ref<Image> &p_image, Image::UsedChannels p_channels, Image::CompressMode p_compress_format, float p_lossy_quality);
+
 	void _save_stex(const Ref<Image> &p_image, const String &p_to_path, CompressMode p_compress_mode, float p_lossy_quality, Image::CompressMode p_vram_compression, bool p_mipmaps, bool p_streamable, bool p_detect_3d, bool p_detect_srgb, bool p_detect_normal, bool p_force_normal, bool p_srgb_friendly, bool p_force_po2_for_compressed, uint32_t p_limit_mipmap, const Ref<Image> &p_normal, Image::RoughnessChannel p_roughness_channel);
 
+	static Ref<Image> _load_vram_cache(const String &p_path);
+	static void _save_vram_cache(const String &p_path, const Ref<Image> &p_image, uint64_t p_max_size);
+	static uint64_t _vram_cache_cleanup(const String &p_dir, uint64_t p_max_size);
+	static void _save_vram_cache_indices();
+
+	friend class ResourceImporterTextureTester;
+
 public:
 	static void save_to_stex_format(FileAccess *f, const Ref<Image> &p_image, CompressMode p_compress_mode, Image::UsedChannels p_channels, Image::CompressMode p_compress_format, float p_lossy_quality);
 
@@ -0,0 +1,132 @@
+/*************************************************************************/
+/*  hlod_3d_editor_plugin.cpp                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "hlod_3d_editor_plugin.h"
+
+void HLOD3DEditorPlugin::_bake() {
+	if (!hlod) {
+		return;
+	}
+
+	// Rebake into the existing file, otherwise ask where to save the data.
+	Ref<HLODData> data = hlod->get_data();
+	if (data.is_valid() && data->get_path().is_resource_file()) {
+		_bake_and_save(data->get_path());
+		return;
+	}
+
+	String path = get_tree()->get_edited_scene_root()->get_filename();
+	if (path == String()) {
+		path = "res://" + hlod->get_name() + "_data.hlod";
+	} else {
+		path = path.get_basename() + "." + hlod->get_name() + "_data.hlod";
+	}
+	file_dialog->set_current_path(path);
+	file_dialog->popup_file_dialog();
+}
+
+void HLOD3DEditorPlugin::_bake_and_save(const String &p_path) {
+	file_dialog->hide();
+	if (!hlod) {
+		return;
+	}
+
+	Ref<HLODData> baked = hlod->bake();
+	ERR_FAIL_COND(baked.is_null());
+	if (baked->get_cluster_count() == 0) {
+		EditorNode::get_singleton()->show_warning(TTR("No meshes to bake. Make sure the HLOD3D node has visible, static MeshInstance3D nodes below it."));
+		return;
+	}
+
+	// When rebaking, the data already loaded from that path is updated in place.
+	Ref<HLODData> data = hlod->get_data();
+	if (data.is_valid() && data->get_path() == p_path) {
+		data->clear();
+		for (int i = 0; i < baked->get_cluster_count(); i++) {
+			data->add_cluster(baked->get_cluster_mesh(i), baked->get_cluster_transform(i), baked->get_cluster_sources(i));
+		}
+	} else {
+		data = baked;
+	}
+
+	Error err = ResourceSaver::save(p_path, data, ResourceSaver::FLAG_CHANGE_PATH);
+	if (err != OK) {
+		EditorNode::get_singleton()->show_warning(vformat(TTR("Failed saving HLOD data to '%s'."), p_path));
+		return;
+	}
+
+	hlod->set_data(data);
+}
+
+void HLOD3DEditorPlugin::edit(Object *p_object) {
+	HLOD3D *s = Object::cast_to<HLOD3D>(p_object);
+	if (!s) {
+		return;
+	}
+
+	hlod = s;
+}
+
+bool HLOD3DEditorPlugin::handles(Object *p_object) const {
+	return p_object->is_class("HLOD3D");
+}
+
+void HLOD3DEditorPlugin::make_visible(bool p_visible) {
+	if (p_visible) {
+		bake->show();
+	} else {
+		bake->hide();
+	}
+}
+
+void HLOD3DEditorPlugin::_bind_methods() {
+}
+
+HLOD3DEditorPlugin::HLOD3DEditorPlugin(EditorNode *p_node) {
+	editor = p_node;
+	bake = memnew(Button);
+	bake->set_flat(true);
+	bake->set_icon(editor->get_gui_base()->get_theme_icon("Bake", "EditorIcons"));
+	bake->set_text(TTR("Bake HLOD"));
+	bake->hide();
+	bake->connect("pressed", callable_mp(this, &HLOD3DEditorPlugin::_bake));
+	add_control_to_container(CONTAINER_SPATIAL_EDITOR_MENU, bake);
+	hlod = nullptr;
+
+	file_dialog = memnew(EditorFileDialog);
+	file_dialog->set_file_mode(EditorFileDialog::FILE_MODE_SAVE_FILE);
+	file_dialog->add_filter("*.hlod ; HLOD Data");
+	file_dialog->add_filter("*.res ; Binary Resource");
+	file_dialog->set_title(TTR("Select path for HLOD Data File"));
+	file_dialog->connect("file_selected", callable_mp(this, &HLOD3DEditorPlugin::_bake_and_save));
+	get_editor_interface()->get_base_control()->add_child(file_dialog);
+}
+
+HLOD3DEditorPlugin::~HLOD3DEditorPlugin() {
+}
@@ -62,6 +62,7 @@
 #include "scene/main/window.h"
 #include "scene/register_scene_types.h"
 #include "scene/resources/packed_scene.h"
+#include "scene/resources/texture.h"
 #include "servers/audio_server.h"
 #include "servers/camera_server.h"
 #include "servers/display_server.h"
@@ -1381,6 +1382,8 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 					PROPERTY_HINT_RANGE,
 					"0,33200,1,or_greater")); // No negative numbers
 
+	ResourceLoader::set_parallel_dependency_loading(GLOBAL_DEF("application/run/parallel_dependency_loading", false));
+
 	GLOBAL_DEF("display/window/ios/hide_home_indicator", true);
 	GLOBAL_DEF("input_devices/pointing/ios/touch_delay", 0.150);
 
@@ -2505,6 +2508,7 @@ bool Main::iteration() {
 		exit = true;
 	}
 	message_queue->flush();
+	StreamTexture2D::flush_streaming();
 
 	RenderingServer::get_singleton()->sync(); //sync if still drawing from previous frames.
 
@@ -34,6 +34,7 @@
 #include "core/os/os.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
+#include "scene/resources/texture.h"
 #include "servers/audio_server.h"
 #include "servers/physics_server_2d.h"
 #include "servers/physics_server_3d.h"
@@ -77,6 +78,10 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
 	BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY);
+	BIND_ENUM_CONSTANT(RENDER_OCCLUDED_OBJECTS_IN_FRAME);
+	BIND_ENUM_CONSTANT(RENDER_DRAW_CALLS_SAVED_IN_FRAME);
+	BIND_ENUM_CONSTANT(OBJECT_RESOURCE_CACHE_LOCK_CONTENTIONS);
+	BIND_ENUM_CONSTANT(RENDER_STREAMING_TEXTURE_MEM_USED);
 
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
@@ -120,6 +125,10 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"physics_3d/collision_pairs",
 		"physics_3d/islands",
 		"audio/driver/output_latency",
+		"raster/occluded_objects",
+		"raster/draw_calls_saved",
+		"object/resource_cache_lock_contentions",
+		"video/streaming_texture_mem",
 
 	};
 
@@ -182,6 +191,14 @@ float Performance::get_monitor(Monitor p_monitor) const {
 			return PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT);
 		case AUDIO_OUTPUT_LATENCY:
 			return AudioServer::get_singleton()->get_output_latency();
+		case RENDER_OCCLUDED_OBJECTS_IN_FRAME:
+			return RS::get_singleton()->get_render_info(RS::INFO_OCCLUDED_OBJECTS_IN_FRAME);
+		case RENDER_DRAW_CALLS_SAVED_IN_FRAME:
+			return RS::get_singleton()->get_render_info(RS::INFO_DRAW_CALLS_SAVED_IN_FRAME);
+		case OBJECT_RESOURCE_CACHE_LOCK_CONTENTIONS:
+			return ResourceCache::get_lock_contention_count();
+		case RENDER_STREAMING_TEXTURE_MEM_USED:
+			return StreamTexture2D::get_streaming_memory_used();
 
 		default: {
 		}
@@ -221,6 +238,10 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
 
 	};
 
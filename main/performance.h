@@ -91,6 +91,10 @@ public:
 		PHYSICS_3D_ISLAND_COUNT,
 		//physics
 		AUDIO_OUTPUT_LATENCY,
+		RENDER_OCCLUDED_OBJECTS_IN_FRAME,
+		RENDER_DRAW_CALLS_SAVED_IN_FRAME,
+		OBJECT_RESOURCE_CACHE_LOCK_CONTENTIONS,
+		RENDER_STREAMING_TEXTURE_MEM_USED,
 		MONITOR_MAX
 	};
 
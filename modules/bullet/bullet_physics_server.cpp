@@ -231,6 +231,16 @@ int BulletPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+Vector<uint8_t> BulletPhysicsServer3D::space_save_state(RID p_space) const {
+	WARN_PRINT("space_save_state is not implemented yet in Bullet backend.");
+	return Vector<uint8_t>();
+}
+
+Error BulletPhysicsServer3D::space_restore_state(RID p_space, const Vector<uint8_t> &p_state) {
+	WARN_PRINT("space_restore_state is not implemented yet in Bullet backend.");
+	return ERR_UNAVAILABLE;
+}
+
 RID BulletPhysicsServer3D::area_create() {
 	AreaBullet *area = bulletnew(AreaBullet);
 	area->set_collision_layer(1);
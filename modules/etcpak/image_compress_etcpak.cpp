@@ -32,6 +32,8 @@
 
 #include "core/os/os.h"
 #include "core/string/print_string.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/thread_work_pool.h"
 
 #include "thirdparty/etcpak/ProcessDxtc.hpp"
 #include "thirdparty/etcpak/ProcessRGB.hpp"
@@ -74,6 +76,44 @@ EtcpakType _determine_dxt_type(Image::UsedChannels p_channels) {
 	}
 }
 
+// Images with fewer blocks than this (a 256x256 image) are compressed on the calling thread.
+static const uint32_t PARALLEL_MIN_BLOCKS = 4096;
+// Rows of blocks compressed by each work item, etcpak blocks don't depend on each other.
+static const uint32_t BAND_BLOCK_ROWS = 4;
+
+static void _compress_etcpak_blocks(EtcpakType p_compresstype, const uint32_t *p_src, uint64_t *p_dst, uint32_t p_blocks, uint32_t p_width) {
+	if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC1) {
+		CompressEtc1RgbDither(p_src, p_dst, p_blocks, p_width);
+	} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2 || p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG) {
+		CompressEtc2Rgb(p_src, p_dst, p_blocks, p_width);
+	} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_ALPHA) {
+		CompressEtc2Rgba(p_src, p_dst, p_blocks, p_width);
+	} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_DXT1) {
+		CompressDxt1Dither(p_src, p_dst, p_blocks, p_width);
+	} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5 || p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG) {
+		CompressDxt5(p_src, p_dst, p_blocks, p_width);
+	} else {
+		ERR_FAIL_MSG("Invalid or unsupported Etcpak compression format.");
+	}
+}
+
+struct EtcpakBand {
+	const uint32_t *src = nullptr;
+	uint64_t *dst = nullptr;
+	uint32_t blocks = 0;
+	uint32_t width = 0;
+};
+
+struct EtcpakBandJob {
+	EtcpakType type;
+	const EtcpakBand *bands = nullptr;
+
+	void compress_band(uint32_t p_index, void *p_userdata) {
+		const EtcpakBand &band = bands[p_index];
+		_compress_etcpak_blocks(type, band.src, band.dst, band.blocks, band.width);
+	}
+};
+
 void _compress_etc1(Image *r_img, float p_lossy_quality) {
 	_compress_etcpak(EtcpakType::ETCPAK_TYPE_ETC1, r_img, p_lossy_quality);
 }
@@ -145,6 +185,14 @@ void _compress_etcpak(EtcpakType p_compresstype, Image *r_img, float p_lossy_qua
 
 	int mip_count = mipmaps ? Image::get_image_required_mipmaps(width, height, target_format) : 0;
 
+	// 16 byte blocks when alpha is encoded separately, 8 byte blocks otherwise.
+	const bool wide_blocks = p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_ALPHA || p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5 || p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG;
+	const uint32_t block_words = wide_blocks ? 2 : 1;
+
+	// Split every mip in bands of block rows, so mips and blocks can be compressed in parallel.
+	LocalVector<EtcpakBand> bands;
+	uint32_t total_blocks = 0;
+
 	for (int i = 0; i < mip_count + 1; i++) {
 		// Get write mip metrics for target image.
 		int mip_w, mip_h;
@@ -156,24 +204,39 @@ void _compress_etcpak(EtcpakType p_compresstype, Image *r_img, float p_lossy_qua
 		// Block size. Align stride to multiple of 4 (RGBA8).
 		mip_w = (mip_w + 3) & ~3;
 		mip_h = (mip_h + 3) & ~3;
-		const uint32_t blocks = mip_w * mip_h / 16;
+		const uint32_t row_blocks = mip_w / 4;
+		const uint32_t block_rows = mip_h / 4;
 
 		// Get mip data from source image for reading.
 		int src_mip_ofs = r_img->get_mipmap_offset(i);
 		const uint32_t *src_mip_read = (const uint32_t *)&src_read[src_mip_ofs];
 
-		if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC1) {
-			CompressEtc1RgbDither(src_mip_read, dest_mip_write, blocks, mip_w);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2 || p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG) {
-			CompressEtc2Rgb(src_mip_read, dest_mip_write, blocks, mip_w);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_ALPHA) {
-			CompressEtc2Rgba(src_mip_read, dest_mip_write, blocks, mip_w);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_DXT1) {
-			CompressDxt1Dither(src_mip_read, dest_mip_write, blocks, mip_w);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5 || p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG) {
-			CompressDxt5(src_mip_read, dest_mip_write, blocks, mip_w);
-		} else {
-			ERR_FAIL_MSG("Invalid or unsupported Etcpak compression format.");
+		for (uint32_t row = 0; row < block_rows; row += BAND_BLOCK_ROWS) {
+			EtcpakBand band;
+			band.src = src_mip_read + row * 4 * mip_w;
+			band.dst = dest_mip_write + row * row_blocks * block_words;
+			band.blocks = MIN(BAND_BLOCK_ROWS, block_rows - row) * row_blocks;
+			band.width = mip_w;
+			bands.push_back(band);
+		}
+		total_blocks += row_blocks * block_rows;
+	}
+
+	ThreadWorkPool *pool = nullptr;
+	if (total_blocks >= PARALLEL_MIN_BLOCKS && bands.size() > 1) {
+		// Images being compressed while the pool is busy don't wait for it.
+		pool = ThreadWorkPool::try_lock_shared();
+	}
+
+	if (pool) {
+		EtcpakBandJob job;
+		job.type = p_compresstype;
+		job.bands = bands.ptr();
+		pool->do_work(bands.size(), &job, &EtcpakBandJob::compress_band, (void *)nullptr);
+		ThreadWorkPool::unlock_shared();
+	} else {
+		for (uint32_t i = 0; i < bands.size(); i++) {
+			_compress_etcpak_blocks(p_compresstype, bands[i].src, bands[i].dst, bands[i].blocks, bands[i].width);
 		}
 	}
 
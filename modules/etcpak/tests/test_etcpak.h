@@ -0,0 +1,119 @@
+/*************************************************************************/
+/*  test_etcpak.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_ETCPAK_H
+#define TEST_ETCPAK_H
+
+#include "core/io/image.h"
+#include "modules/etcpak/image_compress_etcpak.h"
+
+#include "tests/test_macros.h"
+
+#include "thirdparty/etcpak/ProcessDxtc.hpp"
+#include "thirdparty/etcpak/ProcessRGB.hpp"
+
+namespace TestEtcpak {
+
+// Large enough to be compressed in bands over the worker pool.
+static Ref<Image> make_test_image(bool p_mipmaps) {
+	const int size = 512;
+	Vector<uint8_t> data;
+	data.resize(size * size * 4);
+	uint8_t *w = data.ptrw();
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			uint8_t *pixel = w + (y * size + x) * 4;
+			pixel[0] = x * 7 + y;
+			pixel[1] = (x ^ y) * 3;
+			pixel[2] = y * 5 - x;
+			pixel[3] = (x * y) >> 4;
+		}
+	}
+
+	Ref<Image> image;
+	image.instance();
+	image->create(size, size, false, Image::FORMAT_RGBA8, data);
+	if (p_mipmaps) {
+		image->generate_mipmaps();
+	}
+	return image;
+}
+
+// Compresses every mip with a single etcpak call, as it was done before compression was split in bands.
+static Vector<uint8_t> compress_unbanded(const Ref<Image> &p_image, Image::Format p_format, void (*p_compress)(const uint32_t *, uint64_t *, uint32_t, size_t)) {
+	const int width = p_image->get_width();
+	const int height = p_image->get_height();
+	const uint8_t *src = p_image->get_data().ptr();
+
+	Vector<uint8_t> dest;
+	dest.resize(Image::get_image_data_size(width, height, p_format, p_image->has_mipmaps()));
+	int mip_count = p_image->has_mipmaps() ? Image::get_image_required_mipmaps(width, height, p_format) : 0;
+	for (int i = 0; i < mip_count + 1; i++) {
+		int mip_w, mip_h;
+		int mip_ofs = Image::get_image_mipmap_offset_and_dimensions(width, height, p_format, i, mip_w, mip_h);
+		mip_w = (mip_w + 3) & ~3;
+		mip_h = (mip_h + 3) & ~3;
+		const uint32_t *mip_src = (const uint32_t *)(src + p_image->get_mipmap_offset(i));
+		p_compress(mip_src, (uint64_t *)(dest.ptrw() + mip_ofs), mip_w * mip_h / 16, mip_w);
+	}
+	return dest;
+}
+
+TEST_CASE("[Etcpak] Banded compression matches unbanded compression") {
+	struct Case {
+		EtcpakType type;
+		Image::Format format;
+		void (*compress)(const uint32_t *, uint64_t *, uint32_t, size_t);
+	};
+	const Case cases[] = {
+		{ EtcpakType::ETCPAK_TYPE_ETC1, Image::FORMAT_ETC, CompressEtc1RgbDither },
+		{ EtcpakType::ETCPAK_TYPE_ETC2, Image::FORMAT_ETC2_RGB8, CompressEtc2Rgb },
+		{ EtcpakType::ETCPAK_TYPE_ETC2_ALPHA, Image::FORMAT_ETC2_RGBA8, CompressEtc2Rgba },
+		{ EtcpakType::ETCPAK_TYPE_DXT1, Image::FORMAT_DXT1, CompressDxt1Dither },
+		{ EtcpakType::ETCPAK_TYPE_DXT5, Image::FORMAT_DXT5, CompressDxt5 },
+	};
+
+	for (const Case &c : cases) {
+		for (int mipmaps = 0; mipmaps < 2; mipmaps++) {
+			Ref<Image> source = make_test_image(mipmaps);
+			Ref<Image> image = make_test_image(mipmaps);
+			_compress_etcpak(c.type, image.ptr(), 1.0);
+
+			CHECK(image->get_format() == c.format);
+			CHECK(image->has_mipmaps() == bool(mipmaps));
+			CHECK_MESSAGE(
+					image->get_data() == compress_unbanded(source, c.format, c.compress),
+					"Compressing in bands of block rows should give the same blocks as compressing whole mips, format: ", Image::get_format_name(c.format), ", mipmaps: ", mipmaps);
+		}
+	}
+}
+} // namespace TestEtcpak
+
+#endif // TEST_ETCPAK_H
@@ -107,6 +107,14 @@ Error ImageLoaderJPG::load_image(Ref<Image> p_image, FileAccess *f, bool p_force
 	Vector<uint8_t> src_image;
 	int src_image_len = f->get_len();
 	ERR_FAIL_COND_V(src_image_len == 0, ERR_FILE_CORRUPT);
+
+	const uint8_t *mapped = f->get_mapped_buffer();
+	if (mapped) {
+		Error err = jpeg_load_image_from_buffer(p_image.ptr(), mapped, src_image_len);
+		f->close();
+		return err;
+	}
+
 	src_image.resize(src_image_len);
 
 	uint8_t *w = src_image.ptrw();
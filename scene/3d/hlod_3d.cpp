@@ -0,0 +1,554 @@
+/*************************************************************************/
+/*  hlod_3d.cpp                                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "hlod_3d.h"
+
+#include "core/templates/thread_work_pool.h"
+#include "mesh_instance_3d.h"
+#include "scene/resources/surface_tool.h"
+
+void HLODData::add_cluster(const Ref<Mesh> &p_mesh, const Transform &p_transform, const Array &p_sources) {
+	ERR_FAIL_COND(p_mesh.is_null());
+	Cluster cluster;
+	cluster.mesh = p_mesh;
+	cluster.transform = p_transform;
+	cluster.sources = p_sources;
+	clusters.push_back(cluster);
+}
+
+int HLODData::get_cluster_count() const {
+	return clusters.size();
+}
+
+Ref<Mesh> HLODData::get_cluster_mesh(int p_cluster) const {
+	ERR_FAIL_INDEX_V(p_cluster, clusters.size(), Ref<Mesh>());
+	return clusters[p_cluster].mesh;
+}
+
+Transform HLODData::get_cluster_transform(int p_cluster) const {
+	ERR_FAIL_INDEX_V(p_cluster, clusters.size(), Transform());
+	return clusters[p_cluster].transform;
+}
+
+Array HLODData::get_cluster_sources(int p_cluster) const {
+	ERR_FAIL_INDEX_V(p_cluster, clusters.size(), Array());
+	return clusters[p_cluster].sources;
+}
+
+void HLODData::clear() {
+	clusters.clear();
+}
+
+void HLODData::_set_cluster_data(const Array &p_data) {
+	ERR_FAIL_COND(p_data.size() % 3 != 0);
+
+	clusters.clear();
+	for (int i = 0; i < p_data.size(); i += 3) {
+		add_cluster(p_data[i], p_data[i + 1], p_data[i + 2]);
+	}
+}
+
+Array HLODData::_get_cluster_data() const {
+	Array ret;
+	for (int i = 0; i < clusters.size(); i++) {
+		ret.push_back(clusters[i].mesh);
+		ret.push_back(clusters[i].transform);
+		ret.push_back(clusters[i].sources);
+	}
+	return ret;
+}
+
+void HLODData::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("_set_cluster_data", "data"), &HLODData::_set_cluster_data);
+	ClassDB::bind_method(D_METHOD("_get_cluster_data"), &HLODData::_get_cluster_data);
+
+	ClassDB::bind_method(D_METHOD("add_cluster", "mesh", "transform", "sources"), &HLODData::add_cluster);
+	ClassDB::bind_method(D_METHOD("get_cluster_count"), &HLODData::get_cluster_count);
+	ClassDB::bind_method(D_METHOD("get_cluster_mesh", "cluster"), &HLODData::get_cluster_mesh);
+	ClassDB::bind_method(D_METHOD("get_cluster_transform", "cluster"), &HLODData::get_cluster_transform);
+	ClassDB::bind_method(D_METHOD("get_cluster_sources", "cluster"), &HLODData::get_cluster_sources);
+	ClassDB::bind_method(D_METHOD("clear"), &HLODData::clear);
+
+	ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "cluster_data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL), "_set_cluster_data", "_get_cluster_data");
+}
+
+///////////////////////////////
+
+void HLOD3D::_find_meshes(Node *p_at_node, Vector<MeshInstance3D *> &r_meshes) {
+	if (Object::cast_to<HLOD3D>(p_at_node)) {
+		return; //nested HLOD nodes handle their own subtree
+	}
+
+	MeshInstance3D *mi = Object::cast_to<MeshInstance3D>(p_at_node);
+	if (mi && mi->is_visible_in_tree()) {
+		Ref<Mesh> mesh = mi->get_mesh();
+		// Skinned and morphing meshes can't be merged into a static proxy.
+		if (mesh.is_valid() && mi->get_skin().is_null() && mesh->get_blend_shape_count() == 0) {
+			r_meshes.push_back(mi);
+		}
+	}
+
+	for (int i = 0; i < p_at_node->get_child_count(); i++) {
+		_find_meshes(p_at_node->get_child(i), r_meshes);
+	}
+}
+
+bool HLOD3D::_is_surface_mergeable(const Array &p_arrays) {
+	// Only triangle lists are accepted, the merge walks the indices three at a time.
+	int vertex_count = PackedVector3Array(p_arrays[Mesh::ARRAY_VERTEX]).size();
+	int index_count = PackedInt32Array(p_arrays[Mesh::ARRAY_INDEX]).size();
+	return vertex_count > 0 && (index_count ? index_count : vertex_count) % 3 == 0;
+}
+
+Array HLOD3D::_merge_surfaces(const Vector<const BakeSurface *> &p_surfaces, const Vector3 &p_origin) const {
+	bool has_normals = false;
+	bool has_uvs = false;
+	int vertex_total = 0;
+	int index_total = 0;
+
+	for (int i = 0; i < p_surfaces.size(); i++) {
+		ERR_FAIL_COND_V_MSG(!_is_surface_mergeable(p_surfaces[i]->arrays), Array(), "HLOD surfaces must be triangle lists.");
+		const Array &a = p_surfaces[i]->arrays;
+		int vertex_count = PackedVector3Array(a[Mesh::ARRAY_VERTEX]).size();
+		int index_count = PackedInt32Array(a[Mesh::ARRAY_INDEX]).size();
+		vertex_total += vertex_count;
+		index_total += index_count ? index_count : vertex_count;
+		has_normals = has_normals || a[Mesh::ARRAY_NORMAL].get_type() != Variant::NIL;
+		has_uvs = has_uvs || a[Mesh::ARRAY_TEX_UV].get_type() != Variant::NIL;
+	}
+
+	Vector<Vector3> vertices;
+	Vector<Vector3> normals;
+	Vector<Vector2> uvs;
+	Vector<int> indices;
+
+	vertices.resize(vertex_total);
+	if (has_normals) {
+		normals.resize(vertex_total);
+	}
+	if (has_uvs) {
+		uvs.resize(vertex_total);
+	}
+	indices.resize(index_total);
+
+	Vector3 *vw = vertices.ptrw();
+	Vector3 *nw = normals.ptrw();
+	Vector2 *uw = uvs.ptrw();
+	int *iw = indices.ptrw();
+
+	int vertex_ofs = 0;
+	int index_ofs = 0;
+
+	for (int i = 0; i < p_surfaces.size(); i++) {
+		const BakeSurface *surface = p_surfaces[i];
+		const Array &a = surface->arrays;
+
+		Vector<Vector3> src_vertices = a[Mesh::ARRAY_VERTEX];
+		Vector<Vector3> src_normals = a[Mesh::ARRAY_NORMAL];
+		Vector<Vector2> src_uvs = a[Mesh::ARRAY_TEX_UV];
+		Vector<int> src_indices = a[Mesh::ARRAY_INDEX];
+
+		Transform xform = surface->xform;
+		xform.origin -= p_origin;
+		Basis normal_basis = xform.basis.inverse().transposed();
+		bool flip = xform.basis.determinant() < 0;
+
+		int vertex_count = src_vertices.size();
+		for (int j = 0; j < vertex_count; j++) {
+			vw[vertex_ofs + j] = xform.xform(src_vertices[j]);
+			if (has_normals) {
+				nw[vertex_ofs + j] = src_normals.size() == vertex_count ? normal_basis.xform(src_normals[j]).normalized() : Vector3(0, 1, 0);
+			}
+			if (has_uvs) {
+				uw[vertex_ofs + j] = src_uvs.size() == vertex_count ? src_uvs[j] : Vector2();
+			}
+		}
+
+		int index_count = src_indices.size() ? src_indices.size() : vertex_count;
+		for (int j = 0; j < index_count; j += 3) {
+			for (int k = 0; k < 3; k++) {
+				// Mirrored instances need the winding reversed to keep facing.
+				int src = flip ? (3 - k) % 3 : k;
+				int index = src_indices.size() ? src_indices[j + src] : j + src;
+				iw[index_ofs + j + k] = vertex_ofs + index;
+			}
+		}
+
+		vertex_ofs += vertex_count;
+		index_ofs += index_count;
+	}
+
+	if (SurfaceTool::simplify_func && simplify_ratio < 1.0) {
+		size_t target = MAX(size_t(indices.size() * simplify_ratio) / 3 * 3, size_t(3));
+		Vector<int> new_indices;
+		new_indices.resize(indices.size());
+		float error;
+		// The proxy is only seen from far away, so allow up to 5% of the cluster extents as error.
+		size_t new_len = SurfaceTool::simplify_func((unsigned int *)new_indices.ptrw(), (const unsigned int *)indices.ptr(), indices.size(), (const float *)vertices.ptr(), vertices.size(), sizeof(Vector3), target, 0.05, &error);
+		if (new_len > 0) {
+			new_indices.resize(new_len);
+			indices = new_indices;
+		}
+	}
+
+	// Drop the vertices the simplifier no longer references.
+	Vector<int> remap;
+	remap.resize(vertices.size());
+	int *rw = remap.ptrw();
+	for (int i = 0; i < remap.size(); i++) {
+		rw[i] = -1;
+	}
+
+	Vector<Vector3> out_vertices;
+	Vector<Vector3> out_normals;
+	Vector<Vector2> out_uvs;
+	iw = indices.ptrw();
+	for (int i = 0; i < indices.size(); i++) {
+		int index = iw[i];
+		if (rw[index] < 0) {
+			rw[index] = out_vertices.size();
+			out_vertices.push_back(vertices[index]);
+			if (has_normals) {
+				out_normals.push_back(normals[index]);
+			}
+			if (has_uvs) {
+				out_uvs.push_back(uvs[index]);
+			}
+		}
+		iw[i] = rw[index];
+	}
+
+	Array arrays;
+	arrays.resize(Mesh::ARRAY_MAX);
+	arrays[Mesh::ARRAY_VERTEX] = out_vertices;
+	if (has_normals) {
+		arrays[Mesh::ARRAY_NORMAL] = out_normals;
+	}
+	if (has_uvs) {
+		arrays[Mesh::ARRAY_TEX_UV] = out_uvs;
+	}
+	arrays[Mesh::ARRAY_INDEX] = indices;
+	return arrays;
+}
+
+void HLOD3D::_bake_cluster(uint32_t p_cluster, BakeCluster *p_clusters) {
+	BakeCluster &cluster = p_clusters[p_cluster];
+	Vector3 origin = cluster.aabb.position + cluster.aabb.size * 0.5;
+
+	// Surfaces sharing a material are merged together, so a proxy needs one draw per material.
+	LocalVector<bool> merged;
+	merged.resize(cluster.surfaces.size());
+	for (uint32_t i = 0; i < merged.size(); i++) {
+		merged[i] = false;
+	}
+
+	for (int i = 0; i < cluster.surfaces.size(); i++) {
+		if (merged[i]) {
+			continue;
+		}
+
+		Vector<const BakeSurface *> group;
+		for (int j = i; j < cluster.surfaces.size(); j++) {
+			if (!merged[j] && cluster.surfaces[j].material == cluster.surfaces[i].material) {
+				group.push_back(&cluster.surfaces[j]);
+				merged[j] = true;
+			}
+		}
+
+		Array arrays = _merge_surfaces(group, origin);
+		if (arrays.is_empty()) {
+			continue;
+		}
+		cluster.out_arrays.push_back(arrays);
+		cluster.out_materials.push_back(cluster.surfaces[i].material);
+	}
+}
+
+Transform HLOD3D::_get_transform_to_self(const Node3D *p_node) const {
+	Transform xform;
+	for (const Node *n = p_node; n && n != this; n = n->get_parent()) {
+		const Node3D *n3d = Object::cast_to<Node3D>(n);
+		if (n3d) {
+			xform = n3d->get_transform() * xform;
+		}
+	}
+	return xform;
+}
+
+Ref<HLODData> HLOD3D::bake() {
+	Vector<MeshInstance3D *> meshes;
+	for (int i = 0; i < get_child_count(); i++) {
+		_find_meshes(get_child(i), meshes);
+	}
+
+	// Outside the tree (e.g. a scene baked from a tool script) there are no global transforms,
+	// so the local transforms are combined up to this node instead.
+	bool inside_tree = is_inside_tree();
+	Transform to_local = inside_tree ? get_global_transform().affine_inverse() : Transform();
+
+	Map<Vector3i, int> cluster_map;
+	LocalVector<BakeCluster> clusters;
+
+	for (int i = 0; i < meshes.size(); i++) {
+		MeshInstance3D *mi = meshes[i];
+		Ref<Mesh> mesh = mi->get_mesh();
+
+		Transform xf = inside_tree ? to_local * mi->get_global_transform() : _get_transform_to_self(mi);
+		AABB aabb = xf.xform(mesh->get_aabb());
+		Vector3 center = aabb.position + aabb.size * 0.5;
+		Vector3i key(Math::floor(center.x / cluster_size), Math::floor(center.y / cluster_size), Math::floor(center.z / cluster_size));
+
+		Map<Vector3i, int>::Element *E = cluster_map.find(key);
+		int cluster_index;
+		if (E) {
+			cluster_index = E->get();
+		} else {
+			cluster_index = clusters.size();
+			cluster_map.insert(key, cluster_index);
+			clusters.resize(clusters.size() + 1);
+		}
+
+		BakeCluster &cluster = clusters[cluster_index];
+		bool added = false;
+
+		// Arrays are fetched here, reading them back from the server is not thread safe.
+		for (int j = 0; j < mesh->get_surface_count(); j++) {
+			if (mesh->surface_get_primitive_type(j) != Mesh::PRIMITIVE_TRIANGLES) {
+				continue;
+			}
+
+			BakeSurface surface;
+			surface.arrays = mesh->surface_get_arrays(j);
+			ERR_CONTINUE_MSG(!_is_surface_mergeable(surface.arrays), vformat("Surface %d of '%s' is not a valid triangle list, it won't be part of the HLOD proxy.", j, mi->get_name()));
+			surface.xform = xf;
+			surface.material = mi->get_active_material(j);
+			cluster.surfaces.push_back(surface);
+			added = true;
+		}
+
+		if (added) {
+			if (cluster.sources.is_empty()) {
+				cluster.aabb = aabb;
+			} else {
+				cluster.aabb.merge_with(aabb);
+			}
+			cluster.sources.push_back(get_path_to(mi));
+		}
+	}
+
+	if (clusters.size()) {
+		ThreadWorkPool work_pool;
+		work_pool.init();
+		work_pool.do_work(clusters.size(), this, &HLOD3D::_bake_cluster, clusters.ptr());
+		work_pool.finish();
+	}
+
+	Ref<HLODData> hlod;
+	hlod.instance();
+
+	for (uint32_t i = 0; i < clusters.size(); i++) {
+		const BakeCluster &cluster = clusters[i];
+		if (cluster.out_arrays.is_empty()) {
+			continue;
+		}
+
+		Ref<ArrayMesh> mesh;
+		mesh.instance();
+		for (int j = 0; j < cluster.out_arrays.size(); j++) {
+			mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, cluster.out_arrays[j]);
+			mesh->surface_set_material(j, cluster.out_materials[j]);
+		}
+
+		hlod->add_cluster(mesh, Transform(Basis(), cluster.aabb.position + cluster.aabb.size * 0.5), cluster.sources);
+	}
+
+	return hlod;
+}
+
+void HLOD3D::_create_proxies() {
+	_clear_proxies();
+
+	if (!is_inside_world() || data.is_null()) {
+		return;
+	}
+
+	RID scenario = get_world_3d()->get_scenario();
+	Transform global_xform = get_global_transform();
+	bool visible = is_visible_in_tree();
+
+	for (int i = 0; i < data->get_cluster_count(); i++) {
+		Ref<Mesh> mesh = data->get_cluster_mesh(i);
+
+		ProxyInstance proxy;
+		proxy.instance = RS::get_singleton()->instance_create2(mesh->get_rid(), scenario);
+		RS::get_singleton()->instance_set_transform(proxy.instance, global_xform * data->get_cluster_transform(i));
+		RS::get_singleton()->instance_set_visible(proxy.instance, visible);
+		RS::get_singleton()->instance_geometry_set_draw_range(proxy.instance, proxy_distance, 0, 0, 0);
+
+		// Sources measure their distance to the proxy, so the whole cluster switches at once.
+		Array sources = data->get_cluster_sources(i);
+		for (int j = 0; j < sources.size(); j++) {
+			GeometryInstance3D *gi = Object::cast_to<GeometryInstance3D>(get_node_or_null(sources[j]));
+			if (!gi) {
+				continue;
+			}
+
+			float max_distance = gi->get_lod_max_distance() > 0 ? MIN(gi->get_lod_max_distance(), proxy_distance) : proxy_distance;
+			// The proxy switches without a margin, the sources must too or both could be hidden at once.
+			float max_margin = max_distance < proxy_distance ? gi->get_lod_max_hysteresis() : 0.0;
+			RS::get_singleton()->instance_geometry_set_draw_range(gi->get_instance(), gi->get_lod_min_distance(), max_distance, gi->get_lod_min_hysteresis(), max_margin);
+			RS::get_singleton()->instance_geometry_set_as_instance_lod(gi->get_instance(), proxy.instance);
+			proxy.sources.push_back(gi->get_instance_id());
+		}
+
+		proxy_instances.push_back(proxy);
+	}
+}
+
+void HLOD3D::_clear_proxies() {
+	for (int i = 0; i < proxy_instances.size(); i++) {
+		const ProxyInstance &proxy = proxy_instances[i];
+
+		for (int j = 0; j < proxy.sources.size(); j++) {
+			GeometryInstance3D *gi = Object::cast_to<GeometryInstance3D>(ObjectDB::get_instance(proxy.sources[j]));
+			if (!gi) {
+				continue;
+			}
+
+			RS::get_singleton()->instance_geometry_set_as_instance_lod(gi->get_instance(), RID());
+			RS::get_singleton()->instance_geometry_set_draw_range(gi->get_instance(), gi->get_lod_min_distance(), gi->get_lod_max_distance(), gi->get_lod_min_hysteresis(), gi->get_lod_max_hysteresis());
+		}
+
+		RS::get_singleton()->free(proxy.instance);
+	}
+
+	proxy_instances.clear();
+}
+
+void HLOD3D::_notification(int p_what) {
+	switch (p_what) {
+		case NOTIFICATION_ENTER_WORLD: {
+			_create_proxies();
+		} break;
+		case NOTIFICATION_TRANSFORM_CHANGED: {
+			if (data.is_valid() && proxy_instances.size() == data->get_cluster_count()) {
+				Transform global_xform = get_global_transform();
+				for (int i = 0; i < proxy_instances.size(); i++) {
+					RS::get_singleton()->instance_set_transform(proxy_instances[i].instance, global_xform * data->get_cluster_transform(i));
+				}
+			}
+		} break;
+		case NOTIFICATION_VISIBILITY_CHANGED: {
+			bool visible = is_visible_in_tree();
+			for (int i = 0; i < proxy_instances.size(); i++) {
+				RS::get_singleton()->instance_set_visible(proxy_instances[i].instance, visible);
+			}
+		} break;
+		case NOTIFICATION_EXIT_WORLD: {
+			_clear_proxies();
+		} break;
+	}
+}
+
+void HLOD3D::set_cluster_size(float p_size) {
+	ERR_FAIL_COND(p_size <= 0);
+	cluster_size = p_size;
+}
+
+float HLOD3D::get_cluster_size() const {
+	return cluster_size;
+}
+
+void HLOD3D::set_proxy_distance(float p_distance) {
+	ERR_FAIL_COND(p_distance <= 0);
+	proxy_distance = p_distance;
+	if (is_inside_world()) {
+		_create_proxies();
+	}
+}
+
+float HLOD3D::get_proxy_distance() const {
+	return proxy_distance;
+}
+
+void HLOD3D::set_simplify_ratio(float p_ratio) {
+	simplify_ratio = CLAMP(p_ratio, 0.0f, 1.0f);
+}
+
+float HLOD3D::get_simplify_ratio() const {
+	return simplify_ratio;
+}
+
+void HLOD3D::set_data(const Ref<HLODData> &p_data) {
+	data = p_data;
+	if (is_inside_world()) {
+		_create_proxies();
+	}
+	update_configuration_warnings();
+}
+
+Ref<HLODData> HLOD3D::get_data() const {
+	return data;
+}
+
+TypedArray<String> HLOD3D::get_configuration_warnings() const {
+	TypedArray<String> warnings = Node::get_configuration_warnings();
+
+	if (data.is_null()) {
+		warnings.push_back(TTR("No HLOD proxies have been baked yet. Call bake() and assign the result to the data property."));
+	}
+
+	return warnings;
+}
+
+void HLOD3D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_cluster_size", "size"), &HLOD3D::set_cluster_size);
+	ClassDB::bind_method(D_METHOD("get_cluster_size"), &HLOD3D::get_cluster_size);
+
+	ClassDB::bind_method(D_METHOD("set_proxy_distance", "distance"), &HLOD3D::set_proxy_distance);
+	ClassDB::bind_method(D_METHOD("get_proxy_distance"), &HLOD3D::get_proxy_distance);
+
+	ClassDB::bind_method(D_METHOD("set_simplify_ratio", "ratio"), &HLOD3D::set_simplify_ratio);
+	ClassDB::bind_method(D_METHOD("get_simplify_ratio"), &HLOD3D::get_simplify_ratio);
+
+	ClassDB::bind_method(D_METHOD("set_data", "data"), &HLOD3D::set_data);
+	ClassDB::bind_method(D_METHOD("get_data"), &HLOD3D::get_data);
+
+	ClassDB::bind_method(D_METHOD("bake"), &HLOD3D::bake);
+
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cluster_size", PROPERTY_HINT_RANGE, "1,1024,0.1,or_greater"), "set_cluster_size", "get_cluster_size");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "proxy_distance", PROPERTY_HINT_RANGE, "1,4096,0.1,or_greater"), "set_proxy_distance", "get_proxy_distance");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "simplify_ratio", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_simplify_ratio", "get_simplify_ratio");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "data", PROPERTY_HINT_RESOURCE_TYPE, "HLODData"), "set_data", "get_data");
+}
+
+HLOD3D::HLOD3D() {
+	set_notify_transform(true);
+}
@@ -0,0 +1,130 @@
+/*************************************************************************/
+/*  hlod_3d.h                                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef HLOD_3D_H
+#define HLOD_3D_H
+
+#include "scene/3d/node_3d.h"
+#include "scene/resources/mesh.h"
+
+class MeshInstance3D;
+
+class HLODData : public Resource {
+	GDCLASS(HLODData, Resource);
+	RES_BASE_EXTENSION("hlod");
+
+	struct Cluster {
+		Ref<Mesh> mesh;
+		Transform transform;
+		Array sources;
+	};
+
+	Vector<Cluster> clusters;
+
+	void _set_cluster_data(const Array &p_data);
+	Array _get_cluster_data() const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	void add_cluster(const Ref<Mesh> &p_mesh, const Transform &p_transform, const Array &p_sources);
+	int get_cluster_count() const;
+	Ref<Mesh> get_cluster_mesh(int p_cluster) const;
+	Transform get_cluster_transform(int p_cluster) const;
+	Array get_cluster_sources(int p_cluster) const;
+	void clear();
+};
+
+class HLOD3D : public Node3D {
+	GDCLASS(HLOD3D, Node3D);
+
+	float cluster_size = 64.0;
+	float proxy_distance = 128.0;
+	float simplify_ratio = 0.25;
+	Ref<HLODData> data;
+
+	struct ProxyInstance {
+		RID instance;
+		Vector<ObjectID> sources;
+	};
+
+	Vector<ProxyInstance> proxy_instances;
+
+	struct BakeSurface {
+		Array arrays;
+		Transform xform;
+		Ref<Material> material;
+	};
+
+	struct BakeCluster {
+		AABB aabb;
+		Vector<BakeSurface> surfaces;
+		Array sources;
+
+		// Output, one merged and simplified surface per material.
+		Vector<Array> out_arrays;
+		Vector<Ref<Material>> out_materials;
+	};
+
+	void _find_meshes(Node *p_at_node, Vector<MeshInstance3D *> &r_meshes);
+	Transform _get_transform_to_self(const Node3D *p_node) const;
+	static bool _is_surface_mergeable(const Array &p_arrays);
+	void _bake_cluster(uint32_t p_cluster, BakeCluster *p_clusters);
+	Array _merge_surfaces(const Vector<const BakeSurface *> &p_surfaces, const Vector3 &p_origin) const;
+
+	void _create_proxies();
+	void _clear_proxies();
+
+protected:
+	void _notification(int p_what);
+	static void _bind_methods();
+
+public:
+	void set_cluster_size(float p_size);
+	float get_cluster_size() const;
+
+	void set_proxy_distance(float p_distance);
+	float get_proxy_distance() const;
+
+	void set_simplify_ratio(float p_ratio);
+	float get_simplify_ratio() const;
+
+	void set_data(const Ref<HLODData> &p_data);
+	Ref<HLODData> get_data() const;
+
+	Ref<HLODData> bake();
+
+	TypedArray<String> get_configuration_warnings() const override;
+
+	HLOD3D();
+};
+
+#endif // HLOD_3D_H
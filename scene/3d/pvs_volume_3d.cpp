@@ -0,0 +1,392 @@
+/*************************************************************************/
+/*  pvs_volume_3d.cpp                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "pvs_volume_3d.h"
+
+#include "core/math/random_pcg.h"
+#include "core/templates/thread_work_pool.h"
+#include "mesh_instance_3d.h"
+
+void PVSData::set_bounds(const AABB &p_bounds) {
+	bounds = p_bounds;
+}
+
+AABB PVSData::get_bounds() const {
+	return bounds;
+}
+
+void PVSData::set_cell_count(const Vector3i &p_cell_count) {
+	cell_count = p_cell_count;
+}
+
+Vector3i PVSData::get_cell_count() const {
+	return cell_count;
+}
+
+void PVSData::set_visibility(const Vector<uint8_t> &p_visibility) {
+	visibility = p_visibility;
+}
+
+Vector<uint8_t> PVSData::get_visibility() const {
+	return visibility;
+}
+
+bool PVSData::is_cell_visible_from(int p_from_cell, int p_to_cell) const {
+	int cells = cell_count.x * cell_count.y * cell_count.z;
+	ERR_FAIL_INDEX_V(p_from_cell, cells, false);
+	ERR_FAIL_INDEX_V(p_to_cell, cells, false);
+	int row_size = (cells + 7) / 8;
+	ERR_FAIL_COND_V(visibility.size() != cells * row_size, false);
+	return visibility[p_from_cell * row_size + (p_to_cell >> 3)] & (1 << (p_to_cell & 7));
+}
+
+void PVSData::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_bounds", "bounds"), &PVSData::set_bounds);
+	ClassDB::bind_method(D_METHOD("get_bounds"), &PVSData::get_bounds);
+
+	ClassDB::bind_method(D_METHOD("set_cell_count", "cell_count"), &PVSData::set_cell_count);
+	ClassDB::bind_method(D_METHOD("get_cell_count"), &PVSData::get_cell_count);
+
+	ClassDB::bind_method(D_METHOD("set_visibility", "visibility"), &PVSData::set_visibility);
+	ClassDB::bind_method(D_METHOD("get_visibility"), &PVSData::get_visibility);
+
+	ClassDB::bind_method(D_METHOD("is_cell_visible_from", "from_cell", "to_cell"), &PVSData::is_cell_visible_from);
+
+	ADD_PROPERTY(PropertyInfo(Variant::AABB, "bounds", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL), "set_bounds", "get_bounds");
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR3I, "cell_count", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL), "set_cell_count", "get_cell_count");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_BYTE_ARRAY, "visibility", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL), "set_visibility", "get_visibility");
+}
+
+///////////////////////////////
+
+void PVSVolume3D::_find_meshes(const AABB &p_aabb, Node *p_at_node, List<PlotMesh> &plot_meshes) {
+	MeshInstance3D *mi = Object::cast_to<MeshInstance3D>(p_at_node);
+	if (mi && mi->is_visible_in_tree()) {
+		Ref<Mesh> mesh = mi->get_mesh();
+		if (mesh.is_valid()) {
+			AABB aabb = mesh->get_aabb();
+
+			// The grid is axis aligned in world space, only the volume position is taken into account.
+			Transform xf = Transform(Basis(), get_global_transform().origin).affine_inverse() * mi->get_global_transform();
+
+			if (p_aabb.intersects(xf.xform(aabb))) {
+				PlotMesh pm;
+				pm.local_xform = xf;
+				pm.mesh = mesh;
+				plot_meshes.push_back(pm);
+			}
+		}
+	}
+
+	for (int i = 0; i < p_at_node->get_child_count(); i++) {
+		Node *child = p_at_node->get_child(i);
+		_find_meshes(p_aabb, child, plot_meshes);
+	}
+}
+
+void PVSVolume3D::_bake_cell(uint32_t p_cell, BakeParams *p_params) {
+	const Vector3i &cells = p_params->cell_count;
+	uint32_t total = cells.x * cells.y * cells.z;
+	uint8_t *row = &p_params->sampled[p_cell * p_params->row_size];
+
+	int ax = p_cell % cells.x;
+	int ay = (p_cell / cells.x) % cells.y;
+	int az = p_cell / (cells.x * cells.y);
+	Vector3 a_from = p_params->bounds.position + Vector3(ax, ay, az) * p_params->cell_size;
+
+	Vector3 hit_point, hit_normal;
+
+	// Only the upper half of the matrix is sampled here, _mirror_cell() fills the lower half afterwards.
+	for (uint32_t b = p_cell; b < total; b++) {
+		int bx = b % cells.x;
+		int by = (b / cells.x) % cells.y;
+		int bz = b / (cells.x * cells.y);
+
+		bool visible = false;
+
+		if (ABS(bx - ax) <= 1 && ABS(by - ay) <= 1 && ABS(bz - az) <= 1) {
+			// Neighbors are always visible, so crossing into a cell never pops.
+			visible = true;
+		} else if (!p_params->mesh->is_valid()) {
+			visible = true;
+		} else {
+			Vector3 b_from = p_params->bounds.position + Vector3(bx, by, bz) * p_params->cell_size;
+			RandomPCG rng(uint64_t(p_cell) * total + b);
+			for (int i = 0; i < p_params->rays; i++) {
+				Vector3 from = a_from + Vector3(rng.randf(), rng.randf(), rng.randf()) * p_params->cell_size;
+				Vector3 to = b_from + Vector3(rng.randf(), rng.randf(), rng.randf()) * p_params->cell_size;
+				if (!p_params->mesh->intersect_segment(from, to, hit_point, hit_normal)) {
+					visible = true;
+					break;
+				}
+			}
+		}
+
+		if (visible) {
+			row[b >> 3] |= 1 << (b & 7);
+		}
+	}
+}
+
+void PVSVolume3D::_mirror_cell(uint32_t p_cell, BakeParams *p_params) {
+	// Visibility is symmetric, the lower half of the row is read from the column of the sampled matrix.
+	const uint32_t row_size = p_params->row_size;
+	const uint8_t *sampled = p_params->sampled;
+	uint8_t *row = &p_params->visibility[p_cell * row_size];
+	memcpy(row, &sampled[p_cell * row_size], row_size);
+
+	const uint8_t column_mask = 1 << (p_cell & 7);
+	const uint8_t *column = &sampled[p_cell >> 3];
+	for (uint32_t a = 0; a < p_cell; a++) {
+		if (column[a * row_size] & column_mask) {
+			row[a >> 3] |= 1 << (a & 7);
+		}
+	}
+}
+
+Ref<PVSData> PVSVolume3D::bake() {
+	ERR_FAIL_COND_V(!is_inside_tree(), Ref<PVSData>());
+
+	AABB aabb(-extents, extents * 2);
+
+	Vector3i cells;
+	cells.x = MAX(1, int(Math::ceil(aabb.size.x / cell_size)));
+	cells.y = MAX(1, int(Math::ceil(aabb.size.y / cell_size)));
+	cells.z = MAX(1, int(Math::ceil(aabb.size.z / cell_size)));
+	uint32_t total = cells.x * cells.y * cells.z;
+	ERR_FAIL_COND_V_MSG(total > MAX_CELLS, Ref<PVSData>(), "Too many PVS cells (" + itos(total) + "), increase the cell size or reduce the extents.");
+
+	List<PlotMesh> plot_meshes;
+	_find_meshes(aabb, get_parent(), plot_meshes);
+
+	Vector<Vector3> faces;
+
+	for (List<PlotMesh>::Element *E = plot_meshes.front(); E; E = E->next()) {
+		const PlotMesh &pm = E->get();
+
+		for (int i = 0; i < pm.mesh->get_surface_count(); i++) {
+			if (pm.mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
+				continue; //only triangles
+			}
+
+			Array a = pm.mesh->surface_get_arrays(i);
+
+			Vector<Vector3> vertices = a[Mesh::ARRAY_VERTEX];
+			const Vector3 *vr = vertices.ptr();
+			Vector<int> index = a[Mesh::ARRAY_INDEX];
+
+			int facecount = index.size() ? index.size() / 3 : vertices.size() / 3;
+			const int *ir = index.ptr();
+
+			for (int j = 0; j < facecount; j++) {
+				Vector3 face[3];
+				for (int k = 0; k < 3; k++) {
+					face[k] = pm.local_xform.xform(vr[ir ? ir[j * 3 + k] : j * 3 + k]);
+				}
+
+				if (!Geometry3D::triangle_box_overlap(aabb.position + aabb.size * 0.5, aabb.size * 0.5, face)) {
+					continue;
+				}
+
+				faces.push_back(face[0]);
+				faces.push_back(face[1]);
+				faces.push_back(face[2]);
+			}
+		}
+	}
+
+	Ref<TriangleMesh> tmesh;
+	tmesh.instance();
+	if (faces.size()) {
+		tmesh->create(faces);
+	}
+
+	uint32_t row_size = (total + 7) / 8;
+	Vector<uint8_t> sampled;
+	sampled.resize(total * row_size);
+	memset(sampled.ptrw(), 0, sampled.size());
+	Vector<uint8_t> visibility;
+	visibility.resize(total * row_size);
+
+	BakeParams params;
+	params.mesh = tmesh;
+	params.bounds = aabb;
+	params.cell_count = cells;
+	params.cell_size = aabb.size / Vector3(cells.x, cells.y, cells.z);
+	params.row_size = row_size;
+	params.rays = rays_per_cell;
+	params.sampled = sampled.ptrw();
+	params.visibility = visibility.ptrw();
+
+	ThreadWorkPool work_pool;
+	work_pool.init();
+	work_pool.do_work(total, this, &PVSVolume3D::_bake_cell, &params);
+	// Each row is written by a single task, so the mirroring doesn't need any synchronization.
+	work_pool.do_work(total, this, &PVSVolume3D::_mirror_cell, &params);
+	work_pool.finish();
+
+	Ref<PVSData> pvs;
+	pvs.instance();
+	pvs->set_bounds(aabb);
+	pvs->set_cell_count(cells);
+	pvs->set_visibility(visibility);
+	return pvs;
+}
+
+String PVSVolume3D::_get_scenario_group() const {
+	return "_pvs_volumes_" + itos(get_world_3d()->get_scenario().get_id());
+}
+
+bool PVSVolume3D::_is_scenario_pvs_owner() const {
+	// A scenario has a single PVS grid, it's provided by the first volume in the tree.
+	return get_tree()->get_first_node_in_group(_get_scenario_group()) == this;
+}
+
+void PVSVolume3D::_update_scenario_pvs() {
+	if (!is_inside_world() || !_is_scenario_pvs_owner()) {
+		return;
+	}
+
+	RID scenario = get_world_3d()->get_scenario();
+	if (data.is_valid() && !data->get_visibility().is_empty()) {
+		AABB bounds = data->get_bounds();
+		bounds.position += get_global_transform().origin;
+		RS::get_singleton()->scenario_set_pvs(scenario, bounds, data->get_cell_count(), data->get_visibility());
+	} else {
+		RS::get_singleton()->scenario_set_pvs(scenario, AABB(), Vector3i(), Vector<uint8_t>());
+	}
+}
+
+void PVSVolume3D::_notification(int p_what) {
+	switch (p_what) {
+		case NOTIFICATION_ENTER_WORLD: {
+			add_to_group(_get_scenario_group());
+			_update_scenario_pvs();
+			get_tree()->call_group(_get_scenario_group(), "update_configuration_warnings");
+		} break;
+		case NOTIFICATION_TRANSFORM_CHANGED: {
+			_update_scenario_pvs();
+		} break;
+		case NOTIFICATION_EXIT_WORLD: {
+			String group = _get_scenario_group();
+			bool was_owner = _is_scenario_pvs_owner();
+			remove_from_group(group);
+
+			if (was_owner) {
+				// Let the next volume of the world provide the grid, if any.
+				PVSVolume3D *next = Object::cast_to<PVSVolume3D>(get_tree()->get_first_node_in_group(group));
+				if (next) {
+					next->_update_scenario_pvs();
+				} else {
+					RS::get_singleton()->scenario_set_pvs(get_world_3d()->get_scenario(), AABB(), Vector3i(), Vector<uint8_t>());
+				}
+			}
+			get_tree()->call_group(group, "update_configuration_warnings");
+		} break;
+	}
+}
+
+void PVSVolume3D::set_extents(const Vector3 &p_extents) {
+	extents = p_extents;
+	update_gizmo();
+}
+
+Vector3 PVSVolume3D::get_extents() const {
+	return extents;
+}
+
+void PVSVolume3D::set_cell_size(float p_cell_size) {
+	ERR_FAIL_COND(p_cell_size <= 0);
+	cell_size = p_cell_size;
+}
+
+float PVSVolume3D::get_cell_size() const {
+	return cell_size;
+}
+
+void PVSVolume3D::set_rays_per_cell(int p_rays) {
+	ERR_FAIL_COND(p_rays < 1);
+	rays_per_cell = p_rays;
+}
+
+int PVSVolume3D::get_rays_per_cell() const {
+	return rays_per_cell;
+}
+
+void PVSVolume3D::set_data(const Ref<PVSData> &p_data) {
+	data = p_data;
+	_update_scenario_pvs();
+	update_configuration_warnings();
+}
+
+Ref<PVSData> PVSVolume3D::get_data() const {
+	return data;
+}
+
+TypedArray<String> PVSVolume3D::get_configuration_warnings() const {
+	TypedArray<String> warnings = Node::get_configuration_warnings();
+
+	if (data.is_null()) {
+		warnings.push_back(TTR("No PVS data has been baked yet. Call bake() and assign the result to the data property."));
+	}
+
+	if (is_inside_world() && !_is_scenario_pvs_owner()) {
+		warnings.push_back(TTR("Only the first PVSVolume3D of a world is used, this one will be ignored."));
+	}
+
+	return warnings;
+}
+
+void PVSVolume3D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_extents", "extents"), &PVSVolume3D::set_extents);
+	ClassDB::bind_method(D_METHOD("get_extents"), &PVSVolume3D::get_extents);
+
+	ClassDB::bind_method(D_METHOD("set_cell_size", "cell_size"), &PVSVolume3D::set_cell_size);
+	ClassDB::bind_method(D_METHOD("get_cell_size"), &PVSVolume3D::get_cell_size);
+
+	ClassDB::bind_method(D_METHOD("set_rays_per_cell", "rays"), &PVSVolume3D::set_rays_per_cell);
+	ClassDB::bind_method(D_METHOD("get_rays_per_cell"), &PVSVolume3D::get_rays_per_cell);
+
+	ClassDB::bind_method(D_METHOD("set_data", "data"), &PVSVolume3D::set_data);
+	ClassDB::bind_method(D_METHOD("get_data"), &PVSVolume3D::get_data);
+
+	ClassDB::bind_method(D_METHOD("bake"), &PVSVolume3D::bake);
+
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR3, "extents"), "set_extents", "get_extents");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_size", PROPERTY_HINT_RANGE, "0.25,64,0.01,or_greater"), "set_cell_size", "get_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "rays_per_cell", PROPERTY_HINT_RANGE, "1,256,1"), "set_rays_per_cell", "get_rays_per_cell");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "data", PROPERTY_HINT_RESOURCE_TYPE, "PVSData"), "set_data", "get_data");
+
+	BIND_CONSTANT(MAX_CELLS);
+}
+
+PVSVolume3D::PVSVolume3D() {
+	set_notify_transform(true);
+}
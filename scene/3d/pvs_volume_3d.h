@@ -0,0 +1,125 @@
+/*************************************************************************/
+/*  pvs_volume_3d.h                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef PVS_VOLUME_3D_H
+#define PVS_VOLUME_3D_H
+
+#include "core/math/triangle_mesh.h"
+#include "scene/3d/node_3d.h"
+#include "scene/resources/mesh.h"
+
+class PVSData : public Resource {
+	GDCLASS(PVSData, Resource);
+	RES_BASE_EXTENSION("pvs");
+
+	AABB bounds;
+	Vector3i cell_count;
+	Vector<uint8_t> visibility;
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_bounds(const AABB &p_bounds);
+	AABB get_bounds() const;
+
+	void set_cell_count(const Vector3i &p_cell_count);
+	Vector3i get_cell_count() const;
+
+	void set_visibility(const Vector<uint8_t> &p_visibility);
+	Vector<uint8_t> get_visibility() const;
+
+	bool is_cell_visible_from(int p_from_cell, int p_to_cell) const;
+};
+
+class PVSVolume3D : public Node3D {
+	GDCLASS(PVSVolume3D, Node3D);
+
+public:
+	enum {
+		MAX_CELLS = 8192
+	};
+
+private:
+	Vector3 extents = Vector3(10, 10, 10);
+	float cell_size = 4.0;
+	int rays_per_cell = 16;
+	Ref<PVSData> data;
+
+	struct PlotMesh {
+		Ref<Mesh> mesh;
+		Transform local_xform;
+	};
+
+	void _find_meshes(const AABB &p_aabb, Node *p_at_node, List<PlotMesh> &plot_meshes);
+
+	struct BakeParams {
+		Ref<TriangleMesh> mesh;
+		AABB bounds;
+		Vector3i cell_count;
+		Vector3 cell_size;
+		uint32_t row_size = 0;
+		int rays = 0;
+		uint8_t *sampled = nullptr;
+		uint8_t *visibility = nullptr;
+	};
+
+	void _bake_cell(uint32_t p_cell, BakeParams *p_params);
+	void _mirror_cell(uint32_t p_cell, BakeParams *p_params);
+
+	String _get_scenario_group() const;
+	bool _is_scenario_pvs_owner() const;
+	void _update_scenario_pvs();
+
+protected:
+	void _notification(int p_what);
+	static void _bind_methods();
+
+public:
+	void set_extents(const Vector3 &p_extents);
+	Vector3 get_extents() const;
+
+	void set_cell_size(float p_cell_size);
+	float get_cell_size() const;
+
+	void set_rays_per_cell(int p_rays);
+	int get_rays_per_cell() const;
+
+	void set_data(const Ref<PVSData> &p_data);
+	Ref<PVSData> get_data() const;
+
+	Ref<PVSData> bake();
+
+	TypedArray<String> get_configuration_warnings() const override;
+
+	PVSVolume3D();
+};
+
+#endif // PVS_VOLUME_3D_H
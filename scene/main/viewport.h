@@ -120,6 +120,7 @@ public:
 		RENDER_INFO_SHADER_CHANGES_IN_FRAME,
 		RENDER_INFO_SURFACE_CHANGES_IN_FRAME,
 		RENDER_INFO_DRAW_CALLS_IN_FRAME,
+		RENDER_INFO_DRAW_CALLS_SAVED_IN_FRAME,
 		RENDER_INFO_MAX
 	};
 
@@ -130,7 +130,7 @@ bool ShaderMaterial::_set(const StringName &p_name, const Variant &p_value) {
 			}
 		}
 		if (pr) {
-			RenderingServer::get_singleton()->material_set_param(_get_material(), pr, p_value);
+			set_shader_param(pr, p_value);
 			return true;
 		}
 	}
@@ -219,6 +219,18 @@ Ref<Shader> ShaderMaterial::get_shader() const {
 }
 
 void ShaderMaterial::set_shader_param(const StringName &p_param, const Variant &p_value) {
+	//streamed textures are bound by RID, so keep them from being evicted while set here
+	Ref<StreamTexture2D> *old_stex = streamed_textures.getptr(p_param);
+	if (old_stex) {
+		(*old_stex)->unpin_streaming();
+		streamed_textures.erase(p_param);
+	}
+	Ref<StreamTexture2D> stex = p_value;
+	if (stex.is_valid()) {
+		stex->pin_streaming();
+		streamed_textures[p_param] = stex;
+	}
+
 	RS::get_singleton()->material_set_param(_get_material(), p_param, p_value);
 }
 
@@ -284,6 +296,10 @@ ShaderMaterial::ShaderMaterial() {
 }
 
 ShaderMaterial::~ShaderMaterial() {
+	const StringName *K = nullptr;
+	while ((K = streamed_textures.next(K))) {
+		streamed_textures[*K]->unpin_streaming();
+	}
 }
 
 /////////////////////////////////
@@ -1623,6 +1639,17 @@ bool BaseMaterial3D::get_feature(Feature p_feature) const {
 
 void BaseMaterial3D::set_texture(TextureParam p_param, const Ref<Texture2D> &p_texture) {
 	ERR_FAIL_INDEX(p_param, TEXTURE_MAX);
+
+	//streamed textures are bound by RID, so keep them from being evicted while set here
+	Ref<StreamTexture2D> old_stex = textures[p_param];
+	if (old_stex.is_valid()) {
+		old_stex->unpin_streaming();
+	}
+	Ref<StreamTexture2D> stex = p_texture;
+	if (stex.is_valid()) {
+		stex->pin_streaming();
+	}
+
 	textures[p_param] = p_texture;
 	RID rid = p_texture.is_valid() ? p_texture->get_rid() : RID();
 	RS::get_singleton()->material_set_param(_get_material(), shader_names->texture_names[p_param], rid);
@@ -2734,6 +2761,13 @@ BaseMaterial3D::BaseMaterial3D(bool p_orm) :
 }
 
 BaseMaterial3D::~BaseMaterial3D() {
+	for (int i = 0; i < TEXTURE_MAX; i++) {
+		Ref<StreamTexture2D> stex = textures[i];
+		if (stex.is_valid()) {
+			stex->unpin_streaming();
+		}
+	}
+
 	MutexLock lock(material_mutex);
 
 	if (shader_map.has(current_key)) {
@@ -32,6 +32,7 @@
 #define MATERIAL_H
 
 #include "core/io/resource.h"
+#include "core/templates/hash_map.h"
 #include "core/templates/self_list.h"
 #include "scene/resources/shader.h"
 #include "scene/resources/texture.h"
@@ -78,6 +79,7 @@ public:
 class ShaderMaterial : public Material {
 	GDCLASS(ShaderMaterial, Material);
 	Ref<Shader> shader;
+	HashMap<StringName, Ref<StreamTexture2D>> streamed_textures;
 
 protected:
 	bool _set(const StringName &p_name, const Variant &p_value);
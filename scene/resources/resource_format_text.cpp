@@ -766,6 +766,8 @@ void ResourceLoaderText::get_dependencies(FileAccess *p_f, List<String> *p_depen
 }
 
 Error ResourceLoaderText::rename_dependencies(FileAccess *p_f, const String &p_path, const Map<String, String> &p_map) {
+	// The file position is used below to copy the rest of the file as is.
+	stream.readahead_enabled = false;
 	open(p_f, true);
 	ERR_FAIL_COND_V(error != OK, error);
 	ignore_resource_parsing = true;
@@ -31,10 +31,14 @@
 #include "texture.h"
 
 #include "core/core_string_names.h"
+#include "core/config/project_settings.h"
 #include "core/io/image_loader.h"
 #include "core/os/os.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "mesh.h"
 #include "scene/resources/bit_map.h"
+#include "scene/resources/texture_streaming.h"
 #include "servers/camera/camera_feed.h"
 
 Size2 Texture2D::get_size() const {
@@ -342,7 +346,7 @@ Ref<Image> StreamTexture2D::load_image_from_file(FileAccess *f, int p_size_limit
 		for (uint32_t i = 0; i < mipmaps + 1; i++) {
 			uint32_t size = f->get_32();
 
-			if (p_size_limit > 0 && i < (mipmaps - 1) && (sw > p_size_limit || sh > p_size_limit)) {
+			if (p_size_limit > 0 && i < mipmaps && (sw > p_size_limit || sh > p_size_limit)) {
 				//can't load this due to size limit
 				sw = MAX(sw >> 1, 1);
 				sh = MAX(sh >> 1, 1);
@@ -415,7 +419,8 @@ Ref<Image> StreamTexture2D::load_image_from_file(FileAccess *f, int p_size_limit
 				}
 			}
 
-			image->create(w, h, true, mipmap_images[0]->get_format(), img_data);
+			//the first image read may be a smaller mipmap if the size limit skipped some
+			image->create(mipmap_images[0]->get_width(), mipmap_images[0]->get_height(), true, mipmap_images[0]->get_format(), img_data);
 			return image;
 		}
 
@@ -426,13 +431,14 @@ Ref<Image> StreamTexture2D::load_image_from_file(FileAccess *f, int p_size_limit
 			int tw, th;
 			int ofs = Image::get_image_mipmap_offset_and_dimensions(w, h, format, i, tw, th);
 
-			if (p_size_limit > 0 && i < mipmaps && (p_size_limit > tw || p_size_limit > th)) {
-				if (ofs) {
-					f->seek(f->get_position() + ofs);
-				}
+			if (p_size_limit > 0 && i < mipmaps && (tw > p_size_limit || th > p_size_limit)) {
 				continue; //oops, size limit enforced, go to next
 			}
 
+			if (ofs) {
+				f->seek(f->get_position() + ofs);
+			}
+
 			Vector<uint8_t> data;
 			data.resize(size - ofs);
 
@@ -486,6 +492,221 @@ StreamTexture2D::TextureFormatRequestCallback StreamTexture2D::request_3d_callba
 StreamTexture2D::TextureFormatRoughnessRequestCallback StreamTexture2D::request_roughness_callback = nullptr;
 StreamTexture2D::TextureFormatRequestCallback StreamTexture2D::request_normal_callback = nullptr;
 
+static TextureStreamingBudget streaming_budget;
+static HashMap<ObjectID, String> streaming_paths;
+static Mutex streaming_mutex;
+static Semaphore streaming_semaphore;
+static Thread streaming_thread;
+static SafeFlag streaming_exit;
+
+struct StreamingUpload {
+	ObjectID id;
+	Ref<Image> image;
+	int mipmap = 0;
+};
+
+// Loaded mipmaps waiting for the main thread, see flush_streaming().
+static LocalVector<StreamingUpload> streaming_uploads;
+static int streaming_max_uploads = 4;
+
+Ref<Image> StreamTexture2D::_load_streamed_image(const String &p_path, int p_size_limit) {
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	ERR_FAIL_COND_V_MSG(!f, Ref<Image>(), vformat("Unable to open file: %s.", p_path));
+
+	uint8_t header[4];
+	f->get_buffer(header, 4);
+	if (header[0] != 'G' || header[1] != 'S' || header[2] != 'T' || header[3] != '2') {
+		memdelete(f);
+		ERR_FAIL_V_MSG(Ref<Image>(), "Stream texture file is corrupt (Bad header).");
+	}
+
+	//skip version, custom size, data format, mipmap limit and reserved
+	f->seek(f->get_position() + 8 * 4);
+
+	Ref<Image> image = load_image_from_file(f, p_size_limit);
+	memdelete(f);
+
+	return image;
+}
+
+void StreamTexture2D::_streaming_thread_func(void *p_ud) {
+	while (true) {
+		streaming_semaphore.wait();
+		if (streaming_exit.is_set()) {
+			break;
+		}
+
+		LocalVector<TextureStreamingBudget::Change> changes;
+		streaming_budget.update(changes);
+
+		for (uint32_t i = 0; i < changes.size() && !streaming_exit.is_set(); i++) {
+			const TextureStreamingBudget::Change &change = changes[i];
+
+			String path;
+			{
+				MutexLock lock(streaming_mutex);
+				const String *pathptr = streaming_paths.getptr(ObjectID(change.id));
+				if (!pathptr) {
+					continue; //freed meanwhile
+				}
+				path = *pathptr;
+			}
+
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			Ref<Image> image = _load_streamed_image(path, MAX(change.width, change.height));
+			streaming_budget.record_load(OS::get_singleton()->get_ticks_usec() - begin);
+
+			if (image.is_null()) {
+				continue;
+			}
+
+			//textures can only be replaced from the main thread, only the latest load for each is kept
+			StreamingUpload upload;
+			upload.id = ObjectID(change.id);
+			upload.image = image;
+			upload.mipmap = change.mipmap;
+
+			MutexLock lock(streaming_mutex);
+			bool replaced = false;
+			for (uint32_t j = 0; j < streaming_uploads.size(); j++) {
+				if (streaming_uploads[j].id == upload.id) {
+					streaming_uploads[j] = upload;
+					replaced = true;
+					break;
+				}
+			}
+			if (!replaced) {
+				streaming_uploads.push_back(upload);
+			}
+		}
+	}
+}
+
+void StreamTexture2D::_streaming_register(const String &p_path, const Ref<Image> &p_image, int p_width, int p_height) {
+	MutexLock lock(streaming_mutex);
+
+	if (!streaming_thread.is_started()) {
+		streaming_budget.set_budget(uint64_t(int(GLOBAL_GET("rendering/textures/streaming/memory_budget_mb"))) * 1024 * 1024);
+		streaming_max_uploads = MAX(int(GLOBAL_GET("rendering/textures/streaming/max_uploads_per_frame")), 1);
+		streaming_exit.clear();
+		streaming_thread.start(_streaming_thread_func, nullptr);
+	}
+
+	streaming = true;
+	streaming_width = p_width;
+	streaming_height = p_height;
+	streaming_mipmaps = Image::get_image_required_mipmaps(p_width, p_height, p_image->get_format());
+
+	int resident_mipmap = TextureStreamingBudget::get_mipmap_for_size(p_width, p_height, streaming_mipmaps, MAX(p_image->get_width(), p_image->get_height()));
+	streaming_budget.add(get_instance_id(), p_width, p_height, p_image->get_format(), streaming_mipmaps, resident_mipmap);
+	streaming_budget.set_pinned(get_instance_id(), streaming_pins > 0);
+	streaming_paths[get_instance_id()] = p_path;
+
+	streaming_semaphore.post();
+}
+
+void StreamTexture2D::_streaming_unregister() {
+	MutexLock lock(streaming_mutex);
+
+	streaming = false;
+	streaming_budget.remove(get_instance_id());
+	streaming_paths.erase(get_instance_id());
+
+	for (uint32_t i = 0; i < streaming_uploads.size(); i++) {
+		if (streaming_uploads[i].id == get_instance_id()) {
+			streaming_uploads.remove(i);
+			break;
+		}
+	}
+
+	//the freed memory may let other textures stream in
+	streaming_semaphore.post();
+}
+
+void StreamTexture2D::_streaming_apply(const Ref<Image> &p_image, int p_mipmap) {
+	if (!streaming || streaming_budget.get_resident_mipmap(get_instance_id()) != p_mipmap) {
+		return; //superseded by a later change
+	}
+
+	RID new_texture = RS::get_singleton()->texture_2d_create(p_image);
+	RS::get_singleton()->texture_replace(texture, new_texture);
+	RS::get_singleton()->texture_set_size_override(texture, w, h);
+	alpha_cache.unref();
+}
+
+bool StreamTexture2D::is_streaming() const {
+	return streaming;
+}
+
+void StreamTexture2D::request_streaming_size(int p_size) {
+	ERR_FAIL_COND_MSG(!streaming, "Texture is not being streamed.");
+	streaming_budget.request(get_instance_id(), TextureStreamingBudget::get_mipmap_for_size(streaming_width, streaming_height, streaming_mipmaps, p_size));
+	streaming_semaphore.post();
+}
+
+Size2i StreamTexture2D::get_streaming_resident_size() const {
+	if (!streaming) {
+		return Size2i(w, h);
+	}
+	int mipmap = streaming_budget.get_resident_mipmap(get_instance_id());
+	return Size2i(MAX(streaming_width >> mipmap, 1), MAX(streaming_height >> mipmap, 1));
+}
+
+void StreamTexture2D::pin_streaming() {
+	streaming_pins++;
+	if (streaming_pins == 1 && streaming) {
+		streaming_budget.set_pinned(get_instance_id(), true);
+	}
+}
+
+void StreamTexture2D::unpin_streaming() {
+	ERR_FAIL_COND(streaming_pins == 0);
+	streaming_pins--;
+	if (streaming_pins == 0 && streaming) {
+		streaming_budget.set_pinned(get_instance_id(), false);
+	}
+}
+
+uint64_t StreamTexture2D::get_streaming_memory_used() {
+	return streaming_budget.get_memory_used();
+}
+
+void StreamTexture2D::flush_streaming() {
+	if (!streaming_thread.is_started()) {
+		return;
+	}
+
+	//uploading is done on the main thread, so spread it over frames to avoid hitches
+	LocalVector<StreamingUpload> uploads;
+	{
+		MutexLock lock(streaming_mutex);
+		uint32_t count = MIN(streaming_uploads.size(), uint32_t(streaming_max_uploads));
+		for (uint32_t i = 0; i < count; i++) {
+			uploads.push_back(streaming_uploads[i]);
+		}
+		for (uint32_t i = count; i < streaming_uploads.size(); i++) {
+			streaming_uploads[i - count] = streaming_uploads[i];
+		}
+		streaming_uploads.resize(streaming_uploads.size() - count);
+	}
+
+	for (uint32_t i = 0; i < uploads.size(); i++) {
+		StreamTexture2D *stex = Object::cast_to<StreamTexture2D>(ObjectDB::get_instance(uploads[i].id));
+		if (stex) {
+			stex->_streaming_apply(uploads[i].image, uploads[i].mipmap);
+		}
+	}
+}
+
+void StreamTexture2D::finish_streaming() {
+	if (streaming_thread.is_started()) {
+		streaming_exit.set();
+		streaming_semaphore.post();
+		streaming_thread.wait_to_finish();
+	}
+	streaming_uploads.clear();
+}
+
 Image::Format StreamTexture2D::get_format() const {
 	return format;
 }
@@ -539,6 +760,13 @@ Error StreamTexture2D::_load_data(const String &p_path, int &tw, int &th, int &t
 		p_size_limit = 0;
 	}
 
+	//the stored size, as the image may be loaded from a smaller mipmap
+	uint64_t image_pos = f->get_position();
+	f->get_32(); //data format
+	tw = f->get_16();
+	th = f->get_16();
+	f->seek(image_pos);
+
 	image = load_image_from_file(f, p_size_limit);
 
 	memdelete(f);
@@ -560,26 +788,41 @@ Error StreamTexture2D::load(const String &p_path) {
 	bool request_roughness;
 	int mipmap_limit;
 
-	Error err = _load_data(p_path, lw, lh, lwc, lhc, image, request_3d, request_normal, request_roughness, mipmap_limit);
+	//when streaming, only the mipmaps up to this size are loaded now, the rest follow in the background
+	int size_limit = 0;
+	if (GLOBAL_GET("rendering/textures/streaming/enabled")) {
+		size_limit = GLOBAL_GET("rendering/textures/streaming/initial_size");
+	}
+
+	Error err = _load_data(p_path, lw, lh, lwc, lhc, image, request_3d, request_normal, request_roughness, mipmap_limit, size_limit);
 	if (err) {
 		return err;
 	}
 
+	if (streaming) {
+		_streaming_unregister();
+	}
+
 	if (texture.is_valid()) {
 		RID new_texture = RS::get_singleton()->texture_2d_create(image);
 		RS::get_singleton()->texture_replace(texture, new_texture);
 	} else {
 		texture = RS::get_singleton()->texture_2d_create(image);
 	}
-	if (lwc || lhc) {
-		RS::get_singleton()->texture_set_size_override(texture, lwc, lhc);
-	}
 
 	w = lwc ? lwc : lw;
 	h = lhc ? lhc : lh;
 	path_to_file = p_path;
 	format = image->get_format();
 
+	bool streamed = image->has_mipmaps() && (image->get_width() < lw || image->get_height() < lh);
+	if (lwc || lhc || streamed) {
+		RS::get_singleton()->texture_set_size_override(texture, w, h);
+	}
+	if (streamed) {
+		_streaming_register(p_path, image, lw, lh);
+	}
+
 	if (get_path() == String()) {
 		//temporarily set path if no path set for resource, helps find errors
 		RenderingServer::get_singleton()->texture_set_path(texture, p_path);
@@ -640,6 +883,9 @@ void StreamTexture2D::draw(RID p_canvas_item, const Point2 &p_pos, const Color &
 	if ((w | h) == 0) {
 		return;
 	}
+	if (streaming) {
+		streaming_budget.touch(get_instance_id());
+	}
 	RenderingServer::get_singleton()->canvas_item_add_texture_rect(p_canvas_item, Rect2(p_pos, Size2(w, h)), texture, false, p_modulate, p_transpose);
 }
 
@@ -647,6 +893,9 @@ void StreamTexture2D::draw_rect(RID p_canvas_item, const Rect2 &p_rect, bool p_t
 	if ((w | h) == 0) {
 		return;
 	}
+	if (streaming) {
+		streaming_budget.touch(get_instance_id());
+	}
 	RenderingServer::get_singleton()->canvas_item_add_texture_rect(p_canvas_item, p_rect, texture, p_tile, p_modulate, p_transpose);
 }
 
@@ -654,6 +903,9 @@ void StreamTexture2D::draw_rect_region(RID p_canvas_item, const Rect2 &p_rect, c
 	if ((w | h) == 0) {
 		return;
 	}
+	if (streaming) {
+		streaming_budget.touch(get_instance_id());
+	}
 	RenderingServer::get_singleton()->canvas_item_add_texture_rect_region(p_canvas_item, p_rect, texture, p_src_rect, p_modulate, p_transpose, p_clip_uv);
 }
 
@@ -724,6 +976,9 @@ void StreamTexture2D::_validate_property(PropertyInfo &property) const {
 void StreamTexture2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load", "path"), &StreamTexture2D::load);
 	ClassDB::bind_method(D_METHOD("get_load_path"), &StreamTexture2D::get_load_path);
+	ClassDB::bind_method(D_METHOD("is_streaming"), &StreamTexture2D::is_streaming);
+	ClassDB::bind_method(D_METHOD("request_streaming_size", "size"), &StreamTexture2D::request_streaming_size);
+	ClassDB::bind_method(D_METHOD("get_streaming_resident_size"), &StreamTexture2D::get_streaming_resident_size);
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "load_path", PROPERTY_HINT_FILE, "*.stex"), "load", "get_load_path");
 }
@@ -731,6 +986,9 @@ void StreamTexture2D::_bind_methods() {
 StreamTexture2D::StreamTexture2D() {}
 
 StreamTexture2D::~StreamTexture2D() {
+	if (streaming) {
+		_streaming_unregister();
+	}
 	if (texture.is_valid()) {
 		RS::get_singleton()->free(texture);
 	}
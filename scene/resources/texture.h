@@ -165,9 +165,20 @@ private:
 	int w = 0;
 	int h = 0;
 	mutable Ref<BitMap> alpha_cache;
+	bool streaming = false;
+	int streaming_width = 0;
+	int streaming_height = 0;
+	int streaming_mipmaps = 0;
+	int streaming_pins = 0;
 
 	virtual void reload_from_file() override;
 
+	static void _streaming_thread_func(void *p_ud);
+	static Ref<Image> _load_streamed_image(const String &p_path, int p_size_limit);
+	void _streaming_register(const String &p_path, const Ref<Image> &p_image, int p_width, int p_height);
+	void _streaming_unregister();
+	void _streaming_apply(const Ref<Image> &p_image, int p_mipmap);
+
 	static void _requested_3d(void *p_ud);
 	static void _requested_roughness(void *p_ud, const String &p_normal_path, RS::TextureDetectRoughnessChannel p_roughness_channel);
 	static void _requested_normal(void *p_ud);
@@ -205,6 +216,19 @@ public:
 
 	virtual Ref<Image> get_image() const override;
 
+	bool is_streaming() const;
+	void request_streaming_size(int p_size);
+	Size2i get_streaming_resident_size() const;
+
+	// Used by holders that bind the texture by RID, so its draws can't be recorded.
+	// Pinned textures are never evicted to make room for others.
+	void pin_streaming();
+	void unpin_streaming();
+
+	static uint64_t get_streaming_memory_used();
+	static void flush_streaming();
+	static void finish_streaming();
+
 	StreamTexture2D();
 	~StreamTexture2D();
 };
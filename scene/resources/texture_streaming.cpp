@@ -0,0 +1,244 @@
+/*************************************************************************/
+/*  texture_streaming.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "texture_streaming.h"
+
+uint64_t TextureStreamingBudget::_get_mipmap_size(const Entry &p_entry, int p_mipmap) {
+	// Size of the given mipmap and all the smaller ones after it.
+	int total = Image::get_image_data_size(p_entry.width, p_entry.height, p_entry.format, p_entry.mipmaps > 0);
+	return total - Image::get_image_mipmap_offset(p_entry.width, p_entry.height, p_entry.format, MIN(p_mipmap, p_entry.mipmaps));
+}
+
+void TextureStreamingBudget::_set_resident(uint64_t p_id, Entry &p_entry, int p_mipmap, LocalVector<Change> &r_changes) {
+	used -= _get_mipmap_size(p_entry, p_entry.resident_mipmap);
+	used += _get_mipmap_size(p_entry, p_mipmap);
+	p_entry.resident_mipmap = p_mipmap;
+
+	Change change;
+	change.id = p_id;
+	change.mipmap = p_mipmap;
+	change.width = MAX(p_entry.width >> p_mipmap, 1);
+	change.height = MAX(p_entry.height >> p_mipmap, 1);
+
+	// Only the last change for a texture needs loading.
+	for (uint32_t i = 0; i < r_changes.size(); i++) {
+		if (r_changes[i].id == p_id) {
+			r_changes[i] = change;
+			return;
+		}
+	}
+	r_changes.push_back(change);
+}
+
+void TextureStreamingBudget::_evict(uint64_t p_needed, uint64_t p_id, LocalVector<Change> &r_changes) {
+	const Entry &requester = entries[p_id];
+
+	// First drop the mipmaps that are resident but no longer requested.
+	const uint64_t *K = nullptr;
+	while ((K = entries.next(K)) && used + p_needed > budget) {
+		Entry &e = entries[*K];
+		if (*K != p_id && e.resident_mipmap < e.requested_mipmap) {
+			_set_resident(*K, e, e.requested_mipmap, r_changes);
+		}
+	}
+
+	if (used + p_needed <= budget) {
+		return;
+	}
+
+	// Then send textures used less recently than the requester back to their lowest mipmap.
+	LocalVector<UseSort> lru;
+	K = nullptr;
+	while ((K = entries.next(K))) {
+		const Entry &e = entries[*K];
+		if (*K != p_id && _get_last_used(e) < _get_last_used(requester) && e.resident_mipmap < e.lowest_mipmap) {
+			UseSort us;
+			us.id = *K;
+			us.last_used = e.last_used;
+			lru.push_back(us);
+		}
+	}
+	lru.sort();
+
+	for (uint32_t i = 0; i < lru.size() && used + p_needed > budget; i++) {
+		Entry &e = entries[lru[i].id];
+		_set_resident(lru[i].id, e, e.lowest_mipmap, r_changes);
+	}
+}
+
+int TextureStreamingBudget::get_mipmap_for_size(int p_width, int p_height, int p_mipmaps, int p_size) {
+	if (p_size <= 0) {
+		return 0;
+	}
+
+	for (int i = 0; i < p_mipmaps; i++) {
+		if (MAX(p_width >> i, 1) <= p_size && MAX(p_height >> i, 1) <= p_size) {
+			return i;
+		}
+	}
+	return p_mipmaps;
+}
+
+void TextureStreamingBudget::set_budget(uint64_t p_bytes) {
+	MutexLock lock(mutex);
+	budget = p_bytes;
+}
+
+uint64_t TextureStreamingBudget::get_budget() const {
+	MutexLock lock(mutex);
+	return budget;
+}
+
+uint64_t TextureStreamingBudget::get_memory_used() const {
+	MutexLock lock(mutex);
+	return used;
+}
+
+void TextureStreamingBudget::add(uint64_t p_id, int p_width, int p_height, Image::Format p_format, int p_mipmaps, int p_resident_mipmap) {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND(entries.has(p_id));
+	ERR_FAIL_INDEX(p_resident_mipmap, p_mipmaps + 1);
+
+	Entry e;
+	e.width = p_width;
+	e.height = p_height;
+	e.format = p_format;
+	e.mipmaps = p_mipmaps;
+	e.lowest_mipmap = p_resident_mipmap;
+	e.resident_mipmap = p_resident_mipmap;
+	e.requested_mipmap = 0;
+	e.last_used = ++use_tick;
+
+	used += _get_mipmap_size(e, e.resident_mipmap);
+	entries[p_id] = e;
+}
+
+void TextureStreamingBudget::remove(uint64_t p_id) {
+	MutexLock lock(mutex);
+	Entry *e = entries.getptr(p_id);
+	ERR_FAIL_COND(!e);
+
+	used -= _get_mipmap_size(*e, e->resident_mipmap);
+	entries.erase(p_id);
+}
+
+bool TextureStreamingBudget::has(uint64_t p_id) const {
+	MutexLock lock(mutex);
+	return entries.has(p_id);
+}
+
+void TextureStreamingBudget::request(uint64_t p_id, int p_mipmap) {
+	MutexLock lock(mutex);
+	Entry *e = entries.getptr(p_id);
+	ERR_FAIL_COND(!e);
+
+	e->requested_mipmap = CLAMP(p_mipmap, 0, e->lowest_mipmap);
+	e->last_used = ++use_tick;
+}
+
+void TextureStreamingBudget::touch(uint64_t p_id) {
+	MutexLock lock(mutex);
+	Entry *e = entries.getptr(p_id);
+	if (e) {
+		e->last_used = ++use_tick;
+	}
+}
+
+void TextureStreamingBudget::set_pinned(uint64_t p_id, bool p_pinned) {
+	MutexLock lock(mutex);
+	Entry *e = entries.getptr(p_id);
+	if (e) {
+		e->pinned = p_pinned;
+		e->last_used = ++use_tick;
+	}
+}
+
+int TextureStreamingBudget::get_resident_mipmap(uint64_t p_id) const {
+	MutexLock lock(mutex);
+	const Entry *e = entries.getptr(p_id);
+	ERR_FAIL_COND_V(!e, -1);
+	return e->resident_mipmap;
+}
+
+void TextureStreamingBudget::update(LocalVector<Change> &r_changes) {
+	MutexLock lock(mutex);
+
+	// Textures waiting for more detail, most recently used first.
+	LocalVector<UseSort> pending;
+	const uint64_t *K = nullptr;
+	while ((K = entries.next(K))) {
+		const Entry &e = entries[*K];
+		if (e.requested_mipmap < e.resident_mipmap) {
+			UseSort us;
+			us.id = *K;
+			us.last_used = _get_last_used(e);
+			pending.push_back(us);
+		}
+	}
+	pending.sort();
+
+	for (int i = int(pending.size()) - 1; i >= 0; i--) {
+		uint64_t id = pending[i].id;
+		Entry &e = entries[id];
+		if (e.requested_mipmap >= e.resident_mipmap) {
+			continue; // Evicted down to what it asked for meanwhile.
+		}
+
+		uint64_t resident_size = _get_mipmap_size(e, e.resident_mipmap);
+		uint64_t needed = _get_mipmap_size(e, e.requested_mipmap) - resident_size;
+		if (used + needed > budget) {
+			_evict(needed, id, r_changes);
+		}
+
+		// If the requested mipmap still doesn't fit, settle for the largest one that does.
+		for (int mipmap = e.requested_mipmap; mipmap < e.resident_mipmap; mipmap++) {
+			if (used + _get_mipmap_size(e, mipmap) - resident_size <= budget) {
+				_set_resident(id, e, mipmap, r_changes);
+				break;
+			}
+		}
+	}
+}
+
+void TextureStreamingBudget::record_load(uint64_t p_usec) {
+	MutexLock lock(mutex);
+	load_count++;
+	load_time_usec += p_usec;
+}
+
+uint64_t TextureStreamingBudget::get_load_count() const {
+	MutexLock lock(mutex);
+	return load_count;
+}
+
+uint64_t TextureStreamingBudget::get_load_time_usec() const {
+	MutexLock lock(mutex);
+	return load_time_usec;
+}
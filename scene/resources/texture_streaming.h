@@ -0,0 +1,109 @@
+/*************************************************************************/
+/*  texture_streaming.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEXTURE_STREAMING_H
+#define TEXTURE_STREAMING_H
+
+#include "core/io/image.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Decides which mipmaps of streamed textures are kept in memory.
+// Textures register with the mipmap they were loaded at, which always stays resident.
+// Higher mipmaps are granted on request as long as the memory budget allows it,
+// evicting mipmaps nobody asked for and then the least recently used textures first.
+// Pinned textures count as used all the time, for users that can't report when they draw.
+// Pins are set and cleared by the texture, which counts its holders.
+// It only does the bookkeeping, loading the granted mipmaps is up to the caller.
+class TextureStreamingBudget {
+public:
+	struct Change {
+		uint64_t id = 0;
+		int mipmap = 0;
+		int width = 0;
+		int height = 0;
+	};
+
+private:
+	struct Entry {
+		int width = 0;
+		int height = 0;
+		Image::Format format = Image::FORMAT_MAX;
+		int mipmaps = 0;
+		int lowest_mipmap = 0;
+		int resident_mipmap = 0;
+		int requested_mipmap = 0;
+		uint64_t last_used = 0;
+		bool pinned = false;
+	};
+
+	struct UseSort {
+		uint64_t id = 0;
+		uint64_t last_used = 0;
+		bool operator<(const UseSort &p_other) const { return last_used < p_other.last_used; }
+	};
+
+	mutable Mutex mutex;
+	HashMap<uint64_t, Entry> entries;
+	uint64_t budget = 0;
+	uint64_t used = 0;
+	uint64_t use_tick = 0;
+	uint64_t load_count = 0;
+	uint64_t load_time_usec = 0;
+
+	static uint64_t _get_mipmap_size(const Entry &p_entry, int p_mipmap);
+	static uint64_t _get_last_used(const Entry &p_entry) { return p_entry.pinned ? UINT64_MAX : p_entry.last_used; }
+	void _set_resident(uint64_t p_id, Entry &p_entry, int p_mipmap, LocalVector<Change> &r_changes);
+	void _evict(uint64_t p_needed, uint64_t p_id, LocalVector<Change> &r_changes);
+
+public:
+	static int get_mipmap_for_size(int p_width, int p_height, int p_mipmaps, int p_size);
+
+	void set_budget(uint64_t p_bytes);
+	uint64_t get_budget() const;
+	uint64_t get_memory_used() const;
+
+	void add(uint64_t p_id, int p_width, int p_height, Image::Format p_format, int p_mipmaps, int p_resident_mipmap);
+	void remove(uint64_t p_id);
+	bool has(uint64_t p_id) const;
+	void request(uint64_t p_id, int p_mipmap);
+	void touch(uint64_t p_id);
+	void set_pinned(uint64_t p_id, bool p_pinned);
+	int get_resident_mipmap(uint64_t p_id) const;
+
+	void update(LocalVector<Change> &r_changes);
+
+	void record_load(uint64_t p_usec);
+	uint64_t get_load_count() const;
+	uint64_t get_load_time_usec() const;
+};
+
+#endif // TEXTURE_STREAMING_H
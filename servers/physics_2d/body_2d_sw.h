@@ -236,6 +236,21 @@ public:
 	void set_applied_torque(real_t p_torque) { applied_torque = p_torque; }
 	real_t get_applied_torque() const { return applied_torque; }
 
+	// Simulation state that is not derived from the body configuration, used to rewind a space.
+	struct Snapshot {
+		Transform2D transform;
+		Transform2D new_transform;
+		Vector2 linear_velocity;
+		real_t angular_velocity = 0.0;
+		Vector2 applied_force;
+		real_t applied_torque = 0.0;
+		real_t still_time = 0.0;
+		bool active = false;
+	};
+
+	void save_snapshot(Snapshot &r_snapshot) const;
+	void restore_snapshot(const Snapshot &p_snapshot);
+
 	_FORCE_INLINE_ void add_central_force(const Vector2 &p_force) {
 		applied_force += p_force;
 	}
@@ -35,6 +35,10 @@
 #define POSITION_CORRECTION
 #define ACCUMULATE_IMPULSES
 
+// Relative motion between two shapes under which the previous collision result is kept.
+#define NARROWPHASE_CACHE_MAX_TRANSLATION 0.01
+#define NARROWPHASE_CACHE_MAX_ROTATION 0.0001
+
 void BodyPair2DSW::_add_contact(const Vector2 &p_point_A, const Vector2 &p_point_B, void *p_self) {
 	BodyPair2DSW *self = (BodyPair2DSW *)p_self;
 
@@ -211,6 +215,37 @@ bool BodyPair2DSW::_test_ccd(real_t p_step, Body2DSW *p_A, int p_shape_A, const
 	return true;
 }
 
+bool BodyPair2DSW::_is_narrowphase_cached(const Shape2DSW *p_shape_A, const Shape2DSW *p_shape_B, const Transform2D &p_relative_xform) const {
+	if (!narrowphase_cache.valid) {
+		return false;
+	}
+
+	if ((narrowphase_cache.shape_A != p_shape_A) || (narrowphase_cache.shape_B != p_shape_B)) {
+		return false;
+	}
+
+	if ((narrowphase_cache.version_A != p_shape_A->get_version()) || (narrowphase_cache.version_B != p_shape_B->get_version())) {
+		return false;
+	}
+
+	const Transform2D &cached_xform = narrowphase_cache.relative_xform;
+
+	const real_t max_rotation_2 = NARROWPHASE_CACHE_MAX_ROTATION * NARROWPHASE_CACHE_MAX_ROTATION;
+	if ((cached_xform.elements[0] - p_relative_xform.elements[0]).length_squared() > max_rotation_2) {
+		return false;
+	}
+	if ((cached_xform.elements[1] - p_relative_xform.elements[1]).length_squared() > max_rotation_2) {
+		return false;
+	}
+
+	const real_t max_translation_2 = NARROWPHASE_CACHE_MAX_TRANSLATION * NARROWPHASE_CACHE_MAX_TRANSLATION;
+	if ((cached_xform.elements[2] - p_relative_xform.elements[2]).length_squared() > max_translation_2) {
+		return false;
+	}
+
+	return true;
+}
+
 real_t combine_bounce(Body2DSW *A, Body2DSW *B) {
 	return CLAMP(A->get_bounce() + B->get_bounce(), 0, 1);
 }
@@ -223,6 +258,7 @@ bool BodyPair2DSW::setup(real_t p_step) {
 	//cannot collide
 	if (!A->test_collision_mask(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
 		collided = false;
+		narrowphase_cache.valid = false;
 		return false;
 	}
 
@@ -232,12 +268,14 @@ bool BodyPair2DSW::setup(real_t p_step) {
 			report_contacts_only = true;
 		} else {
 			collided = false;
+			narrowphase_cache.valid = false;
 			return false;
 		}
 	}
 
 	if (A->is_shape_set_as_disabled(shape_A) || B->is_shape_set_as_disabled(shape_B)) {
 		collided = false;
+		narrowphase_cache.valid = false;
 		return false;
 	}
 
@@ -268,7 +306,37 @@ bool BodyPair2DSW::setup(real_t p_step) {
 
 	bool prev_collided = collided;
 
-	collided = CollisionSolver2DSW::solve(shape_A_ptr, xform_A, motion_A, shape_B_ptr, xform_B, motion_B, _add_contact, this, &sep_axis);
+	// Continuous collision detection depends on the velocities, so it always needs a new narrowphase.
+	bool use_cache = (A->get_continuous_collision_detection_mode() == PhysicsServer2D::CCD_MODE_DISABLED) && (B->get_continuous_collision_detection_mode() == PhysicsServer2D::CCD_MODE_DISABLED);
+
+	Transform2D relative_xform;
+	if (use_cache) {
+		relative_xform = xform_A.affine_inverse() * xform_B;
+	}
+
+	if (use_cache && _is_narrowphase_cached(shape_A_ptr, shape_B_ptr, relative_xform)) {
+		// Shapes haven't moved enough to change the collision result, keep the current contacts.
+		// Their depth is still updated from the current transforms below.
+		collided = narrowphase_cache.collided;
+		if (collided) {
+			for (int i = 0; i < contact_count; i++) {
+				contacts[i].reused = true;
+			}
+		}
+	} else {
+		collided = CollisionSolver2DSW::solve(shape_A_ptr, xform_A, motion_A, shape_B_ptr, xform_B, motion_B, _add_contact, this, &sep_axis);
+
+		narrowphase_cache.valid = use_cache;
+		if (use_cache) {
+			narrowphase_cache.relative_xform = relative_xform;
+			narrowphase_cache.shape_A = shape_A_ptr;
+			narrowphase_cache.shape_B = shape_B_ptr;
+			narrowphase_cache.version_A = shape_A_ptr->get_version();
+			narrowphase_cache.version_B = shape_B_ptr->get_version();
+			narrowphase_cache.collided = collided;
+		}
+	}
+
 	if (!collided) {
 		//test ccd (currently just a raycast)
 
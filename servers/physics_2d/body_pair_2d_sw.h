@@ -78,6 +78,19 @@ class BodyPair2DSW : public Constraint2DSW {
 	bool oneway_disabled;
 	int cc;
 
+	// Last narrowphase input, its result is reused as long as the shapes barely move relative to each other.
+	struct NarrowphaseCache {
+		bool valid = false;
+		bool collided = false;
+		Transform2D relative_xform;
+		const Shape2DSW *shape_A = nullptr;
+		const Shape2DSW *shape_B = nullptr;
+		uint32_t version_A = 0;
+		uint32_t version_B = 0;
+	} narrowphase_cache;
+
+	_FORCE_INLINE_ bool _is_narrowphase_cached(const Shape2DSW *p_shape_A, const Shape2DSW *p_shape_B, const Transform2D &p_relative_xform) const;
+
 	bool _test_ccd(real_t p_step, Body2DSW *p_A, int p_shape_A, const Transform2D &p_xform_A, Body2DSW *p_B, int p_shape_B, const Transform2D &p_xform_B, bool p_swap_result = false);
 	void _validate_contacts();
 	static void _add_contact(const Vector2 &p_point_A, const Vector2 &p_point_B, void *p_self);
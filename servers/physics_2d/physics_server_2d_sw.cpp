@@ -275,6 +275,22 @@ int PhysicsServer2DSW::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+Vector<uint8_t> PhysicsServer2DSW::space_save_state(RID p_space) const {
+	Space2DSW *space = space_owner.getornull(p_space);
+	ERR_FAIL_COND_V(!space, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG((using_threads && !doing_sync) || space->is_locked(), Vector<uint8_t>(), "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	return space->save_state();
+}
+
+Error PhysicsServer2DSW::space_restore_state(RID p_space, const Vector<uint8_t> &p_state) {
+	Space2DSW *space = space_owner.getornull(p_space);
+	ERR_FAIL_COND_V(!space, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(space->is_locked(), ERR_BUSY, "Space state can't be restored while the space is being stepped.");
+
+	return space->restore_state(p_state);
+}
+
 PhysicsDirectSpaceState2D *PhysicsServer2DSW::space_get_direct_state(RID p_space) {
 	Space2DSW *space = space_owner.getornull(p_space);
 	ERR_FAIL_COND_V(!space, nullptr);
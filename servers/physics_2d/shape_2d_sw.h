@@ -61,6 +61,7 @@ class Shape2DSW {
 	Rect2 aabb;
 	bool configured;
 	real_t custom_bias;
+	uint32_t version;
 
 	Map<ShapeOwner2DSW *, int> owners;
 
@@ -76,6 +77,9 @@ public:
 	_FORCE_INLINE_ Rect2 get_aabb() const { return aabb; }
 	_FORCE_INLINE_ bool is_configured() const { return configured; }
 
+	// Incremented every time the shape data changes.
+	_FORCE_INLINE_ uint32_t get_version() const { return version; }
+
 	virtual bool is_concave() const { return false; }
 
 	virtual bool contains_point(const Vector2 &p_point) const = 0;
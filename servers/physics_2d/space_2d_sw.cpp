@@ -32,6 +32,7 @@
 
 #include "collision_solver_2d_sw.h"
 #include "core/os/os.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "physics_server_2d_sw.h"
 _FORCE_INLINE_ static bool _can_collide_with(CollisionObject2DSW *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
@@ -1306,6 +1307,107 @@ void Space2DSW::update() {
 	broadphase->update();
 }
 
+// Body records are written field by field, so struct padding never ends up in the state buffer.
+#define SPACE_STATE_RECORD_SIZE (sizeof(uint64_t) + 2 * sizeof(Transform2D) + 2 * sizeof(Vector2) + 3 * sizeof(real_t) + 1)
+
+template <class T>
+static _FORCE_INLINE_ void _space_state_put(uint8_t *&r_ptr, const T &p_value) {
+	memcpy(r_ptr, &p_value, sizeof(T));
+	r_ptr += sizeof(T);
+}
+
+template <class T>
+static _FORCE_INLINE_ void _space_state_get(const uint8_t *&r_ptr, T &r_value) {
+	memcpy(&r_value, r_ptr, sizeof(T));
+	r_ptr += sizeof(T);
+}
+
+Vector<uint8_t> Space2DSW::save_state() const {
+	uint32_t body_count = 0;
+	for (const Set<CollisionObject2DSW *>::Element *E = objects.front(); E; E = E->next()) {
+		if (E->get()->get_type() == CollisionObject2DSW::TYPE_BODY) {
+			body_count++;
+		}
+	}
+
+	Vector<uint8_t> state;
+	state.resize(sizeof(uint32_t) + body_count * SPACE_STATE_RECORD_SIZE);
+	uint8_t *w = state.ptrw();
+	_space_state_put(w, body_count);
+
+	for (const Set<CollisionObject2DSW *>::Element *E = objects.front(); E; E = E->next()) {
+		if (E->get()->get_type() != CollisionObject2DSW::TYPE_BODY) {
+			continue;
+		}
+
+		const Body2DSW *body = static_cast<const Body2DSW *>(E->get());
+		Body2DSW::Snapshot snapshot;
+		body->save_snapshot(snapshot);
+
+		_space_state_put(w, body->get_self().get_id());
+		_space_state_put(w, snapshot.transform);
+		_space_state_put(w, snapshot.new_transform);
+		_space_state_put(w, snapshot.linear_velocity);
+		_space_state_put(w, snapshot.angular_velocity);
+		_space_state_put(w, snapshot.applied_force);
+		_space_state_put(w, snapshot.applied_torque);
+		_space_state_put(w, snapshot.still_time);
+		_space_state_put(w, uint8_t(snapshot.active ? 1 : 0));
+	}
+
+	return state;
+}
+
+Error Space2DSW::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_V(p_state.size() < (int)sizeof(uint32_t), ERR_INVALID_DATA);
+
+	const uint8_t *r = p_state.ptr();
+	uint32_t body_count = 0;
+	_space_state_get(r, body_count);
+	ERR_FAIL_COND_V_MSG(p_state.size() != int(sizeof(uint32_t) + body_count * SPACE_STATE_RECORD_SIZE), ERR_INVALID_DATA, "Space state size mismatch, it may have been saved by a different build.");
+
+	// Records follow the object order of the space, so the body set can be validated in a single pass
+	// before anything is modified.
+	LocalVector<Body2DSW *> bodies;
+	bodies.reserve(body_count);
+	const uint8_t *record = r;
+	for (Set<CollisionObject2DSW *>::Element *E = objects.front(); E; E = E->next()) {
+		if (E->get()->get_type() != CollisionObject2DSW::TYPE_BODY) {
+			continue;
+		}
+
+		Body2DSW *body = static_cast<Body2DSW *>(E->get());
+		ERR_FAIL_COND_V_MSG(bodies.size() == body_count, ERR_INVALID_DATA, "Space state doesn't match the bodies currently in the space.");
+		uint64_t id = 0;
+		memcpy(&id, record, sizeof(uint64_t));
+		ERR_FAIL_COND_V_MSG(id != body->get_self().get_id(), ERR_INVALID_DATA, "Space state doesn't match the bodies currently in the space.");
+		bodies.push_back(body);
+		record += SPACE_STATE_RECORD_SIZE;
+	}
+	ERR_FAIL_COND_V_MSG(bodies.size() != body_count, ERR_INVALID_DATA, "Space state doesn't match the bodies currently in the space.");
+
+	for (uint32_t i = 0; i < body_count; i++) {
+		Body2DSW::Snapshot snapshot;
+		uint64_t id = 0;
+		uint8_t active = 0;
+
+		_space_state_get(r, id);
+		_space_state_get(r, snapshot.transform);
+		_space_state_get(r, snapshot.new_transform);
+		_space_state_get(r, snapshot.linear_velocity);
+		_space_state_get(r, snapshot.angular_velocity);
+		_space_state_get(r, snapshot.applied_force);
+		_space_state_get(r, snapshot.applied_torque);
+		_space_state_get(r, snapshot.still_time);
+		_space_state_get(r, active);
+		snapshot.active = active != 0;
+
+		bodies[i]->restore_snapshot(snapshot);
+	}
+
+	return OK;
+}
+
 void Space2DSW::set_param(PhysicsServer2D::SpaceParameter p_param, real_t p_value) {
 	switch (p_param) {
 		case PhysicsServer2D::SPACE_PARAM_CONTACT_RECYCLE_RADIUS:
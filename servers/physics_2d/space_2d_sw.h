@@ -156,6 +156,9 @@ public:
 	void remove_object(CollisionObject2DSW *p_object);
 	const Set<CollisionObject2DSW *> &get_objects() const;
 
+	Vector<uint8_t> save_state() const;
+	Error restore_state(const Vector<uint8_t> &p_state);
+
 	_FORCE_INLINE_ real_t get_contact_recycle_radius() const { return contact_recycle_radius; }
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
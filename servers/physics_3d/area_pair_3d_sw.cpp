@@ -64,7 +64,8 @@ bool AreaPair3DSW::setup(real_t p_step) {
 	return false; //never do any post solving
 }
 
-void AreaPair3DSW::solve(real_t p_step) {
+bool AreaPair3DSW::solve(real_t p_step) {
+	return false;
 }
 
 AreaPair3DSW::AreaPair3DSW(Body3DSW *p_body, int p_body_shape, Area3DSW *p_area, int p_area_shape) {
@@ -129,7 +130,8 @@ bool Area2Pair3DSW::setup(real_t p_step) {
 	return false; //never do any post solving
 }
 
-void Area2Pair3DSW::solve(real_t p_step) {
+bool Area2Pair3DSW::solve(real_t p_step) {
+	return false;
 }
 
 Area2Pair3DSW::Area2Pair3DSW(Area3DSW *p_area_a, int p_shape_a, Area3DSW *p_area_b, int p_shape_b) {
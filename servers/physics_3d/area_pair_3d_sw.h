@@ -44,7 +44,7 @@ class AreaPair3DSW : public Constraint3DSW {
 
 public:
 	bool setup(real_t p_step);
-	void solve(real_t p_step);
+	bool solve(real_t p_step);
 
 	AreaPair3DSW(Body3DSW *p_body, int p_body_shape, Area3DSW *p_area, int p_area_shape);
 	~AreaPair3DSW();
@@ -59,7 +59,7 @@ class Area2Pair3DSW : public Constraint3DSW {
 
 public:
 	bool setup(real_t p_step);
-	void solve(real_t p_step);
+	bool solve(real_t p_step);
 
 	Area2Pair3DSW(Area3DSW *p_area_a, int p_shape_a, Area3DSW *p_area_b, int p_shape_b);
 	~Area2Pair3DSW();
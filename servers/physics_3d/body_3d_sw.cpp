@@ -372,6 +372,42 @@ Variant Body3DSW::get_state(PhysicsServer3D::BodyState p_state) const {
 	return Variant();
 }
 
+void Body3DSW::save_snapshot(Snapshot &r_snapshot) const {
+	r_snapshot.transform = get_transform();
+	r_snapshot.new_transform = new_transform;
+	r_snapshot.linear_velocity = linear_velocity;
+	r_snapshot.angular_velocity = angular_velocity;
+	r_snapshot.applied_force = applied_force;
+	r_snapshot.applied_torque = applied_torque;
+	r_snapshot.still_time = still_time;
+	r_snapshot.active = active;
+}
+
+void Body3DSW::restore_snapshot(const Snapshot &p_snapshot) {
+	// Same as setting the transform state, but without orthonormalizing or waking up neighbours.
+	_set_transform(p_snapshot.transform);
+	if (mode == PhysicsServer3D::BODY_MODE_STATIC || mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
+		_set_inv_transform(get_transform().affine_inverse());
+	} else {
+		_set_inv_transform(get_transform().inverse());
+	}
+	_update_transform_dependant();
+	new_transform = p_snapshot.new_transform;
+	first_time_kinematic = false;
+
+	linear_velocity = p_snapshot.linear_velocity;
+	angular_velocity = p_snapshot.angular_velocity;
+	applied_force = p_snapshot.applied_force;
+	applied_torque = p_snapshot.applied_torque;
+	still_time = p_snapshot.still_time;
+	set_active(p_snapshot.active);
+
+	// Sleeping bodies are not integrated, so they need to be queued here to report the restored state.
+	if (fi_callback && get_space() && !direct_state_query_list.in_list()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+}
+
 void Body3DSW::set_space(Space3DSW *p_space) {
 	if (get_space()) {
 		if (inertia_update_list.in_list()) {
@@ -568,7 +604,7 @@ void Body3DSW::integrate_velocities(real_t p_step) {
 		return;
 	}
 
-	if (fi_callback) {
+	if (fi_callback && !direct_state_query_list.in_list()) {
 		get_space()->body_add_to_state_query_list(&direct_state_query_list);
 	}
 
@@ -218,8 +218,11 @@ bool BodyPair3DSW::setup(real_t p_step) {
 		return false;
 	}
 
+	dynamic_A = (A->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC);
+	dynamic_B = (B->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC);
+
 	bool report_contacts_only = false;
-	if ((A->get_mode() <= PhysicsServer3D::BODY_MODE_KINEMATIC) && (B->get_mode() <= PhysicsServer3D::BODY_MODE_KINEMATIC)) {
+	if (!dynamic_A && !dynamic_B) {
 		if ((A->get_max_contacts_reported() > 0) || (B->get_max_contacts_reported() > 0)) {
 			report_contacts_only = true;
 		} else {
@@ -356,11 +359,15 @@ bool BodyPair3DSW::setup(real_t p_step) {
 	return do_process;
 }
 
-void BodyPair3DSW::solve(real_t p_step) {
+bool BodyPair3DSW::solve(real_t p_step) {
 	if (!collided) {
-		return;
+		return false;
 	}
 
+	const real_t friction = combine_friction(A, B);
+
+	bool do_process = false;
+
 	for (int i = 0; i < contact_count; i++) {
 		Contact &c = contacts[i];
 		if (!c.active) {
@@ -384,8 +391,12 @@ void BodyPair3DSW::solve(real_t p_step) {
 
 			Vector3 jb = c.normal * (c.acc_bias_impulse - jbnOld);
 
-			A->apply_bias_impulse(-jb, c.rA + A->get_center_of_mass(), MAX_BIAS_ROTATION / p_step);
-			B->apply_bias_impulse(jb, c.rB + B->get_center_of_mass(), MAX_BIAS_ROTATION / p_step);
+			if (dynamic_A) {
+				A->apply_bias_impulse(-jb, c.rA + A->get_center_of_mass(), MAX_BIAS_ROTATION / p_step);
+			}
+			if (dynamic_B) {
+				B->apply_bias_impulse(jb, c.rB + B->get_center_of_mass(), MAX_BIAS_ROTATION / p_step);
+			}
 
 			crbA = A->get_biased_angular_velocity().cross(c.rA);
 			crbB = B->get_biased_angular_velocity().cross(c.rB);
@@ -400,11 +411,16 @@ void BodyPair3DSW::solve(real_t p_step) {
 
 				Vector3 jb_com = c.normal * (c.acc_bias_impulse_center_of_mass - jbnOld_com);
 
-				A->apply_bias_impulse(-jb_com, A->get_center_of_mass(), 0.0f);
-				B->apply_bias_impulse(jb_com, B->get_center_of_mass(), 0.0f);
+				if (dynamic_A) {
+					A->apply_bias_impulse(-jb_com, A->get_center_of_mass(), 0.0f);
+				}
+				if (dynamic_B) {
+					B->apply_bias_impulse(jb_com, B->get_center_of_mass(), 0.0f);
+				}
 			}
 
 			c.active = true;
+			do_process = true;
 		}
 
 		Vector3 crA = A->get_angular_velocity().cross(c.rA);
@@ -421,16 +437,19 @@ void BodyPair3DSW::solve(real_t p_step) {
 
 			Vector3 j = c.normal * (c.acc_normal_impulse - jnOld);
 
-			A->apply_impulse(-j, c.rA + A->get_center_of_mass());
-			B->apply_impulse(j, c.rB + B->get_center_of_mass());
+			if (dynamic_A) {
+				A->apply_impulse(-j, c.rA + A->get_center_of_mass());
+			}
+			if (dynamic_B) {
+				B->apply_impulse(j, c.rB + B->get_center_of_mass());
+			}
 
 			c.active = true;
+			do_process = true;
 		}
 
 		//friction impulse
 
-		real_t friction = combine_friction(A, B);
-
 		Vector3 lvA = A->get_linear_velocity() + A->get_angular_velocity().cross(c.rA);
 		Vector3 lvB = B->get_linear_velocity() + B->get_angular_velocity().cross(c.rB);
 
@@ -464,12 +483,19 @@ void BodyPair3DSW::solve(real_t p_step) {
 
 			jt = c.acc_tangent_impulse - jtOld;
 
-			A->apply_impulse(-jt, c.rA + A->get_center_of_mass());
-			B->apply_impulse(jt, c.rB + B->get_center_of_mass());
+			if (dynamic_A) {
+				A->apply_impulse(-jt, c.rA + A->get_center_of_mass());
+			}
+			if (dynamic_B) {
+				B->apply_impulse(jt, c.rB + B->get_center_of_mass());
+			}
 
 			c.active = true;
+			do_process = true;
 		}
 	}
+
+	return do_process;
 }
 
 BodyPair3DSW::BodyPair3DSW(Body3DSW *p_A, int p_shape_A, Body3DSW *p_B, int p_shape_B) :
@@ -670,11 +696,13 @@ bool BodySoftBodyPair3DSW::setup(real_t p_step) {
 	return do_process;
 }
 
-void BodySoftBodyPair3DSW::solve(real_t p_step) {
+bool BodySoftBodyPair3DSW::solve(real_t p_step) {
 	if (!collided) {
-		return;
+		return false;
 	}
 
+	bool do_process = false;
+
 	uint32_t contact_count = contacts.size();
 	for (uint32_t contact_index = 0; contact_index < contact_count; ++contact_index) {
 		Contact &c = contacts[contact_index];
@@ -717,6 +745,7 @@ void BodySoftBodyPair3DSW::solve(real_t p_step) {
 			}
 
 			c.active = true;
+			do_process = true;
 		}
 
 		Vector3 crA = body->get_angular_velocity().cross(c.rA);
@@ -736,6 +765,7 @@ void BodySoftBodyPair3DSW::solve(real_t p_step) {
 			soft_body->apply_node_impulse(c.index_B, j);
 
 			c.active = true;
+			do_process = true;
 		}
 
 		// Friction impulse.
@@ -777,8 +807,11 @@ void BodySoftBodyPair3DSW::solve(real_t p_step) {
 			soft_body->apply_node_impulse(c.index_B, jt);
 
 			c.active = true;
+			do_process = true;
 		}
 	}
+
+	return do_process;
 }
 
 BodySoftBodyPair3DSW::BodySoftBodyPair3DSW(Body3DSW *p_A, int p_shape_A, SoftBody3DSW *p_B) {
@@ -36,6 +36,9 @@
 #include "core/templates/local_vector.h"
 #include "soft_body_3d_sw.h"
 
+real_t combine_bounce(Body3DSW *A, Body3DSW *B);
+real_t combine_friction(Body3DSW *A, Body3DSW *B);
+
 class BodyContact3DSW : public Constraint3DSW {
 protected:
 	struct Contact {
@@ -67,6 +70,8 @@ protected:
 };
 
 class BodyPair3DSW : public BodyContact3DSW {
+	friend class ContactSolver3DSW;
+
 	enum {
 		MAX_CONTACTS = 4
 	};
@@ -83,6 +88,9 @@ class BodyPair3DSW : public BodyContact3DSW {
 	int shape_A;
 	int shape_B;
 
+	bool dynamic_A = false;
+	bool dynamic_B = false;
+
 	Vector3 offset_B; //use local A coordinates to avoid numerical issues on collision detection
 
 	Contact contacts[MAX_CONTACTS];
@@ -97,7 +105,9 @@ class BodyPair3DSW : public BodyContact3DSW {
 
 public:
 	bool setup(real_t p_step);
-	void solve(real_t p_step);
+	bool solve(real_t p_step);
+
+	virtual BodyPair3DSW *get_body_pair() { return this; }
 
 	BodyPair3DSW(Body3DSW *p_A, int p_shape_A, Body3DSW *p_B, int p_shape_B);
 	~BodyPair3DSW();
@@ -119,7 +129,9 @@ class BodySoftBodyPair3DSW : public BodyContact3DSW {
 
 public:
 	bool setup(real_t p_step);
-	void solve(real_t p_step);
+	bool solve(real_t p_step);
+
+	virtual int get_soft_body_count() const { return 1; }
 
 	BodySoftBodyPair3DSW(Body3DSW *p_A, int p_shape_A, SoftBody3DSW *p_B);
 	~BodySoftBodyPair3DSW();
@@ -33,6 +33,8 @@
 
 #include "body_3d_sw.h"
 
+class BodyPair3DSW;
+
 class Constraint3DSW {
 	Body3DSW **_body_ptr;
 	int _body_count;
@@ -61,6 +63,9 @@ public:
 	_FORCE_INLINE_ Body3DSW **get_body_ptr() const { return _body_ptr; }
 	_FORCE_INLINE_ int get_body_count() const { return _body_count; }
 
+	virtual int get_soft_body_count() const { return 0; }
+	virtual BodyPair3DSW *get_body_pair() { return nullptr; }
+
 	_FORCE_INLINE_ void set_priority(int p_priority) { priority = p_priority; }
 	_FORCE_INLINE_ int get_priority() const { return priority; }
 
@@ -68,7 +73,8 @@ public:
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
 	virtual bool setup(real_t p_step) = 0;
-	virtual void solve(real_t p_step) = 0;
+	// Returns false once the constraint has nothing left to solve during the current step.
+	virtual bool solve(real_t p_step) = 0;
 
 	virtual ~Constraint3DSW() {}
 };
@@ -0,0 +1,616 @@
+/*************************************************************************/
+/*  contact_solver_3d_sw.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "contact_solver_3d_sw.h"
+
+// Same thresholds as BodyPair3DSW::solve().
+#define MIN_VELOCITY 0.0001
+#define MAX_BIAS_ROTATION (Math_PI / 8)
+
+#if defined(__SSE2__) && !defined(REAL_T_IS_DOUBLE)
+#define CONTACT_SOLVER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// One value per contact of a batch.
+#ifdef CONTACT_SOLVER_SSE2
+
+struct SolverMask {
+	__m128 v;
+
+	_FORCE_INLINE_ SolverMask(__m128 p_v) :
+			v(p_v) {}
+
+	_FORCE_INLINE_ SolverMask operator&(const SolverMask &p_m) const { return _mm_and_ps(v, p_m.v); }
+	_FORCE_INLINE_ SolverMask operator|(const SolverMask &p_m) const { return _mm_or_ps(v, p_m.v); }
+	_FORCE_INLINE_ bool any() const { return _mm_movemask_ps(v) != 0; }
+	_FORCE_INLINE_ static SolverMask none() { return _mm_setzero_ps(); }
+};
+
+struct SolverLanes {
+	__m128 v;
+
+	_FORCE_INLINE_ SolverLanes(__m128 p_v) :
+			v(p_v) {}
+	_FORCE_INLINE_ SolverLanes(real_t p_value) :
+			v(_mm_set1_ps(p_value)) {}
+
+	_FORCE_INLINE_ static SolverLanes load(const real_t *p_src) { return _mm_loadu_ps(p_src); }
+	_FORCE_INLINE_ void store(real_t *p_dst) const { _mm_storeu_ps(p_dst, v); }
+	_FORCE_INLINE_ static SolverLanes gather(const real_t *p_src, const uint32_t *p_index) {
+		return _mm_setr_ps(p_src[p_index[0]], p_src[p_index[1]], p_src[p_index[2]], p_src[p_index[3]]);
+	}
+	_FORCE_INLINE_ void scatter(real_t *p_dst, const uint32_t *p_index) const {
+		real_t values[4];
+		store(values);
+		for (int i = 0; i < 4; i++) {
+			p_dst[p_index[i]] = values[i];
+		}
+	}
+
+	_FORCE_INLINE_ SolverLanes operator+(const SolverLanes &p_l) const { return _mm_add_ps(v, p_l.v); }
+	_FORCE_INLINE_ SolverLanes operator-(const SolverLanes &p_l) const { return _mm_sub_ps(v, p_l.v); }
+	_FORCE_INLINE_ SolverLanes operator*(const SolverLanes &p_l) const { return _mm_mul_ps(v, p_l.v); }
+	_FORCE_INLINE_ SolverLanes operator/(const SolverLanes &p_l) const { return _mm_div_ps(v, p_l.v); }
+	_FORCE_INLINE_ SolverLanes operator-() const { return _mm_sub_ps(_mm_setzero_ps(), v); }
+	_FORCE_INLINE_ SolverMask operator>(const SolverLanes &p_l) const { return _mm_cmpgt_ps(v, p_l.v); }
+
+	_FORCE_INLINE_ SolverLanes abs() const { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+	_FORCE_INLINE_ SolverLanes sqrt() const { return _mm_sqrt_ps(v); }
+	_FORCE_INLINE_ static SolverLanes max(const SolverLanes &p_a, const SolverLanes &p_b) { return _mm_max_ps(p_a.v, p_b.v); }
+	_FORCE_INLINE_ static SolverLanes select(const SolverMask &p_m, const SolverLanes &p_a, const SolverLanes &p_b) {
+		return _mm_or_ps(_mm_and_ps(p_m.v, p_a.v), _mm_andnot_ps(p_m.v, p_b.v));
+	}
+};
+
+#else
+
+struct SolverMask {
+	bool m[ContactSolver3DSW::LANES];
+
+	_FORCE_INLINE_ SolverMask operator&(const SolverMask &p_m) const {
+		SolverMask r;
+		for (int i = 0; i < ContactSolver3DSW::LANES; i++) {
+			r.m[i] = m[i] && p_m.m[i];
+		}
+		return r;
+	}
+	_FORCE_INLINE_ SolverMask operator|(const SolverMask &p_m) const {
+		SolverMask r;
+		for (int i = 0; i < ContactSolver3DSW::LANES; i++) {
+			r.m[i] = m[i] || p_m.m[i];
+		}
+		return r;
+	}
+	_FORCE_INLINE_ bool any() const {
+		for (int i = 0; i < ContactSolver3DSW::LANES; i++) {
+			if (m[i]) {
+				return true;
+			}
+		}
+		return false;
+	}
+	_FORCE_INLINE_ static SolverMask none() {
+		SolverMask r;
+		for (int i = 0; i < ContactSolver3DSW::LANES; i++) {
+			r.m[i] = false;
+		}
+		return r;
+	}
+};
+
+struct SolverLanes {
+	real_t v[ContactSolver3DSW::LANES];
+
+	_FORCE_INLINE_ SolverLanes() {}
+	_FORCE_INLINE_ SolverLanes(real_t p_value) {
+		for (int i = 0; i < ContactSolver3DSW::LANES; i++) {
+			v[i] = p_value;
+		}
+	}
+
+	_FORCE_INLINE_ static SolverLanes load(const real_t *p_src) {
+		SolverLanes r;
+		for (int i = 0; i < ContactSolver3DSW::LANES; i++) {
+			r.v[i] = p_src[i];
+		}
+		return r;
+	}
+	_FORCE_INLINE_ void store(real_t *p_dst) const {
+		for (int i = 0; i < ContactSolver3DSW::LANES; i++) {
+			p_dst[i] = v[i];
+		}
+	}
+	_FORCE_INLINE_ static SolverLanes gather(const real_t *p_src, const uint32_t *p_index) {
+		SolverLanes r;
+		for (int i = 0; i < ContactSolver3DSW::LANES; i++) {
+			r.v[i] = p_src[p_index[i]];
+		}
+		return r;
+	}
+	_FORCE_INLINE_ void scatter(real_t *p_dst, const uint32_t *p_index) const {
+		for (int i = 0; i < ContactSolver3DSW::LANES; i++) {
+			p_dst[p_index[i]] = v[i];
+		}
+	}
+
+#define SOLVER_LANES_OP(m_op)                                                     \
+	_FORCE_INLINE_ SolverLanes operator m_op(const SolverLanes &p_l) const {     \
+		SolverLanes r;                                                            \
+		for (int i = 0; i < ContactSolver3DSW::LANES; i++) {                     \
+			r.v[i] = v[i] m_op p_l.v[i];                                          \
+		}                                                                         \
+		return r;                                                                 \
+	}
+	SOLVER_LANES_OP(+)
+	SOLVER_LANES_OP(-)
+	SOLVER_LANES_OP(*)
+	SOLVER_LANES_OP(/)
+#undef SOLVER_LANES_OP
+
+	_FORCE_INLINE_ SolverLanes operator-() const {
+		SolverLanes r;
+		for (int i = 0; i < ContactSolver3DSW::LANES; i++) {
+			r.v[i] = -v[i];
+		}
+		return r;
+	}
+	_FORCE_INLINE_ SolverMask operator>(const SolverLanes &p_l) const {
+		SolverMask r;
+		for (int i = 0; i < ContactSolver3DSW::LANES; i++) {
+			r.m[i] = v[i] > p_l.v[i];
+		}
+		return r;
+	}
+
+	_FORCE_INLINE_ SolverLanes abs() const {
+		SolverLanes r;
+		for (int i = 0; i < ContactSolver3DSW::LANES; i++) {
+			r.v[i] = Math::abs(v[i]);
+		}
+		return r;
+	}
+	_FORCE_INLINE_ SolverLanes sqrt() const {
+		SolverLanes r;
+		for (int i = 0; i < ContactSolver3DSW::LANES; i++) {
+			r.v[i] = Math::sqrt(v[i]);
+		}
+		return r;
+	}
+	_FORCE_INLINE_ static SolverLanes max(const SolverLanes &p_a, const SolverLanes &p_b) {
+		SolverLanes r;
+		for (int i = 0; i < ContactSolver3DSW::LANES; i++) {
+			r.v[i] = MAX(p_a.v[i], p_b.v[i]);
+		}
+		return r;
+	}
+	_FORCE_INLINE_ static SolverLanes select(const SolverMask &p_m, const SolverLanes &p_a, const SolverLanes &p_b) {
+		SolverLanes r;
+		for (int i = 0; i < ContactSolver3DSW::LANES; i++) {
+			r.v[i] = p_m.m[i] ? p_a.v[i] : p_b.v[i];
+		}
+		return r;
+	}
+};
+
+#endif // CONTACT_SOLVER_SSE2
+
+struct SolverVector3 {
+	SolverLanes x, y, z;
+
+	_FORCE_INLINE_ SolverVector3(const SolverLanes &p_x, const SolverLanes &p_y, const SolverLanes &p_z) :
+			x(p_x), y(p_y), z(p_z) {}
+
+	_FORCE_INLINE_ static SolverVector3 load(const LocalVector<real_t> *p_src, uint32_t p_ofs) {
+		return SolverVector3(SolverLanes::load(&p_src[0][p_ofs]), SolverLanes::load(&p_src[1][p_ofs]), SolverLanes::load(&p_src[2][p_ofs]));
+	}
+	_FORCE_INLINE_ void store(LocalVector<real_t> *p_dst, uint32_t p_ofs) const {
+		x.store(&p_dst[0][p_ofs]);
+		y.store(&p_dst[1][p_ofs]);
+		z.store(&p_dst[2][p_ofs]);
+	}
+	_FORCE_INLINE_ static SolverVector3 gather(const LocalVector<real_t> *p_src, const uint32_t *p_index) {
+		return SolverVector3(SolverLanes::gather(p_src[0].ptr(), p_index), SolverLanes::gather(p_src[1].ptr(), p_index), SolverLanes::gather(p_src[2].ptr(), p_index));
+	}
+	_FORCE_INLINE_ void scatter(LocalVector<real_t> *p_dst, const uint32_t *p_index) const {
+		x.scatter(p_dst[0].ptr(), p_index);
+		y.scatter(p_dst[1].ptr(), p_index);
+		z.scatter(p_dst[2].ptr(), p_index);
+	}
+
+	_FORCE_INLINE_ SolverVector3 operator+(const SolverVector3 &p_v) const { return SolverVector3(x + p_v.x, y + p_v.y, z + p_v.z); }
+	_FORCE_INLINE_ SolverVector3 operator-(const SolverVector3 &p_v) const { return SolverVector3(x - p_v.x, y - p_v.y, z - p_v.z); }
+	_FORCE_INLINE_ SolverVector3 operator*(const SolverLanes &p_s) const { return SolverVector3(x * p_s, y * p_s, z * p_s); }
+	_FORCE_INLINE_ SolverVector3 operator-() const { return SolverVector3(-x, -y, -z); }
+
+	_FORCE_INLINE_ SolverLanes dot(const SolverVector3 &p_v) const { return x * p_v.x + y * p_v.y + z * p_v.z; }
+	_FORCE_INLINE_ SolverVector3 cross(const SolverVector3 &p_v) const {
+		return SolverVector3(y * p_v.z - z * p_v.y, z * p_v.x - x * p_v.z, x * p_v.y - y * p_v.x);
+	}
+	_FORCE_INLINE_ SolverLanes length() const { return dot(*this).sqrt(); }
+
+	_FORCE_INLINE_ static SolverVector3 select(const SolverMask &p_m, const SolverVector3 &p_a, const SolverVector3 &p_b) {
+		return SolverVector3(SolverLanes::select(p_m, p_a.x, p_b.x), SolverLanes::select(p_m, p_a.y, p_b.y), SolverLanes::select(p_m, p_a.z, p_b.z));
+	}
+};
+
+// Rows of an inverse inertia tensor, as in Basis.
+struct SolverBasis {
+	SolverVector3 rows[3];
+
+	_FORCE_INLINE_ static SolverBasis gather(const LocalVector<real_t> *p_src, const uint32_t *p_index) {
+		return SolverBasis{ { SolverVector3::gather(&p_src[0], p_index), SolverVector3::gather(&p_src[3], p_index), SolverVector3::gather(&p_src[6], p_index) } };
+	}
+
+	_FORCE_INLINE_ SolverVector3 xform(const SolverVector3 &p_v) const {
+		return SolverVector3(rows[0].dot(p_v), rows[1].dot(p_v), rows[2].dot(p_v));
+	}
+};
+
+// Body3DSW::apply_impulse() for the dynamic bodies of the lanes.
+_FORCE_INLINE_ void _apply_impulse(SolverVector3 &r_linear_velocity, SolverVector3 &r_angular_velocity, const SolverLanes &p_inv_mass, const SolverBasis &p_inv_inertia, const SolverVector3 &p_r, const SolverVector3 &p_impulse, const SolverMask &p_dynamic) {
+	r_linear_velocity = SolverVector3::select(p_dynamic, r_linear_velocity + p_impulse * p_inv_mass, r_linear_velocity);
+	r_angular_velocity = SolverVector3::select(p_dynamic, r_angular_velocity + p_inv_inertia.xform(p_r.cross(p_impulse)), r_angular_velocity);
+}
+
+// Body3DSW::apply_bias_impulse() for the dynamic bodies of the lanes, with a positive maximum angular velocity change.
+_FORCE_INLINE_ void _apply_bias_impulse(SolverVector3 &r_linear_velocity, SolverVector3 &r_angular_velocity, const SolverLanes &p_inv_mass, const SolverBasis &p_inv_inertia, const SolverVector3 &p_r, const SolverVector3 &p_impulse, const SolverMask &p_dynamic, const SolverLanes &p_max_delta_av) {
+	r_linear_velocity = SolverVector3::select(p_dynamic, r_linear_velocity + p_impulse * p_inv_mass, r_linear_velocity);
+	SolverVector3 delta_av = p_inv_inertia.xform(p_r.cross(p_impulse));
+	SolverLanes delta_av_length = delta_av.length();
+	SolverMask clamp = delta_av_length > p_max_delta_av;
+	delta_av = SolverVector3::select(clamp, delta_av * (p_max_delta_av / SolverLanes::select(clamp, delta_av_length, SolverLanes(1.0))), delta_av);
+	r_angular_velocity = SolverVector3::select(p_dynamic, r_angular_velocity + delta_av, r_angular_velocity);
+}
+
+} // namespace
+
+bool ContactSolver3DSW::can_solve(const LocalVector<Constraint3DSW *> &p_constraint_island) {
+	uint32_t contact_count = 0;
+	for (uint32_t i = 0; i < p_constraint_island.size(); i++) {
+		BodyPair3DSW *pair = p_constraint_island[i]->get_body_pair();
+		if (!pair || pair->get_priority() != 1) {
+			return false; // Joints and soft bodies read and write the bodies directly.
+		}
+		contact_count += pair->contact_count;
+	}
+	return contact_count >= MIN_CONTACTS;
+}
+
+uint32_t ContactSolver3DSW::_get_body_slot(Body3DSW *p_body) {
+	uint32_t *slot = body_slots.getptr(p_body);
+	if (slot) {
+		return *slot;
+	}
+
+	uint32_t index = bodies.size();
+	body_slots.set(p_body, index);
+	bodies.push_back(p_body);
+
+	if (!p_body) {
+		for (int i = 0; i < 3; i++) {
+			linear_velocity[i].push_back(0);
+			angular_velocity[i].push_back(0);
+			biased_linear_velocity[i].push_back(0);
+			biased_angular_velocity[i].push_back(0);
+		}
+		inv_mass.push_back(0);
+		for (int i = 0; i < 9; i++) {
+			inv_inertia[i].push_back(0);
+		}
+		return index;
+	}
+
+	const Vector3 &lv = p_body->get_linear_velocity();
+	const Vector3 &av = p_body->get_angular_velocity();
+	const Vector3 &blv = p_body->get_biased_linear_velocity();
+	const Vector3 &bav = p_body->get_biased_angular_velocity();
+	for (int i = 0; i < 3; i++) {
+		linear_velocity[i].push_back(lv[i]);
+		angular_velocity[i].push_back(av[i]);
+		biased_linear_velocity[i].push_back(blv[i]);
+		biased_angular_velocity[i].push_back(bav[i]);
+	}
+	inv_mass.push_back(p_body->get_inv_mass());
+	const Basis &inertia = p_body->get_inv_inertia_tensor();
+	for (int i = 0; i < 9; i++) {
+		inv_inertia[i].push_back(inertia.elements[i / 3][i % 3]);
+	}
+	return index;
+}
+
+void ContactSolver3DSW::_add_contact(BodyPair3DSW::Contact *p_contact, BodyPair3DSW *p_pair) {
+	contacts.push_back(p_contact);
+	if (!p_contact) {
+		// Padding, inactive and attached to the empty body.
+		body_A.push_back(0);
+		body_B.push_back(0);
+		dynamic_A.push_back(0);
+		dynamic_B.push_back(0);
+		for (int i = 0; i < 3; i++) {
+			normal[i].push_back(0);
+			r_A[i].push_back(0);
+			r_B[i].push_back(0);
+			acc_tangent_impulse[i].push_back(0);
+		}
+		mass_normal.push_back(0);
+		inv_mass_sum.push_back(1);
+		bias.push_back(0);
+		bounce.push_back(0);
+		friction.push_back(0);
+		acc_normal_impulse.push_back(0);
+		acc_bias_impulse.push_back(0);
+		acc_bias_impulse_center_of_mass.push_back(0);
+		active.push_back(0);
+		return;
+	}
+
+	const BodyPair3DSW::Contact &c = *p_contact;
+	body_A.push_back(*body_slots.getptr(p_pair->A));
+	body_B.push_back(*body_slots.getptr(p_pair->B));
+	dynamic_A.push_back(p_pair->dynamic_A ? 1 : 0);
+	dynamic_B.push_back(p_pair->dynamic_B ? 1 : 0);
+	for (int i = 0; i < 3; i++) {
+		normal[i].push_back(c.normal[i]);
+		r_A[i].push_back(c.rA[i]);
+		r_B[i].push_back(c.rB[i]);
+		acc_tangent_impulse[i].push_back(c.acc_tangent_impulse[i]);
+	}
+	mass_normal.push_back(c.mass_normal);
+	inv_mass_sum.push_back(p_pair->A->get_inv_mass() + p_pair->B->get_inv_mass());
+	bias.push_back(c.bias);
+	bounce.push_back(c.bounce);
+	friction.push_back(combine_friction(p_pair->A, p_pair->B));
+	acc_normal_impulse.push_back(c.acc_normal_impulse);
+	acc_bias_impulse.push_back(c.acc_bias_impulse);
+	acc_bias_impulse_center_of_mass.push_back(c.acc_bias_impulse_center_of_mass);
+	active.push_back(c.active ? 1 : 0);
+}
+
+void ContactSolver3DSW::_solve_batch(uint32_t p_batch, real_t p_max_bias_rotation) {
+	const uint32_t ofs = p_batch * LANES;
+	const SolverLanes zero(0.0);
+	const SolverLanes min_velocity(MIN_VELOCITY);
+
+	const SolverMask live = SolverLanes::load(&active[ofs]) > zero;
+	if (!live.any()) {
+		return;
+	}
+
+	const uint32_t *index_A = &body_A[ofs];
+	const uint32_t *index_B = &body_B[ofs];
+	const SolverMask dyn_A = SolverLanes::load(&dynamic_A[ofs]) > zero;
+	const SolverMask dyn_B = SolverLanes::load(&dynamic_B[ofs]) > zero;
+
+	SolverVector3 lv_A = SolverVector3::gather(linear_velocity, index_A);
+	SolverVector3 av_A = SolverVector3::gather(angular_velocity, index_A);
+	SolverVector3 blv_A = SolverVector3::gather(biased_linear_velocity, index_A);
+	SolverVector3 bav_A = SolverVector3::gather(biased_angular_velocity, index_A);
+	const SolverLanes im_A = SolverLanes::gather(inv_mass.ptr(), index_A);
+	const SolverBasis ii_A = SolverBasis::gather(inv_inertia, index_A);
+
+	SolverVector3 lv_B = SolverVector3::gather(linear_velocity, index_B);
+	SolverVector3 av_B = SolverVector3::gather(angular_velocity, index_B);
+	SolverVector3 blv_B = SolverVector3::gather(biased_linear_velocity, index_B);
+	SolverVector3 bav_B = SolverVector3::gather(biased_angular_velocity, index_B);
+	const SolverLanes im_B = SolverLanes::gather(inv_mass.ptr(), index_B);
+	const SolverBasis ii_B = SolverBasis::gather(inv_inertia, index_B);
+
+	const SolverVector3 n = SolverVector3::load(normal, ofs);
+	const SolverVector3 rA = SolverVector3::load(r_A, ofs);
+	const SolverVector3 rB = SolverVector3::load(r_B, ofs);
+	const SolverLanes c_mass_normal = SolverLanes::load(&mass_normal[ofs]);
+	const SolverLanes c_bias = SolverLanes::load(&bias[ofs]);
+	const SolverLanes c_bounce = SolverLanes::load(&bounce[ofs]);
+
+	SolverMask now_active = SolverMask::none();
+
+	// Bias impulse.
+
+	SolverVector3 dbv = blv_B + bav_B.cross(rB) - blv_A - bav_A.cross(rA);
+	SolverLanes vbn = dbv.dot(n);
+
+	const SolverMask bias_mask = live & ((c_bias - vbn).abs() > min_velocity);
+	if (bias_mask.any()) {
+		SolverLanes acc_old = SolverLanes::load(&acc_bias_impulse[ofs]);
+		SolverLanes acc = SolverLanes::select(bias_mask, SolverLanes::max(acc_old + (c_bias - vbn) * c_mass_normal, zero), acc_old);
+		acc.store(&acc_bias_impulse[ofs]);
+
+		SolverVector3 jb = n * (acc - acc_old);
+		const SolverLanes max_rotation(p_max_bias_rotation);
+		_apply_bias_impulse(blv_A, bav_A, im_A, ii_A, rA, -jb, dyn_A, max_rotation);
+		_apply_bias_impulse(blv_B, bav_B, im_B, ii_B, rB, jb, dyn_B, max_rotation);
+
+		dbv = blv_B + bav_B.cross(rB) - blv_A - bav_A.cross(rA);
+		vbn = dbv.dot(n);
+
+		const SolverMask com_mask = bias_mask & ((c_bias - vbn).abs() > min_velocity);
+		SolverLanes acc_com_old = SolverLanes::load(&acc_bias_impulse_center_of_mass[ofs]);
+		SolverLanes jbn_com = (c_bias - vbn) / SolverLanes::load(&inv_mass_sum[ofs]);
+		SolverLanes acc_com = SolverLanes::select(com_mask, SolverLanes::max(acc_com_old + jbn_com, zero), acc_com_old);
+		acc_com.store(&acc_bias_impulse_center_of_mass[ofs]);
+
+		// Applied at the center of mass, so only the linear velocity changes.
+		SolverVector3 jb_com = n * (acc_com - acc_com_old);
+		blv_A = SolverVector3::select(dyn_A, blv_A - jb_com * im_A, blv_A);
+		blv_B = SolverVector3::select(dyn_B, blv_B + jb_com * im_B, blv_B);
+
+		now_active = now_active | bias_mask;
+	}
+
+	// Normal impulse.
+
+	SolverVector3 dv = lv_B + av_B.cross(rB) - lv_A - av_A.cross(rA);
+	SolverLanes vn = dv.dot(n);
+
+	const SolverMask normal_mask = live & (vn.abs() > min_velocity);
+	SolverLanes acc_normal = SolverLanes::load(&acc_normal_impulse[ofs]);
+	if (normal_mask.any()) {
+		SolverLanes acc_old = acc_normal;
+		acc_normal = SolverLanes::select(normal_mask, SolverLanes::max(acc_old - (c_bounce + vn) * c_mass_normal, zero), acc_old);
+		acc_normal.store(&acc_normal_impulse[ofs]);
+
+		SolverVector3 j = n * (acc_normal - acc_old);
+		_apply_impulse(lv_A, av_A, im_A, ii_A, rA, -j, dyn_A);
+		_apply_impulse(lv_B, av_B, im_B, ii_B, rB, j, dyn_B);
+
+		now_active = now_active | normal_mask;
+	}
+
+	// Friction impulse.
+
+	SolverVector3 dtv = lv_B + av_B.cross(rB) - lv_A - av_A.cross(rA);
+	SolverVector3 tv = dtv - n * n.dot(dtv);
+	SolverLanes tvl = tv.length();
+
+	const SolverMask friction_mask = live & (tvl > min_velocity);
+	if (friction_mask.any()) {
+		tv = tv * (SolverLanes(1.0) / SolverLanes::select(friction_mask, tvl, SolverLanes(1.0)));
+
+		SolverVector3 temp1 = ii_A.xform(rA.cross(tv));
+		SolverVector3 temp2 = ii_B.xform(rB.cross(tv));
+		SolverLanes denominator = im_A + im_B + tv.dot(temp1.cross(rA) + temp2.cross(rB));
+		SolverLanes t = -tvl / SolverLanes::select(friction_mask, denominator, SolverLanes(1.0));
+
+		SolverVector3 acc_old = SolverVector3::load(acc_tangent_impulse, ofs);
+		SolverVector3 acc = SolverVector3::select(friction_mask, acc_old + tv * t, acc_old);
+
+		SolverLanes fi_len = acc.length();
+		SolverLanes jt_max = acc_normal * SolverLanes::load(&friction[ofs]);
+		const SolverMask clamp_mask = friction_mask & (fi_len > SolverLanes(CMP_EPSILON)) & (fi_len > jt_max);
+		acc = SolverVector3::select(clamp_mask, acc * (jt_max / SolverLanes::select(clamp_mask, fi_len, SolverLanes(1.0))), acc);
+		acc.store(acc_tangent_impulse, ofs);
+
+		SolverVector3 jt = acc - acc_old;
+		_apply_impulse(lv_A, av_A, im_A, ii_A, rA, -jt, dyn_A);
+		_apply_impulse(lv_B, av_B, im_B, ii_B, rB, jt, dyn_B);
+
+		now_active = now_active | friction_mask;
+	}
+
+	SolverLanes::select(now_active, SolverLanes(1.0), zero).store(&active[ofs]);
+
+	// Bodies of a batch are all different, except static ones which are left unchanged.
+	lv_A.scatter(linear_velocity, index_A);
+	av_A.scatter(angular_velocity, index_A);
+	blv_A.scatter(biased_linear_velocity, index_A);
+	bav_A.scatter(biased_angular_velocity, index_A);
+	lv_B.scatter(linear_velocity, index_B);
+	av_B.scatter(angular_velocity, index_B);
+	blv_B.scatter(biased_linear_velocity, index_B);
+	bav_B.scatter(biased_angular_velocity, index_B);
+}
+
+void ContactSolver3DSW::solve(const LocalVector<Constraint3DSW *> &p_constraint_island, int p_iterations, real_t p_step) {
+	// Gather the bodies, slot 0 being the empty one.
+	_get_body_slot(nullptr);
+
+	struct PendingContact {
+		BodyPair3DSW::Contact *contact;
+		BodyPair3DSW *pair;
+		uint32_t claim_A; // Dynamic body slot, or 0.
+		uint32_t claim_B;
+	};
+	LocalVector<PendingContact> pending;
+	for (uint32_t i = 0; i < p_constraint_island.size(); i++) {
+		BodyPair3DSW *pair = p_constraint_island[i]->get_body_pair();
+		uint32_t slot_A = _get_body_slot(pair->A);
+		uint32_t slot_B = _get_body_slot(pair->B);
+		for (int j = 0; j < pair->contact_count; j++) {
+			if (pair->contacts[j].active) {
+				pending.push_back({ &pair->contacts[j], pair, pair->dynamic_A ? slot_A : 0, pair->dynamic_B ? slot_B : 0 });
+			}
+		}
+	}
+
+	// Greedy coloring: each color takes every remaining contact whose dynamic bodies are still free in it.
+	LocalVector<uint32_t> claimed_color;
+	claimed_color.resize(bodies.size());
+	for (uint32_t i = 0; i < claimed_color.size(); i++) {
+		claimed_color[i] = 0;
+	}
+	LocalVector<PendingContact> remaining;
+	uint32_t color = 0;
+	while (pending.size()) {
+		color++;
+		remaining.clear();
+		uint32_t color_count = 0;
+		for (uint32_t i = 0; i < pending.size(); i++) {
+			const PendingContact &p = pending[i];
+			if ((p.claim_A && claimed_color[p.claim_A] == color) || (p.claim_B && claimed_color[p.claim_B] == color)) {
+				remaining.push_back(p);
+				continue;
+			}
+			claimed_color[p.claim_A] = color;
+			claimed_color[p.claim_B] = color;
+			_add_contact(p.contact, p.pair);
+			color_count++;
+		}
+		while (color_count % LANES) {
+			_add_contact(nullptr, nullptr);
+			color_count++;
+		}
+		SWAP(pending, remaining);
+	}
+
+	const uint32_t batch_count = contacts.size() / LANES;
+	const real_t max_bias_rotation = MAX_BIAS_ROTATION / p_step;
+	for (int iteration = 0; iteration < p_iterations; iteration++) {
+		for (uint32_t batch = 0; batch < batch_count; batch++) {
+			_solve_batch(batch, max_bias_rotation);
+		}
+	}
+
+	// Scatter the results back.
+	for (uint32_t i = 0; i < contacts.size(); i++) {
+		BodyPair3DSW::Contact *c = contacts[i];
+		if (!c) {
+			continue;
+		}
+		c->acc_normal_impulse = acc_normal_impulse[i];
+		c->acc_tangent_impulse = Vector3(acc_tangent_impulse[0][i], acc_tangent_impulse[1][i], acc_tangent_impulse[2][i]);
+		c->acc_bias_impulse = acc_bias_impulse[i];
+		c->acc_bias_impulse_center_of_mass = acc_bias_impulse_center_of_mass[i];
+		c->active = active[i] > 0;
+	}
+
+	for (uint32_t i = 1; i < bodies.size(); i++) {
+		Body3DSW *body = bodies[i];
+		if (body->get_mode() <= PhysicsServer3D::BODY_MODE_KINEMATIC) {
+			continue;
+		}
+		body->set_linear_velocity(Vector3(linear_velocity[0][i], linear_velocity[1][i], linear_velocity[2][i]));
+		body->set_angular_velocity(Vector3(angular_velocity[0][i], angular_velocity[1][i], angular_velocity[2][i]));
+		body->set_biased_linear_velocity(Vector3(biased_linear_velocity[0][i], biased_linear_velocity[1][i], biased_linear_velocity[2][i]));
+		body->set_biased_angular_velocity(Vector3(biased_angular_velocity[0][i], biased_angular_velocity[1][i], biased_angular_velocity[2][i]));
+	}
+}
@@ -0,0 +1,97 @@
+/*************************************************************************/
+/*  contact_solver_3d_sw.h                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef CONTACT_SOLVER_3D_SW_H
+#define CONTACT_SOLVER_3D_SW_H
+
+#include "body_pair_3d_sw.h"
+
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Solves the contacts of an island made only of body pairs with a sequential impulse solver
+// working on structure of arrays data. Contacts are colored so that no two contacts of a color
+// share a dynamic body, and each color is solved in batches of LANES contacts at a time.
+// Results are written back to the bodies and contacts afterwards.
+class ContactSolver3DSW {
+public:
+	enum {
+		LANES = 4,
+		// Smaller islands are cheaper to solve through BodyPair3DSW::solve().
+		MIN_CONTACTS = 16,
+	};
+
+private:
+	struct BodyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const Body3DSW *p_body) { return hash_one_uint64((uint64_t)p_body); }
+	};
+
+	// Bodies, slot 0 is an empty static body used by the padding lanes.
+	HashMap<Body3DSW *, uint32_t, BodyHasher> body_slots;
+	LocalVector<Body3DSW *> bodies;
+	LocalVector<real_t> linear_velocity[3];
+	LocalVector<real_t> angular_velocity[3];
+	LocalVector<real_t> biased_linear_velocity[3];
+	LocalVector<real_t> biased_angular_velocity[3];
+	LocalVector<real_t> inv_mass;
+	LocalVector<real_t> inv_inertia[9];
+
+	// Contacts, in batches of LANES ordered by color.
+	LocalVector<BodyPair3DSW::Contact *> contacts;
+	LocalVector<uint32_t> body_A;
+	LocalVector<uint32_t> body_B;
+	LocalVector<real_t> dynamic_A;
+	LocalVector<real_t> dynamic_B;
+	LocalVector<real_t> normal[3];
+	LocalVector<real_t> r_A[3];
+	LocalVector<real_t> r_B[3];
+	LocalVector<real_t> mass_normal;
+	LocalVector<real_t> inv_mass_sum;
+	LocalVector<real_t> bias;
+	LocalVector<real_t> bounce;
+	LocalVector<real_t> friction;
+	LocalVector<real_t> acc_normal_impulse;
+	LocalVector<real_t> acc_tangent_impulse[3];
+	LocalVector<real_t> acc_bias_impulse;
+	LocalVector<real_t> acc_bias_impulse_center_of_mass;
+	LocalVector<real_t> active;
+
+	uint32_t _get_body_slot(Body3DSW *p_body);
+	void _add_contact(BodyPair3DSW::Contact *p_contact, BodyPair3DSW *p_pair);
+	void _solve_batch(uint32_t p_batch, real_t p_max_bias_rotation);
+
+public:
+	// Returns true if the island only holds body pairs, with enough contacts to make it worth it.
+	static bool can_solve(const LocalVector<Constraint3DSW *> &p_constraint_island);
+
+	void solve(const LocalVector<Constraint3DSW *> &p_constraint_island, int p_iterations, real_t p_step);
+};
+
+#endif // CONTACT_SOLVER_3D_SW_H
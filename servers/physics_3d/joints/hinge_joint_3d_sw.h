@@ -99,7 +99,7 @@ public:
 	virtual PhysicsServer3D::JointType get_type() const { return PhysicsServer3D::JOINT_TYPE_HINGE; }
 
 	virtual bool setup(real_t p_step);
-	virtual void solve(real_t p_step);
+	virtual bool solve(real_t p_step);
 
 	real_t get_hinge_angle();
 
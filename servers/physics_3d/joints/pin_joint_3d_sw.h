@@ -77,7 +77,7 @@ public:
 	virtual PhysicsServer3D::JointType get_type() const { return PhysicsServer3D::JOINT_TYPE_PIN; }
 
 	virtual bool setup(real_t p_step);
-	virtual void solve(real_t p_step);
+	virtual bool solve(real_t p_step);
 
 	void set_param(PhysicsServer3D::PinJointParam p_param, real_t p_value);
 	real_t get_param(PhysicsServer3D::PinJointParam p_param) const;
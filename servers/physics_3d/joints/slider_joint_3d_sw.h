@@ -241,7 +241,7 @@ public:
 	real_t get_param(PhysicsServer3D::SliderJointParam p_param) const;
 
 	bool setup(real_t p_step);
-	void solve(real_t p_step);
+	bool solve(real_t p_step);
 
 	virtual PhysicsServer3D::JointType get_type() const { return PhysicsServer3D::JOINT_TYPE_SLIDER; }
 };
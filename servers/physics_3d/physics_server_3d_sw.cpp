@@ -213,6 +213,22 @@ int PhysicsServer3DSW::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+Vector<uint8_t> PhysicsServer3DSW::space_save_state(RID p_space) const {
+	Space3DSW *space = space_owner.getornull(p_space);
+	ERR_FAIL_COND_V(!space, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG((using_threads && !doing_sync) || space->is_locked(), Vector<uint8_t>(), "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	return space->save_state();
+}
+
+Error PhysicsServer3DSW::space_restore_state(RID p_space, const Vector<uint8_t> &p_state) {
+	Space3DSW *space = space_owner.getornull(p_space);
+	ERR_FAIL_COND_V(!space, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(space->is_locked(), ERR_BUSY, "Space state can't be restored while the space is being stepped.");
+
+	return space->restore_state(p_state);
+}
+
 RID PhysicsServer3DSW::area_create() {
 	Area3DSW *area = memnew(Area3DSW);
 	RID rid = area_owner.make_rid(area);
@@ -1659,7 +1675,8 @@ void PhysicsServer3DSW::flush_queries() {
 			"generate_islands",
 			"setup_constraints",
 			"solve_constraints",
-			"integrate_velocities"
+			"integrate_velocities",
+			"update_broadphase"
 		};
 
 		for (int i = 0; i < Space3DSW::ELAPSED_TIME_MAX; i++) {
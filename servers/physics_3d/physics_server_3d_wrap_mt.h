@@ -131,6 +131,13 @@ public:
 		return physics_3d_server->space_get_contact_count(p_space);
 	}
 
+	virtual Vector<uint8_t> space_save_state(RID p_space) const override {
+		ERR_FAIL_COND_V(main_thread != Thread::get_caller_id(), Vector<uint8_t>());
+		return physics_3d_server->space_save_state(p_space);
+	}
+
+	FUNC2R(Error, space_restore_state, RID, const Vector<uint8_t> &);
+
 	/* AREA API */
 
 	//FUNC0RID(area);
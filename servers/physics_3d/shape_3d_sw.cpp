@@ -1702,151 +1702,231 @@ _FORCE_INLINE_ bool _heightmap_cell_cull_segment(_HeightmapSegmentCullParams &p_
 	return false;
 }
 
-bool HeightMapShape3DSW::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
-	if (heights.is_empty()) {
-		return false;
+// Restricts the [r_t_min, r_t_max] range of a segment to the part between p_min and p_max along one axis.
+_FORCE_INLINE_ bool _heightmap_clip_segment_axis(real_t p_begin, real_t p_end, real_t p_min, real_t p_max, real_t &r_t_min, real_t &r_t_max) {
+	real_t length = p_end - p_begin;
+	if (Math::abs(length) < CMP_EPSILON) {
+		return (p_begin >= p_min) && (p_begin <= p_max);
 	}
 
-	Vector3 local_begin = p_begin + local_origin;
-	Vector3 local_end = p_end + local_origin;
+	real_t t0 = (p_min - p_begin) / length;
+	real_t t1 = (p_max - p_begin) / length;
+	if (t0 > t1) {
+		SWAP(t0, t1);
+	}
 
-	FaceShape3DSW face;
-	face.backface_collision = false;
+	r_t_min = MAX(r_t_min, t0);
+	r_t_max = MIN(r_t_max, t1);
 
-	_HeightmapSegmentCullParams params;
-	params.from = p_begin;
-	params.to = p_end;
-	params.dir = (p_end - p_begin).normalized();
-	params.heightmap = this;
-	params.face = &face;
+	return r_t_min <= r_t_max;
+}
 
+// Processes the cells crossed by a segment projected on a grid, in order from p_begin to p_end.
+// Coordinates are expressed in grid units, only cells in [p_min_x, p_max_x) and [p_min_z, p_max_z) are processed.
+template <typename ProcessFunction>
+bool _heightmap_intersect_grid_segment(ProcessFunction &p_process, const Vector3 &p_begin, const Vector3 &p_end, int p_min_x, int p_min_z, int p_max_x, int p_max_z) {
 	// Quantize the ray begin/end.
-	int begin_x = floor(local_begin.x);
-	int begin_z = floor(local_begin.z);
-	int end_x = floor(local_end.x);
-	int end_z = floor(local_end.z);
+	int begin_x = floor(p_begin.x);
+	int begin_z = floor(p_begin.z);
+	int end_x = floor(p_end.x);
+	int end_z = floor(p_end.z);
 
 	if ((begin_x == end_x) && (begin_z == end_z)) {
 		// Simple case for rays that don't traverse the grid horizontally.
 		// Just perform a test on the given cell.
-		int x = CLAMP(begin_x, 0, width - 2);
-		int z = CLAMP(begin_z, 0, depth - 2);
-		if (_heightmap_cell_cull_segment(params, x, z)) {
-			r_point = params.result;
-			r_normal = params.normal;
-			return true;
+		int x = CLAMP(begin_x, p_min_x, p_max_x - 1);
+		int z = CLAMP(begin_z, p_min_z, p_max_z - 1);
+		return p_process(x, z);
+	}
+
+	// Perform grid query from projected ray.
+	Vector2 ray_dir_proj(p_end.x - p_begin.x, p_end.z - p_begin.z);
+	real_t ray_dist_proj = ray_dir_proj.length();
+
+	if (ray_dist_proj < CMP_EPSILON) {
+		ray_dir_proj = Vector2();
+	} else {
+		ray_dir_proj /= ray_dist_proj;
+	}
+
+	const int x_step = (ray_dir_proj.x > CMP_EPSILON) ? 1 : ((ray_dir_proj.x < -CMP_EPSILON) ? -1 : 0);
+	const int z_step = (ray_dir_proj.y > CMP_EPSILON) ? 1 : ((ray_dir_proj.y < -CMP_EPSILON) ? -1 : 0);
+
+	const real_t infinite = 1e20;
+	const real_t delta_x = (x_step != 0) ? 1.f / Math::abs(ray_dir_proj.x) : infinite;
+	const real_t delta_z = (z_step != 0) ? 1.f / Math::abs(ray_dir_proj.y) : infinite;
+
+	real_t cross_x; // At which value of `param` we will cross a x-axis lane?
+	real_t cross_z; // At which value of `param` we will cross a z-axis lane?
+
+	// X initialization.
+	if (x_step != 0) {
+		if (x_step == 1) {
+			cross_x = (ceil(p_begin.x) - p_begin.x) * delta_x;
+		} else {
+			cross_x = (p_begin.x - floor(p_begin.x)) * delta_x;
 		}
 	} else {
-		// Perform grid query from projected ray.
-		Vector2 ray_dir_proj(local_end.x - local_begin.x, local_end.z - local_begin.z);
-		real_t ray_dist_proj = ray_dir_proj.length();
+		cross_x = infinite; // Will never cross on X.
+	}
 
-		if (ray_dist_proj < CMP_EPSILON) {
-			ray_dir_proj = Vector2();
+	// Z initialization.
+	if (z_step != 0) {
+		if (z_step == 1) {
+			cross_z = (ceil(p_begin.z) - p_begin.z) * delta_z;
 		} else {
-			ray_dir_proj /= ray_dist_proj;
+			cross_z = (p_begin.z - floor(p_begin.z)) * delta_z;
+		}
+	} else {
+		cross_z = infinite; // Will never cross on Z.
+	}
+
+	int x = floor(p_begin.x);
+	int z = floor(p_begin.z);
+
+	// Workaround cases where the ray starts at an integer position.
+	if (Math::abs(cross_x) < CMP_EPSILON) {
+		cross_x += delta_x;
+		// If going backwards, we should ignore the position we would get by the above flooring,
+		// because the ray is not heading in that direction.
+		if (x_step == -1) {
+			x -= 1;
+		} else if (x_step == 1) {
+			// Segments clipped to a chunk can start slightly before the lane because of precision errors.
+			x = ceil(p_begin.x);
+		}
+	}
+
+	if (Math::abs(cross_z) < CMP_EPSILON) {
+		cross_z += delta_z;
+		if (z_step == -1) {
+			z -= 1;
+		} else if (z_step == 1) {
+			z = ceil(p_begin.z);
 		}
+	}
 
-		const int x_step = (ray_dir_proj.x > CMP_EPSILON) ? 1 : ((ray_dir_proj.x < -CMP_EPSILON) ? -1 : 0);
-		const int z_step = (ray_dir_proj.y > CMP_EPSILON) ? 1 : ((ray_dir_proj.y < -CMP_EPSILON) ? -1 : 0);
+	// Start inside the grid.
+	int x_start = CLAMP(x, p_min_x, p_max_x - 1);
+	int z_start = CLAMP(z, p_min_z, p_max_z - 1);
 
-		const real_t infinite = 1e20;
-		const real_t delta_x = (x_step != 0) ? 1.f / Math::abs(ray_dir_proj.x) : infinite;
-		const real_t delta_z = (z_step != 0) ? 1.f / Math::abs(ray_dir_proj.y) : infinite;
+	// Adjust initial cross values.
+	cross_x += delta_x * x_step * (x_start - x);
+	cross_z += delta_z * z_step * (z_start - z);
 
-		real_t cross_x; // At which value of `param` we will cross a x-axis lane?
-		real_t cross_z; // At which value of `param` we will cross a z-axis lane?
+	x = x_start;
+	z = z_start;
 
-		// X initialization.
-		if (x_step != 0) {
-			if (x_step == 1) {
-				cross_x = (ceil(local_begin.x) - local_begin.x) * delta_x;
-			} else {
-				cross_x = (local_begin.x - floor(local_begin.x)) * delta_x;
-			}
-		} else {
-			cross_x = infinite; // Will never cross on X.
-		}
+	if (p_process(x, z)) {
+		return true;
+	}
 
-		// Z initialization.
-		if (z_step != 0) {
-			if (z_step == 1) {
-				cross_z = (ceil(local_begin.z) - local_begin.z) * delta_z;
-			} else {
-				cross_z = (local_begin.z - floor(local_begin.z)) * delta_z;
-			}
+	real_t dist = 0.0;
+	while (true) {
+		if (cross_x < cross_z) {
+			// X lane.
+			x += x_step;
+			// Assign before advancing the param,
+			// to be in sync with the initialization step.
+			dist = cross_x;
+			cross_x += delta_x;
 		} else {
-			cross_z = infinite; // Will never cross on Z.
+			// Z lane.
+			z += z_step;
+			dist = cross_z;
+			cross_z += delta_z;
 		}
 
-		int x = floor(local_begin.x);
-		int z = floor(local_begin.z);
+		// Stop when outside the grid.
+		if ((x < p_min_x) || (z < p_min_z) || (x >= p_max_x) || (z >= p_max_z)) {
+			break;
+		}
 
-		// Workaround cases where the ray starts at an integer position.
-		if (Math::abs(cross_x) < CMP_EPSILON) {
-			cross_x += delta_x;
-			// If going backwards, we should ignore the position we would get by the above flooring,
-			// because the ray is not heading in that direction.
-			if (x_step == -1) {
-				x -= 1;
-			}
+		if (p_process(x, z)) {
+			return true;
 		}
 
-		if (Math::abs(cross_z) < CMP_EPSILON) {
-			cross_z += delta_z;
-			if (z_step == -1) {
-				z -= 1;
-			}
+		if (dist > ray_dist_proj) {
+			break;
 		}
+	}
 
-		// Start inside the grid.
-		int x_start = CLAMP(x, 0, width - 2);
-		int z_start = CLAMP(z, 0, depth - 2);
+	return false;
+}
 
-		// Adjust initial cross values.
-		cross_x += delta_x * x_step * (x_start - x);
-		cross_z += delta_z * z_step * (z_start - z);
+struct _HeightmapCellCullSegment {
+	_HeightmapSegmentCullParams &params;
 
-		x = x_start;
-		z = z_start;
+	_FORCE_INLINE_ bool operator()(int p_x, int p_z) {
+		return _heightmap_cell_cull_segment(params, p_x, p_z);
+	}
+};
 
-		if (_heightmap_cell_cull_segment(params, x, z)) {
-			r_point = params.result;
-			r_normal = params.normal;
-			return true;
-		}
+struct _HeightmapChunkCullSegment {
+	_HeightmapSegmentCullParams &params;
 
-		real_t dist = 0.0;
-		while (true) {
-			if (cross_x < cross_z) {
-				// X lane.
-				x += x_step;
-				// Assign before advancing the param,
-				// to be in sync with the initialization step.
-				dist = cross_x;
-				cross_x += delta_x;
-			} else {
-				// Z lane.
-				z += z_step;
-				dist = cross_z;
-				cross_z += delta_z;
-			}
+	// Segment in cell units.
+	Vector3 local_begin;
+	Vector3 local_end;
 
-			// Stop when outside the grid.
-			if ((x < 0) || (z < 0) || (x >= width - 1) || (z >= depth - 1)) {
-				break;
-			}
+	bool operator()(int p_x, int p_z) {
+		const HeightMapShape3DSW *heightmap = params.heightmap;
 
-			if (_heightmap_cell_cull_segment(params, x, z)) {
-				r_point = params.result;
-				r_normal = params.normal;
-				return true;
-			}
+		int min_x = p_x * HeightMapShape3DSW::BOUNDS_CHUNK_SIZE;
+		int min_z = p_z * HeightMapShape3DSW::BOUNDS_CHUNK_SIZE;
+		int max_x = MIN(min_x + HeightMapShape3DSW::BOUNDS_CHUNK_SIZE, heightmap->width - 1);
+		int max_z = MIN(min_z + HeightMapShape3DSW::BOUNDS_CHUNK_SIZE, heightmap->depth - 1);
 
-			if (dist > ray_dist_proj) {
-				break;
-			}
+		// Part of the segment that lies over the chunk.
+		real_t t_min = 0.0;
+		real_t t_max = 1.0;
+		if (!_heightmap_clip_segment_axis(local_begin.x, local_end.x, min_x, max_x, t_min, t_max)) {
+			return false;
+		}
+		if (!_heightmap_clip_segment_axis(local_begin.z, local_end.z, min_z, max_z, t_min, t_max)) {
+			return false;
+		}
+
+		Vector3 chunk_begin = local_begin.lerp(local_end, t_min);
+		Vector3 chunk_end = local_begin.lerp(local_end, t_max);
+
+		// Skip the chunk when the segment passes entirely above or below it.
+		const HeightMapShape3DSW::Range &range = heightmap->_get_bounds_chunk(p_x, p_z);
+		if ((MAX(chunk_begin.y, chunk_end.y) < range.min) || (MIN(chunk_begin.y, chunk_end.y) > range.max)) {
+			return false;
 		}
+
+		_HeightmapCellCullSegment cell_process{ params };
+		return _heightmap_intersect_grid_segment(cell_process, chunk_begin, chunk_end, min_x, min_z, max_x, max_z);
+	}
+};
+
+bool HeightMapShape3DSW::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
+	if (bounds_grid.is_empty()) {
+		return false;
+	}
+
+	Vector3 local_begin = p_begin + local_origin;
+	Vector3 local_end = p_end + local_origin;
+
+	FaceShape3DSW face;
+	face.backface_collision = false;
+
+	_HeightmapSegmentCullParams params;
+	params.from = p_begin;
+	params.to = p_end;
+	params.dir = (p_end - p_begin).normalized();
+	params.heightmap = this;
+	params.face = &face;
+
+	// Traverse the chunks first, and only test the cells of the chunks the segment can hit.
+	_HeightmapChunkCullSegment chunk_process{ params, local_begin, local_end };
+
+	const real_t chunk_scale = 1.0 / BOUNDS_CHUNK_SIZE;
+	if (_heightmap_intersect_grid_segment(chunk_process, local_begin * chunk_scale, local_end * chunk_scale, 0, 0, bounds_grid_width, bounds_grid_depth)) {
+		r_point = params.result;
+		r_normal = params.normal;
+		return true;
 	}
 
 	return false;
@@ -1876,7 +1956,7 @@ void HeightMapShape3DSW::_get_cell(const Vector3 &p_point, int &r_x, int &r_y, i
 }
 
 void HeightMapShape3DSW::cull(const AABB &p_local_aabb, Callback p_callback, void *p_userdata) const {
-	if (heights.is_empty()) {
+	if (bounds_grid.is_empty()) {
 		return;
 	}
 
@@ -1901,23 +1981,59 @@ void HeightMapShape3DSW::cull(const AABB &p_local_aabb, Callback p_callback, voi
 	int start_z = MAX(0, aabb_min[2]);
 	int end_z = MIN(depth - 1, aabb_max[2]);
 
+	if ((start_x >= end_x) || (start_z >= end_z)) {
+		return;
+	}
+
+	real_t min_y = local_aabb.position.y;
+	real_t max_y = local_aabb.position.y + local_aabb.size.y;
+
+	int start_chunk_x = start_x / BOUNDS_CHUNK_SIZE;
+	int end_chunk_x = (end_x - 1) / BOUNDS_CHUNK_SIZE;
+
 	FaceShape3DSW face;
 	face.backface_collision = true;
 
+	Vector3 points[4];
+
 	for (int z = start_z; z < end_z; z++) {
-		for (int x = start_x; x < end_x; x++) {
-			// First triangle.
-			_get_point(x, z, face.vertex[0]);
-			_get_point(x + 1, z, face.vertex[1]);
-			_get_point(x, z + 1, face.vertex[2]);
-			face.normal = Plane(face.vertex[0], face.vertex[2], face.vertex[1]).normal;
-			p_callback(p_userdata, &face);
-
-			// Second triangle.
-			face.vertex[0] = face.vertex[1];
-			_get_point(x + 1, z + 1, face.vertex[1]);
-			face.normal = Plane(face.vertex[0], face.vertex[2], face.vertex[1]).normal;
-			p_callback(p_userdata, &face);
+		int chunk_z = z / BOUNDS_CHUNK_SIZE;
+		for (int chunk_x = start_chunk_x; chunk_x <= end_chunk_x; chunk_x++) {
+			// Skip cells from chunks which are entirely above or below the aabb.
+			const Range &range = _get_bounds_chunk(chunk_x, chunk_z);
+			if ((range.max < min_y) || (range.min > max_y)) {
+				continue;
+			}
+
+			int chunk_start_x = MAX(start_x, chunk_x * BOUNDS_CHUNK_SIZE);
+			int chunk_end_x = MIN(end_x, (chunk_x + 1) * BOUNDS_CHUNK_SIZE);
+
+			for (int x = chunk_start_x; x < chunk_end_x; x++) {
+				_get_point(x, z, points[0]);
+				_get_point(x + 1, z, points[1]);
+				_get_point(x, z + 1, points[2]);
+				_get_point(x + 1, z + 1, points[3]);
+
+				// Same test for the cell itself.
+				real_t cell_min_y = MIN(MIN(points[0].y, points[1].y), MIN(points[2].y, points[3].y));
+				real_t cell_max_y = MAX(MAX(points[0].y, points[1].y), MAX(points[2].y, points[3].y));
+				if ((cell_max_y < min_y) || (cell_min_y > max_y)) {
+					continue;
+				}
+
+				// First triangle.
+				face.vertex[0] = points[0];
+				face.vertex[1] = points[1];
+				face.vertex[2] = points[2];
+				face.normal = Plane(face.vertex[0], face.vertex[2], face.vertex[1]).normal;
+				p_callback(p_userdata, &face);
+
+				// Second triangle.
+				face.vertex[0] = points[1];
+				face.vertex[1] = points[3];
+				face.normal = Plane(face.vertex[0], face.vertex[2], face.vertex[1]).normal;
+				p_callback(p_userdata, &face);
+			}
 		}
 	}
 }
@@ -1932,11 +2048,54 @@ Vector3 HeightMapShape3DSW::get_moment_of_inertia(real_t p_mass) const {
 			(p_mass / 3.0) * (extents.x * extents.x + extents.y * extents.y));
 }
 
+void HeightMapShape3DSW::_build_accelerator() {
+	bounds_grid.clear();
+
+	// One chunk for every BOUNDS_CHUNK_SIZE cells, the last one on each axis can be smaller.
+	bounds_grid_width = (width - 1 + BOUNDS_CHUNK_SIZE - 1) / BOUNDS_CHUNK_SIZE;
+	bounds_grid_depth = (depth - 1 + BOUNDS_CHUNK_SIZE - 1) / BOUNDS_CHUNK_SIZE;
+
+	if ((bounds_grid_width <= 0) || (bounds_grid_depth <= 0)) {
+		bounds_grid_width = 0;
+		bounds_grid_depth = 0;
+		return;
+	}
+
+	bounds_grid.resize(bounds_grid_width * bounds_grid_depth);
+	Range *w = bounds_grid.ptrw();
+
+	for (int chunk_z = 0; chunk_z < bounds_grid_depth; ++chunk_z) {
+		int start_z = chunk_z * BOUNDS_CHUNK_SIZE;
+		int end_z = MIN(start_z + BOUNDS_CHUNK_SIZE, depth - 1);
+
+		for (int chunk_x = 0; chunk_x < bounds_grid_width; ++chunk_x) {
+			int start_x = chunk_x * BOUNDS_CHUNK_SIZE;
+			int end_x = MIN(start_x + BOUNDS_CHUNK_SIZE, width - 1);
+
+			// Include the points on the far edges, they are shared with the next chunks.
+			Range range;
+			range.min = _get_height(start_x, start_z);
+			range.max = range.min;
+			for (int z = start_z; z <= end_z; ++z) {
+				for (int x = start_x; x <= end_x; ++x) {
+					float height = _get_height(x, z);
+					range.min = MIN(range.min, height);
+					range.max = MAX(range.max, height);
+				}
+			}
+
+			w[(chunk_z * bounds_grid_width) + chunk_x] = range;
+		}
+	}
+}
+
 void HeightMapShape3DSW::_setup(const Vector<float> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height) {
 	heights = p_heights;
 	width = p_width;
 	depth = p_depth;
 
+	_build_accelerator();
+
 	// Initialize aabb.
 	AABB aabb;
 	aabb.position = Vector3(0.0, p_min_height, 0.0);
@@ -1996,9 +2155,10 @@ void HeightMapShape3DSW::set_data(const Variant &p_data) {
 		min_height = d["min_height"];
 		max_height = d["max_height"];
 	} else {
-		int heights_size = heights.size();
+		int heights_size = heights_buffer.size();
+		const float *r = heights_buffer.ptr();
 		for (int i = 0; i < heights_size; ++i) {
-			float h = heights[i];
+			float h = r[i];
 			if (h < min_height) {
 				min_height = h;
 			} else if (h > max_height) {
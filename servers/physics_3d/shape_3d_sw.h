@@ -394,10 +394,28 @@ struct HeightMapShape3DSW : public ConcaveShape3DSW {
 	int depth = 0;
 	Vector3 local_origin;
 
+	// Min/max heights for chunks of cells, used to skip whole areas of the heightmap in queries.
+	struct Range {
+		float min = 0.0;
+		float max = 0.0;
+	};
+
+	enum {
+		BOUNDS_CHUNK_SIZE = 16,
+	};
+
+	Vector<Range> bounds_grid;
+	int bounds_grid_width = 0;
+	int bounds_grid_depth = 0;
+
 	_FORCE_INLINE_ float _get_height(int p_x, int p_z) const {
 		return heights[(p_z * width) + p_x];
 	}
 
+	_FORCE_INLINE_ const Range &_get_bounds_chunk(int p_x, int p_z) const {
+		return bounds_grid[(p_z * bounds_grid_width) + p_x];
+	}
+
 	_FORCE_INLINE_ void _get_point(int p_x, int p_z, Vector3 &r_point) const {
 		r_point.x = p_x - 0.5 * (width - 1.0);
 		r_point.y = _get_height(p_x, p_z);
@@ -406,6 +424,8 @@ struct HeightMapShape3DSW : public ConcaveShape3DSW {
 
 	void _get_cell(const Vector3 &p_point, int &r_x, int &r_y, int &r_z) const;
 
+	void _build_accelerator();
+
 	void _setup(const Vector<float> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height);
 
 public:
@@ -67,6 +67,7 @@ public:
 		ELAPSED_TIME_SETUP_CONSTRAINTS,
 		ELAPSED_TIME_SOLVE_CONSTRAINTS,
 		ELAPSED_TIME_INTEGRATE_VELOCITIES,
+		ELAPSED_TIME_UPDATE_BROADPHASE,
 		ELAPSED_TIME_MAX
 
 	};
@@ -157,6 +158,9 @@ public:
 	void remove_object(CollisionObject3DSW *p_object);
 	const Set<CollisionObject3DSW *> &get_objects() const;
 
+	Vector<uint8_t> save_state() const;
+	Error restore_state(const Vector<uint8_t> &p_state);
+
 	_FORCE_INLINE_ real_t get_contact_recycle_radius() const { return contact_recycle_radius; }
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
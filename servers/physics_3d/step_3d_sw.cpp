@@ -29,8 +29,10 @@
 /*************************************************************************/
 
 #include "step_3d_sw.h"
+#include "contact_solver_3d_sw.h"
 #include "joints_3d_sw.h"
 
+#include "core/config/project_settings.h"
 #include "core/os/os.h"
 
 #define BODY_ISLAND_COUNT_RESERVE 128
@@ -38,7 +40,7 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 
-void Step3DSW::_populate_island(Body3DSW *p_body, LocalVector<Body3DSW *> &p_body_island, LocalVector<Constraint3DSW *> &p_constraint_island) {
+void Step3DSW::_populate_island(Body3DSW *p_body, LocalVector<Body3DSW *> &p_body_island, LocalVector<Constraint3DSW *> &p_constraint_island, bool &r_soft_body) {
 	p_body->set_island_step(_step);
 	p_body_island.push_back(p_body);
 
@@ -51,6 +53,11 @@ void Step3DSW::_populate_island(Body3DSW *p_body, LocalVector<Body3DSW *> &p_bod
 		c->set_island_step(_step);
 		p_constraint_island.push_back(c);
 
+		if (c->get_soft_body_count() > 0) {
+			// Soft bodies can be shared between islands.
+			r_soft_body = true;
+		}
+
 		for (int i = 0; i < c->get_body_count(); i++) {
 			if (i == E->get()) {
 				continue;
@@ -59,7 +66,7 @@ void Step3DSW::_populate_island(Body3DSW *p_body, LocalVector<Body3DSW *> &p_bod
 			if (b->get_island_step() == _step || b->get_mode() == PhysicsServer3D::BODY_MODE_STATIC || b->get_mode() == PhysicsServer3D::BODY_MODE_KINEMATIC) {
 				continue; //no go
 			}
-			_populate_island(c->get_body_ptr()[i], p_body_island, p_constraint_island);
+			_populate_island(c->get_body_ptr()[i], p_body_island, p_constraint_island, r_soft_body);
 		}
 	}
 }
@@ -78,15 +85,28 @@ void Step3DSW::_setup_island(LocalVector<Constraint3DSW *> &p_constraint_island,
 }
 
 void Step3DSW::_solve_island(LocalVector<Constraint3DSW *> &p_constraint_island, int p_iterations, real_t p_delta) {
+	if (use_soa_contact_solver && ContactSolver3DSW::can_solve(p_constraint_island)) {
+		ContactSolver3DSW solver;
+		solver.solve(p_constraint_island, p_iterations, p_delta);
+		return;
+	}
+
 	int current_priority = 1;
 
 	uint32_t constraint_count = p_constraint_island.size();
 	while (constraint_count > 0) {
 		for (int i = 0; i < p_iterations; i++) {
 			// Go through all iterations.
+			// Constraints that report nothing left to solve are dropped for the remaining iterations,
+			// this saves the virtual calls for resting contacts which have converged early.
+			uint32_t active_constraint_count = 0;
 			for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
-				p_constraint_island[constraint_index]->solve(p_delta);
+				Constraint3DSW *constraint = p_constraint_island[constraint_index];
+				if (constraint->solve(p_delta)) {
+					p_constraint_island[active_constraint_count++] = constraint;
+				}
 			}
+			constraint_count = active_constraint_count;
 		}
 
 		// Check priority to keep only higher priority constraints.
@@ -103,6 +123,12 @@ void Step3DSW::_solve_island(LocalVector<Constraint3DSW *> &p_constraint_island,
 	}
 }
 
+void Step3DSW::_solve_island_threaded(uint32_t p_index, void *p_userdata) {
+	// Warning: _solve_island modifies the constraint islands for optimization purpose,
+	// their content is not reliable after these calls and shouldn't be used anymore.
+	_solve_island(constraint_islands[parallel_islands[p_index]], iterations, delta);
+}
+
 void Step3DSW::_check_suspend(const LocalVector<Body3DSW *> &p_body_island, real_t p_delta) {
 	bool can_sleep = true;
 
@@ -182,6 +208,9 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 	uint32_t body_island_count = 0;
 	uint32_t island_count = 0;
 
+	parallel_islands.clear();
+	serial_islands.clear();
+
 	while (b) {
 		Body3DSW *body = b->self();
 
@@ -202,12 +231,17 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 			constraint_island.clear();
 			constraint_island.reserve(ISLAND_SIZE_RESERVE);
 
-			_populate_island(body, body_island, constraint_island);
+			bool soft_body = false;
+			_populate_island(body, body_island, constraint_island, soft_body);
 
 			body_islands.push_back(body_island);
 
 			if (constraint_island.is_empty()) {
 				--island_count;
+			} else if (soft_body) {
+				serial_islands.push_back(island_count - 1);
+			} else {
+				parallel_islands.push_back(island_count - 1);
 			}
 		}
 		b = b->next();
@@ -231,6 +265,7 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 			LocalVector<Constraint3DSW *> &constraint_island = constraint_islands[island_count - 1];
 			constraint_island.clear();
 			constraint_island.push_back(c);
+			serial_islands.push_back(island_count - 1);
 		}
 		p_space->area_remove_from_moved_list((SelfList<Area3DSW> *)aml.first()); //faster to remove here
 	}
@@ -250,6 +285,7 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 			LocalVector<Constraint3DSW *> &constraint_island = constraint_islands[island_count - 1];
 			constraint_island.clear();
 			constraint_island.push_back(c);
+			serial_islands.push_back(island_count - 1);
 		}
 		sb = sb->next();
 	}
@@ -274,10 +310,28 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
-	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+	iterations = p_iterations;
+	delta = p_delta;
+
+	// Islands are solved serially when the shared pool is busy, e.g. with another space stepping.
+	ThreadWorkPool *pool = nullptr;
+	if (parallel_islands.size() > 1) {
+		pool = ThreadWorkPool::try_lock_shared();
+	}
+
+	if (pool) {
+		pool->do_work(parallel_islands.size(), this, &Step3DSW::_solve_island_threaded, nullptr);
+		ThreadWorkPool::unlock_shared();
+	} else {
+		for (uint32_t i = 0; i < parallel_islands.size(); ++i) {
+			_solve_island_threaded(i, nullptr);
+		}
+	}
+
+	for (uint32_t i = 0; i < serial_islands.size(); ++i) {
 		// Warning: _solve_island modifies the constraint islands for optimization purpose,
 		// their content is not reliable after these calls and shouldn't be used anymore.
-		_solve_island(constraint_islands[island_index], p_iterations, p_delta);
+		_solve_island(constraint_islands[serial_islands[i]], p_iterations, p_delta);
 	}
 
 	{ //profile
@@ -315,7 +369,16 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 		profile_begtime = profile_endtime;
 	}
 
+	/* UPDATE BROADPHASE */
+
 	p_space->update();
+
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(Space3DSW::ELAPSED_TIME_UPDATE_BROADPHASE, profile_endtime - profile_begtime);
+		profile_begtime = profile_endtime;
+	}
+
 	p_space->unlock();
 	_step++;
 }
@@ -325,4 +388,8 @@ Step3DSW::Step3DSW() {
 
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
+	parallel_islands.reserve(ISLAND_COUNT_RESERVE);
+	serial_islands.reserve(ISLAND_COUNT_RESERVE);
+
+	use_soa_contact_solver = GLOBAL_DEF("physics/3d/use_soa_contact_solver", false);
 }
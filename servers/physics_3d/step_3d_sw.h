@@ -34,16 +34,28 @@
 #include "space_3d_sw.h"
 
 #include "core/templates/local_vector.h"
+#include "core/templates/thread_work_pool.h"
 
 class Step3DSW {
 	uint64_t _step;
 
+	int iterations = 0;
+	real_t delta = 0.0;
+
 	LocalVector<LocalVector<Body3DSW *>> body_islands;
 	LocalVector<LocalVector<Constraint3DSW *>> constraint_islands;
 
-	void _populate_island(Body3DSW *p_body, LocalVector<Body3DSW *> &p_body_island, LocalVector<Constraint3DSW *> &p_constraint_island);
+	// Islands that only share static or kinematic bodies with each other can be solved in parallel,
+	// islands involving soft bodies or areas are solved on the stepping thread afterwards.
+	LocalVector<uint32_t> parallel_islands;
+	LocalVector<uint32_t> serial_islands;
+
+	bool use_soa_contact_solver = false;
+
+	void _populate_island(Body3DSW *p_body, LocalVector<Body3DSW *> &p_body_island, LocalVector<Constraint3DSW *> &p_constraint_island, bool &r_soft_body);
 	void _setup_island(LocalVector<Constraint3DSW *> &p_constraint_island, real_t p_delta);
 	void _solve_island(LocalVector<Constraint3DSW *> &p_constraint_island, int p_iterations, real_t p_delta);
+	void _solve_island_threaded(uint32_t p_index, void *p_userdata);
 	void _check_suspend(const LocalVector<Body3DSW *> &p_body_island, real_t p_delta);
 
 public:
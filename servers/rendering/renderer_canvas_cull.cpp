@@ -104,6 +104,107 @@ void _mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner, RID_PtrOwner<Rende
 	} while (ysort_owner && ysort_owner->sort_y);
 }
 
+static _FORCE_INLINE_ AABB _rect_to_aabb(const Rect2 &p_rect) {
+	return AABB(Vector3(p_rect.position.x, p_rect.position.y, 0), Vector3(p_rect.size.x, p_rect.size.y, 0));
+}
+
+void RendererCanvasCull::_mark_subtree_rect_dirty(Item *p_item) {
+	while (p_item && !p_item->subtree_rect_dirty) {
+		p_item->subtree_rect_dirty = true;
+		p_item = _get_parent_item(p_item);
+	}
+}
+
+void RendererCanvasCull::_remove_from_child_bvh(Item *p_parent, Item *p_child) {
+	if (p_child->bvh_id.is_valid()) {
+		p_parent->child_bvh->remove(p_child->bvh_id);
+		p_child->bvh_id = DynamicBVH::ID();
+	}
+}
+
+void RendererCanvasCull::_update_subtree_rect(Item *p_item) {
+	Item *ci = p_item;
+
+	ci->subtree_rect_dirty = false;
+	// These are processed during culling regardless of what ends up on screen.
+	ci->subtree_cullable = !ci->update_when_visible && !ci->copy_back_buffer && !ci->vp_render && !ci->canvas_group;
+	ci->subtree_has_rect = ci->commands != nullptr || ci->custom_rect;
+	if (ci->subtree_has_rect) {
+		ci->subtree_rect = ci->get_rect();
+	}
+
+	int child_item_count = ci->child_items.size();
+	Item **child_items = ci->child_items.ptrw();
+
+	bool use_bvh = child_item_count >= child_bvh_min_children && !ci->sort_y;
+	if (use_bvh && !ci->child_bvh) {
+		ci->child_bvh = memnew(DynamicBVH);
+	} else if (!use_bvh && ci->child_bvh) {
+		for (int i = 0; i < child_item_count; i++) {
+			child_items[i]->bvh_id = DynamicBVH::ID();
+		}
+		memdelete(ci->child_bvh);
+		ci->child_bvh = nullptr;
+	}
+
+	for (int i = 0; i < child_item_count; i++) {
+		Item *child = child_items[i];
+
+		if (!child->visible) {
+			if (ci->child_bvh) {
+				_remove_from_child_bvh(ci, child);
+			}
+			continue;
+		}
+
+		if (child->subtree_rect_dirty) {
+			_update_subtree_rect(child);
+		}
+
+		if (!child->subtree_cullable) {
+			ci->subtree_cullable = false;
+		}
+
+		Rect2 child_rect;
+		if (child->subtree_has_rect) {
+			// Include the pixel snapped position too, so the bounds hold whether snapping is enabled or not.
+			Transform2D snapped_xform = child->xform;
+			snapped_xform.elements[2] = snapped_xform.elements[2].floor();
+			child_rect = child->xform.xform(child->subtree_rect).merge(snapped_xform.xform(child->subtree_rect));
+
+			if (ci->subtree_has_rect) {
+				ci->subtree_rect = ci->subtree_rect.merge(child_rect);
+			} else {
+				ci->subtree_rect = child_rect;
+				ci->subtree_has_rect = true;
+			}
+		}
+
+		if (!ci->child_bvh) {
+			continue;
+		}
+
+		if (child->subtree_cullable && !child->subtree_has_rect) {
+			// Nothing to draw, no need to visit it at all.
+			_remove_from_child_bvh(ci, child);
+			continue;
+		}
+
+		if (!child->subtree_cullable) {
+			// Must always be visited, so make sure every query finds it.
+			child_rect = Rect2(-1e20, -1e20, 2e20, 2e20);
+		}
+
+		if (!child->bvh_id.is_valid()) {
+			child->bvh_id = ci->child_bvh->insert(_rect_to_aabb(child_rect), child);
+			child->bvh_rect = child_rect;
+		} else if (child->bvh_rect != child_rect) {
+			ci->child_bvh->update(child->bvh_id, _rect_to_aabb(child_rect));
+			child->bvh_rect = child_rect;
+		}
+	}
+}
+
 void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **z_list, RendererCanvasRender::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner) {
 	Item *ci = p_canvas_item;
 
@@ -123,6 +224,22 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 	}
 	xform = p_transform * xform;
 
+	if (ci->subtree_rect_dirty) {
+		_update_subtree_rect(ci);
+	}
+
+	if (ci->subtree_cullable) {
+		if (!ci->subtree_has_rect) {
+			return; // Nothing to draw in this subtree.
+		}
+
+		Rect2 global_subtree_rect = xform.xform(ci->subtree_rect);
+		global_subtree_rect.position += p_clip_rect.position;
+		if (!p_clip_rect.intersects(global_subtree_rect, true)) {
+			return;
+		}
+	}
+
 	Rect2 global_rect = xform.xform(rect);
 	global_rect.position += p_clip_rect.position;
 
@@ -172,6 +289,20 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 		sorter.sort(child_items, child_item_count);
 	}
 
+	LocalVector<Item *> culled_child_items;
+	if (ci->child_bvh && !ci->sort_y && xform.basis_determinant() != 0) {
+		// Only visit the children whose subtree overlaps the clip rect, brought to this item's local space.
+		Rect2 local_clip_rect = xform.affine_inverse().xform(Rect2(Point2(), p_clip_rect.size));
+
+		ChildCullQuery query;
+		query.result = &culled_child_items;
+		ci->child_bvh->aabb_query(_rect_to_aabb(local_clip_rect), query);
+		culled_child_items.sort_custom<ItemIndexSort>();
+
+		child_item_count = culled_child_items.size();
+		child_items = culled_child_items.ptr();
+	}
+
 	if (ci->z_relative) {
 		p_z = CLAMP(p_z + ci->z_index, RS::CANVAS_ITEM_Z_MIN, RS::CANVAS_ITEM_Z_MAX);
 	} else {
@@ -418,6 +549,11 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
 			}
+
+			if (item_owner->child_bvh) {
+				_remove_from_child_bvh(item_owner, canvas_item);
+			}
+			_mark_subtree_rect_dirty(item_owner);
 		}
 
 		canvas_item->parent = RID();
@@ -438,6 +574,7 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
 			}
+			_mark_subtree_rect_dirty(item_owner);
 
 		} else {
 			ERR_FAIL_MSG("Invalid parent.");
@@ -454,6 +591,7 @@ void RendererCanvasCull::canvas_item_set_visible(RID p_item, bool p_visible) {
 	canvas_item->visible = p_visible;
 
 	_mark_ysort_dirty(canvas_item, canvas_item_owner);
+	_mark_subtree_rect_dirty(_get_parent_item(canvas_item));
 }
 
 void RendererCanvasCull::canvas_item_set_light_mask(RID p_item, int p_mask) {
@@ -468,6 +606,7 @@ void RendererCanvasCull::canvas_item_set_transform(RID p_item, const Transform2D
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->xform = p_transform;
+	_mark_subtree_rect_dirty(_get_parent_item(canvas_item));
 }
 
 void RendererCanvasCull::canvas_item_set_clip(RID p_item, bool p_clip) {
@@ -487,6 +626,7 @@ void RendererCanvasCull::canvas_item_set_distance_field_mode(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_set_custom_rect(RID p_item, bool p_custom_rect, const Rect2 &p_rect) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
@@ -518,11 +658,13 @@ void RendererCanvasCull::canvas_item_set_update_when_visible(RID p_item, bool p_
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->update_when_visible = p_update;
+	_mark_subtree_rect_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_add_line(RID p_item, const Point2 &p_from, const Point2 &p_to, const Color &p_color, float p_width) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandPrimitive *line = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_COND(!line);
@@ -547,6 +689,7 @@ void RendererCanvasCull::canvas_item_add_polyline(RID p_item, const Vector<Point
 	ERR_FAIL_COND(p_points.size() < 2);
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Color color = Color(1, 1, 1, 1);
 
@@ -686,6 +829,7 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 	ERR_FAIL_COND(p_points.size() < 2);
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandPolygon *pline = canvas_item->alloc_command<Item::CommandPolygon>();
 	ERR_FAIL_COND(!pline);
@@ -702,6 +846,7 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, const Color &p_color) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_COND(!rect);
@@ -712,6 +857,7 @@ void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, c
 void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos, float p_radius, const Color &p_color) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandPolygon *circle = canvas_item->alloc_command<Item::CommandPolygon>();
 	ERR_FAIL_COND(!circle);
@@ -748,6 +894,7 @@ void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos,
 void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_COND(!rect);
@@ -779,6 +926,7 @@ void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p
 void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose, bool p_clip_uv) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_COND(!rect);
@@ -820,6 +968,7 @@ void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const R
 void RendererCanvasCull::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_rect, const Rect2 &p_source, RID p_texture, const Vector2 &p_topleft, const Vector2 &p_bottomright, RS::NinePatchAxisMode p_x_axis_mode, RS::NinePatchAxisMode p_y_axis_mode, bool p_draw_center, const Color &p_modulate) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandNinePatch *style = canvas_item->alloc_command<Item::CommandNinePatch>();
 	ERR_FAIL_COND(!style);
@@ -844,6 +993,7 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandPrimitive *prim = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_COND(!prim);
@@ -870,6 +1020,7 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 #ifdef DEBUG_ENABLED
 	int pointcount = p_points.size();
 	ERR_FAIL_COND(pointcount < 3);
@@ -891,6 +1042,7 @@ void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2
 void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector<int> &p_indices, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, const Vector<int> &p_bones, const Vector<float> &p_weights, RID p_texture, int p_count) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	int vertex_count = p_points.size();
 	ERR_FAIL_COND(vertex_count == 0);
@@ -914,6 +1066,7 @@ void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector
 void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transform2D &p_transform) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandTransform *tr = canvas_item->alloc_command<Item::CommandTransform>();
 	ERR_FAIL_COND(!tr);
@@ -923,6 +1076,7 @@ void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transfo
 void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, const Transform2D &p_transform, const Color &p_modulate, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandMesh *m = canvas_item->alloc_command<Item::CommandMesh>();
 	ERR_FAIL_COND(!m);
@@ -937,6 +1091,7 @@ void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, con
 void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandParticles *part = canvas_item->alloc_command<Item::CommandParticles>();
 	ERR_FAIL_COND(!part);
@@ -951,6 +1106,7 @@ void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles,
 void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandMultiMesh *mm = canvas_item->alloc_command<Item::CommandMultiMesh>();
 	ERR_FAIL_COND(!mm);
@@ -962,6 +1118,7 @@ void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandClipIgnore *ci = canvas_item->alloc_command<Item::CommandClipIgnore>();
 	ERR_FAIL_COND(!ci);
@@ -971,6 +1128,7 @@ void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore)
 void RendererCanvasCull::canvas_item_set_sort_children_by_y(RID p_item, bool p_enable) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	canvas_item->sort_y = p_enable;
 
@@ -1003,6 +1161,7 @@ void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton)
 void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_enable, const Rect2 &p_rect) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 	if (p_enable && (canvas_item->copy_back_buffer == nullptr)) {
 		canvas_item->copy_back_buffer = memnew(RendererCanvasRender::Item::CopyBackBuffer);
 	}
@@ -1020,6 +1179,7 @@ void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_e
 void RendererCanvasCull::canvas_item_clear(RID p_item) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	canvas_item->clear();
 }
@@ -1060,6 +1220,7 @@ void RendererCanvasCull::canvas_item_set_use_parent_material(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::CanvasGroupMode p_mode, float p_clear_margin, bool p_fit_empty, float p_fit_margin, bool p_blur_mipmaps) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	if (p_mode == RS::CANVAS_GROUP_MODE_DISABLED) {
 		if (canvas_item->canvas_group != nullptr) {
@@ -1486,11 +1647,21 @@ bool RendererCanvasCull::free(RID p_rid) {
 				if (item_owner->sort_y) {
 					_mark_ysort_dirty(item_owner, canvas_item_owner);
 				}
+
+				if (item_owner->child_bvh) {
+					_remove_from_child_bvh(item_owner, canvas_item);
+				}
+				_mark_subtree_rect_dirty(item_owner);
 			}
 		}
 
 		for (int i = 0; i < canvas_item->child_items.size(); i++) {
 			canvas_item->child_items[i]->parent = RID();
+			canvas_item->child_items[i]->bvh_id = DynamicBVH::ID();
+		}
+
+		if (canvas_item->child_bvh) {
+			memdelete(canvas_item->child_bvh);
 		}
 
 		/*
@@ -31,6 +31,7 @@
 #ifndef RENDERING_SERVER_CANVAS_CULL_H
 #define RENDERING_SERVER_CANVAS_CULL_H
 
+#include "core/math/dynamic_bvh.h"
 #include "renderer_compositor.h"
 #include "renderer_viewport.h"
 
@@ -55,6 +56,18 @@ public:
 
 		Vector<Item *> child_items;
 
+		// Bounds of this item and all its visible descendants, in local space.
+		Rect2 subtree_rect;
+		bool subtree_rect_dirty;
+		bool subtree_has_rect;
+		// False when something in the subtree must be visited even if off-screen.
+		bool subtree_cullable;
+
+		// Only created for items with many children, used to skip off-screen ones.
+		DynamicBVH *child_bvh;
+		DynamicBVH::ID bvh_id; // Leaf in the parent's child_bvh.
+		Rect2 bvh_rect;
+
 		Item() {
 			children_order_dirty = true;
 			E = nullptr;
@@ -69,6 +82,10 @@ public:
 			ysort_xform = Transform2D();
 			ysort_pos = Vector2();
 			ysort_index = 0;
+			subtree_rect_dirty = true;
+			subtree_has_rect = false;
+			subtree_cullable = false;
+			child_bvh = nullptr;
 		}
 	};
 
@@ -157,6 +174,30 @@ public:
 	bool snapping_2d_transforms_to_pixel = false;
 
 private:
+	friend class RendererCanvasCullTester;
+
+	enum {
+		CHILD_BVH_MIN_CHILDREN = 64,
+	};
+
+	// Parents with fewer visible children than this are culled linearly.
+	int child_bvh_min_children = CHILD_BVH_MIN_CHILDREN;
+
+	struct ChildCullQuery {
+		LocalVector<Item *> *result;
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			result->push_back((Item *)p_data);
+			return false;
+		}
+	};
+
+	_FORCE_INLINE_ Item *_get_parent_item(const Item *p_item) {
+		return canvas_item_owner.owns(p_item->parent) ? canvas_item_owner.getornull(p_item->parent) : nullptr;
+	}
+	void _mark_subtree_rect_dirty(Item *p_item);
+	void _remove_from_child_bvh(Item *p_parent, Item *p_child);
+	void _update_subtree_rect(Item *p_item);
+
 	void _render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel);
 	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **z_list, RendererCanvasRender::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner);
 
@@ -318,6 +318,8 @@ void RenderForwardClustered::_render_list_template(RenderingDevice::DrawListID p
 	RID prev_pipeline_rd;
 	RID prev_xforms_uniform_set;
 
+	RendererStorageRD::RenderInfo render_info;
+
 	bool shadow_pass = (p_params->pass_mode == PASS_MODE_SHADOW) || (p_params->pass_mode == PASS_MODE_SHADOW_DP);
 
 	SceneState::PushConstant push_constant;
@@ -431,6 +433,7 @@ void RenderForwardClustered::_render_list_template(RenderingDevice::DrawListID p
 		if (prev_vertex_array_rd != vertex_array_rd) {
 			RD::get_singleton()->draw_list_bind_vertex_array(draw_list, vertex_array_rd);
 			prev_vertex_array_rd = vertex_array_rd;
+			render_info.surface_switch_count++;
 		}
 
 		if (prev_index_array_rd != index_array_rd) {
@@ -447,6 +450,7 @@ void RenderForwardClustered::_render_list_template(RenderingDevice::DrawListID p
 			// the pipeline may still be different.
 			RD::get_singleton()->draw_list_bind_render_pipeline(draw_list, pipeline_rd);
 			prev_pipeline_rd = pipeline_rd;
+			render_info.shader_switch_count++;
 		}
 
 		if (xforms_uniform_set.is_valid() && prev_xforms_uniform_set != xforms_uniform_set) {
@@ -461,14 +465,24 @@ void RenderForwardClustered::_render_list_template(RenderingDevice::DrawListID p
 			}
 
 			prev_material_uniform_set = material_uniform_set;
+			render_info.material_switch_count++;
 		}
 
 		RD::get_singleton()->draw_list_set_push_constant(draw_list, &push_constant, sizeof(SceneState::PushConstant));
 
-		uint32_t instance_count = surf->owner->instance_count > 1 ? surf->owner->instance_count : element_info.repeat;
+		// A run of equal elements may cross the end of this range when the list is split between threads,
+		// the next range starts drawing from the element it begins at.
+		uint32_t repeat = MIN(element_info.repeat, p_to_element - i);
+		uint32_t instance_count = surf->owner->instance_count > 1 ? surf->owner->instance_count : repeat;
 		RD::get_singleton()->draw_list_draw(draw_list, index_array_rd.is_valid(), instance_count);
-		i += element_info.repeat - 1; //skip equal elements
+		i += repeat - 1; //skip equal elements
+
+		render_info.object_count += repeat;
+		render_info.draw_call_count++;
+		render_info.draw_calls_saved += repeat - 1;
 	}
+
+	storage->render_info_add(render_info);
 }
 
 void RenderForwardClustered::_render_list(RenderingDevice::DrawListID p_draw_list, RenderingDevice::FramebufferFormatID p_framebuffer_Format, RenderListParameters *p_params, uint32_t p_from_element, uint32_t p_to_element) {
@@ -797,20 +811,26 @@ void RenderForwardClustered::_update_instance_data_buffer(RenderListType p_rende
 		RD::get_singleton()->buffer_update(scene_state.instance_buffer[p_render_list], 0, sizeof(SceneState::InstanceData) * scene_state.instance_data[p_render_list].size(), scene_state.instance_data[p_render_list].ptr(), RD::BARRIER_MASK_RASTER);
 	}
 }
-void RenderForwardClustered::_fill_instance_data(RenderListType p_render_list, uint32_t p_offset, int32_t p_max_elements, bool p_update_buffer) {
-	RenderList *rl = &render_list[p_render_list];
-	uint32_t element_total = p_max_elements >= 0 ? uint32_t(p_max_elements) : rl->elements.size();
 
-	scene_state.instance_data[p_render_list].resize(p_offset + element_total);
-	rl->element_info.resize(p_offset + element_total);
+void RenderForwardClustered::RenderList::sort_by_key_range(uint32_t p_from, uint32_t p_size) {
+	if (p_size < RADIX_SORT_MIN_ELEMENTS) {
+		SortArray<GeometryInstanceSurfaceDataCache *, SortByKey> sorter;
+		sorter.sort(elements.ptr() + p_from, p_size);
+		return;
+	}
 
-	uint32_t repeats = 0;
-	GeometryInstanceSurfaceDataCache *prev_surface = nullptr;
-	for (uint32_t i = 0; i < element_total; i++) {
-		GeometryInstanceSurfaceDataCache *surface = rl->elements[i + p_offset];
+	ThreadWorkPool *work_pool = p_size > thread_threshold ? &RendererThreadPool::singleton->thread_work_pool : nullptr;
+	radix_sorter.sort(elements.ptr() + p_from, p_size, work_pool);
+}
+
+void RenderForwardClustered::_fill_instance_data_range(RenderListType p_render_list, uint32_t p_from, uint32_t p_to) {
+	RenderList *rl = &render_list[p_render_list];
+
+	for (uint32_t i = p_from; i < p_to; i++) {
+		GeometryInstanceSurfaceDataCache *surface = rl->elements[i];
 		GeometryInstanceForwardClustered *inst = surface->owner;
 
-		SceneState::InstanceData &instance_data = scene_state.instance_data[p_render_list][i + p_offset];
+		SceneState::InstanceData &instance_data = scene_state.instance_data[p_render_list][i];
 
 		if (inst->store_transform_cache) {
 			RendererStorageRD::store_transform(inst->transform, instance_data.transform);
@@ -827,9 +847,49 @@ void RenderForwardClustered::_fill_instance_data(RenderListType p_render_list, u
 		instance_data.lightmap_uv_scale[2] = inst->lightmap_uv_scale.size.x;
 		instance_data.lightmap_uv_scale[3] = inst->lightmap_uv_scale.size.y;
 
-		bool cant_repeat = instance_data.flags & INSTANCE_DATA_FLAG_MULTIMESH || inst->mesh_instance.is_valid();
+		RenderElementInfo &element_info = rl->element_info[i];
 
-		if (prev_surface != nullptr && !cant_repeat && prev_surface->sort.sort_key1 == surface->sort.sort_key1 && prev_surface->sort.sort_key2 == surface->sort.sort_key2) {
+		element_info.repeat = 0;
+		element_info.lod_index = surface->sort.lod_index;
+		element_info.uses_forward_gi = surface->sort.uses_forward_gi;
+		element_info.uses_lightmap = surface->sort.uses_lightmap;
+	}
+}
+
+void RenderForwardClustered::_fill_instance_data_thread_function(uint32_t p_thread, FillInstanceDataParameters *p_params) {
+	uint32_t total_threads = RendererThreadPool::singleton->thread_work_pool.get_thread_count();
+	uint32_t from = p_params->offset + p_thread * p_params->element_total / total_threads;
+	uint32_t to = p_params->offset + ((p_thread + 1 == total_threads) ? p_params->element_total : ((p_thread + 1) * p_params->element_total / total_threads));
+	_fill_instance_data_range(p_params->render_list, from, to);
+}
+
+void RenderForwardClustered::_fill_instance_data(RenderListType p_render_list, uint32_t p_offset, int32_t p_max_elements, bool p_update_buffer) {
+	RenderList *rl = &render_list[p_render_list];
+	uint32_t element_total = p_max_elements >= 0 ? uint32_t(p_max_elements) : rl->elements.size();
+
+	scene_state.instance_data[p_render_list].resize(p_offset + element_total);
+	rl->element_info.resize(p_offset + element_total);
+
+	if (element_total > render_list_thread_threshold) {
+		FillInstanceDataParameters params;
+		params.render_list = p_render_list;
+		params.offset = p_offset;
+		params.element_total = element_total;
+		RendererThreadPool::singleton->thread_work_pool.do_work(RendererThreadPool::singleton->thread_work_pool.get_thread_count(), this, &RenderForwardClustered::_fill_instance_data_thread_function, &params);
+	} else {
+		_fill_instance_data_range(p_render_list, p_offset, p_offset + element_total);
+	}
+
+	// Repeats depend on neighbouring elements, so they are counted after the data is in place.
+	uint32_t repeats = 0;
+	GeometryInstanceSurfaceDataCache *prev_surface = nullptr;
+	for (uint32_t i = 0; i < element_total; i++) {
+		GeometryInstanceSurfaceDataCache *surface = rl->elements[i + p_offset];
+
+		bool cant_repeat = scene_state.instance_data[p_render_list][i + p_offset].flags & INSTANCE_DATA_FLAG_MULTIMESH || surface->owner->mesh_instance.is_valid();
+
+		// Mirrored instances use a different cull variant, so they can't share an instanced draw with regular ones.
+		if (prev_surface != nullptr && !cant_repeat && prev_surface->sort.sort_key1 == surface->sort.sort_key1 && prev_surface->sort.sort_key2 == surface->sort.sort_key2 && prev_surface->owner->mirror == surface->owner->mirror) {
 			//this element is the same as the previous one, count repeats to draw it using instancing
 			repeats++;
 		} else {
@@ -841,12 +901,6 @@ void RenderForwardClustered::_fill_instance_data(RenderListType p_render_list, u
 			repeats = 1;
 		}
 
-		RenderElementInfo &element_info = rl->element_info[p_offset + i];
-
-		element_info.lod_index = surface->sort.lod_index;
-		element_info.uses_forward_gi = surface->sort.uses_forward_gi;
-		element_info.uses_lightmap = surface->sort.uses_lightmap;
-
 		if (cant_repeat) {
 			prev_surface = nullptr;
 		} else {
@@ -865,44 +919,20 @@ void RenderForwardClustered::_fill_instance_data(RenderListType p_render_list, u
 	}
 }
 
-void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, const PagedArray<GeometryInstance *> &p_instances, PassMode p_pass_mode, const CameraMatrix &p_cam_projection, const Transform &p_cam_transform, bool p_using_sdfgi, bool p_using_opaque_gi, const Plane &p_lod_plane, float p_lod_distance_multiplier, float p_screen_lod_threshold, bool p_append) {
-	if (p_render_list == RENDER_LIST_OPAQUE) {
-		scene_state.used_sss = false;
-		scene_state.used_screen_texture = false;
-		scene_state.used_normal_texture = false;
-		scene_state.used_depth_texture = false;
-	}
-	uint32_t lightmap_captures_used = 0;
-
-	Plane near_plane(p_cam_transform.origin, -p_cam_transform.basis.get_axis(Vector3::AXIS_Z));
-	near_plane.d += p_cam_projection.get_z_near();
-	float z_max = p_cam_projection.get_z_far() - p_cam_projection.get_z_near();
+void RenderForwardClustered::_fill_render_list_range(const FillRenderListParameters *p_params, uint32_t p_from, uint32_t p_to, LocalVector<GeometryInstanceSurfaceDataCache *> &r_elements, LocalVector<GeometryInstanceSurfaceDataCache *> &r_alpha_elements, FillRenderListThreadData &r_data) {
+	for (uint32_t i = p_from; i < p_to; i++) {
+		GeometryInstanceForwardClustered *inst = static_cast<GeometryInstanceForwardClustered *>((*p_params->instances)[i]);
 
-	RenderList *rl = &render_list[p_render_list];
-	_update_dirty_geometry_instances();
-
-	if (!p_append) {
-		rl->clear();
-		if (p_render_list == RENDER_LIST_OPAQUE) {
-			render_list[RENDER_LIST_ALPHA].clear(); //opaque fills alpha too
-		}
-	}
-
-	//fill list
-
-	for (int i = 0; i < (int)p_instances.size(); i++) {
-		GeometryInstanceForwardClustered *inst = static_cast<GeometryInstanceForwardClustered *>(p_instances[i]);
-
-		Vector3 support_min = inst->transformed_aabb.get_support(-near_plane.normal);
-		inst->depth = near_plane.distance_to(support_min);
-		uint32_t depth_layer = CLAMP(int(inst->depth * 16 / z_max), 0, 15);
+		Vector3 support_min = inst->transformed_aabb.get_support(-p_params->near_plane.normal);
+		inst->depth = p_params->near_plane.distance_to(support_min);
+		uint32_t depth_layer = CLAMP(int(inst->depth * 16 / p_params->z_max), 0, 15);
 
 		uint32_t flags = inst->base_flags; //fill flags if appropriate
 
 		bool uses_lightmap = false;
 		bool uses_gi = false;
 
-		if (p_render_list == RENDER_LIST_OPAQUE) {
+		if (p_params->render_list == RENDER_LIST_OPAQUE) {
 			//setup GI
 
 			if (inst->lightmap_instance.is_valid()) {
@@ -926,23 +956,15 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 				}
 
 			} else if (inst->lightmap_sh) {
-				if (lightmap_captures_used < scene_state.max_lightmap_captures) {
-					const Color *src_capture = inst->lightmap_sh->sh;
-					LightmapCaptureData &lcd = scene_state.lightmap_captures[lightmap_captures_used];
-					for (int j = 0; j < 9; j++) {
-						lcd.sh[j * 4 + 0] = src_capture[j].r;
-						lcd.sh[j * 4 + 1] = src_capture[j].g;
-						lcd.sh[j * 4 + 2] = src_capture[j].b;
-						lcd.sh[j * 4 + 3] = src_capture[j].a;
-					}
+				//capture slot was assigned before filling, as captures are packed in list order
+				if (inst->lightmap_capture_index != 0xFFFFFFFF) {
 					flags |= INSTANCE_DATA_FLAG_USE_LIGHTMAP_CAPTURE;
-					inst->gi_offset_cache = lightmap_captures_used;
-					lightmap_captures_used++;
+					inst->gi_offset_cache = inst->lightmap_capture_index;
 					uses_lightmap = true;
 				}
 
 			} else {
-				if (p_using_opaque_gi) {
+				if (p_params->using_opaque_gi) {
 					flags |= INSTANCE_DATA_FLAG_USE_GI_BUFFERS;
 				}
 
@@ -967,7 +989,7 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 					flags |= INSTANCE_DATA_FLAG_USE_GIPROBE;
 					uses_gi = true;
 				} else {
-					if (p_using_sdfgi && inst->can_sdfgi) {
+					if (p_params->using_sdfgi && inst->can_sdfgi) {
 						flags |= INSTANCE_DATA_FLAG_USE_SDFGI;
 						uses_gi = true;
 					}
@@ -985,13 +1007,13 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 
 			// LOD
 
-			if (p_screen_lod_threshold > 0.0 && storage->mesh_surface_has_lod(surf->surface)) {
+			if (p_params->screen_lod_threshold > 0.0 && storage->mesh_surface_has_lod(surf->surface)) {
 				//lod
-				Vector3 lod_support_min = inst->transformed_aabb.get_support(-p_lod_plane.normal);
-				Vector3 lod_support_max = inst->transformed_aabb.get_support(p_lod_plane.normal);
+				Vector3 lod_support_min = inst->transformed_aabb.get_support(-p_params->lod_plane.normal);
+				Vector3 lod_support_max = inst->transformed_aabb.get_support(p_params->lod_plane.normal);
 
-				float distance_min = p_lod_plane.distance_to(lod_support_min);
-				float distance_max = p_lod_plane.distance_to(lod_support_max);
+				float distance_min = p_params->lod_plane.distance_to(lod_support_min);
+				float distance_max = p_params->lod_plane.distance_to(lod_support_max);
 
 				float distance = 0.0;
 
@@ -1004,18 +1026,18 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 					distance = -distance_max;
 				}
 
-				surf->sort.lod_index = storage->mesh_surface_get_lod(surf->surface, inst->lod_model_scale * inst->lod_bias, distance * p_lod_distance_multiplier, p_screen_lod_threshold);
+				surf->sort.lod_index = storage->mesh_surface_get_lod(surf->surface, inst->lod_model_scale * inst->lod_bias, distance * p_params->lod_distance_multiplier, p_params->screen_lod_threshold);
 			} else {
 				surf->sort.lod_index = 0;
 			}
 
 			// ADD Element
-			if (p_pass_mode == PASS_MODE_COLOR) {
+			if (p_params->pass_mode == PASS_MODE_COLOR) {
 				if (surf->flags & (GeometryInstanceSurfaceDataCache::FLAG_PASS_DEPTH | GeometryInstanceSurfaceDataCache::FLAG_PASS_OPAQUE)) {
-					rl->add_element(surf);
+					r_elements.push_back(surf);
 				}
 				if (surf->flags & GeometryInstanceSurfaceDataCache::FLAG_PASS_ALPHA) {
-					render_list[RENDER_LIST_ALPHA].add_element(surf);
+					r_alpha_elements.push_back(surf);
 					if (uses_gi) {
 						surf->sort.uses_forward_gi = 1;
 					}
@@ -1026,25 +1048,25 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 				}
 
 				if (surf->flags & GeometryInstanceSurfaceDataCache::FLAG_USES_SUBSURFACE_SCATTERING) {
-					scene_state.used_sss = true;
+					r_data.used_sss = true;
 				}
 				if (surf->flags & GeometryInstanceSurfaceDataCache::FLAG_USES_SCREEN_TEXTURE) {
-					scene_state.used_screen_texture = true;
+					r_data.used_screen_texture = true;
 				}
 				if (surf->flags & GeometryInstanceSurfaceDataCache::FLAG_USES_NORMAL_TEXTURE) {
-					scene_state.used_normal_texture = true;
+					r_data.used_normal_texture = true;
 				}
 				if (surf->flags & GeometryInstanceSurfaceDataCache::FLAG_USES_DEPTH_TEXTURE) {
-					scene_state.used_depth_texture = true;
+					r_data.used_depth_texture = true;
 				}
 
-			} else if (p_pass_mode == PASS_MODE_SHADOW || p_pass_mode == PASS_MODE_SHADOW_DP) {
+			} else if (p_params->pass_mode == PASS_MODE_SHADOW || p_params->pass_mode == PASS_MODE_SHADOW_DP) {
 				if (surf->flags & GeometryInstanceSurfaceDataCache::FLAG_PASS_SHADOW) {
-					rl->add_element(surf);
+					r_elements.push_back(surf);
 				}
 			} else {
 				if (surf->flags & (GeometryInstanceSurfaceDataCache::FLAG_PASS_DEPTH | GeometryInstanceSurfaceDataCache::FLAG_PASS_OPAQUE)) {
-					rl->add_element(surf);
+					r_elements.push_back(surf);
 				}
 			}
 
@@ -1053,6 +1075,108 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 			surf = surf->next;
 		}
 	}
+}
+
+void RenderForwardClustered::_merge_render_list_usage(const FillRenderListThreadData &p_data) {
+	scene_state.used_sss = scene_state.used_sss || p_data.used_sss;
+	scene_state.used_screen_texture = scene_state.used_screen_texture || p_data.used_screen_texture;
+	scene_state.used_normal_texture = scene_state.used_normal_texture || p_data.used_normal_texture;
+	scene_state.used_depth_texture = scene_state.used_depth_texture || p_data.used_depth_texture;
+}
+
+void RenderForwardClustered::_fill_render_list_thread_function(uint32_t p_thread, FillRenderListParameters *p_params) {
+	uint32_t total = p_params->instances->size();
+	uint32_t total_threads = RendererThreadPool::singleton->thread_work_pool.get_thread_count();
+	uint32_t from = p_thread * total / total_threads;
+	uint32_t to = (p_thread + 1 == total_threads) ? total : ((p_thread + 1) * total / total_threads);
+
+	FillRenderListThreadData &data = fill_render_list_thread_data[p_thread];
+	data.elements.clear();
+	data.alpha_elements.clear();
+	data.used_sss = false;
+	data.used_screen_texture = false;
+	data.used_normal_texture = false;
+	data.used_depth_texture = false;
+	_fill_render_list_range(p_params, from, to, data.elements, data.alpha_elements, data);
+}
+
+void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, const PagedArray<GeometryInstance *> &p_instances, PassMode p_pass_mode, const CameraMatrix &p_cam_projection, const Transform &p_cam_transform, bool p_using_sdfgi, bool p_using_opaque_gi, const Plane &p_lod_plane, float p_lod_distance_multiplier, float p_screen_lod_threshold, bool p_append) {
+	if (p_render_list == RENDER_LIST_OPAQUE) {
+		scene_state.used_sss = false;
+		scene_state.used_screen_texture = false;
+		scene_state.used_normal_texture = false;
+		scene_state.used_depth_texture = false;
+	}
+	uint32_t lightmap_captures_used = 0;
+
+	FillRenderListParameters params;
+	params.render_list = p_render_list;
+	params.instances = &p_instances;
+	params.pass_mode = p_pass_mode;
+	params.near_plane = Plane(p_cam_transform.origin, -p_cam_transform.basis.get_axis(Vector3::AXIS_Z));
+	params.near_plane.d += p_cam_projection.get_z_near();
+	params.z_max = p_cam_projection.get_z_far() - p_cam_projection.get_z_near();
+	params.using_sdfgi = p_using_sdfgi;
+	params.using_opaque_gi = p_using_opaque_gi;
+	params.lod_plane = p_lod_plane;
+	params.lod_distance_multiplier = p_lod_distance_multiplier;
+	params.screen_lod_threshold = p_screen_lod_threshold;
+
+	RenderList *rl = &render_list[p_render_list];
+	_update_dirty_geometry_instances();
+
+	if (!p_append) {
+		rl->clear();
+		if (p_render_list == RENDER_LIST_OPAQUE) {
+			render_list[RENDER_LIST_ALPHA].clear(); //opaque fills alpha too
+		}
+	}
+
+	if (p_render_list == RENDER_LIST_OPAQUE) {
+		//assign lightmap capture slots in list order, so the result does not depend on how the fill is split
+		for (uint32_t i = 0; i < p_instances.size(); i++) {
+			GeometryInstanceForwardClustered *inst = static_cast<GeometryInstanceForwardClustered *>(p_instances[i]);
+			if (inst->lightmap_instance.is_valid() || !inst->lightmap_sh) {
+				continue;
+			}
+
+			if (lightmap_captures_used < scene_state.max_lightmap_captures) {
+				const Color *src_capture = inst->lightmap_sh->sh;
+				LightmapCaptureData &lcd = scene_state.lightmap_captures[lightmap_captures_used];
+				for (int j = 0; j < 9; j++) {
+					lcd.sh[j * 4 + 0] = src_capture[j].r;
+					lcd.sh[j * 4 + 1] = src_capture[j].g;
+					lcd.sh[j * 4 + 2] = src_capture[j].b;
+					lcd.sh[j * 4 + 3] = src_capture[j].a;
+				}
+				inst->lightmap_capture_index = lightmap_captures_used;
+				lightmap_captures_used++;
+			} else {
+				inst->lightmap_capture_index = 0xFFFFFFFF;
+			}
+		}
+	}
+
+	//fill list
+
+	if (p_instances.size() > render_list_thread_threshold) {
+		uint32_t thread_count = RendererThreadPool::singleton->thread_work_pool.get_thread_count();
+		fill_render_list_thread_data.resize(thread_count);
+
+		RendererThreadPool::singleton->thread_work_pool.do_work(thread_count, this, &RenderForwardClustered::_fill_render_list_thread_function, &params);
+
+		//merge in thread order, so the list matches a single threaded fill
+		for (uint32_t i = 0; i < thread_count; i++) {
+			FillRenderListThreadData &data = fill_render_list_thread_data[i];
+			rl->append_elements(data.elements);
+			render_list[RENDER_LIST_ALPHA].append_elements(data.alpha_elements);
+			_merge_render_list_usage(data);
+		}
+	} else {
+		FillRenderListThreadData data;
+		_fill_render_list_range(&params, 0, p_instances.size(), rl->elements, render_list[RENDER_LIST_ALPHA].elements, data);
+		_merge_render_list_usage(data);
+	}
 
 	if (p_render_list == RENDER_LIST_OPAQUE && lightmap_captures_used) {
 		RD::get_singleton()->buffer_update(scene_state.lightmap_capture_buffer, 0, sizeof(LightmapCaptureData) * lightmap_captures_used, scene_state.lightmap_captures, RD::BARRIER_MASK_RASTER);
@@ -2875,6 +2999,9 @@ RenderForwardClustered::RenderForwardClustered(RendererStorageRD *p_storage) :
 	}
 
 	render_list_thread_threshold = GLOBAL_GET("rendering/limits/forward_renderer/threaded_render_minimum_instances");
+	for (int i = 0; i < RENDER_LIST_MAX; i++) {
+		render_list[i].thread_threshold = render_list_thread_threshold;
+	}
 }
 
 RenderForwardClustered::~RenderForwardClustered() {
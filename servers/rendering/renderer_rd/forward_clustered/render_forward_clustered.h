@@ -32,6 +32,7 @@
 #define RENDERING_SERVER_SCENE_RENDER_FORWARD_CLUSTERED_H
 
 #include "core/templates/paged_allocator.h"
+#include "core/templates/radix_sort.h"
 #include "servers/rendering/renderer_rd/forward_clustered/scene_shader_forward_clustered.h"
 #include "servers/rendering/renderer_rd/pipeline_cache_rd.h"
 #include "servers/rendering/renderer_rd/renderer_scene_render_rd.h"
@@ -372,8 +373,43 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 
 	uint32_t render_list_thread_threshold = 500;
 
+	struct FillInstanceDataParameters {
+		RenderListType render_list = RENDER_LIST_OPAQUE;
+		uint32_t offset = 0;
+		uint32_t element_total = 0;
+	};
+
+	struct FillRenderListParameters {
+		RenderListType render_list = RENDER_LIST_OPAQUE;
+		const PagedArray<GeometryInstance *> *instances = nullptr;
+		PassMode pass_mode = PASS_MODE_COLOR;
+		Plane near_plane;
+		float z_max = 0.0;
+		bool using_sdfgi = false;
+		bool using_opaque_gi = false;
+		Plane lod_plane;
+		float lod_distance_multiplier = 0.0;
+		float screen_lod_threshold = 0.0;
+	};
+
+	struct FillRenderListThreadData {
+		LocalVector<GeometryInstanceSurfaceDataCache *> elements;
+		LocalVector<GeometryInstanceSurfaceDataCache *> alpha_elements;
+		bool used_sss = false;
+		bool used_screen_texture = false;
+		bool used_normal_texture = false;
+		bool used_depth_texture = false;
+	};
+
+	LocalVector<FillRenderListThreadData> fill_render_list_thread_data;
+
 	void _update_instance_data_buffer(RenderListType p_render_list);
+	void _fill_instance_data_range(RenderListType p_render_list, uint32_t p_from, uint32_t p_to);
+	void _fill_instance_data_thread_function(uint32_t p_thread, FillInstanceDataParameters *p_params);
 	void _fill_instance_data(RenderListType p_render_list, uint32_t p_offset = 0, int32_t p_max_elements = -1, bool p_update_buffer = true);
+	void _fill_render_list_range(const FillRenderListParameters *p_params, uint32_t p_from, uint32_t p_to, LocalVector<GeometryInstanceSurfaceDataCache *> &r_elements, LocalVector<GeometryInstanceSurfaceDataCache *> &r_alpha_elements, FillRenderListThreadData &r_data);
+	void _fill_render_list_thread_function(uint32_t p_thread, FillRenderListParameters *p_params);
+	void _merge_render_list_usage(const FillRenderListThreadData &p_data);
 	void _fill_render_list(RenderListType p_render_list, const PagedArray<GeometryInstance *> &p_instances, PassMode p_pass_mode, const CameraMatrix &p_cam_projection, const Transform &p_cam_transform, bool p_using_sdfgi = false, bool p_using_opaque_gi = false, const Plane &p_lod_camera_plane = Plane(), float p_lod_distance_multiplier = 0.0, float p_screen_lod_threshold = 0.0, bool p_append = false);
 
 	Map<Size2i, RID> sdfgi_framebuffer_size_cache;
@@ -445,6 +481,7 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 		AABB transformed_aabb; //needed for LOD
 		float depth = 0;
 		uint32_t gi_offset_cache = 0;
+		uint32_t lightmap_capture_index = 0xFFFFFFFF;
 		uint32_t flags_cache = 0;
 		bool store_transform_cache = true;
 		int32_t shader_parameters_offset = -1;
@@ -515,22 +552,31 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 			element_info.clear();
 		}
 
-		//should eventually be replaced by radix
-
 		struct SortByKey {
 			_FORCE_INLINE_ bool operator()(const GeometryInstanceSurfaceDataCache *A, const GeometryInstanceSurfaceDataCache *B) const {
 				return (A->sort.sort_key2 == B->sort.sort_key2) ? (A->sort.sort_key1 < B->sort.sort_key1) : (A->sort.sort_key2 < B->sort.sort_key2);
 			}
 		};
 
-		void sort_by_key() {
-			SortArray<GeometryInstanceSurfaceDataCache *, SortByKey> sorter;
-			sorter.sort(elements.ptr(), elements.size());
-		}
+		// Same order as SortByKey, sort_key2 is the most significant word.
+		struct SortKey {
+			static _FORCE_INLINE_ uint64_t get_key(const GeometryInstanceSurfaceDataCache *p_element, uint32_t p_word) {
+				return p_word == 0 ? p_element->sort.sort_key1 : p_element->sort.sort_key2;
+			}
+		};
 
-		void sort_by_key_range(uint32_t p_from, uint32_t p_size) {
-			SortArray<GeometryInstanceSurfaceDataCache *, SortByKey> sorter;
-			sorter.sort(elements.ptr() + p_from, p_size);
+		// Large lists are radix sorted, on the renderer thread pool above thread_threshold.
+		enum {
+			RADIX_SORT_MIN_ELEMENTS = 256
+		};
+
+		uint32_t thread_threshold = 500;
+		RadixSortArray<GeometryInstanceSurfaceDataCache *, SortKey, 2> radix_sorter;
+
+		void sort_by_key_range(uint32_t p_from, uint32_t p_size);
+
+		void sort_by_key() {
+			sort_by_key_range(0, elements.size());
 		}
 
 		struct SortByDepth {
@@ -560,6 +606,15 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 		_FORCE_INLINE_ void add_element(GeometryInstanceSurfaceDataCache *p_element) {
 			elements.push_back(p_element);
 		}
+
+		void append_elements(const LocalVector<GeometryInstanceSurfaceDataCache *> &p_elements) {
+			if (p_elements.size() == 0) {
+				return;
+			}
+			uint32_t from = elements.size();
+			elements.resize(from + p_elements.size());
+			memcpy(elements.ptr() + from, p_elements.ptr(), p_elements.size() * sizeof(GeometryInstanceSurfaceDataCache *));
+		}
 	};
 
 	RenderList render_list[RENDER_LIST_MAX];
@@ -420,8 +420,8 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 	push_constant.color_texture_pixel_size[0] = 0;
 	push_constant.color_texture_pixel_size[1] = 0;
 
-	push_constant.pad[0] = 0;
-	push_constant.pad[1] = 0;
+	push_constant.batch_offset = 0;
+	push_constant.pad = 0;
 
 	push_constant.lights[0] = 0;
 	push_constant.lights[1] = 0;
@@ -462,14 +462,34 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 	RID last_texture;
 	Size2 texpixel_size;
 
+	bool batch_rects = state.rect_batch.active && light_mode == PIPELINE_LIGHT_MODE_DISABLED && pipeline_variants == &shader.pipeline_variants;
+
 	const Item::Command *c = p_item->commands;
 	while (c) {
 		push_constant.flags = base_flags | (push_constant.flags & (FLAGS_DEFAULT_NORMAL_MAP_USED | FLAGS_DEFAULT_SPECULAR_MAP_USED)); //reset on each command for sanity, keep canvastexture binding config
 
+		//batched rects carry their own transform, anything else that draws or changes state ends the batch
+		if (c->type != Item::Command::TYPE_RECT && c->type != Item::Command::TYPE_TRANSFORM && _flush_rect_batch(p_draw_list, p_framebuffer_format)) {
+			last_texture = RID(); //the batch bound its own texture
+		}
+
 		switch (c->type) {
 			case Item::Command::TYPE_RECT: {
 				const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
 
+				if (state.rect_batch.active) {
+					uint32_t batch_index = state.rect_batch.next++;
+
+					if (batch_rects && !(rect->flags & CANVAS_RECT_CLIP_UV)) {
+						_add_rect_to_batch(p_draw_list, p_framebuffer_format, batch_index, rect->texture, current_filter, current_repeat);
+						break;
+					}
+
+					if (_flush_rect_batch(p_draw_list, p_framebuffer_format)) {
+						last_texture = RID();
+					}
+				}
+
 				//bind pipeline
 				{
 					RID pipeline = pipeline_variants->variants[light_mode][PIPELINE_VARIANT_QUAD].get_render_pipeline(RD::INVALID_ID, p_framebuffer_format);
@@ -545,6 +565,8 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 				RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 				RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
 				RD::get_singleton()->draw_list_draw(p_draw_list, true);
+				state.render_info.object_count++;
+				state.render_info.draw_call_count++;
 
 			} break;
 
@@ -609,6 +631,8 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 				RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 				RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
 				RD::get_singleton()->draw_list_draw(p_draw_list, true);
+				state.render_info.object_count++;
+				state.render_info.draw_call_count++;
 
 				//restore if overrided
 				push_constant.color_texture_pixel_size[0] = texpixel_size.x;
@@ -654,6 +678,8 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 					RD::get_singleton()->draw_list_bind_index_array(p_draw_list, pb->indices);
 				}
 				RD::get_singleton()->draw_list_draw(p_draw_list, pb->indices.is_valid());
+				state.render_info.object_count++;
+				state.render_info.draw_call_count++;
 
 			} break;
 			case Item::Command::TYPE_PRIMITIVE: {
@@ -684,6 +710,8 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 				}
 				RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 				RD::get_singleton()->draw_list_draw(p_draw_list, true);
+				state.render_info.object_count++;
+				state.render_info.draw_call_count++;
 
 				if (primitive->point_count == 4) {
 					for (uint32_t j = 1; j < 3; j++) {
@@ -699,6 +727,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, const Item
 
 					RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 					RD::get_singleton()->draw_list_draw(p_draw_list, true);
+					state.render_info.draw_call_count++;
 				}
 
 			} break;
@@ -1160,10 +1189,15 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 
 	RD::FramebufferFormatID fb_format = RD::get_singleton()->framebuffer_get_format(framebuffer);
 
+	state.render_info = RendererStorageRD::RenderInfo();
+
+	//buffers can't be updated once the draw list begins
+	_update_rect_batch(p_item_count, canvas_transform_inverse);
+
 	RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(framebuffer, clear ? RD::INITIAL_ACTION_CLEAR : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_DISCARD, clear_colors);
 
 	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, fb_uniform_set, BASE_UNIFORM_SET);
-	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, state.default_transforms_uniform_set, TRANSFORMS_UNIFORM_SET);
+	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, state.rect_batch.active ? state.rect_batch.uniform_set : state.default_transforms_uniform_set, TRANSFORMS_UNIFORM_SET);
 
 	RID prev_material;
 
@@ -1173,6 +1207,8 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 		Item *ci = items[i];
 
 		if (current_clip != ci->final_clip_owner) {
+			_flush_rect_batch(draw_list, fb_format);
+
 			current_clip = ci->final_clip_owner;
 
 			//setup clip
@@ -1191,6 +1227,8 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 		}
 
 		if (material != prev_material) {
+			_flush_rect_batch(draw_list, fb_format);
+
 			MaterialData *material_data = nullptr;
 			if (material.is_valid()) {
 				material_data = (MaterialData *)storage->material_get_data(material, RendererStorageRD::SHADER_TYPE_2D);
@@ -1215,7 +1253,202 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 		prev_material = material;
 	}
 
+	_flush_rect_batch(draw_list, fb_format);
+
 	RD::get_singleton()->draw_list_end();
+
+	storage->render_info_add(state.render_info);
+}
+
+void RendererCanvasRenderRD::_update_rect_batch(int p_item_count, const Transform2D &p_canvas_transform_inverse) {
+	State::RectBatch &rb = state.rect_batch;
+	rb.active = false;
+	rb.count = 0;
+
+	if (!rb.enabled) {
+		return;
+	}
+
+	//gather the data of every rect command, in the same order _render_item() will find them
+	rb.rects.clear();
+
+	for (int i = 0; i < p_item_count; i++) {
+		const Item *ci = items[i];
+		Transform2D base_transform = p_canvas_transform_inverse * ci->final_transform;
+		Transform2D transform = base_transform;
+		Color base_color = ci->final_modulate;
+
+		const Item::Command *c = ci->commands;
+		while (c) {
+			if (c->type == Item::Command::TYPE_TRANSFORM) {
+				transform = base_transform * static_cast<const Item::CommandTransform *>(c)->xform;
+
+			} else if (c->type == Item::Command::TYPE_RECT) {
+				const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
+
+				State::BatchRect br;
+				_update_transform_2d_to_mat2x3(transform, br.world);
+				br.flags = 0;
+				br.pad = 0;
+
+				Rect2 src_rect;
+				Rect2 dst_rect(rect->rect.position, rect->rect.size);
+
+				if (dst_rect.size.width < 0) {
+					dst_rect.position.x += dst_rect.size.width;
+					dst_rect.size.width *= -1;
+				}
+				if (dst_rect.size.height < 0) {
+					dst_rect.position.y += dst_rect.size.height;
+					dst_rect.size.height *= -1;
+				}
+
+				if (rect->texture != RID()) {
+					//the texture size is only known when binding it, so regions are scaled in the shader
+					if (rect->flags & CANVAS_RECT_REGION) {
+						src_rect = rect->source;
+						br.flags |= FLAGS_BATCH_RECT_REGION;
+					} else {
+						src_rect = Rect2(0, 0, 1, 1);
+					}
+
+					if (rect->flags & CANVAS_RECT_FLIP_H) {
+						src_rect.size.x *= -1;
+					}
+
+					if (rect->flags & CANVAS_RECT_FLIP_V) {
+						src_rect.size.y *= -1;
+					}
+
+					if (rect->flags & CANVAS_RECT_TRANSPOSE) {
+						dst_rect.size.x *= -1; // Encoding in the dst_rect.z uniform
+					}
+				} else {
+					src_rect = Rect2(0, 0, 1, 1);
+				}
+
+				br.modulation[0] = rect->modulate.r * base_color.r;
+				br.modulation[1] = rect->modulate.g * base_color.g;
+				br.modulation[2] = rect->modulate.b * base_color.b;
+				br.modulation[3] = rect->modulate.a * base_color.a;
+
+				br.src_rect[0] = src_rect.position.x;
+				br.src_rect[1] = src_rect.position.y;
+				br.src_rect[2] = src_rect.size.width;
+				br.src_rect[3] = src_rect.size.height;
+
+				br.dst_rect[0] = dst_rect.position.x;
+				br.dst_rect[1] = dst_rect.position.y;
+				br.dst_rect[2] = dst_rect.size.width;
+				br.dst_rect[3] = dst_rect.size.height;
+
+				rb.rects.push_back(br);
+			}
+
+			c = c->next;
+		}
+	}
+
+	uint32_t rect_count = rb.rects.size();
+	if (rect_count < 2) {
+		return; //nothing to batch
+	}
+
+	//every render in a frame needs its own region, as all buffer updates happen before drawing starts
+	uint64_t frame = RendererCompositorRD::singleton->get_frame_number();
+	if (rb.frame != frame) {
+		rb.frame = frame;
+		rb.used = 0;
+	}
+
+	if (rb.used + rect_count > rb.capacity) {
+		if (rb.buffer.is_valid()) {
+			//regions used earlier this frame are kept alive until the frame is done, uniform set is freed by dependency
+			RD::get_singleton()->free(rb.buffer);
+		}
+
+		rb.capacity = MAX(next_power_of_2(rect_count), MAX(rb.capacity * 2, 1024u));
+		rb.used = 0;
+		rb.buffer = RD::get_singleton()->storage_buffer_create(rb.capacity * sizeof(State::BatchRect));
+
+		Vector<RD::Uniform> uniforms;
+		{
+			RD::Uniform u;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.binding = 0;
+			u.ids.push_back(rb.buffer);
+			uniforms.push_back(u);
+		}
+
+		rb.uniform_set = RD::get_singleton()->uniform_set_create(uniforms, shader.default_version_rd_shader, TRANSFORMS_UNIFORM_SET);
+	}
+
+	RD::get_singleton()->buffer_update(rb.buffer, rb.used * sizeof(State::BatchRect), rect_count * sizeof(State::BatchRect), rb.rects.ptr());
+
+	rb.next = rb.used;
+	rb.used += rect_count;
+	rb.active = true;
+}
+
+void RendererCanvasRenderRD::_add_rect_to_batch(RD::DrawListID p_draw_list, RD::FramebufferFormatID p_framebuffer_format, uint32_t p_index, RID p_texture, RS::CanvasItemTextureFilter p_filter, RS::CanvasItemTextureRepeat p_repeat) {
+	State::RectBatch &rb = state.rect_batch;
+
+	if (rb.count > 0 && (rb.texture != p_texture || rb.filter != p_filter || rb.repeat != p_repeat || rb.from + rb.count != p_index)) {
+		_flush_rect_batch(p_draw_list, p_framebuffer_format);
+	}
+
+	if (rb.count == 0) {
+		rb.from = p_index;
+		rb.texture = p_texture;
+		rb.filter = p_filter;
+		rb.repeat = p_repeat;
+	}
+
+	rb.count++;
+}
+
+bool RendererCanvasRenderRD::_flush_rect_batch(RD::DrawListID p_draw_list, RD::FramebufferFormatID p_framebuffer_format) {
+	State::RectBatch &rb = state.rect_batch;
+
+	if (rb.count == 0) {
+		return false;
+	}
+
+	PushConstant push_constant;
+	for (int i = 0; i < 6; i++) {
+		push_constant.world[i] = 0;
+	}
+	for (int i = 0; i < 4; i++) {
+		push_constant.modulation[i] = 0;
+		push_constant.ninepatch_margins[i] = 0;
+		push_constant.src_rect[i] = 0;
+		push_constant.dst_rect[i] = 0;
+		push_constant.lights[i] = 0;
+	}
+	push_constant.flags = 0;
+	push_constant.specular_shininess = 0;
+	push_constant.batch_offset = rb.from;
+	push_constant.pad = 0;
+
+	RID pipeline = shader.pipeline_variants.variants[PIPELINE_LIGHT_MODE_DISABLED][PIPELINE_VARIANT_QUAD].get_render_pipeline(RD::INVALID_ID, p_framebuffer_format);
+	RD::get_singleton()->draw_list_bind_render_pipeline(p_draw_list, pipeline);
+
+	RID last_texture;
+	Size2 texpixel_size;
+	_bind_canvas_texture(p_draw_list, rb.texture, rb.filter, rb.repeat, last_texture, push_constant, texpixel_size);
+
+	push_constant.flags |= FLAGS_BATCHED_RECTS;
+
+	RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
+	RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
+	RD::get_singleton()->draw_list_draw(p_draw_list, true, rb.count);
+
+	state.render_info.object_count += rb.count;
+	state.render_info.draw_call_count++;
+	state.render_info.draw_calls_saved += rb.count - 1;
+
+	rb.count = 0;
+	return true;
 }
 
 void RendererCanvasRenderRD::canvas_render_items(RID p_to_render_target, Item *p_item_list, const Color &p_modulate, Light *p_light_list, Light *p_directional_light_list, const Transform2D &p_canvas_transform, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, bool &r_sdf_used) {
@@ -2702,6 +2935,7 @@ RendererCanvasRenderRD::RendererCanvasRenderRD(RendererStorageRD *p_storage) {
 	storage->canvas_texture_initialize(default_canvas_texture);
 
 	state.shadow_texture_size = GLOBAL_GET("rendering/2d/shadow_atlas/size");
+	state.rect_batch.enabled = GLOBAL_GET("rendering/2d/batching/use_batching");
 
 	//create functions for shader and material
 	storage->shader_set_data_request_function(RendererStorageRD::SHADER_TYPE_2D, _create_shader_funcs);
@@ -2806,6 +3040,10 @@ RendererCanvasRenderRD::~RendererCanvasRenderRD() {
 	}
 	RD::get_singleton()->free(state.shadow_texture);
 
+	if (state.rect_batch.buffer.is_valid()) {
+		RD::get_singleton()->free(state.rect_batch.buffer);
+	}
+
 	storage->free(default_canvas_texture);
 	//pipelines don't need freeing, they are all gone after shaders are gone
 }
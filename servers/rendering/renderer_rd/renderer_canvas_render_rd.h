@@ -86,7 +86,10 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 		FLAGS_LIGHT_COUNT_SHIFT = 20,
 
 		FLAGS_DEFAULT_NORMAL_MAP_USED = (1 << 26),
-		FLAGS_DEFAULT_SPECULAR_MAP_USED = (1 << 27)
+		FLAGS_DEFAULT_SPECULAR_MAP_USED = (1 << 27),
+
+		FLAGS_BATCHED_RECTS = (1 << 28),
+		FLAGS_BATCH_RECT_REGION = (1 << 29)
 
 	};
 
@@ -377,6 +380,40 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 
 		RID default_transforms_uniform_set;
 
+		//rects drawn with the default shader are batched into instanced draws,
+		//reading their per rect data from the transforms storage buffer
+		struct BatchRect {
+			float world[6];
+			uint32_t flags;
+			uint32_t pad;
+			float modulation[4];
+			float src_rect[4]; //in pixels when FLAGS_BATCH_RECT_REGION is set
+			float dst_rect[4];
+		};
+
+		struct RectBatch {
+			bool enabled = true;
+			bool active = false; //data was uploaded for the items being rendered
+
+			RID buffer;
+			RID uniform_set;
+			uint32_t capacity = 0;
+			uint32_t used = 0; //rects uploaded during the current frame
+			uint64_t frame = 0;
+
+			LocalVector<BatchRect> rects;
+			uint32_t next = 0; //buffer index of the next rect command to render
+
+			//pending batch
+			uint32_t from = 0;
+			uint32_t count = 0;
+			RID texture;
+			RS::CanvasItemTextureFilter filter = RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT;
+			RS::CanvasItemTextureRepeat repeat = RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT;
+		} rect_batch;
+
+		RendererStorageRD::RenderInfo render_info;
+
 		uint32_t max_lights_per_render;
 		uint32_t max_lights_per_item;
 
@@ -395,7 +432,8 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 				float ninepatch_margins[4];
 				float dst_rect[4];
 				float src_rect[4];
-				float pad[2];
+				uint32_t batch_offset;
+				uint32_t pad;
 			};
 			//primitive
 			struct {
@@ -430,6 +468,10 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 	void _render_item(RenderingDevice::DrawListID p_draw_list, const Item *p_item, RenderingDevice::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants);
 	void _render_items(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights, bool p_to_backbuffer = false);
 
+	void _update_rect_batch(int p_item_count, const Transform2D &p_canvas_transform_inverse);
+	void _add_rect_to_batch(RenderingDevice::DrawListID p_draw_list, RenderingDevice::FramebufferFormatID p_framebuffer_format, uint32_t p_index, RID p_texture, RS::CanvasItemTextureFilter p_filter, RS::CanvasItemTextureRepeat p_repeat);
+	bool _flush_rect_batch(RenderingDevice::DrawListID p_draw_list, RenderingDevice::FramebufferFormatID p_framebuffer_format);
+
 	_FORCE_INLINE_ void _update_transform_2d_to_mat2x4(const Transform2D &p_transform, float *p_mat2x4);
 	_FORCE_INLINE_ void _update_transform_2d_to_mat2x3(const Transform2D &p_transform, float *p_mat2x3);
 
@@ -89,6 +89,8 @@ void RendererCompositorRD::begin_frame(double frame_step) {
 }
 
 void RendererCompositorRD::end_frame(bool p_swap_buffers) {
+	storage->render_info_end_frame();
+
 #ifndef _MSC_VER
 #warning TODO: likely pass a bool to swap buffers to avoid display?
 #endif
@@ -157,6 +159,8 @@ void RendererCompositorRD::initialize() {
 uint64_t RendererCompositorRD::frame = 1;
 
 void RendererCompositorRD::finalize() {
+	ShaderRD::shader_cache_save_index();
+
 	memdelete(scene);
 	memdelete(canvas);
 	memdelete(storage);
@@ -173,6 +177,11 @@ RendererCompositorRD::RendererCompositorRD() {
 	singleton = this;
 	time = 0;
 
+	if (GLOBAL_GET("rendering/shader_compiler/shader_cache/enabled")) {
+		ShaderRD::set_shader_cache_dir(OS::get_singleton()->get_user_data_dir().plus_file("shader_cache"));
+		ShaderRD::shader_cache_cleanup(uint64_t(int(GLOBAL_GET("rendering/shader_compiler/shader_cache/max_size_mb"))) * 1024 * 1024);
+	}
+
 	storage = memnew(RendererStorageRD);
 	canvas = memnew(RendererCanvasRenderRD(storage));
 	scene = memnew(RendererSceneRenderImplementation::RenderForwardClustered(storage));
@@ -7852,6 +7852,8 @@ void RendererStorageRD::global_variable_add(const StringName &p_name, RS::Global
 	}
 
 	global_variables.variables[p_name] = gv;
+
+	ShaderCompilerRD::invalidate_compile_caches();
 }
 
 void RendererStorageRD::global_variable_remove(const StringName &p_name) {
@@ -7868,6 +7870,8 @@ void RendererStorageRD::global_variable_remove(const StringName &p_name) {
 	}
 
 	global_variables.variables.erase(p_name);
+
+	ShaderCompilerRD::invalidate_compile_caches();
 }
 
 Vector<StringName> RendererStorageRD::global_variable_get_list() const {
@@ -8168,6 +8172,57 @@ void RendererStorageRD::update_dirty_resources() {
 	_update_decal_atlas();
 }
 
+uint64_t RendererStorageRD::RenderInfo::get(RS::RenderInfo p_info) const {
+	switch (p_info) {
+		case RS::INFO_OBJECTS_IN_FRAME:
+			return object_count;
+		case RS::INFO_MATERIAL_CHANGES_IN_FRAME:
+			return material_switch_count;
+		case RS::INFO_SHADER_CHANGES_IN_FRAME:
+			return shader_switch_count;
+		case RS::INFO_SURFACE_CHANGES_IN_FRAME:
+			return surface_switch_count;
+		case RS::INFO_DRAW_CALLS_IN_FRAME:
+			return draw_call_count;
+		case RS::INFO_DRAW_CALLS_SAVED_IN_FRAME:
+			return draw_calls_saved;
+		default:
+			return 0;
+	}
+}
+
+void RendererStorageRD::render_info_add(const RenderInfo &p_info) {
+	info.lock.lock();
+	info.render.add(p_info);
+	info.lock.unlock();
+}
+
+void RendererStorageRD::render_info_end_frame() {
+	info.render_final = info.render;
+	info.render = RenderInfo();
+}
+
+void RendererStorageRD::render_info_begin_capture() {
+	info.snap = info.render;
+}
+
+void RendererStorageRD::render_info_end_capture() {
+	info.capture.object_count = info.render.object_count - info.snap.object_count;
+	info.capture.draw_call_count = info.render.draw_call_count - info.snap.draw_call_count;
+	info.capture.draw_calls_saved = info.render.draw_calls_saved - info.snap.draw_calls_saved;
+	info.capture.material_switch_count = info.render.material_switch_count - info.snap.material_switch_count;
+	info.capture.shader_switch_count = info.render.shader_switch_count - info.snap.shader_switch_count;
+	info.capture.surface_switch_count = info.render.surface_switch_count - info.snap.surface_switch_count;
+}
+
+int RendererStorageRD::get_captured_render_info(RS::RenderInfo p_info) {
+	return info.capture.get(p_info);
+}
+
+uint64_t RendererStorageRD::get_render_info(RS::RenderInfo p_info) {
+	return info.render_final.get(p_info);
+}
+
 bool RendererStorageRD::has_os_feature(const String &p_feature) const {
 	if (p_feature == "rgtc" && RD::get_singleton()->texture_is_format_supported_for_usage(RD::DATA_FORMAT_BC5_UNORM_BLOCK, RD::TEXTURE_USAGE_SAMPLING_BIT)) {
 		return true;
@@ -31,6 +31,7 @@
 #ifndef RENDERING_SERVER_STORAGE_RD_H
 #define RENDERING_SERVER_STORAGE_RD_H
 
+#include "core/os/spin_lock.h"
 #include "core/templates/list.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid_owner.h"
@@ -2234,11 +2235,46 @@ public:
 
 	void set_debug_generate_wireframes(bool p_generate) {}
 
-	void render_info_begin_capture() {}
-	void render_info_end_capture() {}
-	int get_captured_render_info(RS::RenderInfo p_info) { return 0; }
+	/* RENDER INFO */
+
+	struct RenderInfo {
+		uint64_t object_count = 0;
+		uint64_t draw_call_count = 0;
+		uint64_t draw_calls_saved = 0;
+		uint64_t material_switch_count = 0;
+		uint64_t shader_switch_count = 0;
+		uint64_t surface_switch_count = 0;
+
+		_FORCE_INLINE_ void add(const RenderInfo &p_info) {
+			object_count += p_info.object_count;
+			draw_call_count += p_info.draw_call_count;
+			draw_calls_saved += p_info.draw_calls_saved;
+			material_switch_count += p_info.material_switch_count;
+			shader_switch_count += p_info.shader_switch_count;
+			surface_switch_count += p_info.surface_switch_count;
+		}
+
+		uint64_t get(RS::RenderInfo p_info) const;
+	};
+
+private:
+	struct Info {
+		SpinLock lock; // Render lists may be drawn from several threads.
+		RenderInfo render; // Accumulated during the current frame.
+		RenderInfo render_final; // Totals of the last finished frame.
+		RenderInfo snap; // Value of render when a capture began.
+		RenderInfo capture; // Counted between begin and end of the last capture.
+	} info;
+
+public:
+	void render_info_add(const RenderInfo &p_info);
+	void render_info_end_frame();
+
+	void render_info_begin_capture();
+	void render_info_end_capture();
+	int get_captured_render_info(RS::RenderInfo p_info);
 
-	uint64_t get_render_info(RS::RenderInfo p_info) { return 0; }
+	uint64_t get_render_info(RS::RenderInfo p_info);
 	String get_video_adapter_name() const { return String(); }
 	String get_video_adapter_vendor() const { return String(); }
 
@@ -1292,7 +1292,116 @@ ShaderLanguage::DataType ShaderCompilerRD::_get_variable_type(const StringName &
 	return RS::global_variable_type_get_shader_datatype(gvt);
 }
 
+uint64_t ShaderCompilerRD::compile_cache_version = 0;
+
+void ShaderCompilerRD::invalidate_compile_caches() {
+	compile_cache_version++;
+}
+
+void ShaderCompilerRD::_apply_cached_actions(const CompileCacheEntry &p_entry, IdentifierActions *p_actions) const {
+	// Same order as when dumping the shader node, so later render modes still win.
+	for (int i = 0; i < p_entry.render_modes.size(); i++) {
+		if (p_actions->render_mode_flags.has(p_entry.render_modes[i])) {
+			*p_actions->render_mode_flags[p_entry.render_modes[i]] = true;
+		}
+
+		if (p_actions->render_mode_values.has(p_entry.render_modes[i])) {
+			Pair<int *, int> &p = p_actions->render_mode_values[p_entry.render_modes[i]];
+			*p.first = p.second;
+		}
+	}
+
+	for (int i = 0; i < p_entry.usage_flags.size(); i++) {
+		if (p_actions->usage_flag_pointers.has(p_entry.usage_flags[i])) {
+			*p_actions->usage_flag_pointers[p_entry.usage_flags[i]] = true;
+		}
+	}
+
+	for (int i = 0; i < p_entry.write_flags.size(); i++) {
+		if (p_actions->write_flag_pointers.has(p_entry.write_flags[i])) {
+			*p_actions->write_flag_pointers[p_entry.write_flags[i]] = true;
+		}
+	}
+
+	if (p_actions->uniforms) {
+		for (const Map<StringName, SL::ShaderNode::Uniform>::Element *E = p_entry.uniforms.front(); E; E = E->next()) {
+			p_actions->uniforms->insert(E->key(), E->get());
+		}
+	}
+}
+
 Error ShaderCompilerRD::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	const String key = p_code.sha256_text();
+	CompileCacheEntry *cached = compile_cache.getptr(key);
+	if (cached && cached->mode == p_mode && cached->version == compile_cache_version) {
+		compile_cache_order.move_to_back(cached->order);
+		r_gen_code = cached->gen_code;
+		_apply_cached_actions(*cached, p_actions);
+		return OK;
+	}
+
+	// Compile against local flag storage, so the effects on p_actions can be recorded and replayed on cache hits.
+	Map<StringName, bool> usage_flags;
+	Map<StringName, bool> write_flags;
+	int unused_value = 0;
+	bool unused_flag = false;
+
+	IdentifierActions recording_actions;
+	recording_actions.entry_point_stages = p_actions->entry_point_stages;
+	for (const Map<StringName, Pair<int *, int>>::Element *E = p_actions->render_mode_values.front(); E; E = E->next()) {
+		recording_actions.render_mode_values[E->key()] = Pair<int *, int>(&unused_value, E->get().second);
+	}
+	for (const Map<StringName, bool *>::Element *E = p_actions->render_mode_flags.front(); E; E = E->next()) {
+		recording_actions.render_mode_flags[E->key()] = &unused_flag;
+	}
+	for (const Map<StringName, bool *>::Element *E = p_actions->usage_flag_pointers.front(); E; E = E->next()) {
+		recording_actions.usage_flag_pointers[E->key()] = &usage_flags[E->key()];
+	}
+	for (const Map<StringName, bool *>::Element *E = p_actions->write_flag_pointers.front(); E; E = E->next()) {
+		recording_actions.write_flag_pointers[E->key()] = &write_flags[E->key()];
+	}
+
+	CompileCacheEntry entry;
+	recording_actions.uniforms = &entry.uniforms;
+
+	Error err = _compile(p_mode, p_code, &recording_actions, p_path, r_gen_code);
+	if (err != OK) {
+		return err;
+	}
+
+	entry.mode = p_mode;
+	entry.version = compile_cache_version;
+	entry.gen_code = r_gen_code;
+	entry.render_modes = parser.get_shader()->render_modes;
+	for (const Map<StringName, bool>::Element *E = usage_flags.front(); E; E = E->next()) {
+		if (E->get()) {
+			entry.usage_flags.push_back(E->key());
+		}
+	}
+	for (const Map<StringName, bool>::Element *E = write_flags.front(); E; E = E->next()) {
+		if (E->get()) {
+			entry.write_flags.push_back(E->key());
+		}
+	}
+
+	_apply_cached_actions(entry, p_actions);
+
+	if (cached) {
+		entry.order = cached->order;
+		compile_cache_order.move_to_back(entry.order);
+	} else {
+		if (compile_cache_order.size() >= COMPILE_CACHE_MAX_ENTRIES) {
+			compile_cache.erase(compile_cache_order.front()->get());
+			compile_cache_order.pop_front();
+		}
+		entry.order = compile_cache_order.push_back(key);
+	}
+	compile_cache.set(key, entry);
+
+	return OK;
+}
+
+Error ShaderCompilerRD::_compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
 	Error err = parser.compile(p_code, ShaderTypes::get_singleton()->get_functions(p_mode), ShaderTypes::get_singleton()->get_modes(p_mode), ShaderLanguage::VaryingFunctionNames(), ShaderTypes::get_singleton()->get_types(), _get_variable_type);
 
 	if (err != OK) {
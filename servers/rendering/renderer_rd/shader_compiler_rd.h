@@ -31,6 +31,8 @@
 #ifndef SHADER_COMPILER_RD_H
 #define SHADER_COMPILER_RD_H
 
+#include "core/templates/hash_map.h"
+#include "core/templates/list.h"
 #include "core/templates/pair.h"
 #include "servers/rendering/shader_language.h"
 #include "servers/rendering/shader_types.h"
@@ -121,9 +123,37 @@ private:
 
 	static ShaderLanguage::DataType _get_variable_type(const StringName &p_type);
 
+	// Results of recently compiled sources, including the flags the compilation sets through IdentifierActions,
+	// so materials sharing the same code (e.g. generated by visual shaders) skip parsing and code generation.
+	struct CompileCacheEntry {
+		RS::ShaderMode mode = RS::SHADER_MAX;
+		uint64_t version = 0;
+		GeneratedCode gen_code;
+		Vector<StringName> render_modes;
+		Vector<StringName> usage_flags;
+		Vector<StringName> write_flags;
+		Map<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+		List<String>::Element *order = nullptr;
+	};
+
+	enum {
+		COMPILE_CACHE_MAX_ENTRIES = 1024
+	};
+
+	// Keyed by the SHA-256 of the source, least recently used entries first in the order list.
+	HashMap<String, CompileCacheEntry> compile_cache;
+	List<String> compile_cache_order;
+	static uint64_t compile_cache_version;
+
+	Error _compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
+	void _apply_cached_actions(const CompileCacheEntry &p_entry, IdentifierActions *p_actions) const;
+
 public:
 	Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
 
+	// Must be called when anything the generated code depends on outside the source changes, such as global uniforms.
+	static void invalidate_compile_caches();
+
 	void initialize(DefaultIdentifierActions p_actions);
 	ShaderCompilerRD();
 };
@@ -30,9 +30,22 @@
 
 #include "shader_rd.h"
 
+#include "core/crypto/crypto_core.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/version.h"
 #include "renderer_compositor_rd.h"
 #include "servers/rendering/rendering_device.h"
 
+#define SHADER_CACHE_FORMAT_VERSION 1
+#define SHADER_CACHE_INDEX_FILE "access_times.index"
+#define SHADER_CACHE_INDEX_VERSION 1
+
+bool ShaderRD::shader_cache_dir_valid = false;
+String ShaderRD::shader_cache_dir;
+Mutex ShaderRD::shader_cache_access_mutex;
+HashMap<String, uint64_t> ShaderRD::shader_cache_access_times;
+
 void ShaderRD::_add_stage(const char *p_code, StageType p_stage_type) {
 	Vector<String> lines = String(p_code).split("\n");
 
@@ -183,82 +196,165 @@ void ShaderRD::_compile_variant(uint32_t p_variant, Version *p_version) {
 		return; //variant is disabled, return
 	}
 
-	Vector<RD::ShaderStageData> stages;
-
-	String error;
-	String current_source;
-	RD::ShaderStage current_stage = RD::SHADER_STAGE_VERTEX;
-	bool build_ok = true;
+	RD::ShaderStage stage_types[2];
+	String sources[2];
+	uint32_t stage_count = 0;
 
 	if (!is_compute) {
-		//vertex stage
+		//vertex and fragment stages
+		stage_types[0] = RD::SHADER_STAGE_VERTEX;
+		stage_types[1] = RD::SHADER_STAGE_FRAGMENT;
+		stage_count = 2;
+
+		StringBuilder vertex_builder;
+		_build_variant_code(vertex_builder, p_variant, p_version, stage_templates[STAGE_TYPE_VERTEX]);
+		sources[0] = vertex_builder.as_string();
+
+		StringBuilder fragment_builder;
+		_build_variant_code(fragment_builder, p_variant, p_version, stage_templates[STAGE_TYPE_FRAGMENT]);
+		sources[1] = fragment_builder.as_string();
+	} else {
+		//compute stage
+		stage_types[0] = RD::SHADER_STAGE_COMPUTE;
+		stage_count = 1;
 
 		StringBuilder builder;
-		_build_variant_code(builder, p_variant, p_version, stage_templates[STAGE_TYPE_VERTEX]);
+		_build_variant_code(builder, p_variant, p_version, stage_templates[STAGE_TYPE_COMPUTE]);
+		sources[0] = builder.as_string();
+	}
 
-		current_source = builder.as_string();
-		RD::ShaderStageData stage;
-		stage.spir_v = RD::get_singleton()->shader_compile_from_source(RD::SHADER_STAGE_VERTEX, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
-		if (stage.spir_v.size() == 0) {
-			build_ok = false;
-		} else {
-			stage.shader_stage = RD::SHADER_STAGE_VERTEX;
-			stages.push_back(stage);
+	Vector<RD::ShaderStageData> stages;
+
+	String cache_path;
+	if (shader_cache_dir_valid) {
+		cache_path = _get_cache_file_path(sources, stage_count);
+		if (_load_from_cache(cache_path, stage_types, stage_count, stages)) {
+			cache_hits.increment();
 		}
 	}
 
-	if (!is_compute && build_ok) {
-		//fragment stage
-		current_stage = RD::SHADER_STAGE_FRAGMENT;
+	if (stages.is_empty()) {
+		cache_misses.increment();
 
-		StringBuilder builder;
-		_build_variant_code(builder, p_variant, p_version, stage_templates[STAGE_TYPE_FRAGMENT]);
+		String error;
+		uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
 
-		current_source = builder.as_string();
-		RD::ShaderStageData stage;
-		stage.spir_v = RD::get_singleton()->shader_compile_from_source(RD::SHADER_STAGE_FRAGMENT, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
-		if (stage.spir_v.size() == 0) {
-			build_ok = false;
-		} else {
-			stage.shader_stage = RD::SHADER_STAGE_FRAGMENT;
+		for (uint32_t i = 0; i < stage_count; i++) {
+			RD::ShaderStageData stage;
+			stage.spir_v = RD::get_singleton()->shader_compile_from_source(stage_types[i], sources[i], RD::SHADER_LANGUAGE_GLSL, &error);
+			if (stage.spir_v.size() == 0) {
+				MutexLock lock(variant_set_mutex); //properly print the errors
+				ERR_PRINT("Error compiling " + String(stage_types[i] == RD::SHADER_STAGE_COMPUTE ? "Compute " : (stage_types[i] == RD::SHADER_STAGE_VERTEX ? "Vertex" : "Fragment")) + " shader, variant #" + itos(p_variant) + " (" + variant_defines[p_variant].get_data() + ").");
+				ERR_PRINT(error);
+
+#ifdef DEBUG_ENABLED
+				ERR_PRINT("code:\n" + sources[i].get_with_code_lines());
+#endif
+				return;
+			}
+
+			stage.shader_stage = stage_types[i];
 			stages.push_back(stage);
 		}
+
+		compile_usec.add(OS::get_singleton()->get_ticks_usec() - begin_usec);
+
+		if (!cache_path.is_empty()) {
+			_save_to_cache(cache_path, stages);
+		}
 	}
 
-	if (is_compute) {
-		//compute stage
-		current_stage = RD::SHADER_STAGE_COMPUTE;
+	RID shader = RD::get_singleton()->shader_create(stages);
+	{
+		MutexLock lock(variant_set_mutex);
+		p_version->variants[p_variant] = shader;
+	}
+}
 
-		StringBuilder builder;
-		_build_variant_code(builder, p_variant, p_version, stage_templates[STAGE_TYPE_COMPUTE]);
+String ShaderRD::_get_cache_file_path(const String *p_sources, uint32_t p_source_count) const {
+	// The SPIR-V compiler picks its target and the subgroup defines it adds to the source from the device capabilities,
+	// so they go into the hash along with the engine and cache format versions. Vulkan 1.0 devices get no subgroup defines.
+	const RD::Capabilities *capabilities = RD::get_singleton()->get_device_capabilities();
+	const bool subgroups_used = !(capabilities->device_family == RD::DEVICE_VULKAN && capabilities->version_major == 1 && capabilities->version_minor == 0);
+	String key_prefix = String(VERSION_FULL_BUILD) + "|" + itos(SHADER_CACHE_FORMAT_VERSION) + "|" + itos(capabilities->device_family) + "|" + itos(capabilities->version_major) + "." + itos(capabilities->version_minor) + "|";
+	key_prefix += subgroups_used ? itos(capabilities->subgroup_in_shaders) + "|" + itos(capabilities->subgroup_operations) + "|" : String("-|-|");
+	CharString key_prefix_utf8 = key_prefix.utf8();
+
+	CryptoCore::SHA256Context ctx;
+	ctx.start();
+	ctx.update((const uint8_t *)key_prefix_utf8.get_data(), key_prefix_utf8.length());
+	for (uint32_t i = 0; i < p_source_count; i++) {
+		CharString source_utf8 = p_sources[i].utf8();
+		ctx.update((const uint8_t *)source_utf8.get_data(), source_utf8.length() + 1); // Include the terminator to separate stages.
+	}
+	unsigned char hash[32];
+	ctx.finish(hash);
 
-		current_source = builder.as_string();
+	// Relative to the cache directory.
+	return String(name).plus_file(String::hex_encode_buffer(hash, 32) + ".cache");
+}
+
+bool ShaderRD::_load_from_cache(const String &p_path, const RD::ShaderStage *p_stages, uint32_t p_stage_count, Vector<RD::ShaderStageData> &r_stages) const {
+	FileAccessRef f = FileAccess::open(shader_cache_dir.plus_file(p_path), FileAccess::READ);
+	if (!f) {
+		return false;
+	}
+
+	uint8_t header[4];
+	if (f->get_buffer(header, 4) != 4 || header[0] != 'G' || header[1] != 'S' || header[2] != 'C' || header[3] != 'F') {
+		return false;
+	}
+	if (f->get_32() != SHADER_CACHE_FORMAT_VERSION || f->get_32() != p_stage_count) {
+		return false;
+	}
 
+	for (uint32_t i = 0; i < p_stage_count; i++) {
 		RD::ShaderStageData stage;
-		stage.spir_v = RD::get_singleton()->shader_compile_from_source(RD::SHADER_STAGE_COMPUTE, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
-		if (stage.spir_v.size() == 0) {
-			build_ok = false;
-		} else {
-			stage.shader_stage = RD::SHADER_STAGE_COMPUTE;
-			stages.push_back(stage);
+		stage.shader_stage = RD::ShaderStage(f->get_32());
+		uint32_t size = f->get_32();
+		if (stage.shader_stage != p_stages[i] || size == 0 || size > f->get_len() - f->get_position()) {
+			r_stages.clear();
+			return false;
+		}
+		stage.spir_v.resize(size);
+		if (f->get_buffer(stage.spir_v.ptrw(), size) != (int)size) {
+			r_stages.clear();
+			return false;
 		}
+		r_stages.push_back(stage);
 	}
 
-	if (!build_ok) {
-		MutexLock lock(variant_set_mutex); //properly print the errors
-		ERR_PRINT("Error compiling " + String(current_stage == RD::SHADER_STAGE_COMPUTE ? "Compute " : (current_stage == RD::SHADER_STAGE_VERTEX ? "Vertex" : "Fragment")) + " shader, variant #" + itos(p_variant) + " (" + variant_defines[p_variant].get_data() + ").");
-		ERR_PRINT(error);
+	f->close();
 
-#ifdef DEBUG_ENABLED
-		ERR_PRINT("code:\n" + current_source.get_with_code_lines());
-#endif
-		return;
+	{
+		MutexLock lock(shader_cache_access_mutex);
+		shader_cache_access_times[p_path] = OS::get_singleton()->get_unix_time();
 	}
 
-	RID shader = RD::get_singleton()->shader_create(stages);
-	{
-		MutexLock lock(variant_set_mutex);
-		p_version->variants[p_variant] = shader;
+	return true;
+}
+
+void ShaderRD::_save_to_cache(const String &p_path, const Vector<RD::ShaderStageData> &p_stages) const {
+	// Each shader has its own subdirectory, it may not exist yet when its first variant is saved.
+	// Other threads can create it at the same time, that is not an error.
+	String path = shader_cache_dir.plus_file(p_path);
+	String dir = path.get_base_dir();
+	DirAccessRef d = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	if (d && !d->dir_exists(dir)) {
+		d->make_dir_recursive(dir);
+	}
+
+	// Files are written to a temporary path and renamed on close, so concurrent readers never see partial data.
+	FileAccessRef f = FileAccess::open(path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(!f, "Can't write shader cache file: " + path);
+
+	f->store_buffer((const uint8_t *)"GSCF", 4);
+	f->store_32(SHADER_CACHE_FORMAT_VERSION);
+	f->store_32(p_stages.size());
+	for (int i = 0; i < p_stages.size(); i++) {
+		f->store_32(p_stages[i].shader_stage);
+		f->store_32(p_stages[i].spir_v.size());
+		f->store_buffer(p_stages[i].spir_v.ptr(), p_stages[i].spir_v.size());
 	}
 }
 
@@ -322,7 +418,13 @@ void ShaderRD::_compile_version(Version *p_version) {
 	p_version->variants = memnew_arr(RID, variant_defines.size());
 #if 1
 
+	cache_hits.set(0);
+	cache_misses.set(0);
+	compile_usec.set(0);
+
 	RendererThreadPool::singleton->thread_work_pool.do_work(variant_defines.size(), this, &ShaderRD::_compile_variant, p_version);
+
+	print_verbose(String(name) + ": " + itos(cache_hits.get()) + " variants loaded from the shader cache, " + itos(cache_misses.get()) + " compiled in " + rtos(compile_usec.get() / 1000.0) + " msec (summed over threads).");
 #else
 	for (int i = 0; i < variant_defines.size(); i++) {
 		_compile_variant(i, p_version);
@@ -471,6 +573,139 @@ void ShaderRD::initialize(const Vector<String> &p_variant_defines, const String
 	}
 }
 
+void ShaderRD::set_shader_cache_dir(const String &p_dir) {
+	shader_cache_dir = p_dir;
+	shader_cache_dir_valid = false;
+
+	DirAccessRef d = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	ERR_FAIL_COND(!d);
+	if (!d->dir_exists(p_dir) && d->make_dir_recursive(p_dir) != OK) {
+		WARN_PRINT("Can't create shader cache directory, shader caching is disabled: " + p_dir);
+		return;
+	}
+
+	shader_cache_dir_valid = true;
+	print_verbose("Shader cache directory: " + p_dir);
+}
+
+void ShaderRD::_load_shader_cache_index() {
+	MutexLock lock(shader_cache_access_mutex);
+	shader_cache_access_times.clear();
+
+	FileAccessRef f = FileAccess::open(shader_cache_dir.plus_file(SHADER_CACHE_INDEX_FILE), FileAccess::READ);
+	if (!f || f->get_32() != SHADER_CACHE_INDEX_VERSION) {
+		return;
+	}
+	uint32_t count = f->get_32();
+	for (uint32_t i = 0; i < count && !f->eof_reached(); i++) {
+		String path = f->get_pascal_string();
+		uint64_t access_time = f->get_64();
+		if (!f->eof_reached()) {
+			shader_cache_access_times[path] = access_time;
+		}
+	}
+}
+
+void ShaderRD::shader_cache_save_index() {
+	if (!shader_cache_dir_valid) {
+		return;
+	}
+
+	MutexLock lock(shader_cache_access_mutex);
+	FileAccessRef f = FileAccess::open(shader_cache_dir.plus_file(SHADER_CACHE_INDEX_FILE), FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(!f, "Can't write shader cache index: " + shader_cache_dir.plus_file(SHADER_CACHE_INDEX_FILE));
+
+	f->store_32(SHADER_CACHE_INDEX_VERSION);
+	f->store_32(shader_cache_access_times.size());
+	const String *key = nullptr;
+	while ((key = shader_cache_access_times.next(key))) {
+		f->store_pascal_string(*key);
+		f->store_64(shader_cache_access_times[*key]);
+	}
+}
+
+void ShaderRD::shader_cache_cleanup(uint64_t p_max_size) {
+	ERR_FAIL_COND(!shader_cache_dir_valid);
+
+	_load_shader_cache_index();
+
+	struct CacheFile {
+		String path; // Relative to the cache directory.
+		uint64_t access_time = 0;
+		uint64_t size = 0;
+
+		bool operator<(const CacheFile &p_file) const { return access_time < p_file.access_time; }
+	};
+
+	LocalVector<CacheFile> files;
+	uint64_t total_size = 0;
+
+	// One subdirectory per shader, each holding one file per compiled variant.
+	DirAccessRef d = DirAccess::open(shader_cache_dir);
+	ERR_FAIL_COND(!d);
+	Vector<String> subdirs;
+	d->list_dir_begin();
+	for (String n = d->get_next(); !n.is_empty(); n = d->get_next()) {
+		if (d->current_is_dir() && n != "." && n != "..") {
+			subdirs.push_back(n);
+		}
+	}
+	d->list_dir_end();
+
+	MutexLock lock(shader_cache_access_mutex);
+	HashMap<String, uint64_t> access_times;
+
+	for (int i = 0; i < subdirs.size(); i++) {
+		DirAccessRef sd = DirAccess::open(shader_cache_dir.plus_file(subdirs[i]));
+		if (!sd) {
+			continue;
+		}
+		sd->list_dir_begin();
+		for (String n = sd->get_next(); !n.is_empty(); n = sd->get_next()) {
+			if (sd->current_is_dir() || n.get_extension() != "cache") {
+				continue;
+			}
+			CacheFile file;
+			file.path = subdirs[i].plus_file(n);
+			const String full_path = shader_cache_dir.plus_file(file.path);
+
+			// Files written since their last recorded hit are more recent than the index says.
+			file.access_time = FileAccess::get_modified_time(full_path);
+			const uint64_t *last_hit = shader_cache_access_times.getptr(file.path);
+			if (last_hit && *last_hit > file.access_time) {
+				file.access_time = *last_hit;
+			}
+
+			FileAccessRef f = FileAccess::open(full_path, FileAccess::READ);
+			if (f) {
+				file.size = f->get_len();
+			}
+			total_size += file.size;
+			files.push_back(file);
+		}
+		sd->list_dir_end();
+	}
+
+	// Evict the least recently used entries first.
+	files.sort();
+	uint32_t evicted = 0;
+	for (uint32_t i = 0; i < files.size(); i++) {
+		if (total_size > p_max_size && d->remove(shader_cache_dir.plus_file(files[i].path)) == OK) {
+			total_size -= files[i].size;
+			evicted++;
+		} else {
+			access_times[files[i].path] = files[i].access_time;
+		}
+	}
+
+	// Entries of files which no longer exist are dropped from the index.
+	shader_cache_access_times = access_times;
+
+	if (evicted) {
+		print_verbose("Shader cache: evicted " + itos(evicted) + " files, " + itos(total_size / 1024) + " KiB left.");
+	}
+}
+
 ShaderRD::~ShaderRD() {
 	List<RID> remaining;
 	version_owner.get_owned_list(&remaining);
@@ -37,7 +37,9 @@
 #include "core/templates/local_vector.h"
 #include "core/templates/map.h"
 #include "core/templates/rid_owner.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
+#include "servers/rendering/rendering_device.h"
 #include "servers/rendering_server.h"
 
 #include <stdio.h>
@@ -113,6 +115,25 @@ class ShaderRD {
 
 	void _add_stage(const char *p_code, StageType p_stage_type);
 
+	// On-disk SPIR-V cache, keyed by the hash of the final source of each variant.
+	static bool shader_cache_dir_valid;
+	static String shader_cache_dir;
+
+	// Last access time of each cache file, by path relative to the cache directory.
+	// Loaded by the startup cleanup, updated on cache hits and saved on exit, so hits never write to the cache files.
+	static Mutex shader_cache_access_mutex;
+	static HashMap<String, uint64_t> shader_cache_access_times;
+
+	SafeNumeric<uint32_t> cache_hits;
+	SafeNumeric<uint32_t> cache_misses;
+	SafeNumeric<uint64_t> compile_usec;
+
+	String _get_cache_file_path(const String *p_sources, uint32_t p_source_count) const;
+	bool _load_from_cache(const String &p_path, const RD::ShaderStage *p_stages, uint32_t p_stage_count, Vector<RD::ShaderStageData> &r_stages) const;
+	void _save_to_cache(const String &p_path, const Vector<RD::ShaderStageData> &p_stages) const;
+
+	static void _load_shader_cache_index();
+
 protected:
 	ShaderRD();
 	void setup(const char *p_vertex_code, const char *p_fragment_code, const char *p_compute_code, const char *p_name);
@@ -151,6 +172,11 @@ public:
 	RS::ShaderNativeSourceCode version_get_native_source_code(RID p_version);
 
 	void initialize(const Vector<String> &p_variant_defines, const String &p_general_defines = "");
+
+	static void set_shader_cache_dir(const String &p_dir);
+	static void shader_cache_cleanup(uint64_t p_max_size);
+	static void shader_cache_save_index();
+
 	virtual ~ShaderRD();
 };
 
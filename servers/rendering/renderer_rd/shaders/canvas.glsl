@@ -38,6 +38,9 @@ layout(set = 1, binding = 0, std140) uniform MaterialUniforms{
 
 void main() {
 	vec4 instance_custom = vec4(0.0);
+	vec2 world_x = draw_data.world_x;
+	vec2 world_y = draw_data.world_y;
+	vec2 world_ofs = draw_data.world_ofs;
 #ifdef USE_PRIMITIVE
 
 	//weird bug,
@@ -75,14 +78,34 @@ void main() {
 	vec2 vertex_base_arr[4] = vec2[](vec2(0.0, 0.0), vec2(0.0, 1.0), vec2(1.0, 1.0), vec2(1.0, 0.0));
 	vec2 vertex_base = vertex_base_arr[gl_VertexIndex];
 
-	vec2 uv = draw_data.src_rect.xy + abs(draw_data.src_rect.zw) * ((draw_data.flags & FLAGS_TRANSPOSE_RECT) != 0 ? vertex_base.yx : vertex_base.xy);
+	vec4 src_rect = draw_data.src_rect;
+	vec4 dst_rect = draw_data.dst_rect;
 	vec4 color = draw_data.modulation;
-	vec2 vertex = draw_data.dst_rect.xy + abs(draw_data.dst_rect.zw) * mix(vertex_base, vec2(1.0, 1.0) - vertex_base, lessThan(draw_data.src_rect.zw, vec2(0.0, 0.0)));
+	uint rect_flags = draw_data.flags;
+
+	if (bool(draw_data.flags & FLAGS_BATCHED_RECTS)) {
+		uint ofs = (draw_data.batch_offset + uint(gl_InstanceIndex)) * 5;
+		vec4 world = transforms.data[ofs + 0];
+		world_x = world.xy;
+		world_y = world.zw;
+		world_ofs = transforms.data[ofs + 1].xy;
+		rect_flags = floatBitsToUint(transforms.data[ofs + 1].z);
+		color = transforms.data[ofs + 2];
+		src_rect = transforms.data[ofs + 3];
+		dst_rect = transforms.data[ofs + 4];
+
+		if (bool(rect_flags & FLAGS_BATCH_RECT_REGION)) {
+			src_rect *= draw_data.color_texture_pixel_size.xyxy;
+		}
+	}
+
+	vec2 uv = src_rect.xy + abs(src_rect.zw) * ((rect_flags & FLAGS_TRANSPOSE_RECT) != 0 ? vertex_base.yx : vertex_base.xy);
+	vec2 vertex = dst_rect.xy + abs(dst_rect.zw) * mix(vertex_base, vec2(1.0, 1.0) - vertex_base, lessThan(src_rect.zw, vec2(0.0, 0.0)));
 	uvec4 bones = uvec4(0, 0, 0, 0);
 
 #endif
 
-	mat4 world_matrix = mat4(vec4(draw_data.world_x, 0.0, 0.0), vec4(draw_data.world_y, 0.0, 0.0), vec4(0.0, 0.0, 1.0, 0.0), vec4(draw_data.world_ofs, 0.0, 1.0));
+	mat4 world_matrix = mat4(vec4(world_x, 0.0, 0.0), vec4(world_y, 0.0, 0.0), vec4(0.0, 0.0, 1.0, 0.0), vec4(world_ofs, 0.0, 1.0));
 
 #if 0
 	if (draw_data.flags & FLAGS_INSTANCING_ENABLED) {
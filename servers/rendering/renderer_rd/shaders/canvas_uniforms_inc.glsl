@@ -26,6 +26,9 @@
 #define FLAGS_DEFAULT_NORMAL_MAP_USED (1 << 26)
 #define FLAGS_DEFAULT_SPECULAR_MAP_USED (1 << 27)
 
+#define FLAGS_BATCHED_RECTS (1 << 28)
+#define FLAGS_BATCH_RECT_REGION (1 << 29)
+
 #define SAMPLER_NEAREST_CLAMP 0
 #define SAMPLER_LINEAR_CLAMP 1
 #define SAMPLER_NEAREST_WITH_MIPMAPS_CLAMP 2
@@ -56,7 +59,8 @@ layout(push_constant, binding = 0, std430) uniform DrawData {
 	vec4 ninepatch_margins;
 	vec4 dst_rect; //for built-in rect and UV
 	vec4 src_rect;
-	vec2 pad;
+	uint batch_offset;
+	uint pad;
 
 #endif
 	vec2 color_texture_pixel_size;
@@ -149,6 +153,9 @@ global_variables;
 
 /* SET2: Instancing and Skeleton */
 
+// Also holds the per rect data of batched rects, 5 vec4 each:
+// world_x and world_y, world_ofs and flags, modulation, src_rect, dst_rect.
+
 layout(set = 2, binding = 0, std430) restrict readonly buffer Transforms {
 	vec4 data[];
 }
@@ -109,6 +109,43 @@ bool RendererSceneCull::is_camera(RID p_camera) const {
 	return camera_owner.owns(p_camera);
 }
 
+/* OCCLUDER API */
+
+RID RendererSceneCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RendererSceneCull::occluder_initialize(RID p_rid) {
+	occluder_owner.initialize_rid(p_rid, memnew(Occluder));
+}
+
+void RendererSceneCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.getornull(p_occluder);
+	ERR_FAIL_COND(!occluder);
+	ERR_FAIL_COND(p_indices.size() % 3 != 0);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+	occluder->aabb = AABB();
+
+	const Vector3 *r = p_vertices.ptr();
+	for (int i = 0; i < p_vertices.size(); i++) {
+		if (i == 0) {
+			occluder->aabb.position = r[i];
+		} else {
+			occluder->aabb.expand_to(r[i]);
+		}
+	}
+
+	for (Set<Instance *>::Element *E = occluder->users.front(); E; E = E->next()) {
+		_instance_queue_update(E->get(), true, false);
+	}
+}
+
+uint64_t RendererSceneCull::get_occluded_objects_in_frame() const {
+	return occluded_objects_in_frame;
+}
+
 /* SCENARIO API */
 
 void RendererSceneCull::_instance_pair(Instance *p_A, Instance *p_B) {
@@ -343,6 +380,30 @@ void RendererSceneCull::scenario_set_reflection_atlas_size(RID p_scenario, int p
 	scene_render->reflection_atlas_set_size(scenario->reflection_atlas, p_reflection_size, p_reflection_count);
 }
 
+void RendererSceneCull::scenario_set_pvs(RID p_scenario, const AABB &p_bounds, const Vector3i &p_cell_count, const Vector<uint8_t> &p_visibility) {
+	Scenario *scenario = scenario_owner.getornull(p_scenario);
+	ERR_FAIL_COND(!scenario);
+
+	scenario->pvs = Scenario::PVS();
+
+	if (p_visibility.is_empty()) {
+		return;
+	}
+
+	ERR_FAIL_COND(p_cell_count.x <= 0 || p_cell_count.y <= 0 || p_cell_count.z <= 0);
+	ERR_FAIL_COND(p_bounds.size.x <= 0 || p_bounds.size.y <= 0 || p_bounds.size.z <= 0);
+
+	uint32_t cells = p_cell_count.x * p_cell_count.y * p_cell_count.z;
+	uint32_t row_size = (cells + 7) / 8;
+	ERR_FAIL_COND_MSG(uint32_t(p_visibility.size()) != cells * row_size, "PVS visibility size does not match the cell count.");
+
+	scenario->pvs.bounds = p_bounds;
+	scenario->pvs.cell_count = p_cell_count;
+	scenario->pvs.inv_cell_size = Vector3(p_cell_count.x, p_cell_count.y, p_cell_count.z) / p_bounds.size;
+	scenario->pvs.row_size = row_size;
+	scenario->pvs.visibility = p_visibility;
+}
+
 bool RendererSceneCull::is_scenario(RID p_scenario) const {
 	return scenario_owner.owns(p_scenario);
 }
@@ -497,6 +558,17 @@ void RendererSceneCull::instance_set_base(RID p_instance, RID p_base) {
 				scene_render->free(gi_probe->probe_instance);
 
 			} break;
+			case RS::INSTANCE_OCCLUDER: {
+				InstanceOccluderData *occluder_data = static_cast<InstanceOccluderData *>(instance->base_data);
+				if (scenario && occluder_data->E) {
+					scenario->occluders.erase(occluder_data->E);
+					occluder_data->E = nullptr;
+				}
+				Occluder *occluder = occluder_owner.getornull(instance->base);
+				if (occluder) {
+					occluder->users.erase(instance);
+				}
+			} break;
 			default: {
 			}
 		}
@@ -513,7 +585,11 @@ void RendererSceneCull::instance_set_base(RID p_instance, RID p_base) {
 	instance->base = RID();
 
 	if (p_base.is_valid()) {
-		instance->base_type = RSG::storage->get_base_type(p_base);
+		if (occluder_owner.owns(p_base)) {
+			instance->base_type = RS::INSTANCE_OCCLUDER;
+		} else {
+			instance->base_type = RSG::storage->get_base_type(p_base);
+		}
 		ERR_FAIL_COND(instance->base_type == RS::INSTANCE_NONE);
 
 		switch (instance->base_type) {
@@ -588,6 +664,16 @@ void RendererSceneCull::instance_set_base(RID p_instance, RID p_base) {
 				gi_probe->probe_instance = scene_render->gi_probe_instance_create(p_base);
 
 			} break;
+			case RS::INSTANCE_OCCLUDER: {
+				InstanceOccluderData *occluder_data = memnew(InstanceOccluderData);
+				instance->base_data = occluder_data;
+
+				if (scenario) {
+					occluder_data->E = scenario->occluders.push_back(instance);
+				}
+
+				occluder_owner.getornull(p_base)->users.insert(instance);
+			} break;
 			default: {
 			}
 		}
@@ -598,8 +684,10 @@ void RendererSceneCull::instance_set_base(RID p_instance, RID p_base) {
 			_instance_update_mesh_instance(instance);
 		}
 
-		//forcefully update the dependency now, so if for some reason it gets removed, we can immediately clear it
-		RSG::storage->base_update_dependency(p_base, &instance->dependency_tracker);
+		if (instance->base_type != RS::INSTANCE_OCCLUDER) {
+			//forcefully update the dependency now, so if for some reason it gets removed, we can immediately clear it
+			RSG::storage->base_update_dependency(p_base, &instance->dependency_tracker);
+		}
 	}
 
 	_instance_queue_update(instance, true, true);
@@ -655,6 +743,13 @@ void RendererSceneCull::instance_set_scenario(RID p_instance, RID p_scenario) {
 					gi_probe_update_list.remove(&gi_probe->update_element);
 				}
 			} break;
+			case RS::INSTANCE_OCCLUDER: {
+				InstanceOccluderData *occluder_data = static_cast<InstanceOccluderData *>(instance->base_data);
+				if (occluder_data->E) {
+					instance->scenario->occluders.erase(occluder_data->E);
+					occluder_data->E = nullptr;
+				}
+			} break;
 			default: {
 			}
 		}
@@ -684,6 +779,10 @@ void RendererSceneCull::instance_set_scenario(RID p_instance, RID p_scenario) {
 					gi_probe_update_list.add(&gi_probe->update_element);
 				}
 			} break;
+			case RS::INSTANCE_OCCLUDER: {
+				InstanceOccluderData *occluder_data = static_cast<InstanceOccluderData *>(instance->base_data);
+				occluder_data->E = scenario->occluders.push_back(instance);
+			} break;
 			default: {
 			}
 		}
@@ -1047,9 +1146,48 @@ void RendererSceneCull::instance_geometry_set_material_override(RID p_instance,
 }
 
 void RendererSceneCull::instance_geometry_set_draw_range(RID p_instance, float p_min, float p_max, float p_min_margin, float p_max_margin) {
+	Instance *instance = instance_owner.getornull(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	instance->lod_begin = p_min;
+	instance->lod_end = p_max;
+	instance->lod_begin_hysteresis = p_min_margin;
+	instance->lod_end_hysteresis = p_max_margin;
+	instance->lod_range_checked = false;
+
+	if (instance->scenario && instance->array_index >= 0) {
+		InstanceData &idata = instance->scenario->instance_data[instance->array_index];
+
+		if (instance->lod_begin > 0.0 || instance->lod_end > 0.0) {
+			idata.flags |= InstanceData::FLAG_DRAW_RANGE;
+		} else {
+			idata.flags &= ~uint32_t(InstanceData::FLAG_DRAW_RANGE);
+		}
+	}
 }
 
 void RendererSceneCull::instance_geometry_set_as_instance_lod(RID p_instance, RID p_as_lod_of_instance) {
+	Instance *instance = instance_owner.getornull(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	Instance *parent = nullptr;
+	if (p_as_lod_of_instance.is_valid()) {
+		parent = instance_owner.getornull(p_as_lod_of_instance);
+		ERR_FAIL_COND(!parent);
+		ERR_FAIL_COND(parent == instance);
+		ERR_FAIL_COND_MSG(parent->lod_parent != nullptr, "An instance that is itself the LOD of another instance can't be used as LOD parent.");
+	}
+
+	if (instance->lod_parent) {
+		instance->lod_parent->lod_children.erase(instance);
+	}
+
+	instance->lod_parent = parent;
+	instance->lod_range_checked = false;
+
+	if (parent) {
+		parent->lod_children.insert(instance);
+	}
 }
 
 void RendererSceneCull::instance_geometry_set_lightmap(RID p_instance, RID p_lightmap, const Rect2 &p_lightmap_uv_scale, int p_slice_index) {
@@ -1153,6 +1291,34 @@ void RendererSceneCull::instance_geometry_get_shader_parameter_list(RID p_instan
 }
 
 void RendererSceneCull::_update_instance(Instance *p_instance) {
+	_update_instance_transformed_aabb(p_instance);
+
+	if (!_update_instance_bounds(p_instance)) {
+		return;
+	}
+
+	//move instance and repair
+	pair_pass++;
+
+	PairInstances pair;
+
+	pair.instance = p_instance;
+	pair.pair_allocator = &pair_allocator;
+	pair.pair_pass = pair_pass;
+	_instance_pair_setup(p_instance, pair.pair_mask, pair.bvh, pair.bvh2);
+
+	pair.pair();
+
+	p_instance->prev_transformed_aabb = p_instance->transformed_aabb;
+}
+
+void RendererSceneCull::_update_instance_transformed_aabb(Instance *p_instance) {
+	if (!p_instance->aabb.has_no_surface()) {
+		p_instance->transformed_aabb = p_instance->transform.xform(p_instance->aabb);
+	}
+}
+
+bool RendererSceneCull::_update_instance_bounds(Instance *p_instance) {
 	p_instance->version++;
 
 	if (p_instance->base_type == RS::INSTANCE_LIGHT) {
@@ -1213,7 +1379,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 	}
 
 	if (p_instance->aabb.has_no_surface()) {
-		return;
+		return false;
 	}
 
 	if (p_instance->base_type == RS::INSTANCE_LIGHTMAP) {
@@ -1227,10 +1393,6 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		}
 	}
 
-	AABB new_aabb;
-	new_aabb = p_instance->transform.xform(p_instance->aabb);
-	p_instance->transformed_aabb = new_aabb;
-
 	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
 		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
 		//make sure lights are updated if it casts shadow
@@ -1259,7 +1421,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 	// note: we had to remove is equal approx check here, it meant that det == 0.000004 won't work, which is the case for some of our scenes.
 	if (p_instance->scenario == nullptr || !p_instance->visible || p_instance->transform.basis.determinant() == 0) {
 		p_instance->prev_transformed_aabb = p_instance->transformed_aabb;
-		return;
+		return false;
 	}
 
 	//quantize to improve moving object performance
@@ -1337,6 +1499,9 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		if (p_instance->mesh_instance.is_valid()) {
 			idata.flags |= InstanceData::FLAG_USES_MESH_INSTANCE;
 		}
+		if (p_instance->lod_begin > 0.0 || p_instance->lod_end > 0.0) {
+			idata.flags |= InstanceData::FLAG_DRAW_RANGE;
+		}
 
 		p_instance->scenario->instance_data.push_back(idata);
 		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
@@ -1349,51 +1514,45 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
 	}
 
-	//move instance and repair
-	pair_pass++;
-
-	PairInstances pair;
+	return true;
+}
 
-	pair.instance = p_instance;
-	pair.pair_allocator = &pair_allocator;
-	pair.pair_pass = pair_pass;
-	pair.pair_mask = 0;
+void RendererSceneCull::_instance_pair_setup(Instance *p_instance, uint32_t &r_pair_mask, DynamicBVH *&r_bvh, DynamicBVH *&r_bvh2) {
+	r_pair_mask = 0;
+	r_bvh = nullptr;
+	r_bvh2 = nullptr;
 
 	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
-		pair.pair_mask |= 1 << RS::INSTANCE_LIGHT;
-		pair.pair_mask |= 1 << RS::INSTANCE_GI_PROBE;
-		pair.pair_mask |= 1 << RS::INSTANCE_LIGHTMAP;
+		r_pair_mask |= 1 << RS::INSTANCE_LIGHT;
+		r_pair_mask |= 1 << RS::INSTANCE_GI_PROBE;
+		r_pair_mask |= 1 << RS::INSTANCE_LIGHTMAP;
 
-		pair.pair_mask |= geometry_instance_pair_mask;
+		r_pair_mask |= geometry_instance_pair_mask;
 
-		pair.bvh2 = &p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES];
+		r_bvh2 = &p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES];
 	} else if (p_instance->base_type == RS::INSTANCE_LIGHT) {
-		pair.pair_mask |= RS::INSTANCE_GEOMETRY_MASK;
-		pair.bvh = &p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY];
+		r_pair_mask |= RS::INSTANCE_GEOMETRY_MASK;
+		r_bvh = &p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY];
 
 		if (RSG::storage->light_get_bake_mode(p_instance->base) == RS::LIGHT_BAKE_DYNAMIC) {
-			pair.pair_mask |= (1 << RS::INSTANCE_GI_PROBE);
-			pair.bvh2 = &p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES];
+			r_pair_mask |= (1 << RS::INSTANCE_GI_PROBE);
+			r_bvh2 = &p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES];
 		}
 	} else if (geometry_instance_pair_mask & (1 << RS::INSTANCE_REFLECTION_PROBE) && (p_instance->base_type == RS::INSTANCE_REFLECTION_PROBE)) {
-		pair.pair_mask = RS::INSTANCE_GEOMETRY_MASK;
-		pair.bvh = &p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY];
+		r_pair_mask = RS::INSTANCE_GEOMETRY_MASK;
+		r_bvh = &p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY];
 	} else if (geometry_instance_pair_mask & (1 << RS::INSTANCE_DECAL) && (p_instance->base_type == RS::INSTANCE_DECAL)) {
-		pair.pair_mask = RS::INSTANCE_GEOMETRY_MASK;
-		pair.bvh = &p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY];
+		r_pair_mask = RS::INSTANCE_GEOMETRY_MASK;
+		r_bvh = &p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY];
 	} else if (p_instance->base_type == RS::INSTANCE_PARTICLES_COLLISION) {
-		pair.pair_mask = (1 << RS::INSTANCE_PARTICLES);
-		pair.bvh = &p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY];
+		r_pair_mask = (1 << RS::INSTANCE_PARTICLES);
+		r_bvh = &p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY];
 	} else if (p_instance->base_type == RS::INSTANCE_GI_PROBE) {
 		//lights and geometries
-		pair.pair_mask = RS::INSTANCE_GEOMETRY_MASK | (1 << RS::INSTANCE_LIGHT);
-		pair.bvh = &p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY];
-		pair.bvh2 = &p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES];
+		r_pair_mask = RS::INSTANCE_GEOMETRY_MASK | (1 << RS::INSTANCE_LIGHT);
+		r_bvh = &p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY];
+		r_bvh2 = &p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES];
 	}
-
-	pair.pair();
-
-	p_instance->prev_transformed_aabb = p_instance->transformed_aabb;
 }
 
 void RendererSceneCull::_unpair_instance(Instance *p_instance) {
@@ -1506,6 +1665,13 @@ void RendererSceneCull::_update_instance_aabb(Instance *p_instance) {
 		case RenderingServer::INSTANCE_LIGHTMAP: {
 			new_aabb = RSG::storage->lightmap_get_aabb(p_instance->base);
 
+		} break;
+		case RenderingServer::INSTANCE_OCCLUDER: {
+			Occluder *occluder = occluder_owner.getornull(p_instance->base);
+			if (occluder) {
+				new_aabb = occluder->aabb;
+			}
+
 		} break;
 		default: {
 		}
@@ -2274,7 +2440,12 @@ void RendererSceneCull::_frustum_cull(FrustumCullData &cull_data, FrustumCullRes
 	for (uint64_t i = p_from; i < p_to; i++) {
 		bool mesh_visible = false;
 
-		if (cull_data.scenario->instance_aabbs[i].in_frustum(cull_data.cull->frustum)) {
+		//out of its draw range, also skipped for directional shadows so HLOD proxies don't double them up.
+		//omni and spot shadows are cached and not redrawn when the camera moves, and SDFGI regions are
+		//voxelized once for all cameras, so they ignore draw ranges
+		bool in_draw_range = !(cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_DRAW_RANGE) || _instance_in_draw_range(cull_data.scenario->instance_data[i].instance, cull_data.cam_transform.origin);
+
+		if (in_draw_range && cull_data.scenario->instance_aabbs[i].in_frustum(cull_data.cull->frustum)) {
 			InstanceData &idata = cull_data.scenario->instance_data[i];
 			uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 
@@ -2321,6 +2492,12 @@ void RendererSceneCull::_frustum_cull(FrustumCullData &cull_data, FrustumCullRes
 
 			} else if (base_type == RS::INSTANCE_LIGHTMAP) {
 				cull_result.gi_probes.push_back(RID::from_uint64(idata.instance_data_rid));
+			} else if (cull_data.pvs_row && ((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && !cull_data.scenario->pvs.is_visible(cull_data.pvs_row, cull_data.scenario->instance_aabbs[i].bounds)) {
+				//not in a cell visible from the camera cell
+				cull_result.occluded_count++;
+			} else if (cull_data.occlusion_buffer && ((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds)) {
+				//hidden behind occluders, still allowed to cast shadows below
+				cull_result.occluded_count++;
 			} else if (((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && !(idata.flags & InstanceData::FLAG_CAST_SHADOWS_ONLY)) {
 				bool keep = true;
 
@@ -2426,7 +2603,7 @@ void RendererSceneCull::_frustum_cull(FrustumCullData &cull_data, FrustumCullRes
 			}
 		}
 
-		for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
+		for (uint32_t j = 0; in_draw_range && j < cull_data.cull->shadow_count; j++) {
 			for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
 				if (cull_data.scenario->instance_aabbs[i].in_frustum(cull_data.cull->shadows[j].cascades[k].frustum)) {
 					InstanceData &idata = cull_data.scenario->instance_data[i];
@@ -2560,6 +2737,38 @@ void RendererSceneCull::_render_scene(const Transform p_cam_transform, const Cam
 		}
 	}
 
+	const RendererSceneOcclusionCull *occlusion = nullptr;
+
+	if (use_occlusion_culling && !render_reflection_probe && scenario->occluders.size()) {
+		RENDER_TIMESTAMP("Render Occluders");
+
+		occlusion_buffer.begin(occlusion_buffer_width, p_cam_transform, p_cam_projection);
+
+		for (List<Instance *>::Element *E = scenario->occluders.front(); E; E = E->next()) {
+			Instance *ins = E->get();
+			if (!ins->visible || !(ins->layer_mask & p_visible_layers)) {
+				continue;
+			}
+
+			if (!InstanceBounds(ins->transformed_aabb).in_frustum(cull.frustum)) {
+				continue;
+			}
+
+			Occluder *occluder = occluder_owner.getornull(ins->base);
+			if (!occluder || occluder->indices.is_empty()) {
+				continue;
+			}
+
+			occlusion_buffer.add_occluder(ins->transform, occluder->vertices.ptr(), occluder->vertices.size(), occluder->indices.ptr(), occluder->indices.size());
+		}
+
+		occlusion_buffer.end();
+
+		if (occlusion_buffer.is_active()) {
+			occlusion = &occlusion_buffer;
+		}
+	}
+
 	frustum_cull_result.clear();
 
 	{
@@ -2575,6 +2784,8 @@ void RendererSceneCull::_render_scene(const Transform p_cam_transform, const Cam
 		cull_data.cam_transform = p_cam_transform;
 		cull_data.visible_layers = p_visible_layers;
 		cull_data.render_reflection_probe = render_reflection_probe;
+		cull_data.occlusion_buffer = occlusion;
+		cull_data.pvs_row = (!render_reflection_probe && !scenario->pvs.is_empty()) ? scenario->pvs.get_cell_row(p_cam_transform.origin) : nullptr;
 //#define DEBUG_CULL_TIME
 #ifdef DEBUG_CULL_TIME
 		uint64_t time_from = OS::get_singleton()->get_ticks_usec();
@@ -2604,6 +2815,10 @@ void RendererSceneCull::_render_scene(const Transform p_cam_transform, const Cam
 		print_line("time taken: " + rtos(time_avg / time_count));
 #endif
 
+		if (!render_reflection_probe) {
+			occluded_objects_in_frame = frustum_cull_result.occluded_count;
+		}
+
 		if (frustum_cull_result.mesh_instances.size()) {
 			for (uint64_t i = 0; i < frustum_cull_result.mesh_instances.size(); i++) {
 				RSG::storage->mesh_instance_check_for_update(frustum_cull_result.mesh_instances[i]);
@@ -3215,6 +3430,11 @@ void RendererSceneCull::_update_instance_shader_parameters_from_material(Map<Str
 }
 
 void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
+	_update_dirty_instance_data(p_instance);
+	_update_instance(p_instance);
+}
+
+void RendererSceneCull::_update_dirty_instance_data(Instance *p_instance) {
 	if (p_instance->update_aabb) {
 		_update_instance_aabb(p_instance);
 	}
@@ -3222,7 +3442,7 @@ void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
 	if (p_instance->update_dependencies) {
 		p_instance->dependency_tracker.update_begin();
 
-		if (p_instance->base.is_valid()) {
+		if (p_instance->base.is_valid() && p_instance->base_type != RS::INSTANCE_OCCLUDER) {
 			RSG::storage->base_update_dependency(p_instance->base, &p_instance->dependency_tracker);
 		}
 
@@ -3424,17 +3644,99 @@ void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
 
 	_instance_update_list.remove(&p_instance->update_item);
 
-	_update_instance(p_instance);
-
+	// cleared here, so anything queued again while updating bounds or pairing is picked up next round
 	p_instance->update_aabb = false;
 	p_instance->update_dependencies = false;
 }
 
+void RendererSceneCull::_update_instance_batch_transforms_threaded(uint32_t p_thread, void *p_userdata) {
+	uint32_t total = instance_update_batch.size();
+	uint32_t total_threads = RendererThreadPool::singleton->thread_work_pool.get_thread_count();
+	uint32_t from = p_thread * total / total_threads;
+	uint32_t to = (p_thread + 1 == total_threads) ? total : ((p_thread + 1) * total / total_threads);
+
+	for (uint32_t i = from; i < to; i++) {
+		_update_instance_transformed_aabb(instance_update_batch[i]);
+	}
+}
+
+void RendererSceneCull::_update_instance_batch_pairs_threaded(uint32_t p_thread, void *p_userdata) {
+	uint32_t total = instance_pair_queries.size();
+	uint32_t total_threads = RendererThreadPool::singleton->thread_work_pool.get_thread_count();
+	uint32_t from = p_thread * total / total_threads;
+	uint32_t to = (p_thread + 1 == total_threads) ? total : ((p_thread + 1) * total / total_threads);
+
+	for (uint32_t i = from; i < to; i++) {
+		instance_pair_queries[i].query();
+	}
+}
+
+void RendererSceneCull::_update_dirty_instances_threaded() {
+	// Dependencies and base AABBs go through storage, which is not thread safe.
+	instance_update_batch.clear();
+	while (_instance_update_list.first()) {
+		Instance *instance = _instance_update_list.first()->self();
+		_update_dirty_instance_data(instance);
+		instance_update_batch.push_back(instance);
+	}
+
+	uint32_t thread_count = RendererThreadPool::singleton->thread_work_pool.get_thread_count();
+
+	RendererThreadPool::singleton->thread_work_pool.do_work(thread_count, this, &RendererSceneCull::_update_instance_batch_transforms_threaded, (void *)nullptr);
+
+	// Renderer state and BVH changes are applied serially, so the pair queries below see the final tree.
+	instance_pair_queries.clear();
+	for (uint32_t i = 0; i < instance_update_batch.size(); i++) {
+		Instance *instance = instance_update_batch[i];
+		if (!_update_instance_bounds(instance)) {
+			continue;
+		}
+
+		instance_pair_queries.resize(instance_pair_queries.size() + 1);
+		PairQuery &query = instance_pair_queries[instance_pair_queries.size() - 1];
+		query.instance = instance;
+		query.found.clear();
+		_instance_pair_setup(instance, query.pair_mask, query.bvh, query.bvh2);
+	}
+
+	RendererThreadPool::singleton->thread_work_pool.do_work(thread_count, this, &RendererSceneCull::_update_instance_batch_pairs_threaded, (void *)nullptr);
+
+	// Merge in batch order, which keeps pairing deterministic regardless of thread scheduling.
+	for (uint32_t i = 0; i < instance_pair_queries.size(); i++) {
+		PairQuery &query = instance_pair_queries[i];
+
+		pair_pass++;
+
+		PairInstances pair;
+		pair.instance = query.instance;
+		pair.pair_allocator = &pair_allocator;
+		pair.pair_pass = pair_pass;
+		pair.pair_mask = query.pair_mask;
+
+		for (uint32_t j = 0; j < query.found.size(); j++) {
+			pair.add_pair(query.found[j]);
+		}
+
+		pair.pair();
+
+		query.instance->prev_transformed_aabb = query.instance->transformed_aabb;
+	}
+}
+
 void RendererSceneCull::update_dirty_instances() {
 	RSG::storage->update_dirty_resources();
 
 	while (_instance_update_list.first()) {
-		_update_dirty_instance(_instance_update_list.first()->self());
+		uint32_t pending = 0;
+		for (SelfList<Instance> *E = _instance_update_list.first(); E && pending < thread_update_threshold; E = E->next()) {
+			pending++;
+		}
+
+		if (pending >= thread_update_threshold) {
+			_update_dirty_instances_threaded();
+		} else {
+			_update_dirty_instance(_instance_update_list.first()->self());
+		}
 	}
 }
 
@@ -3461,6 +3763,16 @@ bool RendererSceneCull::free(RID p_rid) {
 		camera_owner.free(p_rid);
 		memdelete(camera);
 
+	} else if (occluder_owner.owns(p_rid)) {
+		Occluder *occluder = occluder_owner.getornull(p_rid);
+
+		while (occluder->users.front()) {
+			instance_set_base(occluder->users.front()->get()->self, RID());
+		}
+
+		occluder_owner.free(p_rid);
+		memdelete(occluder);
+
 	} else if (scenario_owner.owns(p_rid)) {
 		Scenario *scenario = scenario_owner.getornull(p_rid);
 
@@ -3483,6 +3795,10 @@ bool RendererSceneCull::free(RID p_rid) {
 		Instance *instance = instance_owner.getornull(p_rid);
 
 		instance_geometry_set_lightmap(p_rid, RID(), Rect2(), 0);
+		instance_geometry_set_as_instance_lod(p_rid, RID());
+		while (instance->lod_children.front()) {
+			instance_geometry_set_as_instance_lod(instance->lod_children.front()->get()->self, RID());
+		}
 		instance_set_scenario(p_rid, RID());
 		instance_set_base(p_rid, RID());
 		instance_geometry_set_material_override(p_rid, RID());
@@ -3543,6 +3859,12 @@ RendererSceneCull::RendererSceneCull() {
 	indexer_update_iterations = GLOBAL_GET("rendering/limits/spatial_indexer/update_iterations_per_frame");
 	thread_cull_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_cull_minimum_instances");
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)RendererThreadPool::singleton->thread_work_pool.get_thread_count()); //make sure there is at least one thread per CPU
+
+	thread_update_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_update_minimum_instances");
+	thread_update_threshold = MAX(thread_update_threshold, (uint32_t)RendererThreadPool::singleton->thread_work_pool.get_thread_count());
+
+	use_occlusion_culling = GLOBAL_GET("rendering/occlusion_culling/use_occlusion_culling");
+	occlusion_buffer_width = GLOBAL_GET("rendering/occlusion_culling/buffer_width");
 }
 
 RendererSceneCull::~RendererSceneCull() {
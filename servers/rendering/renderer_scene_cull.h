@@ -45,6 +45,7 @@
 #include "core/templates/rid_owner.h"
 #include "core/templates/self_list.h"
 #include "servers/rendering/renderer_scene.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
 #include "servers/rendering/renderer_scene_render.h"
 #include "servers/xr/xr_interface.h"
 class RendererSceneCull : public RendererScene {
@@ -109,10 +110,27 @@ public:
 	virtual void camera_set_use_vertical_aspect(RID p_camera, bool p_enable);
 	virtual bool is_camera(RID p_camera) const;
 
-	/* SCENARIO API */
+	/* OCCLUDER API */
 
 	struct Instance;
 
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		AABB aabb;
+		Set<Instance *> users;
+	};
+
+	mutable RID_PtrOwner<Occluder, true> occluder_owner;
+
+	virtual RID occluder_allocate();
+	virtual void occluder_initialize(RID p_rid);
+
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices);
+	virtual uint64_t get_occluded_objects_in_frame() const;
+
+	/* SCENARIO API */
+
 	struct PlaneSign {
 		_ALWAYS_INLINE_ PlaneSign() {}
 		_ALWAYS_INLINE_ PlaneSign(const Plane &p_plane) {
@@ -248,6 +266,7 @@ public:
 			FLAG_USES_BAKED_LIGHT = (1 << 16),
 			FLAG_USES_MESH_INSTANCE = (1 << 17),
 			FLAG_REFLECTION_PROBE_DIRTY = (1 << 18),
+			FLAG_DRAW_RANGE = (1 << 19),
 		};
 
 		uint32_t flags = 0;
@@ -276,6 +295,7 @@ public:
 		RID self;
 
 		List<Instance *> directional_lights;
+		List<Instance *> occluders;
 		RID environment;
 		RID fallback_environment;
 		RID camera_effects;
@@ -289,6 +309,54 @@ public:
 		PagedArray<InstanceBounds> instance_aabbs;
 		PagedArray<InstanceData> instance_data;
 
+		// Baked potentially visible set: one bit row per cell, telling which cells can be seen from it.
+		struct PVS {
+			AABB bounds;
+			Vector3i cell_count;
+			Vector3 inv_cell_size;
+			uint32_t row_size = 0;
+			Vector<uint8_t> visibility;
+
+			_FORCE_INLINE_ bool is_empty() const { return visibility.is_empty(); }
+
+			const uint8_t *get_cell_row(const Vector3 &p_pos) const {
+				Vector3 local = (p_pos - bounds.position) * inv_cell_size;
+				int x = Math::floor(local.x);
+				int y = Math::floor(local.y);
+				int z = Math::floor(local.z);
+				if (x < 0 || y < 0 || z < 0 || x >= cell_count.x || y >= cell_count.y || z >= cell_count.z) {
+					return nullptr;
+				}
+				return &visibility.ptr()[((z * cell_count.y + y) * cell_count.x + x) * row_size];
+			}
+
+			// Conservative: bounds that leave the grid or span too many cells are always visible.
+			_FORCE_INLINE_ bool is_visible(const uint8_t *p_row, const real_t *p_bounds) const {
+				int from[3], to[3];
+				for (int i = 0; i < 3; i++) {
+					from[i] = Math::floor((p_bounds[i] - bounds.position[i]) * inv_cell_size[i]);
+					to[i] = Math::floor((p_bounds[i + 3] - bounds.position[i]) * inv_cell_size[i]);
+					if (from[i] < 0 || to[i] >= cell_count[i]) {
+						return true;
+					}
+				}
+				if ((to[0] - from[0] + 1) * (to[1] - from[1] + 1) * (to[2] - from[2] + 1) > 64) {
+					return true;
+				}
+				for (int z = from[2]; z <= to[2]; z++) {
+					for (int y = from[1]; y <= to[1]; y++) {
+						for (int x = from[0]; x <= to[0]; x++) {
+							uint32_t cell = (z * cell_count.y + y) * cell_count.x + x;
+							if (p_row[cell >> 3] & (1 << (cell & 7))) {
+								return true;
+							}
+						}
+					}
+				}
+				return false;
+			}
+		} pvs;
+
 		Scenario() {
 			indexers[INDEXER_GEOMETRY].set_index(INDEXER_GEOMETRY);
 			indexers[INDEXER_VOLUMES].set_index(INDEXER_VOLUMES);
@@ -313,6 +381,7 @@ public:
 	virtual void scenario_set_camera_effects(RID p_scenario, RID p_fx);
 	virtual void scenario_set_fallback_environment(RID p_scenario, RID p_environment);
 	virtual void scenario_set_reflection_atlas_size(RID p_scenario, int p_reflection_size, int p_reflection_count);
+	virtual void scenario_set_pvs(RID p_scenario, const AABB &p_bounds, const Vector3i &p_cell_count, const Vector<uint8_t> &p_visibility);
 	virtual bool is_scenario(RID p_scenario) const;
 	virtual RID scenario_get_environment(RID p_scenario);
 
@@ -403,7 +472,10 @@ public:
 		float lod_end;
 		float lod_begin_hysteresis;
 		float lod_end_hysteresis;
-		RID lod_instance;
+		bool lod_range_checked; // lod_in_range holds the last result, so the margins can be applied
+		bool lod_in_range;
+		Instance *lod_parent; // draw range distance is measured to this instance instead, so a group switches at once
+		Set<Instance *> lod_children;
 
 		Vector<Color> lightmap_target_sh; //target is used for incrementally changing the SH over time, this avoids pops in some corner cases and when going interior <-> exterior
 
@@ -484,6 +556,9 @@ public:
 			lod_end = 0;
 			lod_begin_hysteresis = 0;
 			lod_end_hysteresis = 0;
+			lod_range_checked = false;
+			lod_in_range = false;
+			lod_parent = nullptr;
 
 			last_frame_pass = 0;
 			version = 1;
@@ -509,6 +584,35 @@ public:
 		}
 	};
 
+	// Each instance is only checked by the thread culling its index range, so updating the state is safe.
+	// The state is shared by all the cameras drawing the scenario.
+	static _FORCE_INLINE_ bool _instance_in_draw_range(Instance *p_instance, const Vector3 &p_camera_pos) {
+		if (p_instance->lod_begin <= 0.0 && p_instance->lod_end <= 0.0) {
+			return true;
+		}
+
+		const AABB &aabb = p_instance->lod_parent ? p_instance->lod_parent->transformed_aabb : p_instance->transformed_aabb;
+		float distance = (aabb.position + aabb.size * 0.5).distance_to(p_camera_pos);
+
+		// The margins widen the range while the instance is drawn and narrow it while it's not,
+		// so it doesn't flicker when the camera stays around one of the limits.
+		float begin = p_instance->lod_begin;
+		float end = p_instance->lod_end;
+		if (p_instance->lod_range_checked) {
+			float sign = p_instance->lod_in_range ? -1.0 : 1.0;
+			if (begin > 0.0) {
+				begin += sign * p_instance->lod_begin_hysteresis;
+			}
+			if (end > 0.0) {
+				end -= sign * p_instance->lod_end_hysteresis;
+			}
+		}
+
+		p_instance->lod_in_range = distance >= begin && (p_instance->lod_end <= 0.0 || distance < end);
+		p_instance->lod_range_checked = true;
+		return p_instance->lod_in_range;
+	}
+
 	SelfList<Instance>::List _instance_update_list;
 	void _instance_queue_update(Instance *p_instance, bool p_update_aabb, bool p_update_dependencies = false);
 
@@ -634,6 +738,10 @@ public:
 		}
 	};
 
+	struct InstanceOccluderData : public InstanceBaseData {
+		List<Instance *>::Element *E = nullptr;
+	};
+
 	uint64_t pair_pass = 1;
 
 	struct PairInstances {
@@ -645,15 +753,19 @@ public:
 		uint32_t pair_mask;
 		uint64_t pair_pass;
 
+		_FORCE_INLINE_ void add_pair(Instance *p_instance) {
+			p_instance->pair_check = pair_pass;
+			InstancePair *pair = pair_allocator->alloc();
+			pair->a = instance;
+			pair->b = p_instance;
+			pairs_found.add(&pair->list_a);
+		}
+
 		_FORCE_INLINE_ bool operator()(void *p_data) {
 			Instance *p_instance = (Instance *)p_data;
 			if (instance != p_instance && instance->transformed_aabb.intersects(p_instance->transformed_aabb) && (pair_mask & (1 << p_instance->base_type))) {
 				//test is more coarse in indexer
-				p_instance->pair_check = pair_pass;
-				InstancePair *pair = pair_allocator->alloc();
-				pair->a = instance;
-				pair->b = p_instance;
-				pairs_found.add(&pair->list_a);
+				add_pair(p_instance);
 			}
 			return false;
 		}
@@ -692,6 +804,36 @@ public:
 		}
 	};
 
+	// Pair query run from a worker thread, results are merged serially into PairInstances.
+	struct PairQuery {
+		Instance *instance = nullptr;
+		DynamicBVH *bvh = nullptr;
+		DynamicBVH *bvh2 = nullptr;
+		uint32_t pair_mask = 0;
+		LocalVector<Instance *> found;
+
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			Instance *p_instance = (Instance *)p_data;
+			if (instance != p_instance && instance->transformed_aabb.intersects(p_instance->transformed_aabb) && (pair_mask & (1 << p_instance->base_type))) {
+				found.push_back(p_instance);
+			}
+			return false;
+		}
+
+		void query() {
+			if (bvh) {
+				bvh->aabb_query(instance->transformed_aabb, *this);
+			}
+			if (bvh2) {
+				bvh2->aabb_query(instance->transformed_aabb, *this);
+			}
+		}
+	};
+
+	LocalVector<Instance *> instance_update_batch;
+	LocalVector<PairQuery> instance_pair_queries;
+	uint32_t thread_update_threshold = 256;
+
 	Set<Instance *> heightfield_particle_colliders_update_list;
 
 	PagedArrayPool<Instance *> instance_cull_page_pool;
@@ -718,6 +860,8 @@ public:
 		PagedArray<RendererSceneRender::GeometryInstance *> sdfgi_region_geometry_instances[SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE];
 		PagedArray<RID> sdfgi_cascade_lights[SDFGI_MAX_CASCADES];
 
+		uint32_t occluded_count = 0;
+
 		void clear() {
 			geometry_instances.clear();
 			lights.clear();
@@ -727,6 +871,7 @@ public:
 			decals.clear();
 			gi_probes.clear();
 			mesh_instances.clear();
+			occluded_count = 0;
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
 					directional_shadows[i].cascade_geometry_instances[j].clear();
@@ -775,6 +920,7 @@ public:
 			decals.merge_unordered(p_cull_result.decals);
 			gi_probes.merge_unordered(p_cull_result.gi_probes);
 			mesh_instances.merge_unordered(p_cull_result.mesh_instances);
+			occluded_count += p_cull_result.occluded_count;
 
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
@@ -827,6 +973,11 @@ public:
 
 	uint32_t thread_cull_threshold = 200;
 
+	bool use_occlusion_culling = false;
+	int occlusion_buffer_width = 256;
+	RendererSceneOcclusionCull occlusion_buffer;
+	uint64_t occluded_objects_in_frame = 0;
+
 	RID_PtrOwner<Instance, true> instance_owner;
 
 	uint32_t geometry_instance_pair_mask; // used in traditional forward, unnecesary on clustered
@@ -872,8 +1023,15 @@ public:
 	virtual Variant instance_geometry_get_shader_parameter_default_value(RID p_instance, const StringName &p_parameter) const;
 
 	_FORCE_INLINE_ void _update_instance(Instance *p_instance);
+	_FORCE_INLINE_ void _update_instance_transformed_aabb(Instance *p_instance);
+	_FORCE_INLINE_ bool _update_instance_bounds(Instance *p_instance);
+	_FORCE_INLINE_ void _instance_pair_setup(Instance *p_instance, uint32_t &r_pair_mask, DynamicBVH *&r_bvh, DynamicBVH *&r_bvh2);
 	_FORCE_INLINE_ void _update_instance_aabb(Instance *p_instance);
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance);
+	_FORCE_INLINE_ void _update_dirty_instance_data(Instance *p_instance);
+	void _update_instance_batch_transforms_threaded(uint32_t p_thread, void *p_userdata);
+	void _update_instance_batch_pairs_threaded(uint32_t p_thread, void *p_userdata);
+	void _update_dirty_instances_threaded();
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance);
 	void _unpair_instance(Instance *p_instance);
 
@@ -928,6 +1086,8 @@ public:
 		Transform cam_transform;
 		uint32_t visible_layers;
 		Instance *render_reflection_probe;
+		const RendererSceneOcclusionCull *occlusion_buffer;
+		const uint8_t *pvs_row;
 	};
 
 	void _frustum_cull_threaded(uint32_t p_thread, FrustumCullData *cull_data);
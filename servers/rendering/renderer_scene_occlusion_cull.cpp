@@ -0,0 +1,349 @@
+/*************************************************************************/
+/*  renderer_scene_occlusion_cull.cpp                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "renderer_scene_occlusion_cull.h"
+
+#include "core/math/math_funcs.h"
+
+#define OCCLUSION_DEPTH_CLEAR 1e20f
+
+void RendererSceneOcclusionCull::begin(int p_width, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection) {
+	active = false;
+
+	real_t aspect = p_cam_projection.get_aspect();
+	if (p_width <= 0 || !(aspect > CMP_EPSILON)) {
+		mip_count = 0;
+		return;
+	}
+
+	view_projection = p_cam_projection * CameraMatrix(p_cam_transform.affine_inverse());
+
+	Mip &mip = mips[0];
+	mip.width = p_width;
+	mip.height = MAX(1, int(p_width / aspect));
+	mip.depth.resize(mip.width * mip.height);
+
+	float *depth = mip.depth.ptr();
+	for (uint32_t i = 0; i < mip.depth.size(); i++) {
+		depth[i] = OCCLUSION_DEPTH_CLEAR;
+	}
+	mip_count = 1;
+}
+
+void RendererSceneOcclusionCull::add_occluder(const Transform &p_xform, const Vector3 *p_vertices, int p_vertex_count, const int *p_indices, int p_index_count) {
+	if (mip_count == 0) {
+		return;
+	}
+
+	CameraMatrix mvp = view_projection * CameraMatrix(p_xform);
+
+	clip_vertices.resize(p_vertex_count);
+	for (int i = 0; i < p_vertex_count; i++) {
+		Plane p = mvp.xform4(Plane(p_vertices[i].x, p_vertices[i].y, p_vertices[i].z, 1.0));
+		ClipVertex &cv = clip_vertices[i];
+		cv.x = p.normal.x;
+		cv.y = p.normal.y;
+		cv.z = p.normal.z;
+		cv.w = p.d;
+	}
+
+	for (int i = 0; i + 2 < p_index_count; i += 3) {
+		int a = p_indices[i + 0];
+		int b = p_indices[i + 1];
+		int c = p_indices[i + 2];
+		ERR_CONTINUE(a < 0 || a >= p_vertex_count || b < 0 || b >= p_vertex_count || c < 0 || c >= p_vertex_count);
+		_clip_and_rasterize_triangle(clip_vertices[a], clip_vertices[b], clip_vertices[c]);
+	}
+}
+
+void RendererSceneOcclusionCull::_clip_and_rasterize_triangle(const ClipVertex &p_a, const ClipVertex &p_b, const ClipVertex &p_c) {
+	// Clip against the near plane (z >= -w), the only plane that matters for
+	// correctness; the rest is handled by the screen-space bounding box.
+	const ClipVertex *in[3] = { &p_a, &p_b, &p_c };
+	real_t d[3];
+	int inside = 0;
+	for (int i = 0; i < 3; i++) {
+		d[i] = in[i]->z + in[i]->w;
+		if (d[i] >= 0) {
+			inside++;
+		}
+	}
+
+	if (inside == 0) {
+		return;
+	}
+	if (inside == 3) {
+		_rasterize_triangle(p_a, p_b, p_c);
+		return;
+	}
+
+	ClipVertex out[4];
+	int out_count = 0;
+	for (int i = 0; i < 3; i++) {
+		int j = (i + 1) % 3;
+		const ClipVertex &vi = *in[i];
+		const ClipVertex &vj = *in[j];
+		if (d[i] >= 0) {
+			out[out_count++] = vi;
+		}
+		if ((d[i] >= 0) != (d[j] >= 0)) {
+			real_t t = d[i] / (d[i] - d[j]);
+			ClipVertex &v = out[out_count++];
+			v.x = vi.x + (vj.x - vi.x) * t;
+			v.y = vi.y + (vj.y - vi.y) * t;
+			v.z = vi.z + (vj.z - vi.z) * t;
+			v.w = vi.w + (vj.w - vi.w) * t;
+		}
+	}
+
+	for (int i = 1; i + 1 < out_count; i++) {
+		_rasterize_triangle(out[0], out[i], out[i + 1]);
+	}
+}
+
+void RendererSceneOcclusionCull::_rasterize_triangle(const ClipVertex &p_a, const ClipVertex &p_b, const ClipVertex &p_c) {
+	if (p_a.w <= CMP_EPSILON || p_b.w <= CMP_EPSILON || p_c.w <= CMP_EPSILON) {
+		return;
+	}
+
+	Mip &mip = mips[0];
+	const float half_w = mip.width * 0.5;
+	const float half_h = mip.height * 0.5;
+
+	float x[3], y[3], z[3];
+	const ClipVertex *v[3] = { &p_a, &p_b, &p_c };
+	for (int i = 0; i < 3; i++) {
+		float inv_w = 1.0 / v[i]->w;
+		x[i] = (v[i]->x * inv_w + 1.0) * half_w;
+		y[i] = (v[i]->y * inv_w + 1.0) * half_h;
+		z[i] = v[i]->z * inv_w;
+	}
+
+	float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (Math::abs(area) < CMP_EPSILON) {
+		return;
+	}
+	if (area < 0) {
+		// Occluders are double sided.
+		SWAP(x[1], x[2]);
+		SWAP(y[1], y[2]);
+		SWAP(z[1], z[2]);
+		area = -area;
+	}
+
+	int min_x = MAX(0, int(Math::floor(MIN(x[0], MIN(x[1], x[2])))));
+	int min_y = MAX(0, int(Math::floor(MIN(y[0], MIN(y[1], y[2])))));
+	int max_x = MIN(mip.width - 1, int(Math::floor(MAX(x[0], MAX(x[1], x[2])))));
+	int max_y = MIN(mip.height - 1, int(Math::floor(MAX(y[0], MAX(y[1], y[2])))));
+	if (min_x > max_x || min_y > max_y) {
+		return;
+	}
+
+	// Edge functions, evaluated at pixel centers and stepped incrementally.
+	float e_dx[3], e_dy[3], e_row[3];
+	float px = min_x + 0.5;
+	float py = min_y + 0.5;
+	for (int i = 0; i < 3; i++) {
+		int j = (i + 1) % 3;
+		e_dx[i] = y[i] - y[j];
+		e_dy[i] = x[j] - x[i];
+		e_row[i] = (x[j] - x[i]) * (py - y[i]) - (y[j] - y[i]) * (px - x[i]);
+	}
+
+	// Depth is affine in screen space; edge i weights the vertex opposite to it.
+	float inv_area = 1.0 / area;
+	float z_dx = (e_dx[1] * z[0] + e_dx[2] * z[1] + e_dx[0] * z[2]) * inv_area;
+	float z_dy = (e_dy[1] * z[0] + e_dy[2] * z[1] + e_dy[0] * z[2]) * inv_area;
+	float z_row = (e_row[1] * z[0] + e_row[2] * z[1] + e_row[0] * z[2]) * inv_area;
+
+	float *depth = mip.depth.ptr();
+	for (int py_i = min_y; py_i <= max_y; py_i++) {
+		float e0 = e_row[0];
+		float e1 = e_row[1];
+		float e2 = e_row[2];
+		float zv = z_row;
+		float *row = &depth[py_i * mip.width];
+		for (int px_i = min_x; px_i <= max_x; px_i++) {
+			if (e0 >= 0 && e1 >= 0 && e2 >= 0 && zv < row[px_i]) {
+				row[px_i] = zv;
+			}
+			e0 += e_dx[0];
+			e1 += e_dx[1];
+			e2 += e_dx[2];
+			zv += z_dx;
+		}
+		e_row[0] += e_dy[0];
+		e_row[1] += e_dy[1];
+		e_row[2] += e_dy[2];
+		z_row += z_dy;
+	}
+}
+
+void RendererSceneOcclusionCull::_dilate_depth() {
+	// Occluders are rasterized at texel centers, so texels on their edges can be only partially covered, and the
+	// depth at the center is not the farthest one over the texel. Keeping the farthest depth of the neighboring
+	// texels fixes both: a texel is only considered occluded when the occluders cover all of it.
+	Mip &mip = mips[0];
+	dilate_buffer.resize(mip.depth.size());
+
+	const float *src = mip.depth.ptr();
+	float *tmp = dilate_buffer.ptr();
+	for (int y = 0; y < mip.height; y++) {
+		const float *s = &src[y * mip.width];
+		float *d = &tmp[y * mip.width];
+		for (int x = 0; x < mip.width; x++) {
+			float m = s[x];
+			if (x > 0) {
+				m = MAX(m, s[x - 1]);
+			}
+			if (x < mip.width - 1) {
+				m = MAX(m, s[x + 1]);
+			}
+			d[x] = m;
+		}
+	}
+
+	float *dst = mip.depth.ptr();
+	for (int y = 0; y < mip.height; y++) {
+		const float *s = &tmp[y * mip.width];
+		const float *s_prev = (y > 0) ? s - mip.width : s;
+		const float *s_next = (y < mip.height - 1) ? s + mip.width : s;
+		float *d = &dst[y * mip.width];
+		for (int x = 0; x < mip.width; x++) {
+			d[x] = MAX(s[x], MAX(s_prev[x], s_next[x]));
+		}
+	}
+}
+
+void RendererSceneOcclusionCull::_build_mips() {
+	while (mip_count < MAX_MIPS) {
+		const Mip &src = mips[mip_count - 1];
+		if (src.width == 1 && src.height == 1) {
+			break;
+		}
+
+		Mip &dst = mips[mip_count];
+		dst.width = MAX(1, (src.width + 1) >> 1);
+		dst.height = MAX(1, (src.height + 1) >> 1);
+		dst.depth.resize(dst.width * dst.height);
+
+		const float *s = src.depth.ptr();
+		float *d = dst.depth.ptr();
+		for (int y = 0; y < dst.height; y++) {
+			int sy0 = y * 2;
+			int sy1 = MIN(sy0 + 1, src.height - 1);
+			for (int x = 0; x < dst.width; x++) {
+				int sx0 = x * 2;
+				int sx1 = MIN(sx0 + 1, src.width - 1);
+				// Keep the farthest depth so coarse levels stay conservative.
+				float m = MAX(MAX(s[sy0 * src.width + sx0], s[sy0 * src.width + sx1]), MAX(s[sy1 * src.width + sx0], s[sy1 * src.width + sx1]));
+				d[y * dst.width + x] = m;
+			}
+		}
+		mip_count++;
+	}
+}
+
+void RendererSceneOcclusionCull::end() {
+	if (mip_count == 0) {
+		return;
+	}
+	_dilate_depth();
+	_build_mips();
+	active = true;
+}
+
+bool RendererSceneOcclusionCull::is_occluded(const real_t *p_bounds) const {
+	if (!active) {
+		return false;
+	}
+
+	float min_x = 1e20, min_y = 1e20, max_x = -1e20, max_y = -1e20;
+	float min_z = 1e20;
+
+	for (int i = 0; i < 8; i++) {
+		Plane p(p_bounds[(i & 1) ? 3 : 0], p_bounds[(i & 2) ? 4 : 1], p_bounds[(i & 4) ? 5 : 2], 1.0);
+		p = view_projection.xform4(p);
+		if (p.d <= CMP_EPSILON || p.normal.z < -p.d) {
+			// Crosses the near plane, treat as visible.
+			return false;
+		}
+		float inv_w = 1.0 / p.d;
+		float nx = p.normal.x * inv_w;
+		float ny = p.normal.y * inv_w;
+		min_x = MIN(min_x, nx);
+		max_x = MAX(max_x, nx);
+		min_y = MIN(min_y, ny);
+		max_y = MAX(max_y, ny);
+		min_z = MIN(min_z, float(p.normal.z * inv_w));
+	}
+
+	if (max_x < -1.0 || min_x > 1.0 || max_y < -1.0 || min_y > 1.0) {
+		return false;
+	}
+
+	const Mip &base = mips[0];
+	int x0 = CLAMP(int(Math::floor((min_x + 1.0) * 0.5 * base.width)), 0, base.width - 1);
+	int x1 = CLAMP(int(Math::floor((max_x + 1.0) * 0.5 * base.width)), 0, base.width - 1);
+	int y0 = CLAMP(int(Math::floor((min_y + 1.0) * 0.5 * base.height)), 0, base.height - 1);
+	int y1 = CLAMP(int(Math::floor((max_y + 1.0) * 0.5 * base.height)), 0, base.height - 1);
+
+	int level = 0;
+	while (level < mip_count - 1 && (x1 - x0 >= 4 || y1 - y0 >= 4)) {
+		level++;
+		x0 >>= 1;
+		x1 >>= 1;
+		y0 >>= 1;
+		y1 >>= 1;
+	}
+
+	const Mip &mip = mips[level];
+	x1 = MIN(x1, mip.width - 1);
+	y1 = MIN(y1, mip.height - 1);
+	const float *depth = mip.depth.ptr();
+	for (int y = y0; y <= y1; y++) {
+		const float *row = &depth[y * mip.width];
+		for (int x = x0; x <= x1; x++) {
+			if (row[x] >= min_z) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool RendererSceneOcclusionCull::is_occluded(const AABB &p_aabb) const {
+	real_t bounds[6] = {
+		p_aabb.position.x, p_aabb.position.y, p_aabb.position.z,
+		p_aabb.position.x + p_aabb.size.x, p_aabb.position.y + p_aabb.size.y, p_aabb.position.z + p_aabb.size.z
+	};
+	return is_occluded(bounds);
+}
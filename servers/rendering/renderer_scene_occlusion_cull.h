@@ -0,0 +1,88 @@
+/*************************************************************************/
+/*  renderer_scene_occlusion_cull.h                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef RENDERER_SCENE_OCCLUSION_CULL_H
+#define RENDERER_SCENE_OCCLUSION_CULL_H
+
+#include "core/math/aabb.h"
+#include "core/math/camera_matrix.h"
+#include "core/math/transform.h"
+#include "core/math/vector3.h"
+#include "core/templates/local_vector.h"
+
+// Software occlusion buffer. Occluder triangles are rasterized on the CPU into
+// a small depth buffer for the current camera, then reduced into a max-depth
+// hierarchy so bounding boxes can be tested with a handful of texel reads.
+class RendererSceneOcclusionCull {
+public:
+	enum {
+		MAX_MIPS = 16
+	};
+
+private:
+	struct Mip {
+		int width = 0;
+		int height = 0;
+		LocalVector<float> depth;
+	};
+
+	struct ClipVertex {
+		real_t x, y, z, w;
+	};
+
+	Mip mips[MAX_MIPS];
+	int mip_count = 0;
+	bool active = false;
+
+	CameraMatrix view_projection;
+
+	LocalVector<ClipVertex> clip_vertices;
+	LocalVector<float> dilate_buffer;
+
+	void _rasterize_triangle(const ClipVertex &p_a, const ClipVertex &p_b, const ClipVertex &p_c);
+	void _clip_and_rasterize_triangle(const ClipVertex &p_a, const ClipVertex &p_b, const ClipVertex &p_c);
+	void _dilate_depth();
+	void _build_mips();
+
+public:
+	// Clears the buffer and sets up the camera. Width is in texels, height follows the projection aspect.
+	void begin(int p_width, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection);
+	void add_occluder(const Transform &p_xform, const Vector3 *p_vertices, int p_vertex_count, const int *p_indices, int p_index_count);
+	void end();
+
+	_FORCE_INLINE_ bool is_active() const { return active; }
+	void clear() { active = false; }
+
+	// Safe to call from multiple threads once end() was called.
+	bool is_occluded(const real_t *p_bounds) const;
+	bool is_occluded(const AABB &p_aabb) const;
+};
+
+#endif // RENDERER_SCENE_OCCLUSION_CULL_H
@@ -258,6 +258,9 @@ void RenderingServerDefault::finish() {
 /* STATUS INFORMATION */
 
 uint64_t RenderingServerDefault::get_render_info(RenderInfo p_info) {
+	if (p_info == INFO_OCCLUDED_OBJECTS_IN_FRAME) {
+		return RSG::scene->get_occluded_objects_in_frame();
+	}
 	return RSG::storage->get_render_info(p_info);
 }
 
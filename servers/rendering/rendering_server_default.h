@@ -540,6 +540,11 @@ public:
 	FUNC2(camera_set_camera_effects, RID, RID)
 	FUNC2(camera_set_use_vertical_aspect, RID, bool)
 
+	/* OCCLUDER API */
+
+	FUNCRIDSPLIT(occluder)
+	FUNC3(occluder_set_mesh, RID, const PackedVector3Array &, const PackedInt32Array &)
+
 #undef server_name
 #undef ServerName
 //from now on, calls forwarded to this singleton
@@ -693,6 +698,7 @@ public:
 	FUNC2(scenario_set_environment, RID, RID)
 	FUNC2(scenario_set_camera_effects, RID, RID)
 	FUNC2(scenario_set_fallback_environment, RID, RID)
+	FUNC4(scenario_set_pvs, RID, const AABB &, const Vector3i &, const Vector<uint8_t> &)
 
 	/* INSTANCING API */
 	FUNCRIDSPLIT(instance)
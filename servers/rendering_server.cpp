@@ -1641,6 +1641,9 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("camera_set_environment", "camera", "env"), &RenderingServer::camera_set_environment);
 	ClassDB::bind_method(D_METHOD("camera_set_use_vertical_aspect", "camera", "enable"), &RenderingServer::camera_set_use_vertical_aspect);
 
+	ClassDB::bind_method(D_METHOD("occluder_create"), &RenderingServer::occluder_create);
+	ClassDB::bind_method(D_METHOD("occluder_set_mesh", "occluder", "vertices", "indices"), &RenderingServer::occluder_set_mesh);
+
 	ClassDB::bind_method(D_METHOD("viewport_create"), &RenderingServer::viewport_create);
 	ClassDB::bind_method(D_METHOD("viewport_set_use_xr", "viewport", "use_xr"), &RenderingServer::viewport_set_use_xr);
 	ClassDB::bind_method(D_METHOD("viewport_set_size", "viewport", "width", "height"), &RenderingServer::viewport_set_size);
@@ -1695,6 +1698,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("scenario_set_debug", "scenario", "debug_mode"), &RenderingServer::scenario_set_debug);
 	ClassDB::bind_method(D_METHOD("scenario_set_environment", "scenario", "environment"), &RenderingServer::scenario_set_environment);
 	ClassDB::bind_method(D_METHOD("scenario_set_fallback_environment", "scenario", "environment"), &RenderingServer::scenario_set_fallback_environment);
+	ClassDB::bind_method(D_METHOD("scenario_set_pvs", "scenario", "bounds", "cell_count", "visibility"), &RenderingServer::scenario_set_pvs);
 
 #ifndef _3D_DISABLED
 
@@ -2004,6 +2008,7 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_SHADER_CHANGES_IN_FRAME);
 	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_SURFACE_CHANGES_IN_FRAME);
 	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_DRAW_CALLS_IN_FRAME);
+	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_DRAW_CALLS_SAVED_IN_FRAME);
 	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_MAX);
 
 	BIND_ENUM_CONSTANT(VIEWPORT_DEBUG_DRAW_DISABLED);
@@ -2104,6 +2109,7 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(INSTANCE_DECAL);
 	BIND_ENUM_CONSTANT(INSTANCE_GI_PROBE);
 	BIND_ENUM_CONSTANT(INSTANCE_LIGHTMAP);
+	BIND_ENUM_CONSTANT(INSTANCE_OCCLUDER);
 	BIND_ENUM_CONSTANT(INSTANCE_MAX);
 	BIND_ENUM_CONSTANT(INSTANCE_GEOMETRY_MASK);
 
@@ -2196,6 +2202,8 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_VIDEO_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_TEXTURE_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_VERTEX_MEM_USED);
+	BIND_ENUM_CONSTANT(INFO_OCCLUDED_OBJECTS_IN_FRAME);
+	BIND_ENUM_CONSTANT(INFO_DRAW_CALLS_SAVED_IN_FRAME);
 
 	BIND_ENUM_CONSTANT(FEATURE_SHADERS);
 	BIND_ENUM_CONSTANT(FEATURE_MULTITHREADED);
@@ -2265,6 +2273,14 @@ RenderingServer::RenderingServer() {
 	GLOBAL_DEF_RST("rendering/textures/vram_compression/import_etc2", true);
 	GLOBAL_DEF_RST("rendering/textures/vram_compression/import_pvrtc", false);
 
+	GLOBAL_DEF("rendering/textures/streaming/enabled", false);
+	GLOBAL_DEF("rendering/textures/streaming/initial_size", 128);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/textures/streaming/initial_size", PropertyInfo(Variant::INT, "rendering/textures/streaming/initial_size", PROPERTY_HINT_RANGE, "1,16384,1"));
+	GLOBAL_DEF("rendering/textures/streaming/memory_budget_mb", 256);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/textures/streaming/memory_budget_mb", PropertyInfo(Variant::INT, "rendering/textures/streaming/memory_budget_mb", PROPERTY_HINT_RANGE, "1,16384,1,or_greater"));
+	GLOBAL_DEF("rendering/textures/streaming/max_uploads_per_frame", 4);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/textures/streaming/max_uploads_per_frame", PropertyInfo(Variant::INT, "rendering/textures/streaming/max_uploads_per_frame", PROPERTY_HINT_RANGE, "1,256,1"));
+
 	GLOBAL_DEF("rendering/limits/time/time_rollover_secs", 3600);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/time/time_rollover_secs", PropertyInfo(Variant::FLOAT, "rendering/limits/time/time_rollover_secs", PROPERTY_HINT_RANGE, "0,10000,1,or_greater"));
 
@@ -2281,10 +2297,15 @@ RenderingServer::RenderingServer() {
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/shadows/shadows/soft_shadow_quality", PropertyInfo(Variant::INT, "rendering/shadows/shadows/soft_shadow_quality", PROPERTY_HINT_ENUM, "Hard (Fastest),Soft Low (Fast),Soft Medium (Average),Soft High (Slow),Soft Ultra (Slowest)"));
 
 	GLOBAL_DEF("rendering/2d/shadow_atlas/size", 2048);
+	GLOBAL_DEF("rendering/2d/batching/use_batching", true);
 
 	GLOBAL_DEF("rendering/driver/rd_renderer/use_low_end_renderer", false);
 	GLOBAL_DEF("rendering/driver/rd_renderer/use_low_end_renderer.mobile", true);
 
+	GLOBAL_DEF("rendering/shader_compiler/shader_cache/enabled", true);
+	GLOBAL_DEF("rendering/shader_compiler/shader_cache/max_size_mb", 512);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/shader_compiler/shader_cache/max_size_mb", PropertyInfo(Variant::INT, "rendering/shader_compiler/shader_cache/max_size_mb", PROPERTY_HINT_RANGE, "1,4096,1,or_greater"));
+
 	GLOBAL_DEF("rendering/reflections/sky_reflections/roughness_layers", 8);
 	GLOBAL_DEF("rendering/reflections/sky_reflections/texture_array_reflections", true);
 	GLOBAL_DEF("rendering/reflections/sky_reflections/texture_array_reflections.mobile", false);
@@ -2378,11 +2399,17 @@ RenderingServer::RenderingServer() {
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/spatial_indexer/update_iterations_per_frame", PropertyInfo(Variant::INT, "rendering/limits/spatial_indexer/update_iterations_per_frame", PROPERTY_HINT_RANGE, "0,1024,1"));
 	GLOBAL_DEF("rendering/limits/spatial_indexer/threaded_cull_minimum_instances", 1000);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/spatial_indexer/threaded_cull_minimum_instances", PropertyInfo(Variant::INT, "rendering/limits/spatial_indexer/threaded_cull_minimum_instances", PROPERTY_HINT_RANGE, "32,65536,1"));
+	GLOBAL_DEF("rendering/limits/spatial_indexer/threaded_update_minimum_instances", 256);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/spatial_indexer/threaded_update_minimum_instances", PropertyInfo(Variant::INT, "rendering/limits/spatial_indexer/threaded_update_minimum_instances", PROPERTY_HINT_RANGE, "32,65536,1"));
 	GLOBAL_DEF("rendering/limits/forward_renderer/threaded_render_minimum_instances", 500);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/forward_renderer/threaded_render_minimum_instances", PropertyInfo(Variant::INT, "rendering/limits/forward_renderer/threaded_render_minimum_instances", PROPERTY_HINT_RANGE, "32,65536,1"));
 
 	GLOBAL_DEF("rendering/limits/cluster_builder/max_clustered_elements", 512);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/cluster_builder/max_clustered_elements", PropertyInfo(Variant::FLOAT, "rendering/limits/cluster_builder/max_clustered_elements", PROPERTY_HINT_RANGE, "32,8192,1"));
+
+	GLOBAL_DEF("rendering/occlusion_culling/use_occlusion_culling", false);
+	GLOBAL_DEF("rendering/occlusion_culling/buffer_width", 256);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/occlusion_culling/buffer_width", PropertyInfo(Variant::INT, "rendering/occlusion_culling/buffer_width", PROPERTY_HINT_RANGE, "32,2048,1"));
 }
 
 RenderingServer::~RenderingServer() {
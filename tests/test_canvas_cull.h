@@ -0,0 +1,257 @@
+/*************************************************************************/
+/*  test_canvas_cull.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_CANVAS_CULL_H
+#define TEST_CANVAS_CULL_H
+
+#include "servers/rendering/renderer_canvas_cull.h"
+
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+class RendererCanvasCullTester {
+public:
+	static void update_subtree_rect(RendererCanvasCull &p_canvas, RendererCanvasCull::Item *p_item) {
+		p_canvas._update_subtree_rect(p_item);
+	}
+
+	static void cull_canvas_item(RendererCanvasCull &p_canvas, RendererCanvasCull::Item *p_item, const Rect2 &p_clip_rect, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list) {
+		p_canvas._cull_canvas_item(p_item, Transform2D(), p_clip_rect, Color(1, 1, 1), 0, r_z_list, r_z_last_list, nullptr, nullptr);
+	}
+
+	static void set_child_bvh_min_children(RendererCanvasCull &p_canvas, RendererCanvasCull::Item *p_root, int p_min_children) {
+		p_canvas.child_bvh_min_children = p_min_children;
+		p_canvas._mark_subtree_rect_dirty(p_root);
+	}
+};
+
+namespace TestCanvasCull {
+
+RID create_item(RendererCanvasCull &p_canvas, RID p_parent, const Vector2 &p_position, const Rect2 &p_rect) {
+	RID item = p_canvas.canvas_item_allocate();
+	p_canvas.canvas_item_initialize(item);
+	if (p_parent.is_valid()) {
+		p_canvas.canvas_item_set_parent(item, p_parent);
+	}
+	p_canvas.canvas_item_set_transform(item, Transform2D(0, p_position));
+	if (p_rect != Rect2()) {
+		p_canvas.canvas_item_add_rect(item, p_rect, Color(1, 1, 1));
+	}
+	return item;
+}
+
+// Culls the tree below p_root and returns the items that ended up in the draw lists.
+Set<RendererCanvasCull::Item *> cull_items(RendererCanvasCull &p_canvas, RID p_root, const Rect2 &p_clip_rect) {
+	const int z_range = RS::CANVAS_ITEM_Z_MAX - RS::CANVAS_ITEM_Z_MIN + 1;
+	LocalVector<RendererCanvasRender::Item *> z_list;
+	LocalVector<RendererCanvasRender::Item *> z_last_list;
+	z_list.resize(z_range);
+	z_last_list.resize(z_range);
+	for (int i = 0; i < z_range; i++) {
+		z_list[i] = nullptr;
+		z_last_list[i] = nullptr;
+	}
+
+	RendererCanvasCullTester::cull_canvas_item(p_canvas, p_canvas.canvas_item_owner.getornull(p_root), p_clip_rect, z_list.ptr(), z_last_list.ptr());
+
+	Set<RendererCanvasCull::Item *> result;
+	for (int i = 0; i < z_range; i++) {
+		for (RendererCanvasRender::Item *E = z_list[i]; E; E = E->next) {
+			result.insert(static_cast<RendererCanvasCull::Item *>(E));
+		}
+	}
+	return result;
+}
+
+TEST_CASE("[CanvasCull] Subtree bounds") {
+	RendererCanvasCull canvas;
+
+	RID root = create_item(canvas, RID(), Vector2(), Rect2(0, 0, 10, 10));
+	RID child = create_item(canvas, root, Vector2(100, 0), Rect2(0, 0, 10, 10));
+	RID grandchild = create_item(canvas, child, Vector2(50, 50), Rect2(0, 0, 5, 5));
+
+	RendererCanvasCull::Item *root_item = canvas.canvas_item_owner.getornull(root);
+	RendererCanvasCull::Item *child_item = canvas.canvas_item_owner.getornull(child);
+
+	RendererCanvasCullTester::update_subtree_rect(canvas, root_item);
+	CHECK(root_item->subtree_has_rect);
+	CHECK(root_item->subtree_cullable);
+	CHECK(child_item->subtree_rect == Rect2(0, 0, 55, 55));
+	CHECK(root_item->subtree_rect == Rect2(0, 0, 155, 55));
+
+	// Moving a descendant must invalidate the bounds of every ancestor.
+	canvas.canvas_item_set_transform(grandchild, Transform2D(0, Vector2(-200, 0)));
+	CHECK(root_item->subtree_rect_dirty);
+	CHECK(child_item->subtree_rect_dirty);
+	RendererCanvasCullTester::update_subtree_rect(canvas, root_item);
+	CHECK(root_item->subtree_rect == Rect2(-100, 0, 210, 10));
+
+	// Hidden descendants don't contribute.
+	canvas.canvas_item_set_visible(child, false);
+	RendererCanvasCullTester::update_subtree_rect(canvas, root_item);
+	CHECK(root_item->subtree_rect == Rect2(0, 0, 10, 10));
+
+	// Items that update when visible have to be visited even when off-screen.
+	canvas.canvas_item_set_visible(child, true);
+	canvas.canvas_item_set_update_when_visible(grandchild, true);
+	RendererCanvasCullTester::update_subtree_rect(canvas, root_item);
+	CHECK_FALSE(root_item->subtree_cullable);
+
+	canvas.free(grandchild);
+	canvas.free(child);
+	canvas.free(root);
+}
+
+TEST_CASE("[CanvasCull] Off-screen subtrees are skipped") {
+	RendererCanvasCull canvas;
+
+	RID root = create_item(canvas, RID(), Vector2(), Rect2());
+	// The parent is off-screen but its child is moved back into view.
+	RID far_item = create_item(canvas, root, Vector2(-1000, 0), Rect2(0, 0, 10, 10));
+	RID near_item = create_item(canvas, far_item, Vector2(1010, 10), Rect2(0, 0, 10, 10));
+	RID hidden = create_item(canvas, root, Vector2(500, 500), Rect2(0, 0, 10, 10));
+
+	Set<RendererCanvasCull::Item *> drawn = cull_items(canvas, root, Rect2(0, 0, 100, 100));
+	CHECK(drawn.size() == 1);
+	CHECK(drawn.has(canvas.canvas_item_owner.getornull(near_item)));
+
+	drawn = cull_items(canvas, root, Rect2(0, 0, 1000, 1000));
+	CHECK(drawn.size() == 2);
+	CHECK(drawn.has(canvas.canvas_item_owner.getornull(hidden)));
+
+	canvas.free(hidden);
+	canvas.free(near_item);
+	canvas.free(far_item);
+	canvas.free(root);
+}
+
+TEST_CASE("[CanvasCull] Children BVH") {
+	RendererCanvasCull canvas;
+
+	const int child_count = 100;
+	RID root = create_item(canvas, RID(), Vector2(), Rect2());
+	Vector<RID> children;
+	for (int i = 0; i < child_count; i++) {
+		children.push_back(create_item(canvas, root, Vector2(i * 20, 0), Rect2(0, 0, 10, 10)));
+	}
+
+	RendererCanvasCull::Item *root_item = canvas.canvas_item_owner.getornull(root);
+
+	Set<RendererCanvasCull::Item *> drawn = cull_items(canvas, root, Rect2(0, 0, 195, 100));
+	REQUIRE_MESSAGE(root_item->child_bvh != nullptr, "Items with many children should keep a BVH of them.");
+	CHECK(drawn.size() == 10);
+	for (int i = 0; i < 10; i++) {
+		CHECK(drawn.has(canvas.canvas_item_owner.getornull(children[i])));
+	}
+
+	// Moving a child updates its leaf.
+	canvas.canvas_item_set_transform(children[50], Transform2D(0, Vector2(5, 50)));
+	drawn = cull_items(canvas, root, Rect2(0, 0, 195, 100));
+	CHECK(drawn.size() == 11);
+	CHECK(drawn.has(canvas.canvas_item_owner.getornull(children[50])));
+
+	// The clip rect is brought into the parent's space.
+	canvas.canvas_item_set_transform(root, Transform2D(0, Vector2(-1000, 0)));
+	drawn = cull_items(canvas, root, Rect2(0, 0, 195, 100));
+	CHECK(drawn.size() == 9);
+	for (int i = 50; i < 60; i++) {
+		CHECK(drawn.has(canvas.canvas_item_owner.getornull(children[i])) == (i != 50));
+	}
+
+	// Dropping below the threshold removes the BVH, everything gets visited again.
+	for (int i = 10; i < child_count; i++) {
+		canvas.free(children[i]);
+	}
+	canvas.canvas_item_set_transform(root, Transform2D());
+	drawn = cull_items(canvas, root, Rect2(0, 0, 1000, 100));
+	CHECK(root_item->child_bvh == nullptr);
+	CHECK(drawn.size() == 10);
+
+	for (int i = 0; i < 10; i++) {
+		canvas.free(children[i]);
+	}
+	canvas.free(root);
+}
+
+TEST_CASE("[CanvasCull] Children BVH against linear culling") {
+	RendererCanvasCull canvas;
+
+	// A large scrolling level: a grid of tiles of which only a small part is on screen.
+	const int grid_size = 150;
+	const int iterations = 20;
+	RID root = create_item(canvas, RID(), Vector2(-1000, -1000), Rect2());
+	Vector<RID> children;
+	for (int i = 0; i < grid_size * grid_size; i++) {
+		children.push_back(create_item(canvas, root, Vector2(i % grid_size, i / grid_size) * 32, Rect2(0, 0, 32, 32)));
+	}
+
+	RendererCanvasCull::Item *root_item = canvas.canvas_item_owner.getornull(root);
+	const Rect2 clip_rect(0, 0, 1024, 610);
+
+	// Build the bounds and the BVH outside of the timed loops.
+	Set<RendererCanvasCull::Item *> bvh_drawn = cull_items(canvas, root, clip_rect);
+	REQUIRE(root_item->child_bvh != nullptr);
+	uint64_t bvh_begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		bvh_drawn = cull_items(canvas, root, clip_rect);
+	}
+	uint64_t bvh_time = OS::get_singleton()->get_ticks_usec() - bvh_begin;
+
+	RendererCanvasCullTester::set_child_bvh_min_children(canvas, root_item, INT32_MAX);
+	Set<RendererCanvasCull::Item *> linear_drawn = cull_items(canvas, root, clip_rect);
+	REQUIRE(root_item->child_bvh == nullptr);
+	uint64_t linear_begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		linear_drawn = cull_items(canvas, root, clip_rect);
+	}
+	uint64_t linear_time = OS::get_singleton()->get_ticks_usec() - linear_begin;
+
+	MESSAGE("Culled ", children.size(), " items ", iterations, " times: ", bvh_time / 1000.0, " ms with the children BVH, ", linear_time / 1000.0, " ms linearly.");
+
+	// 33 columns by 20 rows of tiles overlap the clip rect.
+	CHECK(bvh_drawn.size() == 33 * 20);
+	CHECK(linear_drawn.size() == bvh_drawn.size());
+	bool same_items = true;
+	for (Set<RendererCanvasCull::Item *>::Element *E = bvh_drawn.front(); E; E = E->next()) {
+		same_items = same_items && linear_drawn.has(E->get());
+	}
+	CHECK_MESSAGE(same_items, "Both paths should draw the same items.");
+	CHECK_MESSAGE(bvh_time < linear_time, "Querying the BVH should be faster than visiting every child.");
+
+	for (int i = 0; i < children.size(); i++) {
+		canvas.free(children[i]);
+	}
+	canvas.free(root);
+}
+
+} // namespace TestCanvasCull
+
+#endif // TEST_CANVAS_CULL_H
@@ -31,7 +31,10 @@
 #ifndef TEST_FILE_ACCESS_H
 #define TEST_FILE_ACCESS_H
 
+#include "core/io/file_access_memory.h"
+#include "core/os/dir_access.h"
 #include "core/os/file_access.h"
+#include "core/os/os.h"
 #include "test_utils.h"
 
 namespace TestFileAccess {
@@ -60,6 +63,83 @@ TEST_CASE("[FileAccess] CSV read") {
 	f->close();
 	memdelete(f);
 }
+
+TEST_CASE("[FileAccess] Get integers") {
+	const uint8_t data[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+
+	FileAccessMemory fa;
+	fa.open_custom(data, sizeof(data));
+
+	CHECK(fa.get_16() == 0x0201);
+	CHECK(fa.get_32() == 0x06050403);
+	fa.seek(0);
+	CHECK(fa.get_64() == 0x0807060504030201);
+
+	fa.set_endian_swap(true);
+	fa.seek(0);
+	CHECK(fa.get_16() == 0x0102);
+	CHECK(fa.get_32() == 0x03040506);
+	fa.seek(0);
+	CHECK(fa.get_64() == 0x0102030405060708);
+}
+
+TEST_CASE("[FileAccess] Get integers from a file") {
+	// FileAccessMemory has its own decoding, a file on disk goes through the base FileAccess one.
+	const String path = OS::get_singleton()->get_cache_path().plus_file("file_access_integers.bin");
+	const uint8_t data[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A };
+	{
+		FileAccessRef f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f);
+		f->store_buffer(data, sizeof(data));
+	}
+
+	{
+		FileAccessRef f = FileAccess::open(path, FileAccess::READ);
+		REQUIRE(f);
+
+		CHECK(f->get_16() == 0x0201);
+		CHECK(f->get_32() == 0x06050403);
+		CHECK(f->get_position() == 6);
+		f->seek(0);
+		CHECK(f->get_64() == 0x0807060504030201);
+
+		// Reading past the end fills the missing bytes with zeros.
+		CHECK(f->get_32() == 0x0A09);
+		CHECK(f->eof_reached());
+
+		f->set_endian_swap(true);
+		f->seek(0);
+		CHECK(f->get_16() == 0x0102);
+		CHECK(f->get_32() == 0x03040506);
+		f->seek(0);
+		CHECK(f->get_64() == 0x0102030405060708);
+	}
+
+	// Big endian values written by the base FileAccess read back the same.
+	{
+		FileAccessRef f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f);
+		f->set_endian_swap(true);
+		f->store_16(0x0102);
+		f->store_32(0x03040506);
+		f->store_64(0x0708090A0B0C0D0E);
+	}
+
+	{
+		FileAccessRef f = FileAccess::open(path, FileAccess::READ);
+		REQUIRE(f);
+
+		CHECK(f->get_8() == 0x01);
+		CHECK(f->get_8() == 0x02);
+		f->set_endian_swap(true);
+		CHECK(f->get_32() == 0x03040506);
+		CHECK(f->get_64() == 0x0708090A0B0C0D0E);
+		f->seek(0);
+		CHECK(f->get_16() == 0x0102);
+	}
+
+	DirAccess::remove_file_or_error(path);
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
@@ -0,0 +1,357 @@
+/*************************************************************************/
+/*  test_heightmap_shape_3d.h                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_HEIGHTMAP_SHAPE_3D_H
+#define TEST_HEIGHTMAP_SHAPE_3D_H
+
+#include "core/math/face3.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "servers/physics_3d/shape_3d_sw.h"
+
+#include "tests/test_macros.h"
+
+namespace TestHeightMapShape3D {
+
+// Size which is not a multiple of the chunk size, so the last chunks on each axis are smaller.
+const int WIDTH = 40;
+const int DEPTH = 35;
+const int SPIKE_X = 21;
+const int SPIKE_Z = 18;
+
+Dictionary create_heightmap_data() {
+	PackedFloat32Array heights;
+	heights.resize(WIDTH * DEPTH);
+	for (int z = 0; z < DEPTH; z++) {
+		for (int x = 0; x < WIDTH; x++) {
+			heights.write[z * WIDTH + x] = Math::sin(x * 0.3) * Math::cos(z * 0.2);
+		}
+	}
+	heights.write[SPIKE_Z * WIDTH + SPIKE_X] = 10.0;
+
+	Dictionary d;
+	d["width"] = WIDTH;
+	d["depth"] = DEPTH;
+	d["heights"] = heights;
+	return d;
+}
+
+void collect_faces(void *p_userdata, Shape3DSW *p_convex) {
+	const FaceShape3DSW *face = static_cast<FaceShape3DSW *>(p_convex);
+	static_cast<Vector<Face3> *>(p_userdata)->push_back(Face3(face->vertex[0], face->vertex[1], face->vertex[2]));
+}
+
+// Large terrain used to compare the chunked queries against walking every cell in range.
+const int LARGE_SIZE = 4096;
+
+Dictionary create_large_heightmap_data() {
+	PackedFloat32Array heights;
+	heights.resize(LARGE_SIZE * LARGE_SIZE);
+	float *w = heights.ptrw();
+	for (int z = 0; z < LARGE_SIZE; z++) {
+		for (int x = 0; x < LARGE_SIZE; x++) {
+			w[z * LARGE_SIZE + x] = 20.0 * Math::sin(x * 0.01) * Math::cos(z * 0.013) + Math::sin(x * 0.7 + z * 0.3);
+		}
+	}
+
+	Dictionary d;
+	d["width"] = LARGE_SIZE;
+	d["depth"] = LARGE_SIZE;
+	d["heights"] = heights;
+	return d;
+}
+
+void get_cell_faces(const HeightMapShape3DSW &p_shape, int p_x, int p_z, Face3 r_faces[2]) {
+	Vector3 points[4];
+	p_shape._get_point(p_x, p_z, points[0]);
+	p_shape._get_point(p_x + 1, p_z, points[1]);
+	p_shape._get_point(p_x, p_z + 1, points[2]);
+	p_shape._get_point(p_x + 1, p_z + 1, points[3]);
+	r_faces[0] = Face3(points[0], points[1], points[2]);
+	r_faces[1] = Face3(points[1], points[3], points[2]);
+}
+
+// Cell range covered by a local rectangle, clamped to the heightmap.
+void get_cell_range(const HeightMapShape3DSW &p_shape, real_t p_min_x, real_t p_min_z, real_t p_max_x, real_t p_max_z, int &r_begin_x, int &r_begin_z, int &r_end_x, int &r_end_z) {
+	const real_t offset_x = 0.5 * (p_shape.width - 1.0);
+	const real_t offset_z = 0.5 * (p_shape.depth - 1.0);
+	r_begin_x = CLAMP(int(Math::floor(p_min_x + offset_x)), 0, p_shape.width - 2);
+	r_begin_z = CLAMP(int(Math::floor(p_min_z + offset_z)), 0, p_shape.depth - 2);
+	r_end_x = CLAMP(int(Math::floor(p_max_x + offset_x)), 0, p_shape.width - 2);
+	r_end_z = CLAMP(int(Math::floor(p_max_z + offset_z)), 0, p_shape.depth - 2);
+}
+
+int count_overlapping_faces_naive(const HeightMapShape3DSW &p_shape, const AABB &p_aabb) {
+	int begin_x, begin_z, end_x, end_z;
+	get_cell_range(p_shape, p_aabb.position.x, p_aabb.position.z, p_aabb.position.x + p_aabb.size.x, p_aabb.position.z + p_aabb.size.z, begin_x, begin_z, end_x, end_z);
+
+	int count = 0;
+	for (int z = begin_z; z <= end_z; z++) {
+		for (int x = begin_x; x <= end_x; x++) {
+			Face3 faces[2];
+			get_cell_faces(p_shape, x, z, faces);
+			for (int i = 0; i < 2; i++) {
+				if (faces[i].get_aabb().intersects_inclusive(p_aabb)) {
+					count++;
+				}
+			}
+		}
+	}
+	return count;
+}
+
+bool intersect_segment_naive(const HeightMapShape3DSW &p_shape, const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point) {
+	int begin_x, begin_z, end_x, end_z;
+	get_cell_range(p_shape, MIN(p_begin.x, p_end.x), MIN(p_begin.z, p_end.z), MAX(p_begin.x, p_end.x), MAX(p_begin.z, p_end.z), begin_x, begin_z, end_x, end_z);
+
+	bool found = false;
+	real_t closest = 1e20;
+	for (int z = begin_z; z <= end_z; z++) {
+		for (int x = begin_x; x <= end_x; x++) {
+			Face3 faces[2];
+			get_cell_faces(p_shape, x, z, faces);
+			for (int i = 0; i < 2; i++) {
+				Vector3 point;
+				if (faces[i].intersects_segment(p_begin, p_end, &point) && p_begin.distance_to(point) < closest) {
+					closest = p_begin.distance_to(point);
+					r_point = point;
+					found = true;
+				}
+			}
+		}
+	}
+	return found;
+}
+
+void count_culled_faces(void *p_userdata, Shape3DSW *p_convex) {
+	(*static_cast<int *>(p_userdata))++;
+}
+
+TEST_CASE("[HeightMapShape3DSW] Chunk bounds") {
+	HeightMapShape3DSW shape;
+	shape.set_data(create_heightmap_data());
+
+	REQUIRE(shape.bounds_grid_width == 3);
+	REQUIRE(shape.bounds_grid_depth == 3);
+	REQUIRE(shape.bounds_grid.size() == 9);
+
+	for (int chunk_z = 0; chunk_z < shape.bounds_grid_depth; chunk_z++) {
+		for (int chunk_x = 0; chunk_x < shape.bounds_grid_width; chunk_x++) {
+			// Chunks include the points on their far edges.
+			const int end_x = MIN((chunk_x + 1) * HeightMapShape3DSW::BOUNDS_CHUNK_SIZE, WIDTH - 1);
+			const int end_z = MIN((chunk_z + 1) * HeightMapShape3DSW::BOUNDS_CHUNK_SIZE, DEPTH - 1);
+
+			float expected_min = 1e20;
+			float expected_max = -1e20;
+			for (int z = chunk_z * HeightMapShape3DSW::BOUNDS_CHUNK_SIZE; z <= end_z; z++) {
+				for (int x = chunk_x * HeightMapShape3DSW::BOUNDS_CHUNK_SIZE; x <= end_x; x++) {
+					expected_min = MIN(expected_min, shape._get_height(x, z));
+					expected_max = MAX(expected_max, shape._get_height(x, z));
+				}
+			}
+
+			const HeightMapShape3DSW::Range &range = shape._get_bounds_chunk(chunk_x, chunk_z);
+			CHECK_MESSAGE(range.min == expected_min, vformat("Chunk (%d, %d) should have the minimum height of its points.", chunk_x, chunk_z));
+			CHECK_MESSAGE(range.max == expected_max, vformat("Chunk (%d, %d) should have the maximum height of its points.", chunk_x, chunk_z));
+		}
+	}
+
+	// The spike is on the edge between chunks, so all chunks sharing it must include it.
+	CHECK(shape._get_bounds_chunk(1, 1).max == 10.0);
+	CHECK(shape._get_bounds_chunk(0, 1).max < 10.0);
+}
+
+TEST_CASE("[HeightMapShape3DSW] Cull returns every face overlapping the query") {
+	HeightMapShape3DSW shape;
+	shape.set_data(create_heightmap_data());
+
+	const AABB queries[] = {
+		AABB(Vector3(-3.3, -0.5, -2.7), Vector3(4.1, 1.0, 3.6)), // Inside the regular terrain.
+		AABB(Vector3(0.2, 4.0, -1.4), Vector3(2.0, 2.0, 2.0)), // Only intersects the spike.
+		AABB(Vector3(-25.0, -0.2, -20.0), Vector3(50.0, 0.4, 40.0)), // Whole heightmap, thin slice.
+		AABB(Vector3(-10.0, 20.0, -10.0), Vector3(20.0, 5.0, 20.0)), // Above everything.
+	};
+
+	for (const AABB &query : queries) {
+		Vector<Face3> faces;
+		shape.cull(query, collect_faces, &faces);
+
+		int expected_count = 0;
+		for (int z = 0; z < DEPTH - 1; z++) {
+			for (int x = 0; x < WIDTH - 1; x++) {
+				Vector3 points[4];
+				shape._get_point(x, z, points[0]);
+				shape._get_point(x + 1, z, points[1]);
+				shape._get_point(x, z + 1, points[2]);
+				shape._get_point(x + 1, z + 1, points[3]);
+
+				const Face3 cell_faces[2] = {
+					Face3(points[0], points[1], points[2]),
+					Face3(points[1], points[3], points[2]),
+				};
+				for (const Face3 &cell_face : cell_faces) {
+					if (!cell_face.get_aabb().intersects_inclusive(query)) {
+						continue;
+					}
+					expected_count++;
+
+					bool found = false;
+					for (int i = 0; i < faces.size(); i++) {
+						if (faces[i].vertex[0] == cell_face.vertex[0] && faces[i].vertex[1] == cell_face.vertex[1] && faces[i].vertex[2] == cell_face.vertex[2]) {
+							found = true;
+							break;
+						}
+					}
+					CHECK_MESSAGE(found, vformat("Face of cell (%d, %d) overlapping %s should be returned.", x, z, query));
+				}
+			}
+		}
+
+		// Faces can be returned conservatively, but chunks far from the query must be skipped.
+		CHECK(faces.size() >= expected_count);
+		CHECK(faces.size() < (WIDTH - 1) * (DEPTH - 1) * 2);
+	}
+}
+
+TEST_CASE("[HeightMapShape3DSW] Intersect segment") {
+	HeightMapShape3DSW shape;
+	shape.set_data(create_heightmap_data());
+
+	Vector3 spike;
+	shape._get_point(SPIKE_X, SPIKE_Z, spike);
+
+	Vector3 point;
+	Vector3 normal;
+
+	// Horizontal segment crossing the whole heightmap above the regular terrain, it can only hit the spike.
+	CHECK(shape.intersect_segment(Vector3(-30.0, 5.0, spike.z + 0.25), Vector3(30.0, 5.0, spike.z + 0.25), point, normal));
+	CHECK(point.x > spike.x - 1.0);
+	CHECK(point.x < spike.x);
+	CHECK(point.y == doctest::Approx(5.0));
+	CHECK(normal.x < 0.0);
+
+	// Same segment away from the spike.
+	CHECK_FALSE(shape.intersect_segment(Vector3(-30.0, 5.0, spike.z - 6.25), Vector3(30.0, 5.0, spike.z - 6.25), point, normal));
+
+	// Vertical segment on a regular cell.
+	CHECK(shape.intersect_segment(Vector3(-10.3, 20.0, 5.6), Vector3(-10.3, -20.0, 5.6), point, normal));
+	CHECK(point.y >= -1.0);
+	CHECK(point.y <= 1.0);
+	CHECK(normal.y > 0.0);
+
+	// Diagonal segment going down onto the spike from above.
+	CHECK(shape.intersect_segment(spike + Vector3(-0.2, 20.0, 0.1), spike + Vector3(0.2, -20.0, 0.1), point, normal));
+	CHECK(point.y > 7.0);
+}
+
+TEST_CASE("[HeightMapShape3DSW] Queries on a 4k by 4k heightmap") {
+	HeightMapShape3DSW shape;
+	shape.set_data(create_large_heightmap_data());
+
+	RandomPCG rng(1234);
+	const double half_size = 0.5 * (LARGE_SIZE - 1.0);
+
+	// Boxes scattered over the terrain, some of them above it.
+	Vector<AABB> boxes;
+	for (int i = 0; i < 200; i++) {
+		const Vector3 position(rng.random(-half_size, half_size - 64.0), rng.random(-25.0, 25.0), rng.random(-half_size, half_size - 64.0));
+		boxes.push_back(AABB(position, Vector3(64.0, 2.0, 64.0)));
+	}
+	// Wide slices above the terrain, where the chunks matter the most.
+	for (int i = 0; i < 4; i++) {
+		boxes.push_back(AABB(Vector3(-half_size + i * 512.0, 23.0, -half_size), Vector3(1024.0, 1.0, 1024.0)));
+	}
+
+	// Segments going down through the terrain.
+	Vector<Vector3> segments;
+	for (int i = 0; i < 50; i++) {
+		const Vector3 begin(rng.random(-half_size + 256.0, half_size - 256.0), 30.0, rng.random(-half_size + 256.0, half_size - 256.0));
+		segments.push_back(begin);
+		segments.push_back(begin + Vector3(rng.random(-256.0, 256.0), -60.0, rng.random(-256.0, 256.0)));
+	}
+
+	uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+	Vector<int> naive_counts;
+	for (int i = 0; i < boxes.size(); i++) {
+		naive_counts.push_back(count_overlapping_faces_naive(shape, boxes[i]));
+	}
+	const uint64_t naive_cull_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+	begin_usec = OS::get_singleton()->get_ticks_usec();
+	Vector<int> counts;
+	for (int i = 0; i < boxes.size(); i++) {
+		int count = 0;
+		shape.cull(boxes[i], count_culled_faces, &count);
+		counts.push_back(count);
+	}
+	const uint64_t cull_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+	for (int i = 0; i < boxes.size(); i++) {
+		// Faces can be returned conservatively, but nothing overlapping the box can be missed.
+		CHECK_MESSAGE(counts[i] >= naive_counts[i], vformat("Cull should return every face overlapping %s.", boxes[i]));
+	}
+
+	begin_usec = OS::get_singleton()->get_ticks_usec();
+	Vector<bool> naive_hits;
+	Vector<Vector3> naive_points;
+	for (int i = 0; i < segments.size(); i += 2) {
+		Vector3 point;
+		naive_hits.push_back(intersect_segment_naive(shape, segments[i], segments[i + 1], point));
+		naive_points.push_back(point);
+	}
+	const uint64_t naive_segment_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+	begin_usec = OS::get_singleton()->get_ticks_usec();
+	Vector<bool> hits;
+	Vector<Vector3> points;
+	for (int i = 0; i < segments.size(); i += 2) {
+		Vector3 point;
+		Vector3 normal;
+		hits.push_back(shape.intersect_segment(segments[i], segments[i + 1], point, normal));
+		points.push_back(point);
+	}
+	const uint64_t segment_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+	for (int i = 0; i < hits.size(); i++) {
+		CHECK(hits[i] == naive_hits[i]);
+		if (hits[i] && naive_hits[i]) {
+			CHECK_MESSAGE(points[i].distance_to(naive_points[i]) < 0.01, "Segments should stop at the first face they hit.");
+		}
+	}
+
+	MESSAGE(vformat("Cull: %d usec with chunks, %d usec walking every cell.", cull_usec, naive_cull_usec));
+	MESSAGE(vformat("Intersect segment: %d usec with chunks, %d usec walking every cell.", segment_usec, naive_segment_usec));
+	CHECK_MESSAGE(cull_usec < naive_cull_usec, "Skipping chunks should make culling faster.");
+	CHECK_MESSAGE(segment_usec < naive_segment_usec, "Skipping chunks should make segment queries faster.");
+}
+
+} // namespace TestHeightMapShape3D
+
+#endif // TEST_HEIGHTMAP_SHAPE_3D_H
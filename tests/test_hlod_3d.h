@@ -0,0 +1,234 @@
+/*************************************************************************/
+/*  test_heightmap_shape_3d.h                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#ifndef TEST_HLOD_3D_H
+#define TEST_HLOD_3D_H
+
+#include "drivers/dummy/rasterizer_dummy.h"
+#include "scene/3d/hlod_3d.h"
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/resources/material.h"
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering/rendering_server_default.h"
+
+#include "tests/test_macros.h"
+
+namespace TestHLOD3D {
+
+typedef RendererSceneCull::Instance Instance;
+
+static bool in_draw_range(Instance &p_instance, float p_distance) {
+	return RendererSceneCull::_instance_in_draw_range(&p_instance, Vector3(0, 0, p_distance));
+}
+
+TEST_CASE("[HLOD3D] Draw range") {
+	Instance instance;
+	instance.transformed_aabb = AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2));
+
+	SUBCASE("No range") {
+		CHECK(in_draw_range(instance, 0));
+		CHECK(in_draw_range(instance, 100000));
+	}
+
+	SUBCASE("Without margins") {
+		instance.lod_begin = 10;
+		instance.lod_end = 100;
+		CHECK_FALSE(in_draw_range(instance, 9.9));
+		CHECK(in_draw_range(instance, 10));
+		CHECK(in_draw_range(instance, 99.9));
+		CHECK_FALSE(in_draw_range(instance, 100));
+		CHECK(in_draw_range(instance, 50));
+
+		instance.lod_end = 0;
+		CHECK_MESSAGE(in_draw_range(instance, 100000), "An end of 0 should mean no upper limit.");
+	}
+
+	SUBCASE("End margin") {
+		instance.lod_end = 100;
+		instance.lod_end_hysteresis = 5;
+
+		CHECK(in_draw_range(instance, 50));
+		CHECK_MESSAGE(in_draw_range(instance, 104), "A drawn instance should stay drawn within the margin past the end.");
+		CHECK_FALSE(in_draw_range(instance, 105));
+		CHECK_MESSAGE(!in_draw_range(instance, 96), "A hidden instance should stay hidden within the margin before the end.");
+		CHECK(in_draw_range(instance, 94));
+	}
+
+	SUBCASE("Begin margin") {
+		instance.lod_begin = 10;
+		instance.lod_begin_hysteresis = 2;
+
+		CHECK(in_draw_range(instance, 20));
+		CHECK_MESSAGE(in_draw_range(instance, 8.5), "A drawn instance should stay drawn within the margin before the begin.");
+		CHECK_FALSE(in_draw_range(instance, 7.9));
+		CHECK_MESSAGE(!in_draw_range(instance, 11), "A hidden instance should stay hidden within the margin past the begin.");
+		CHECK(in_draw_range(instance, 12));
+		CHECK_MESSAGE(in_draw_range(instance, 100000), "A begin margin shouldn't add an upper limit.");
+	}
+
+	SUBCASE("First check ignores the margins") {
+		instance.lod_end = 100;
+		instance.lod_end_hysteresis = 5;
+		CHECK_FALSE(in_draw_range(instance, 102));
+
+		instance.lod_range_checked = false;
+		CHECK(in_draw_range(instance, 98));
+	}
+
+	SUBCASE("Measured to the LOD parent") {
+		Instance parent;
+		parent.transformed_aabb = AABB(Vector3(-1, -1, 49), Vector3(2, 2, 2));
+		instance.lod_parent = &parent;
+		instance.lod_end = 20;
+
+		CHECK_MESSAGE(in_draw_range(instance, 40), "The distance should be measured to the center of the LOD parent.");
+		CHECK_FALSE(in_draw_range(instance, 0));
+	}
+}
+
+static Ref<ArrayMesh> make_box_mesh() {
+	Vector<Vector3> vertices;
+	for (int i = 0; i < 8; i++) {
+		vertices.push_back(Vector3(i & 1 ? 1 : -1, i & 2 ? 1 : -1, i & 4 ? 1 : -1));
+	}
+	const int faces[6][4] = { { 0, 1, 3, 2 }, { 4, 6, 7, 5 }, { 0, 4, 5, 1 }, { 2, 3, 7, 6 }, { 0, 2, 6, 4 }, { 1, 5, 7, 3 } };
+	Vector<int> indices;
+	for (int i = 0; i < 6; i++) {
+		indices.push_back(faces[i][0]);
+		indices.push_back(faces[i][1]);
+		indices.push_back(faces[i][2]);
+		indices.push_back(faces[i][0]);
+		indices.push_back(faces[i][2]);
+		indices.push_back(faces[i][3]);
+	}
+
+	Array arrays;
+	arrays.resize(Mesh::ARRAY_MAX);
+	arrays[Mesh::ARRAY_VERTEX] = vertices;
+	arrays[Mesh::ARRAY_INDEX] = indices;
+
+	Ref<ArrayMesh> mesh;
+	mesh.instance();
+	mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays);
+	return mesh;
+}
+
+static MeshInstance3D *add_box(Node *p_parent, const Ref<Mesh> &p_mesh, const Ref<Material> &p_material, const Vector3 &p_position) {
+	MeshInstance3D *mi = memnew(MeshInstance3D);
+	mi->set_mesh(p_mesh);
+	mi->set_material_override(p_material);
+	mi->set_translation(p_position);
+	p_parent->add_child(mi);
+	return mi;
+}
+
+TEST_CASE("[HLOD3D] Bake") {
+	// Baking reads the source meshes back from the rendering server, the dummy one keeps them.
+	RasterizerDummy::make_current();
+	RenderingServer *rendering_server = memnew(RenderingServerDefault);
+	rendering_server->init();
+
+	{
+		Ref<ArrayMesh> box = make_box_mesh();
+		Ref<ShaderMaterial> material_a;
+		material_a.instance();
+		Ref<ShaderMaterial> material_b;
+		material_b.instance();
+
+		HLOD3D *hlod = memnew(HLOD3D);
+		hlod->set_cluster_size(10);
+		hlod->set_simplify_ratio(1.0);
+
+		// Two clusters, the first one with two materials. The transform of the group
+		// node must be applied, the one of the HLOD node must not.
+		hlod->set_translation(Vector3(1000, 0, 0));
+		Node3D *group = memnew(Node3D);
+		group->set_translation(Vector3(0, 0, 5));
+		hlod->add_child(group);
+
+		MeshInstance3D *a0 = add_box(group, box, material_a, Vector3(2, 2, 0));
+		MeshInstance3D *a1 = add_box(group, box, material_b, Vector3(6, 2, 0));
+		MeshInstance3D *b0 = add_box(group, box, material_a, Vector3(32, 2, 0));
+		MeshInstance3D *b1 = add_box(group, box, material_a, Vector3(36, 2, 0));
+		MeshInstance3D *hidden = add_box(group, box, material_a, Vector3(52, 2, 0));
+		hidden->set_visible(false);
+
+		Ref<HLODData> data = hlod->bake();
+		REQUIRE(data.is_valid());
+		REQUIRE_MESSAGE(data->get_cluster_count() == 2, "Hidden meshes shouldn't be baked.");
+
+		CHECK(data->get_cluster_transform(0).origin.is_equal_approx(Vector3(4, 2, 5)));
+		CHECK(data->get_cluster_transform(1).origin.is_equal_approx(Vector3(34, 2, 5)));
+
+		Array sources = data->get_cluster_sources(0);
+		REQUIRE(sources.size() == 2);
+		CHECK(NodePath(sources[0]) == hlod->get_path_to(a0));
+		CHECK(NodePath(sources[1]) == hlod->get_path_to(a1));
+		sources = data->get_cluster_sources(1);
+		REQUIRE(sources.size() == 2);
+		CHECK(NodePath(sources[0]) == hlod->get_path_to(b0));
+		CHECK(NodePath(sources[1]) == hlod->get_path_to(b1));
+
+		Ref<Mesh> mesh = data->get_cluster_mesh(0);
+		REQUIRE(mesh.is_valid());
+		REQUIRE_MESSAGE(mesh->get_surface_count() == 2, "The first proxy should have one surface per material.");
+		CHECK(mesh->surface_get_material(0) == material_a);
+		CHECK(mesh->surface_get_material(1) == material_b);
+
+		mesh = data->get_cluster_mesh(1);
+		REQUIRE(mesh.is_valid());
+		REQUIRE_MESSAGE(mesh->get_surface_count() == 1, "Surfaces sharing a material should be merged.");
+
+		Array arrays = mesh->surface_get_arrays(0);
+		Vector<Vector3> vertices = arrays[Mesh::ARRAY_VERTEX];
+		Vector<int> indices = arrays[Mesh::ARRAY_INDEX];
+		CHECK(vertices.size() == 16);
+		CHECK(indices.size() == 72);
+
+		// Vertices are relative to the cluster center.
+		AABB bounds;
+		for (int i = 0; i < vertices.size(); i++) {
+			if (i == 0) {
+				bounds.position = vertices[i];
+			} else {
+				bounds.expand_to(vertices[i]);
+			}
+		}
+		CHECK(bounds.is_equal_approx(AABB(Vector3(-3, -1, -1), Vector3(6, 2, 2))));
+
+		memdelete(hlod);
+	}
+
+	rendering_server->finish();
+	memdelete(rendering_server);
+}
+
+} // namespace TestHLOD3D
+
+#endif // TEST_HLOD_3D_H
@@ -33,6 +33,7 @@
 
 #include "core/io/file_access_pack.h"
 #include "core/io/image.h"
+#include "core/templates/thread_work_pool.h"
 #include "test_utils.h"
 
 #include "thirdparty/doctest/doctest.h"
@@ -255,5 +256,163 @@ TEST_CASE("[Image] Modifying pixels of an image") {
 			image3->get_pixel(1, 0).is_equal_approx(Color(0, 0, 0, 0)),
 			"flip_y() should not leave old pixels behind.");
 }
+
+TEST_CASE("[Image] Processing large images") {
+	// Large enough to be processed by several threads, the results must match a per-pixel reference.
+	const int size = 512;
+	Vector<uint8_t> pattern;
+	pattern.resize(size * size * 4);
+	for (int i = 0; i < pattern.size(); i++) {
+		pattern.write[i] = (i * 7 + i / 2048) % 256;
+	}
+
+	Ref<Image> image = memnew(Image(size, size, false, Image::FORMAT_RGBA8, pattern));
+	image->premultiply_alpha();
+	bool premultiplied = true;
+	Vector<uint8_t> data = image->get_data();
+	const uint8_t *r = data.ptr();
+	for (int i = 0; i < size * size; i++) {
+		const uint8_t *src = &pattern[i * 4];
+		premultiplied = premultiplied && r[i * 4 + 0] == (src[0] * src[3]) >> 8 && r[i * 4 + 1] == (src[1] * src[3]) >> 8 && r[i * 4 + 2] == (src[2] * src[3]) >> 8 && r[i * 4 + 3] == src[3];
+	}
+	CHECK_MESSAGE(
+			premultiplied,
+			"premultiply_alpha() should multiply every pixel of a large image by its alpha.");
+
+	Ref<Image> source = memnew(Image(size, size, false, Image::FORMAT_RGBA8, pattern));
+	Ref<Image> resized_image = memnew(Image(size, size, false, Image::FORMAT_RGBA8, pattern));
+	resized_image->resize(size * 2, size * 2, Image::INTERPOLATE_NEAREST);
+	bool resized = true;
+	for (int y = 0; y < size * 2; y += 3) {
+		for (int x = 0; x < size * 2; x += 5) {
+			resized = resized && resized_image->get_pixel(x, y) == source->get_pixel(x / 2, y / 2);
+		}
+	}
+	CHECK_MESSAGE(
+			resized,
+			"resize() with nearest interpolation should duplicate every pixel of a large image.");
+
+	Ref<Image> converted_image = memnew(Image(size, size, false, Image::FORMAT_RGBA8, pattern));
+	converted_image->convert(Image::FORMAT_RGB8);
+	CHECK(converted_image->get_format() == Image::FORMAT_RGB8);
+	bool converted = true;
+	data = converted_image->get_data();
+	r = data.ptr();
+	for (int i = 0; i < size * size; i++) {
+		converted = converted && r[i * 3 + 0] == pattern[i * 4 + 0] && r[i * 3 + 1] == pattern[i * 4 + 1] && r[i * 3 + 2] == pattern[i * 4 + 2];
+	}
+	CHECK_MESSAGE(
+			converted,
+			"convert() should keep the color channels of every pixel of a large image.");
+
+	Ref<Image> mipmap = memnew(Image(size, size, false, Image::FORMAT_RGBA8, pattern));
+	mipmap->generate_mipmaps();
+	mipmap->shrink_x2();
+	data = mipmap->get_data();
+	bool averaged = true;
+	for (int y = 0; y < size / 2; y += 3) {
+		for (int x = 0; x < size / 2; x += 5) {
+			const uint8_t *src = &pattern[(y * 2 * size + x * 2) * 4];
+			uint32_t sum = uint32_t(src[0]) + src[4] + src[size * 4] + src[size * 4 + 4];
+			averaged = averaged && data[(y * (size / 2) + x) * 4] == (sum + 2) >> 2;
+		}
+	}
+	CHECK_MESSAGE(
+			averaged,
+			"generate_mipmaps() should average every 2x2 block of a large image.");
+}
+
+static Ref<Image> create_large_pattern_image(int p_size) {
+	Vector<uint8_t> pattern;
+	pattern.resize(p_size * p_size * 4);
+	for (int i = 0; i < pattern.size(); i++) {
+		pattern.write[i] = (i * 7 + i / 2048) % 256;
+	}
+	// Some fully transparent areas, so alpha edges get fixed and blending skips pixels.
+	for (int y = 0; y < p_size; y += 8) {
+		for (int x = 0; x < p_size / 2; x++) {
+			pattern.write[(y * p_size + x) * 4 + 3] = 0;
+		}
+	}
+	return memnew(Image(p_size, p_size, false, Image::FORMAT_RGBA8, pattern));
+}
+
+// Processes a copy of the image. Holding the shared pool keeps the processing on the calling thread.
+template <class F>
+static Vector<uint8_t> process_image_copy(const Ref<Image> &p_image, bool p_banded, const F &p_process) {
+	Ref<Image> image = p_image->duplicate();
+	if (p_banded) {
+		p_process(image);
+	} else {
+		ThreadWorkPool *pool = ThreadWorkPool::try_lock_shared();
+		REQUIRE_MESSAGE(pool, "The shared thread pool should be available to tests.");
+		p_process(image);
+		ThreadWorkPool::unlock_shared();
+	}
+	return image->get_data();
+}
+
+template <class F>
+static bool is_processed_the_same_in_bands(const Ref<Image> &p_image, const F &p_process) {
+	return process_image_copy(p_image, true, p_process) == process_image_copy(p_image, false, p_process);
+}
+
+TEST_CASE("[Image] Processing large images in bands matches the calling thread") {
+	// Larger than IMAGE_PROCESS_MIN_PIXELS, so the banded runs are split over the pool.
+	const int size = 512;
+	Ref<Image> image = create_large_pattern_image(size);
+
+	SUBCASE("Blending") {
+		Ref<Image> source = create_large_pattern_image(size);
+		CHECK_MESSAGE(
+				is_processed_the_same_in_bands(image, [&](Ref<Image> &p_image) {
+					p_image->blend_rect(source, Rect2(16, 8, size - 32, size - 24), Point2(5, 3));
+				}),
+				"blend_rect() should give the same result in bands as on the calling thread.");
+		CHECK_MESSAGE(
+				is_processed_the_same_in_bands(image, [&](Ref<Image> &p_image) {
+					p_image->blend_rect(p_image, Rect2(0, 0, size - 40, size - 40), Point2(24, 40));
+				}),
+				"blend_rect() of an image onto itself should give the same result in bands as on the calling thread.");
+	}
+
+	SUBCASE("Color space and alpha") {
+		Ref<Image> mipmapped = image->duplicate();
+		mipmapped->generate_mipmaps();
+		CHECK_MESSAGE(
+				is_processed_the_same_in_bands(mipmapped, [](Ref<Image> &p_image) {
+					p_image->srgb_to_linear();
+				}),
+				"srgb_to_linear() of an image with mipmaps should give the same result in bands as on the calling thread.");
+		CHECK_MESSAGE(
+				is_processed_the_same_in_bands(image, [](Ref<Image> &p_image) {
+					p_image->fix_alpha_edges();
+				}),
+				"fix_alpha_edges() should give the same result in bands as on the calling thread.");
+		CHECK_MESSAGE(
+				is_processed_the_same_in_bands(image, [](Ref<Image> &p_image) {
+					p_image->premultiply_alpha();
+				}),
+				"premultiply_alpha() should give the same result in bands as on the calling thread.");
+	}
+
+	SUBCASE("Resizing") {
+		const Image::Interpolation interpolations[] = {
+			Image::INTERPOLATE_BILINEAR,
+			Image::INTERPOLATE_CUBIC,
+			Image::INTERPOLATE_TRILINEAR,
+			Image::INTERPOLATE_LANCZOS,
+		};
+		for (int i = 0; i < 4; i++) {
+			Image::Interpolation interpolation = interpolations[i];
+			// Different scales on each axis, so both Lanczos passes run (the first one in bands of columns).
+			CHECK_MESSAGE(
+					is_processed_the_same_in_bands(image, [&](Ref<Image> &p_image) {
+						p_image->resize(size * 3 / 2, size - 100, interpolation);
+					}),
+					vformat("resize() with interpolation %d should give the same result in bands as on the calling thread.", interpolation));
+		}
+	}
+}
 } // namespace TestImage
 #endif // TEST_IMAGE_H
@@ -36,6 +36,7 @@
 #include "test_array.h"
 #include "test_astar.h"
 #include "test_basis.h"
+#include "test_canvas_cull.h"
 #include "test_class_db.h"
 #include "test_color.h"
 #include "test_command_queue.h"
@@ -50,6 +51,8 @@
 #include "test_gradient.h"
 #include "test_gui.h"
 #include "test_hashing_context.h"
+#include "test_heightmap_shape_3d.h"
+#include "test_hlod_3d.h"
 #include "test_image.h"
 #include "test_json.h"
 #include "test_list.h"
@@ -61,19 +64,26 @@
 #include "test_node_path.h"
 #include "test_oa_hash_map.h"
 #include "test_object.h"
+#include "test_occlusion_cull.h"
 #include "test_ordered_hash_map.h"
+#include "test_packet_peer.h"
 #include "test_paged_array.h"
 #include "test_path_3d.h"
 #include "test_pck_packer.h"
 #include "test_physics_2d.h"
 #include "test_physics_3d.h"
+#include "test_radix_sort.h"
 #include "test_random_number_generator.h"
 #include "test_rect2.h"
 #include "test_render.h"
 #include "test_resource.h"
+#include "test_resource_format_binary.h"
+#include "test_resource_importer_texture.h"
+#include "test_shader_compiler_rd.h"
 #include "test_shader_lang.h"
 #include "test_string.h"
 #include "test_text_server.h"
+#include "test_texture_streaming.h"
 #include "test_validate_testing.h"
 #include "test_variant.h"
 #include "test_xml_parser.h"
@@ -324,6 +324,112 @@ TEST_CASE("[Marshalls] FLOAT double precision Variant decoding") {
 	CHECK(r_len == 12);
 	CHECK(variant == Variant(0.33333333333333333));
 }
+
+TEST_CASE("[Marshalls] STRING Variant encoding") {
+	int r_len;
+	Variant variant(String::utf8("h\xc3\xa9llo"));
+	uint8_t buffer[16];
+
+	CHECK(encode_variant(variant, buffer, r_len) == OK);
+	CHECK_MESSAGE(r_len == 16, "Length == 4 bytes for Variant::Type + 4 bytes for length + 6 bytes for UTF-8 + 2 bytes of padding");
+	CHECK(buffer[0] == 0x04);
+	CHECK(buffer[4] == 0x06);
+	CHECK(buffer[8] == 'h');
+	CHECK(buffer[9] == 0xc3);
+	CHECK(buffer[10] == 0xa9);
+	CHECK(buffer[13] == 'o');
+	CHECK(buffer[14] == 0x00);
+	CHECK(buffer[15] == 0x00);
+
+	Variant decoded;
+	CHECK(decode_variant(decoded, buffer, r_len) == OK);
+	CHECK(decoded == variant);
+}
+
+TEST_CASE("[Marshalls] Typed ARRAY Variant encoding") {
+	Array array;
+	array.set_typed(Variant::INT, StringName(), Variant());
+	array.push_back(1);
+	array.push_back(-2);
+	array.push_back(int64_t(1) << 40);
+
+	int r_len;
+	uint8_t buffer[36];
+	CHECK(encode_variant(array, buffer, r_len) == OK);
+	CHECK_MESSAGE(r_len == 36, "Length == 4 bytes for Variant::Type + 4 bytes for size + 4 bytes for element type + 3 * 8 bytes for values");
+	CHECK(buffer[0] == Variant::ARRAY);
+	CHECK_MESSAGE(buffer[2] == 0x01, "Typed array flag");
+	CHECK(buffer[4] == 0x03);
+	CHECK(buffer[8] == Variant::INT);
+
+	Variant decoded;
+	int used;
+	CHECK(decode_variant(decoded, buffer, r_len, &used) == OK);
+	CHECK(used == 36);
+	Array decoded_array = decoded;
+	CHECK(decoded_array.is_typed());
+	CHECK(decoded_array.get_typed_builtin() == Variant::INT);
+	CHECK(decoded_array.size() == 3);
+	CHECK(decoded_array[0] == Variant(1));
+	CHECK(decoded_array[1] == Variant(-2));
+	CHECK(decoded_array[2] == Variant(int64_t(1) << 40));
+}
+
+TEST_CASE("[Marshalls] Typed ARRAY Variant decoding with invalid element type") {
+	Variant variant;
+	uint8_t buffer[] = {
+		0x19, 0x00, 0x01, 0x00, // Variant::ARRAY & ENCODE_FLAG_TYPED_ARRAY
+		0x01, 0x00, 0x00, 0x00, // size
+		0x15, 0x00, 0x00, 0x00, // Variant::OBJECT
+		0x00, 0x00, 0x00, 0x00
+	};
+
+	ERR_PRINT_OFF;
+	CHECK(decode_variant(variant, buffer, 16) == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[Marshalls] Variant decoding with storage reuse") {
+	Array source;
+	source.push_back("first");
+	source.push_back(PackedInt32Array());
+	source.push_back(2.5);
+
+	Vector<uint8_t> buffer;
+	int r_len;
+	CHECK(encode_variant(source, buffer, 0, r_len) == OK);
+
+	Array target;
+	target.push_back("a previous string");
+	target.push_back(Variant());
+	target.push_back(Variant());
+	target.push_back(Variant());
+	Variant variant = target;
+
+	CHECK(decode_variant(variant, buffer.ptr(), r_len, nullptr, false, true) == OK);
+	CHECK_MESSAGE(target.size() == 3, "The array held by the Variant is decoded into in place.");
+	CHECK(target[0] == Variant("first"));
+	CHECK(target[1].get_type() == Variant::PACKED_INT32_ARRAY);
+	CHECK(target[2] == Variant(2.5));
+}
+
+TEST_CASE("[Marshalls] Variant encoding into a reusable buffer") {
+	Vector<uint8_t> buffer;
+	int r_len;
+
+	CHECK(encode_variant(String("reusable"), buffer, 4, r_len) == OK);
+	CHECK(r_len == 16);
+	CHECK(buffer.size() == 20);
+	CHECK(buffer[4] == Variant::STRING);
+
+	CHECK(encode_variant(1, buffer, 0, r_len) == OK);
+	CHECK(r_len == 8);
+	CHECK_MESSAGE(buffer.size() == 20, "The buffer is not shrunk.");
+
+	Variant decoded;
+	CHECK(decode_variant(decoded, buffer.ptr(), r_len) == OK);
+	CHECK(decoded == Variant(1));
+}
 } // namespace TestMarshalls
 
 #endif // TEST_MARSHALLS_H
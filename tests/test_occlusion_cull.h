@@ -0,0 +1,102 @@
+/*************************************************************************/
+/*  test_occlusion_cull.h                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_OCCLUSION_CULL_H
+#define TEST_OCCLUSION_CULL_H
+
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestOcclusionCull {
+
+// Quad facing the camera at the given depth, the camera looks towards -Z.
+void add_quad_occluder(RendererSceneOcclusionCull &p_occlusion, real_t p_left, real_t p_right, real_t p_bottom, real_t p_top, real_t p_z) {
+	const Vector3 vertices[4] = {
+		Vector3(p_left, p_bottom, p_z),
+		Vector3(p_right, p_bottom, p_z),
+		Vector3(p_right, p_top, p_z),
+		Vector3(p_left, p_top, p_z),
+	};
+	const int indices[6] = { 0, 1, 2, 0, 2, 3 };
+	p_occlusion.add_occluder(Transform(), vertices, 4, indices, 6);
+}
+
+TEST_CASE("[OcclusionCull] Orthogonal projection") {
+	RendererSceneOcclusionCull occlusion;
+	CHECK_FALSE(occlusion.is_active());
+
+	// 64x64 texels over 32x32 units, so each texel is 0.5 units wide.
+	CameraMatrix projection;
+	projection.set_orthogonal(-16, 16, -16, 16, 0.1, 100);
+	occlusion.begin(64, Transform(), projection);
+	// The right edge crosses the texel spanning [4, 4.5], after its center.
+	add_quad_occluder(occlusion, -4, 4.3, -4, 4, -10);
+	occlusion.end();
+	REQUIRE(occlusion.is_active());
+
+	CHECK_MESSAGE(occlusion.is_occluded(AABB(Vector3(2, -0.4, -20), Vector3(1, 0.8, 1))), "Box behind the occluder should be occluded.");
+	CHECK_FALSE_MESSAGE(occlusion.is_occluded(AABB(Vector3(-1, -1, -6), Vector3(2, 2, 1))), "Box in front of the occluder should be visible.");
+	CHECK_FALSE_MESSAGE(occlusion.is_occluded(AABB(Vector3(6, -1, -20), Vector3(2, 2, 1))), "Box next to the occluder should be visible.");
+	CHECK_FALSE_MESSAGE(occlusion.is_occluded(AABB(Vector3(-1, -1, -12), Vector3(2, 2, 4))), "Box crossing the occluder should be visible.");
+	CHECK_FALSE_MESSAGE(occlusion.is_occluded(AABB(Vector3(20, -1, -20), Vector3(2, 2, 1))), "Box out of the view should not be occluded.");
+
+	// Sticks out of the occluder by less than a texel, in a texel whose center is covered.
+	CHECK_FALSE_MESSAGE(occlusion.is_occluded(AABB(Vector3(3.6, -0.4, -20), Vector3(0.8, 0.8, 1))), "Box partially visible by less than a texel should be visible.");
+
+	occlusion.clear();
+	CHECK_FALSE(occlusion.is_active());
+	CHECK_FALSE(occlusion.is_occluded(AABB(Vector3(2, -0.4, -20), Vector3(1, 0.8, 1))));
+}
+
+TEST_CASE("[OcclusionCull] Perspective projection") {
+	RendererSceneOcclusionCull occlusion;
+
+	CameraMatrix projection;
+	projection.set_perspective(90, 1, 0.1, 100);
+	occlusion.begin(64, Transform(), projection);
+	add_quad_occluder(occlusion, -5, 5, -5, 5, -10);
+	occlusion.end();
+	REQUIRE(occlusion.is_active());
+
+	CHECK_MESSAGE(occlusion.is_occluded(AABB(Vector3(-1, -1, -31), Vector3(2, 2, 1))), "Box behind the occluder should be occluded.");
+	CHECK_FALSE_MESSAGE(occlusion.is_occluded(AABB(Vector3(20, -1, -31), Vector3(2, 2, 1))), "Box outside of the occluder's projection should be visible.");
+	CHECK_FALSE_MESSAGE(occlusion.is_occluded(AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2))), "Box crossing the near plane should be visible.");
+
+	// Moving the camera changes what is hidden.
+	occlusion.begin(64, Transform(Basis(), Vector3(20, 0, 0)), projection);
+	add_quad_occluder(occlusion, -5, 5, -5, 5, -10);
+	occlusion.end();
+	CHECK_FALSE(occlusion.is_occluded(AABB(Vector3(-1, -1, -31), Vector3(2, 2, 1))));
+}
+
+} // namespace TestOcclusionCull
+
+#endif // TEST_OCCLUSION_CULL_H
@@ -0,0 +1,133 @@
+/*************************************************************************/
+/*  test_packet_peer.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PACKET_PEER_H
+#define TEST_PACKET_PEER_H
+
+#include "core/io/packet_peer.h"
+#include "core/templates/list.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPacketPeer {
+
+// Every packet that is put can be got back, in order.
+class LoopbackPacketPeer : public PacketPeer {
+	List<Vector<uint8_t>> packets;
+	Vector<uint8_t> current_packet;
+
+public:
+	virtual int get_available_packet_count() const override { return packets.size(); }
+
+	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) override {
+		ERR_FAIL_COND_V(packets.is_empty(), ERR_UNAVAILABLE);
+		current_packet = packets.front()->get();
+		packets.pop_front();
+		*r_buffer = current_packet.ptr();
+		r_buffer_size = current_packet.size();
+		return OK;
+	}
+
+	virtual Error put_packet(const uint8_t *p_buffer, int p_buffer_size) override {
+		Vector<uint8_t> packet;
+		packet.resize(p_buffer_size);
+		copymem(packet.ptrw(), p_buffer, p_buffer_size);
+		packets.push_back(packet);
+		return OK;
+	}
+
+	virtual int get_max_packet_size() const override { return 1 << 24; }
+};
+
+TEST_CASE("[PacketPeer] Put and get variants") {
+	Ref<LoopbackPacketPeer> peer;
+	peer.instance();
+
+	PackedInt32Array numbers;
+	numbers.push_back(1);
+	numbers.push_back(-2);
+	CHECK(peer->put_var("a string") == OK);
+	CHECK(peer->put_var(numbers) == OK);
+	CHECK(peer->put_var(42) == OK);
+	CHECK(peer->get_available_packet_count() == 3);
+
+	Variant value;
+	CHECK(peer->get_var(value) == OK);
+	CHECK(value == Variant("a string"));
+	CHECK(peer->get_var(value) == OK);
+	CHECK(value == Variant(numbers));
+	CHECK(peer->get_var(value) == OK);
+	CHECK(value == Variant(42));
+}
+
+TEST_CASE("[PacketPeer] Get variants into the same storage") {
+	Ref<LoopbackPacketPeer> peer;
+	peer.instance();
+
+	PackedByteArray first;
+	PackedByteArray second;
+	for (int i = 0; i < 64; i++) {
+		first.push_back(i);
+	}
+	for (int i = 0; i < 32; i++) {
+		second.push_back(i * 3);
+	}
+	CHECK(peer->put_var(first) == OK);
+	CHECK(peer->put_var(second) == OK);
+
+	Variant value;
+	CHECK(peer->get_var(value, false, true) == OK);
+	CHECK(value == Variant(first));
+	const PackedByteArray kept = value;
+
+	CHECK(peer->get_var(value, false, true) == OK);
+	CHECK(value == Variant(second));
+	CHECK_MESSAGE(kept == first, "Copies of the previous value are not written to.");
+}
+
+TEST_CASE("[PacketPeer] Encode buffer size limit") {
+	Ref<LoopbackPacketPeer> peer;
+	peer.instance();
+	peer->set_encode_buffer_max_size(1024);
+
+	PackedByteArray data;
+	data.resize(2048);
+	ERR_PRINT_OFF;
+	CHECK(peer->put_var(data) == ERR_OUT_OF_MEMORY);
+	ERR_PRINT_ON;
+	CHECK(peer->get_available_packet_count() == 0);
+
+	data.resize(512);
+	CHECK(peer->put_var(data) == OK);
+	CHECK(peer->get_available_packet_count() == 1);
+}
+} // namespace TestPacketPeer
+
+#endif // TEST_PACKET_PEER_H
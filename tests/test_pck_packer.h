@@ -32,8 +32,11 @@
 #define TEST_PCK_PACKER_H
 
 #include "core/io/file_access_pack.h"
+#include "core/io/marshalls.h"
 #include "core/io/pck_packer.h"
+#include "core/object/script_language.h"
 #include "core/os/os.h"
+#include "core/version.h"
 
 #include "thirdparty/doctest/doctest.h"
 
@@ -42,6 +45,79 @@ namespace TestPCKPacker {
 // Dummy 64-character encryption key (since it's required).
 constexpr const char *ENCRYPTION_KEY = "0000000000000000000000000000000000000000000000000000000000000000";
 
+// Repetitive data that compresses well, spanning several 64 KiB blocks.
+static Vector<uint8_t> make_compressible_data(int p_size, int p_seed) {
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	for (int i = 0; i < p_size; i++) {
+		data.write[i] = ((i / 7) + p_seed) % 61;
+	}
+	return data;
+}
+
+static String write_source_file(const String &p_name, const Vector<uint8_t> &p_data) {
+	const String path = OS::get_singleton()->get_cache_path().plus_file(p_name);
+	FileAccessRef f = FileAccess::open(path, FileAccess::WRITE);
+	REQUIRE(f);
+	f->store_buffer(p_data.ptr(), p_data.size());
+	return path;
+}
+
+static Vector<uint8_t> read_packed_file(const String &p_path) {
+	Vector<uint8_t> data;
+	FileAccessRef f = FileAccess::open(p_path, FileAccess::READ);
+	REQUIRE(f);
+	data.resize(f->get_len());
+	CHECK(f->get_buffer(data.ptrw(), data.size()) == data.size());
+	return data;
+}
+
+struct RawPackedFile {
+	String path;
+	uint64_t size = 0; // Uncompressed size.
+	Vector<uint8_t> data; // As stored in the pack.
+	uint32_t flags = 0;
+};
+
+// Writes a pack by hand, for formats and contents PCKPacker doesn't produce.
+static void write_raw_pack(const String &p_path, uint32_t p_version, const Vector<RawPackedFile> &p_files) {
+	FileAccessRef f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f);
+
+	f->store_32(PACK_HEADER_MAGIC);
+	f->store_32(p_version);
+	f->store_32(VERSION_MAJOR);
+	f->store_32(VERSION_MINOR);
+	f->store_32(0); // Patch.
+	f->store_32(0); // Pack flags.
+	uint64_t file_base_ofs = f->get_position();
+	f->store_64(0); // Files base, set below.
+	for (int i = 0; i < 16; i++) {
+		f->store_32(0); // Reserved, or the compression dictionary in version 3.
+	}
+
+	f->store_32(p_files.size());
+	uint64_t ofs = 0;
+	for (int i = 0; i < p_files.size(); i++) {
+		CharString path = p_files[i].path.utf8();
+		f->store_32(path.length());
+		f->store_buffer((const uint8_t *)path.get_data(), path.length());
+		f->store_64(ofs);
+		f->store_64(p_files[i].size);
+		uint8_t md5[16] = {};
+		f->store_buffer(md5, 16);
+		f->store_32(p_files[i].flags);
+		ofs += p_files[i].data.size();
+	}
+
+	uint64_t file_base = f->get_position();
+	for (int i = 0; i < p_files.size(); i++) {
+		f->store_buffer(p_files[i].data.ptr(), p_files[i].data.size());
+	}
+	f->seek(file_base_ofs);
+	f->store_64(file_base);
+}
+
 TEST_CASE("[PCKPacker] Pack an empty PCK file") {
 	PCKPacker pck_packer;
 	const String output_pck_path = OS::get_singleton()->get_cache_path().plus_file("output_empty.pck");
@@ -109,6 +185,219 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_len() <= 35000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Pack and read back a PCK file with compressed files") {
+	// Several blocks of repetitive data (blocks are 64 KiB), so that reads span cached partial blocks and whole blocks.
+	const int block_size = 65536;
+	const String source_path = OS::get_singleton()->get_cache_path().plus_file("compressed_source.bin");
+	Vector<uint8_t> source;
+	source.resize(block_size * 5 + 1234);
+	for (int i = 0; i < source.size(); i++) {
+		source.write[i] = (i / 7) % 61;
+	}
+	{
+		FileAccessRef f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f);
+		f->store_buffer(source.ptr(), source.size());
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = OS::get_singleton()->get_cache_path().plus_file("output_compressed.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path, 0, ENCRYPTION_KEY) == OK);
+	CHECK_MESSAGE(
+			pck_packer.add_file("res://compressed_test/data.bin", source_path, false, true) == OK,
+			"Adding a compressed file to the PCK should return an OK error code.");
+	CHECK_MESSAGE(
+			pck_packer.flush() == OK,
+			"Flushing the PCK should return an OK error code.");
+
+	{
+		FileAccessRef f = FileAccess::open(output_pck_path, FileAccess::READ);
+		REQUIRE(f);
+		CHECK_MESSAGE(
+				f->get_len() < (uint64_t)source.size() / 4,
+				"The generated PCK file should be much smaller than the repetitive file it holds.");
+	}
+
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+	FileAccessRef f = FileAccess::open("res://compressed_test/data.bin", FileAccess::READ);
+	REQUIRE(f);
+	CHECK_MESSAGE(
+			f->get_len() == (uint64_t)source.size(),
+			"The compressed file should report its uncompressed length.");
+
+	Vector<uint8_t> read;
+	read.resize(source.size());
+	CHECK(f->get_buffer(read.ptrw(), read.size()) == read.size());
+	CHECK_MESSAGE(
+			read == source,
+			"Reading the whole compressed file should return its original contents.");
+	CHECK(f->eof_reached() == false);
+	f->get_8();
+	CHECK(f->eof_reached() == true);
+
+	const uint64_t offset = block_size * 2 - 100;
+	f->seek(offset);
+	CHECK(f->get_8() == source[offset]);
+	uint8_t span[200];
+	CHECK(f->get_buffer(span, 200) == 200);
+	bool span_matches = true;
+	for (int i = 0; i < 200; i++) {
+		span_matches = span_matches && span[i] == source[offset + 1 + i];
+	}
+	CHECK_MESSAGE(
+			span_matches,
+			"Reading across a block boundary after seeking should return the original contents.");
+}
+
+TEST_CASE("[PCKPacker] Compress files with a dictionary") {
+	Vector<String> samples;
+	for (int i = 0; i < 3; i++) {
+		samples.push_back(write_source_file(vformat("dictionary_sample_%d.bin", i), make_compressible_data(4096, i)));
+	}
+	const Vector<uint8_t> source = make_compressible_data(65536 * 2 + 300, 5);
+	const String source_path = write_source_file("dictionary_source.bin", source);
+
+	{
+		PCKPacker pck_packer;
+		const String output_pck_path = OS::get_singleton()->get_cache_path().plus_file("output_built_dictionary.pck");
+		REQUIRE(pck_packer.pck_start(output_pck_path, 0, ENCRYPTION_KEY) == OK);
+		CHECK_MESSAGE(
+				pck_packer.build_compression_dictionary(samples, 8192) == OK,
+				"Building a dictionary from samples should return an OK error code.");
+		REQUIRE(pck_packer.add_file("res://built_dictionary/data.bin", source_path, false, true) == OK);
+		ERR_PRINT_OFF;
+		CHECK_MESSAGE(
+				pck_packer.set_compression_dictionary(source) == ERR_ALREADY_IN_USE,
+				"The dictionary can't be changed once files were added.");
+		ERR_PRINT_ON;
+		REQUIRE(pck_packer.flush() == OK);
+
+		REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+		CHECK_MESSAGE(
+				read_packed_file("res://built_dictionary/data.bin") == source,
+				"A file compressed with a built dictionary should read back as the original.");
+	}
+
+	{
+		Vector<uint8_t> dictionary = make_compressible_data(2048, 5);
+
+		PCKPacker pck_packer;
+		const String output_pck_path = OS::get_singleton()->get_cache_path().plus_file("output_set_dictionary.pck");
+		REQUIRE(pck_packer.pck_start(output_pck_path, 32, ENCRYPTION_KEY) == OK);
+		CHECK(pck_packer.set_compression_dictionary(dictionary) == OK);
+		REQUIRE(pck_packer.add_file("res://set_dictionary/data.bin", source_path, false, true) == OK);
+		REQUIRE(pck_packer.add_file("res://set_dictionary/stored.bin", samples[0]) == OK);
+		REQUIRE(pck_packer.flush() == OK);
+
+		REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+		CHECK(read_packed_file("res://set_dictionary/data.bin") == source);
+		CHECK_MESSAGE(
+				read_packed_file("res://set_dictionary/stored.bin") == make_compressible_data(4096, 0),
+				"Uncompressed files stored after the dictionary should read back as the original.");
+	}
+}
+
+TEST_CASE("[PCKPacker] Pack and read back encrypted compressed files") {
+	const Vector<uint8_t> source = make_compressible_data(65536 * 3 + 17, 3);
+	const String source_path = write_source_file("encrypted_compressed_source.bin", source);
+
+	// Packs are decrypted with the key the engine was built with.
+	const String key = String::hex_encode_buffer(script_encryption_key, 32);
+
+	PCKPacker pck_packer;
+	const String output_pck_path = OS::get_singleton()->get_cache_path().plus_file("output_encrypted_compressed.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path, 32, key, true) == OK);
+	REQUIRE(pck_packer.add_file("res://encrypted_compressed/data.bin", source_path, true, true) == OK);
+	REQUIRE(pck_packer.add_file("res://encrypted_compressed/plain.bin", source_path, false, false) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	{
+		FileAccessRef f = FileAccess::open(output_pck_path, FileAccess::READ);
+		REQUIRE(f);
+		CHECK_MESSAGE(
+				f->get_len() < (uint64_t)source.size() * 5 / 4,
+				"Only the uncompressed copy should take its full size in the pack.");
+	}
+
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+	CHECK(read_packed_file("res://encrypted_compressed/data.bin") == source);
+	CHECK(read_packed_file("res://encrypted_compressed/plain.bin") == source);
+
+	FileAccessRef f = FileAccess::open("res://encrypted_compressed/data.bin", FileAccess::READ);
+	REQUIRE(f);
+	const uint64_t offset = 65536 * 2 - 10;
+	f->seek(offset);
+	uint8_t span[20];
+	CHECK(f->get_buffer(span, 20) == 20);
+	bool span_matches = true;
+	for (int i = 0; i < 20; i++) {
+		span_matches = span_matches && span[i] == source[offset + i];
+	}
+	CHECK_MESSAGE(
+			span_matches,
+			"Reading across a block boundary of an encrypted compressed file should return the original contents.");
+}
+
+TEST_CASE("[PCKPacker] Read a version 2 pack") {
+	const String text = "Packed before files could be compressed.";
+	RawPackedFile file;
+	file.path = "res://version_2/file.txt";
+	file.data.resize(text.utf8().length());
+	copymem(file.data.ptrw(), text.utf8().get_data(), file.data.size());
+	file.size = file.data.size();
+
+	const String output_pck_path = OS::get_singleton()->get_cache_path().plus_file("output_version_2.pck");
+	Vector<RawPackedFile> files;
+	files.push_back(file);
+	write_raw_pack(output_pck_path, 2, files);
+
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+	FileAccessRef f = FileAccess::open("res://version_2/file.txt", FileAccess::READ);
+	REQUIRE(f);
+	CHECK(f->get_len() == file.size);
+	CHECK(f->get_as_utf8_string() == text);
+}
+
+TEST_CASE("[PCKPacker] Reject corrupt compressed files") {
+	// Header of a compressed file: block size, block count, then the compressed size of each block.
+	RawPackedFile oversized;
+	oversized.path = "res://corrupt_compressed/oversized_blocks.bin";
+	oversized.size = 100;
+	oversized.flags = PACK_FILE_COMPRESSED;
+	oversized.data.resize(16);
+	encode_uint32(1024 * 1024, oversized.data.ptrw());
+	encode_uint32(1, oversized.data.ptrw() + 4);
+	encode_uint32(4, oversized.data.ptrw() + 8);
+	encode_uint32(0, oversized.data.ptrw() + 12);
+
+	// Claims more blocks than the pack holds, the block sizes would be read past its end.
+	RawPackedFile truncated;
+	truncated.path = "res://corrupt_compressed/truncated.bin";
+	truncated.size = 65536 * 1000;
+	truncated.flags = PACK_FILE_COMPRESSED;
+	truncated.data.resize(8);
+	encode_uint32(65536, truncated.data.ptrw());
+	encode_uint32(1000, truncated.data.ptrw() + 4);
+
+	const String output_pck_path = OS::get_singleton()->get_cache_path().plus_file("output_corrupt_compressed.pck");
+	Vector<RawPackedFile> files;
+	files.push_back(oversized);
+	files.push_back(truncated); // Last, so nothing follows it in the pack.
+	write_raw_pack(output_pck_path, PACK_FORMAT_VERSION, files);
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+
+	ERR_PRINT_OFF;
+	for (int i = 0; i < files.size(); i++) {
+		FileAccessRef f = FileAccess::open(files[i].path, FileAccess::READ);
+		REQUIRE(f);
+		uint8_t buffer[64];
+		CHECK_MESSAGE(
+				f->get_buffer(buffer, 64) == -1,
+				"Reading a corrupt compressed file should fail instead of reading out of bounds.");
+	}
+	ERR_PRINT_ON;
+}
 } // namespace TestPCKPacker
 
 #endif // TEST_PCK_PACKER_H
@@ -32,10 +32,124 @@
 #define TEST_PHYSICS_2D_H
 
 #include "core/os/main_loop.h"
+#include "servers/physics_2d/body_2d_sw.h"
+#include "servers/physics_2d/body_pair_2d_sw.h"
+#include "servers/physics_2d/physics_server_2d_sw.h"
+#include "servers/physics_2d/shape_2d_sw.h"
+#include "servers/physics_2d/space_2d_sw.h"
+
+#include "tests/test_macros.h"
 
 namespace TestPhysics2D {
 
 MainLoop *test();
+
+static void move_body(Body2DSW *p_body, const Vector2 &p_position) {
+	p_body->set_state(PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, p_position));
+}
+
+static bool setup_pair(BodyPair2DSW *p_pair) {
+	return p_pair->setup(1.0 / 60.0);
 }
 
+TEST_CASE("[BodyPair2DSW] Narrowphase cache") {
+	// Bodies queue their shape updates on the server.
+	PhysicsServer2DSW *server = memnew(PhysicsServer2DSW);
+	server->init();
+	Space2DSW *space = memnew(Space2DSW);
+
+	// Static box at the origin and rigid box overlapping it, both with half extents of 1.
+	RectangleShape2DSW *shape_A = memnew(RectangleShape2DSW);
+	shape_A->set_data(Vector2(1, 1));
+	RectangleShape2DSW *shape_B = memnew(RectangleShape2DSW);
+	shape_B->set_data(Vector2(1, 1));
+
+	Body2DSW *body_A = memnew(Body2DSW);
+	body_A->set_mode(PhysicsServer2D::BODY_MODE_STATIC);
+	body_A->set_space(space);
+	body_A->add_shape(shape_A);
+
+	Body2DSW *body_B = memnew(Body2DSW);
+	body_B->set_space(space);
+	body_B->add_shape(shape_B);
+	move_body(body_B, Vector2(1.5, 0));
+
+	BodyPair2DSW *pair = memnew(BodyPair2DSW(body_A, 0, body_B, 0));
+	REQUIRE(setup_pair(pair));
+
+	SUBCASE("Result is reused while shapes don't change") {
+		CHECK_MESSAGE(setup_pair(pair), "Cached result should be kept when nothing moves.");
+
+		// Tiny motion within the cache tolerance.
+		move_body(body_B, Vector2(1.5005, 0));
+		CHECK(setup_pair(pair));
+
+		// Changing the shape data must trigger a new narrowphase.
+		shape_B->set_data(Vector2(0.2, 0.2));
+		CHECK_FALSE_MESSAGE(setup_pair(pair), "Shrunk shape should no longer collide.");
+		shape_B->set_data(Vector2(1, 1));
+		CHECK_MESSAGE(setup_pair(pair), "Restored shape should collide again.");
+
+		// Moving beyond the tolerance must trigger a new narrowphase.
+		move_body(body_B, Vector2(2.5, 0));
+		CHECK_FALSE(setup_pair(pair));
+		move_body(body_B, Vector2(1.5, 0));
+		CHECK(setup_pair(pair));
+	}
+
+	SUBCASE("Invalidated when the pair is skipped for a disabled shape") {
+		body_B->set_shape_as_disabled(0, true);
+		CHECK_FALSE(setup_pair(pair));
+		body_B->set_shape_as_disabled(0, false);
+		CHECK(setup_pair(pair));
+
+		// Separated while the pair was skipped.
+		body_B->set_shape_as_disabled(0, true);
+		CHECK_FALSE(setup_pair(pair));
+		move_body(body_B, Vector2(2.5, 0));
+		body_B->set_shape_as_disabled(0, false);
+		CHECK_FALSE_MESSAGE(setup_pair(pair), "Re-enabled shape should go through the narrowphase again.");
+	}
+
+	SUBCASE("Invalidated when the pair is skipped for its collision mask") {
+		body_B->set_collision_layer(0);
+		body_B->set_collision_mask(0);
+		CHECK_FALSE(setup_pair(pair));
+
+		move_body(body_B, Vector2(2.5, 0));
+		body_B->set_collision_layer(1);
+		body_B->set_collision_mask(1);
+		CHECK_FALSE_MESSAGE(setup_pair(pair), "Pair should go through the narrowphase again when it can collide.");
+
+		move_body(body_B, Vector2(1.5, 0));
+		CHECK(setup_pair(pair));
+	}
+
+	SUBCASE("Invalidated when the pair is skipped for kinematic bodies") {
+		body_B->set_mode(PhysicsServer2D::BODY_MODE_KINEMATIC);
+		CHECK_FALSE(setup_pair(pair));
+
+		body_B->set_mode(PhysicsServer2D::BODY_MODE_RIGID);
+		move_body(body_B, Vector2(2.5, 0));
+		CHECK_FALSE_MESSAGE(setup_pair(pair), "Pair should go through the narrowphase again when it can collide.");
+	}
+
+	memdelete(pair);
+	Body2DSW *bodies[2] = { body_A, body_B };
+	for (Body2DSW *body : bodies) {
+		body->set_space(nullptr);
+		while (body->get_shape_count()) {
+			body->remove_shape(0);
+		}
+		memdelete(body);
+	}
+	memdelete(shape_A);
+	memdelete(shape_B);
+	memdelete(space);
+	server->finish();
+	memdelete(server);
+}
+
+} // namespace TestPhysics2D
+
 #endif // TEST_PHYSICS_2D_H
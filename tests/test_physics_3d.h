@@ -31,11 +31,212 @@
 #ifndef TEST_PHYSICS_H
 #define TEST_PHYSICS_H
 
+#include "core/config/project_settings.h"
 #include "core/os/main_loop.h"
+#include "servers/physics_3d/physics_server_3d_sw.h"
+
+#include "tests/test_macros.h"
+
+// Declared in global namespace because of GDCLASS macro warning (Windows):
+// "Unqualified friend declaration referring to type outside of the nearest enclosing namespace
+// is a Microsoft extension; add a nested name specifier".
+class _TestBodyStateReceiver : public Object {
+	GDCLASS(_TestBodyStateReceiver, Object);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("body_state_changed", "state"), &_TestBodyStateReceiver::body_state_changed);
+	}
+
+public:
+	int calls = 0;
+	Transform last_transform;
+
+	void body_state_changed(Object *p_state) {
+		PhysicsDirectBodyState3D *state = Object::cast_to<PhysicsDirectBodyState3D>(p_state);
+		calls++;
+		last_transform = state->get_transform();
+	}
+};
 
 namespace TestPhysics3D {
 
 MainLoop *test();
+
+static void step_server(PhysicsServer3DSW *p_server, int p_count) {
+	for (int i = 0; i < p_count; i++) {
+		p_server->step(1.0 / 60.0);
+	}
+}
+
+static Transform get_body_transform(PhysicsServer3DSW *p_server, RID p_body) {
+	return p_server->body_get_state(p_body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+}
+
+TEST_CASE("[PhysicsServer3DSW] Space state restore") {
+	// Falling sphere in an active space of a standalone physics server.
+	PhysicsServer3DSW *server = memnew(PhysicsServer3DSW);
+	server->init();
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID shape = server->shape_create(PhysicsServer3D::SHAPE_SPHERE);
+	server->shape_set_data(shape, 0.5);
+
+	RID body = server->body_create();
+	server->body_set_space(body, space);
+	server->body_add_shape(body, shape);
+	server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform(Basis(), Vector3(0, 100, 0)));
+
+	SUBCASE("Rewinds bodies") {
+		step_server(server, 10);
+
+		const Vector<uint8_t> state = server->space_save_state(space);
+		const Transform saved_transform = get_body_transform(server, body);
+		const Vector3 saved_velocity = server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+
+		step_server(server, 10);
+		const Transform stepped_transform = get_body_transform(server, body);
+		REQUIRE(stepped_transform.origin.y < saved_transform.origin.y);
+
+		CHECK(server->space_restore_state(space, state) == OK);
+		CHECK(get_body_transform(server, body) == saved_transform);
+		CHECK(Vector3(server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)) == saved_velocity);
+
+		step_server(server, 10);
+		CHECK_MESSAGE(get_body_transform(server, body).is_equal_approx(stepped_transform), "Replaying the same steps should give the same result.");
+	}
+
+	SUBCASE("Reports sleeping bodies") {
+		ClassDB::register_class<_TestBodyStateReceiver>();
+		_TestBodyStateReceiver receiver;
+
+		server->body_set_force_integration_callback(body, &receiver, "body_state_changed");
+		step_server(server, 5);
+
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_SLEEPING, true);
+		const Vector<uint8_t> state = server->space_save_state(space);
+		const Transform saved_transform = get_body_transform(server, body);
+
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_SLEEPING, false);
+		step_server(server, 10);
+		server->flush_queries();
+		REQUIRE(receiver.last_transform != saved_transform);
+
+		receiver.calls = 0;
+		CHECK(server->space_restore_state(space, state) == OK);
+		CHECK(bool(server->body_get_state(body, PhysicsServer3D::BODY_STATE_SLEEPING)));
+
+		server->flush_queries();
+		CHECK_MESSAGE(receiver.calls == 1, "Restored sleeping body should report its state.");
+		CHECK(receiver.last_transform == saved_transform);
+
+		// Already queued by the restore when it gets integrated again.
+		receiver.calls = 0;
+		CHECK(server->space_restore_state(space, state) == OK);
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_SLEEPING, false);
+		step_server(server, 1);
+		server->flush_queries();
+		CHECK(receiver.calls == 1);
+
+		server->body_set_force_integration_callback(body, nullptr, StringName());
+	}
+
+	SUBCASE("Rejects mismatching data") {
+		const Vector<uint8_t> state = server->space_save_state(space);
+		const Transform saved_transform = get_body_transform(server, body);
+
+		RID other_body = server->body_create();
+		server->body_set_space(other_body, space);
+		step_server(server, 10);
+		const Transform stepped_transform = get_body_transform(server, body);
+
+		ERR_PRINT_OFF;
+		CHECK_MESSAGE(server->space_restore_state(space, state) == ERR_INVALID_DATA, "State saved with different bodies should be rejected.");
+		CHECK(server->space_restore_state(space, Vector<uint8_t>()) == ERR_INVALID_DATA);
+		CHECK(server->space_restore_state(RID(), state) == ERR_INVALID_PARAMETER);
+		ERR_PRINT_ON;
+		CHECK_MESSAGE(get_body_transform(server, body) == stepped_transform, "Nothing should be restored when the state is rejected.");
+
+		server->free(other_body);
+		CHECK(server->space_restore_state(space, state) == OK);
+		CHECK(get_body_transform(server, body) == saved_transform);
+	}
+
+	server->free(body);
+	server->free(shape);
+	server->free(space);
+	server->finish();
+	memdelete(server);
+}
+
+// Steps two levels of boxes resting on a static floor and returns their final positions.
+static Vector<Vector3> simulate_box_pile(bool p_use_soa_contact_solver) {
+	const Variant previous = GLOBAL_DEF("physics/3d/use_soa_contact_solver", false);
+	ProjectSettings::get_singleton()->set_setting("physics/3d/use_soa_contact_solver", p_use_soa_contact_solver);
+
+	PhysicsServer3DSW *server = memnew(PhysicsServer3DSW);
+	server->init();
+	ProjectSettings::get_singleton()->set_setting("physics/3d/use_soa_contact_solver", previous);
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID floor_shape = server->shape_create(PhysicsServer3D::SHAPE_BOX);
+	server->shape_set_data(floor_shape, Vector3(20, 1, 20));
+	RID floor = server->body_create();
+	server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_set_space(floor, space);
+	server->body_add_shape(floor, floor_shape);
+	server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform(Basis(), Vector3(0, -1, 0)));
+
+	RID box_shape = server->shape_create(PhysicsServer3D::SHAPE_BOX);
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	Vector<RID> boxes;
+	for (int level = 0; level < 2; level++) {
+		for (int x = 0; x < 4; x++) {
+			for (int z = 0; z < 4; z++) {
+				RID box = server->body_create();
+				server->body_set_space(box, space);
+				server->body_add_shape(box, box_shape);
+				server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform(Basis(), Vector3(x * 1.01, 0.5 + level * 1.01, z * 1.01)));
+				boxes.push_back(box);
+			}
+		}
+	}
+
+	for (int i = 0; i < 120; i++) {
+		server->step(1.0 / 60.0);
+	}
+
+	Vector<Vector3> positions;
+	for (int i = 0; i < boxes.size(); i++) {
+		positions.push_back(Transform(server->body_get_state(boxes[i], PhysicsServer3D::BODY_STATE_TRANSFORM)).origin);
+		server->free(boxes[i]);
+	}
+	server->free(floor);
+	server->free(box_shape);
+	server->free(floor_shape);
+	server->free(space);
+	server->finish();
+	memdelete(server);
+
+	return positions;
 }
 
+TEST_CASE("[PhysicsServer3DSW] SoA contact solver matches the default solver") {
+	const Vector<Vector3> expected = simulate_box_pile(false);
+	const Vector<Vector3> positions = simulate_box_pile(true);
+
+	REQUIRE(positions.size() == expected.size());
+	for (int i = 0; i < positions.size(); i++) {
+		const real_t rest_height = i < 16 ? 0.5 : 1.5;
+		CHECK_MESSAGE(Math::abs(expected[i].y - rest_height) < 0.05, "Boxes should come to rest on top of each other.");
+		CHECK_MESSAGE(positions[i].distance_to(expected[i]) < 0.05, "Both solvers should settle the pile the same way.");
+	}
+}
+
+} // namespace TestPhysics3D
+
 #endif
@@ -0,0 +1,154 @@
+/*************************************************************************/
+/*  test_render_list_sort.h                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#ifndef TEST_RADIX_SORT_H
+#define TEST_RADIX_SORT_H
+
+#include "core/math/random_pcg.h"
+#include "core/templates/radix_sort.h"
+#include "core/templates/sort_array.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRadixSort {
+
+// Laid out like the render list sort key: 128 bits, key2 most significant.
+struct Element {
+	uint64_t key1 = 0;
+	uint64_t key2 = 0;
+	uint32_t index = 0;
+};
+
+struct ElementKey {
+	static _FORCE_INLINE_ uint64_t get_key(const Element *p_element, uint32_t p_word) {
+		return p_word == 0 ? p_element->key1 : p_element->key2;
+	}
+};
+
+struct ElementCompare {
+	_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
+		return (A->key2 == B->key2) ? (A->key1 < B->key1) : (A->key2 < B->key2);
+	}
+};
+
+// Sorts random elements and checks the result against SortArray.
+// The original position of each element is stored in index to check that the sort is stable.
+void check_radix_sort(uint32_t p_count, ThreadWorkPool *p_work_pool) {
+	RandomPCG rng(p_count);
+	LocalVector<Element> storage;
+	storage.resize(p_count);
+
+	LocalVector<Element *> elements;
+	for (uint32_t i = 0; i < p_count; i++) {
+		Element &element = storage[i];
+		// Few different values, so many keys are equal and several bytes are the same for all elements.
+		element.key1 = uint64_t(rng.rand() % 64) | (uint64_t(rng.rand() % 4) << 12) | ((rng.rand() % 2) ? (uint64_t(0x3FFF) << 48) : 0);
+		element.key2 = uint64_t((rng.rand() % 8) << 20) | (uint64_t(rng.rand() % 3) << 56);
+		element.index = i;
+		elements.push_back(&element);
+	}
+
+	LocalVector<Element *> expected = elements;
+	SortArray<Element *, ElementCompare> sorter;
+	sorter.sort(expected.ptr(), expected.size());
+
+	RadixSortArray<Element *, ElementKey, 2> radix_sorter;
+	radix_sorter.sort(elements.ptr(), elements.size(), p_work_pool);
+	REQUIRE(elements.size() == p_count);
+
+	ElementCompare less;
+	bool matches_keys = true;
+	bool stable = true;
+	for (uint32_t i = 0; i < p_count; i++) {
+		if (elements[i]->key1 != expected[i]->key1 || elements[i]->key2 != expected[i]->key2) {
+			matches_keys = false;
+		}
+		if (i > 0 && !less(elements[i - 1], elements[i]) && elements[i - 1]->index > elements[i]->index) {
+			stable = false;
+		}
+	}
+	CHECK_MESSAGE(matches_keys, "Sorted keys should be in the same order as with SortArray.");
+	CHECK_MESSAGE(stable, "Elements with equal keys should keep their order.");
+
+	// Every element must still be in the array exactly once.
+	LocalVector<uint32_t> found;
+	found.resize(p_count);
+	memset(found.ptr(), 0, p_count * sizeof(uint32_t));
+	for (uint32_t i = 0; i < p_count; i++) {
+		found[elements[i]->index]++;
+	}
+	bool permutation = true;
+	for (uint32_t i = 0; i < p_count; i++) {
+		if (found[i] != 1) {
+			permutation = false;
+		}
+	}
+	CHECK(permutation);
+}
+
+TEST_CASE("[RadixSortArray] Sort by 128 bit key") {
+	check_radix_sort(1, nullptr);
+	check_radix_sort(255, nullptr);
+	check_radix_sort(2000, nullptr);
+}
+
+TEST_CASE("[RadixSortArray] Sort by 128 bit key on threads") {
+	ThreadWorkPool work_pool;
+	work_pool.init(4);
+	check_radix_sort(5003, &work_pool);
+	// Fewer elements than threads.
+	check_radix_sort(3, &work_pool);
+	work_pool.finish();
+}
+
+TEST_CASE("[RadixSortArray] Sort by equal keys") {
+	LocalVector<Element> storage;
+	storage.resize(300);
+	LocalVector<Element *> elements;
+	for (uint32_t i = 0; i < storage.size(); i++) {
+		storage[i].key1 = 42;
+		storage[i].index = i;
+		elements.push_back(&storage[i]);
+	}
+
+	RadixSortArray<Element *, ElementKey, 2> radix_sorter;
+	radix_sorter.sort(elements.ptr(), elements.size());
+
+	bool unchanged = true;
+	for (uint32_t i = 0; i < elements.size(); i++) {
+		if (elements[i]->index != i) {
+			unchanged = false;
+		}
+	}
+	CHECK_MESSAGE(unchanged, "Sorting equal keys should leave the array as it was.");
+}
+
+} // namespace TestRadixSort
+
+#endif // TEST_RADIX_SORT_H
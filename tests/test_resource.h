@@ -35,9 +35,33 @@
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/os/os.h"
+#include "core/os/thread.h"
 
 #include "thirdparty/doctest/doctest.h"
 
+class ResourceCacheTester {
+public:
+	static int get_shard_count() {
+		return ResourceCache::SHARD_COUNT;
+	}
+
+	static int get_shard_index(const String &p_path) {
+		return &ResourceCache::_get_shard(p_path) - ResourceCache::shards;
+	}
+
+	static bool shard_has(int p_shard, const String &p_path) {
+		return ResourceCache::shards[p_shard].resources.has(p_path);
+	}
+
+	static void lock_shard(const String &p_path) {
+		ResourceCache::_get_shard(p_path).lock.write_lock();
+	}
+
+	static void unlock_shard(const String &p_path) {
+		ResourceCache::_get_shard(p_path).lock.write_unlock();
+	}
+};
+
 namespace TestResource {
 
 TEST_CASE("[Resource] Duplication") {
@@ -109,6 +133,89 @@ TEST_CASE("[Resource] Saving and loading") {
 			loaded_child_resource_text->get_name() == "I'm a child resource",
 			"The loaded child resource name should be equal to the expected value.");
 }
+
+TEST_CASE("[Resource] Cache shards") {
+	const int resource_count = 64;
+	Vector<Ref<Resource>> resources;
+	Set<int> used_shards;
+	for (int i = 0; i < resource_count; i++) {
+		Ref<Resource> resource = memnew(Resource);
+		resource->set_path("res://cache_shards/resource_" + itos(i) + ".tres");
+		resources.push_back(resource);
+	}
+
+	for (int i = 0; i < resource_count; i++) {
+		const String path = resources[i]->get_path();
+		const int shard = ResourceCacheTester::get_shard_index(path);
+		CHECK(shard == int(path.hash() % ResourceCacheTester::get_shard_count()));
+		used_shards.insert(shard);
+
+		bool only_in_own_shard = true;
+		for (int j = 0; j < ResourceCacheTester::get_shard_count(); j++) {
+			only_in_own_shard = only_in_own_shard && ResourceCacheTester::shard_has(j, path) == (j == shard);
+		}
+		CHECK_MESSAGE(only_in_own_shard, "A resource should only be registered in the shard picked by its path.");
+		CHECK(ResourceCache::get(path) == resources[i].ptr());
+	}
+	CHECK_MESSAGE(used_shards.size() > 1, "Paths should be spread over the shards.");
+
+	const String path = resources[0]->get_path();
+	const int shard = ResourceCacheTester::get_shard_index(path);
+	resources.clear();
+	CHECK_FALSE(ResourceCache::has(path));
+	CHECK_FALSE(ResourceCacheTester::shard_has(shard, path));
+
+#ifdef TOOLS_ENABLED
+	// Scene IDs are kept in the shard of the scene path.
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_path("res://cache_shards/sub_resource.tres");
+	CHECK(resource->get_id_for_path("res://cache_shards/scene.tscn") == -1);
+	resource->set_id_for_path("res://cache_shards/scene.tscn", 7);
+	CHECK(resource->get_id_for_path("res://cache_shards/scene.tscn") == 7);
+	CHECK(resource->get_id_for_path("res://cache_shards/other_scene.tscn") == -1);
+	resource->set_id_for_path("res://cache_shards/scene.tscn", -1);
+	CHECK(resource->get_id_for_path("res://cache_shards/scene.tscn") == -1);
+#endif
+}
+
+static void _cache_lookup(void *p_userdata) {
+	String *path = (String *)p_userdata;
+	if (!ResourceCache::has(*path)) {
+		*path = String();
+	}
+}
+
+TEST_CASE("[Resource] Cache lock contention") {
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_path("res://cache_contention/resource.tres");
+	Ref<Resource> other_resource;
+	for (int i = 0; other_resource.is_null(); i++) {
+		const String other_path = "res://cache_contention/other_" + itos(i) + ".tres";
+		if (ResourceCacheTester::get_shard_index(other_path) != ResourceCacheTester::get_shard_index(resource->get_path())) {
+			other_resource = Ref<Resource>(memnew(Resource));
+			other_resource->set_path(other_path);
+		}
+	}
+
+	const uint64_t contentions = ResourceCache::get_lock_contention_count();
+	ResourceCacheTester::lock_shard(resource->get_path());
+
+	// Other shards don't wait for the locked one.
+	CHECK(ResourceCache::has(other_resource->get_path()));
+	CHECK(ResourceCache::get_lock_contention_count() == contentions);
+
+	String path = resource->get_path();
+	Thread thread;
+	thread.start(_cache_lookup, &path);
+	for (int i = 0; i < 200 && ResourceCache::get_lock_contention_count() == contentions; i++) {
+		OS::get_singleton()->delay_usec(5000);
+	}
+	CHECK_MESSAGE(ResourceCache::get_lock_contention_count() == contentions + 1, "A lookup waiting for a locked shard should be counted.");
+
+	ResourceCacheTester::unlock_shard(resource->get_path());
+	thread.wait_to_finish();
+	CHECK_MESSAGE(path == resource->get_path(), "The lookup should find the resource once the shard is unlocked.");
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE
@@ -0,0 +1,373 @@
+/*************************************************************************/
+/*  test_resource.h                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_RESOURCE_FORMAT_BINARY_H
+#define TEST_RESOURCE_FORMAT_BINARY_H
+
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "core/os/os.h"
+#include "core/templates/safe_refcount.h"
+#include "drivers/dummy/rasterizer_dummy.h"
+#include "scene/3d/node_3d.h"
+#include "scene/resources/mesh.h"
+#include "scene/resources/packed_scene.h"
+#include "servers/rendering/rendering_server_default.h"
+
+#include "tests/test_macros.h"
+
+class ResourceLoaderTester {
+public:
+	static int get_abandoned_thread_count() {
+		ResourceLoader::thread_load_mutex->lock();
+		int count = ResourceLoader::thread_load_abandoned_threads.size();
+		ResourceLoader::thread_load_mutex->unlock();
+		return count;
+	}
+};
+
+namespace TestResourceFormatBinary {
+
+static RES load_timed(const String &p_path, uint64_t &r_usec) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	RES res = ResourceLoader::load(p_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	r_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	return res;
+}
+
+TEST_CASE("[ResourceFormatBinary] Packed arrays") {
+	Ref<Resource> resource = memnew(Resource);
+
+	Vector<int32_t> int32s;
+	Vector<int64_t> int64s;
+	Vector<float> float32s;
+	Vector<double> float64s;
+	Vector<Vector2> vector2s;
+	Vector<Vector3> vector3s;
+	Vector<Color> colors;
+	for (int i = 0; i < 1000; i++) {
+		int32s.push_back(i * 65537 - 1000000);
+		int64s.push_back(int64_t(i) * 0x100000001LL - 5);
+		float32s.push_back(i * 0.25f);
+		float64s.push_back(i * 1e100);
+		vector2s.push_back(Vector2(i, -i));
+		vector3s.push_back(Vector3(i, i * 2, -0.5 * i));
+		colors.push_back(Color(i / 1000.0, 0.25, 0.5, 1.0));
+	}
+	resource->set_meta("int32s", int32s);
+	resource->set_meta("int64s", int64s);
+	resource->set_meta("float32s", float32s);
+	resource->set_meta("float64s", float64s);
+	resource->set_meta("vector2s", vector2s);
+	resource->set_meta("vector3s", vector3s);
+	resource->set_meta("colors", colors);
+
+	// Big endian files have to be swapped back word by word on load.
+	const uint32_t flags[] = { 0, ResourceSaver::FLAG_SAVE_BIG_ENDIAN };
+	for (int i = 0; i < 2; i++) {
+		const String path = OS::get_singleton()->get_cache_path().plus_file("packed_arrays.res");
+		REQUIRE(ResourceSaver::save(path, resource, flags[i]) == OK);
+
+		RES loaded = ResourceLoader::load(path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(loaded.is_valid());
+		CHECK(Vector<int32_t>(loaded->get_meta("int32s")) == int32s);
+		CHECK(Vector<int64_t>(loaded->get_meta("int64s")) == int64s);
+		CHECK(Vector<float>(loaded->get_meta("float32s")) == float32s);
+		CHECK(Vector<double>(loaded->get_meta("float64s")) == float64s);
+		CHECK(Vector<Vector2>(loaded->get_meta("vector2s")) == vector2s);
+		CHECK(Vector<Vector3>(loaded->get_meta("vector3s")) == vector3s);
+		CHECK(Vector<Color>(loaded->get_meta("colors")) == colors);
+	}
+}
+
+TEST_CASE("[ResourceFormatBinary] Large mesh round trip") {
+	// Meshes keep their surfaces in the rendering server, the dummy one stores them.
+	RasterizerDummy::make_current();
+	RenderingServer *rendering_server = memnew(RenderingServerDefault);
+	rendering_server->init();
+
+	{
+		// A 300x300 grid, about 90000 vertices and 540000 indices.
+		const int grid_size = 300;
+		Vector<Vector3> vertices;
+		Vector<Vector3> normals;
+		Vector<Vector2> uvs;
+		Vector<int> indices;
+		for (int y = 0; y < grid_size; y++) {
+			for (int x = 0; x < grid_size; x++) {
+				vertices.push_back(Vector3(x, Math::sin(x * 0.1) * Math::cos(y * 0.1), y));
+				normals.push_back(Vector3(0, 1, 0));
+				uvs.push_back(Vector2(x, y) / grid_size);
+				if (x > 0 && y > 0) {
+					int i = y * grid_size + x;
+					indices.push_back(i - grid_size - 1);
+					indices.push_back(i - grid_size);
+					indices.push_back(i);
+					indices.push_back(i - grid_size - 1);
+					indices.push_back(i);
+					indices.push_back(i - 1);
+				}
+			}
+		}
+
+		Array arrays;
+		arrays.resize(Mesh::ARRAY_MAX);
+		arrays[Mesh::ARRAY_VERTEX] = vertices;
+		arrays[Mesh::ARRAY_NORMAL] = normals;
+		arrays[Mesh::ARRAY_TEX_UV] = uvs;
+		arrays[Mesh::ARRAY_INDEX] = indices;
+
+		Ref<ArrayMesh> mesh;
+		mesh.instance();
+		mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays);
+
+		const String binary_path = OS::get_singleton()->get_cache_path().plus_file("large_mesh.res");
+		const String text_path = OS::get_singleton()->get_cache_path().plus_file("large_mesh.tres");
+		uint64_t save_begin = OS::get_singleton()->get_ticks_usec();
+		REQUIRE(ResourceSaver::save(binary_path, mesh) == OK);
+		uint64_t save_time = OS::get_singleton()->get_ticks_usec() - save_begin;
+		REQUIRE(ResourceSaver::save(text_path, mesh) == OK);
+
+		uint64_t binary_time = 0;
+		uint64_t text_time = 0;
+		Ref<ArrayMesh> binary_mesh = load_timed(binary_path, binary_time);
+		Ref<ArrayMesh> text_mesh = load_timed(text_path, text_time);
+		MESSAGE("Mesh with ", vertices.size(), " vertices: saved in ", save_time / 1000.0, " ms, loaded in ", binary_time / 1000.0, " ms from binary and ", text_time / 1000.0, " ms from text.");
+
+		REQUIRE(binary_mesh.is_valid());
+		REQUIRE(binary_mesh->get_surface_count() == 1);
+		Array loaded_arrays = binary_mesh->surface_get_arrays(0);
+		CHECK(Vector<Vector3>(loaded_arrays[Mesh::ARRAY_VERTEX]) == vertices);
+		CHECK(Vector<Vector2>(loaded_arrays[Mesh::ARRAY_TEX_UV]).size() == uvs.size());
+		CHECK(Vector<int>(loaded_arrays[Mesh::ARRAY_INDEX]) == indices);
+		CHECK(binary_mesh->get_aabb().is_equal_approx(mesh->get_aabb()));
+
+		REQUIRE(text_mesh.is_valid());
+		CHECK_MESSAGE(binary_time < text_time, "Loading the binary mesh should be faster than parsing the text one.");
+	}
+
+	rendering_server->finish();
+	memdelete(rendering_server);
+}
+
+TEST_CASE("[ResourceFormatBinary] Large scene round trip") {
+	const int node_count = 5000;
+	Node3D *root = memnew(Node3D);
+	root->set_name("Root");
+	for (int i = 0; i < node_count; i++) {
+		Node3D *node = memnew(Node3D);
+		node->set_name("Node" + itos(i));
+		node->set_transform(Transform(Basis(Vector3(0, 1, 0), i * 0.01), Vector3(i, i % 7, -i)));
+		node->set_meta("index", i);
+		Vector<Vector3> points;
+		points.push_back(Vector3(i, 0, 0));
+		points.push_back(Vector3(0, i, 0));
+		node->set_meta("points", points);
+		root->add_child(node);
+		node->set_owner(root);
+	}
+
+	Ref<PackedScene> scene;
+	scene.instance();
+	REQUIRE(scene->pack(root) == OK);
+	memdelete(root);
+
+	const String binary_path = OS::get_singleton()->get_cache_path().plus_file("large_scene.scn");
+	const String text_path = OS::get_singleton()->get_cache_path().plus_file("large_scene.tscn");
+	uint64_t save_begin = OS::get_singleton()->get_ticks_usec();
+	REQUIRE(ResourceSaver::save(binary_path, scene) == OK);
+	uint64_t save_time = OS::get_singleton()->get_ticks_usec() - save_begin;
+	REQUIRE(ResourceSaver::save(text_path, scene) == OK);
+
+	uint64_t binary_time = 0;
+	uint64_t text_time = 0;
+	Ref<PackedScene> binary_scene = load_timed(binary_path, binary_time);
+	Ref<PackedScene> text_scene = load_timed(text_path, text_time);
+	MESSAGE("Scene with ", node_count, " nodes: saved in ", save_time / 1000.0, " ms, loaded in ", binary_time / 1000.0, " ms from binary and ", text_time / 1000.0, " ms from text.");
+
+	REQUIRE(binary_scene.is_valid());
+	Node *instance = binary_scene->instance();
+	REQUIRE(instance != nullptr);
+	CHECK(instance->get_child_count() == node_count);
+	Node3D *last = Object::cast_to<Node3D>(instance->get_child(node_count - 1));
+	REQUIRE(last != nullptr);
+	CHECK(last->get_transform().is_equal_approx(Transform(Basis(Vector3(0, 1, 0), (node_count - 1) * 0.01), Vector3(node_count - 1, (node_count - 1) % 7, 1 - node_count))));
+	CHECK(int(last->get_meta("index")) == node_count - 1);
+	CHECK(Vector<Vector3>(last->get_meta("points")).size() == 2);
+	memdelete(instance);
+
+	REQUIRE(text_scene.is_valid());
+	CHECK_MESSAGE(binary_time < text_time, "Loading the binary scene should be faster than parsing the text one.");
+}
+
+// Loads "*.testdep" files without touching the disk. Most take a little while and return a
+// resource named after the file. "root" loads "cycle" on a thread, which loads "root" again.
+class DependencyLoader : public ResourceFormatLoader {
+public:
+	SafeNumeric<int> loading;
+	SafeNumeric<int> max_loading;
+
+	static String get_path(const String &p_name) {
+		return OS::get_singleton()->get_cache_path().plus_file(p_name + ".testdep");
+	}
+
+	virtual RES load(const String &p_path, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode) override {
+		String name = p_path.get_file().get_basename();
+		max_loading.exchange_if_greater(loading.increment());
+
+		if (name == "root") {
+			ResourceLoader::load_threaded_request(get_path("cycle"));
+			// Let "cycle" start waiting for this load before collecting it.
+			OS::get_singleton()->delay_usec(100000);
+			ResourceLoader::load_threaded_get(get_path("cycle"));
+		} else if (name == "cycle") {
+			ResourceLoader::load(get_path("root"));
+		} else {
+			OS::get_singleton()->delay_usec(20000);
+		}
+
+		loading.decrement();
+
+		RES res;
+		res.instance();
+		res->set_name(name);
+		if (r_error) {
+			*r_error = OK;
+		}
+		return res;
+	}
+
+	virtual void get_recognized_extensions(List<String> *p_extensions) const override {
+		p_extensions->push_back("testdep");
+	}
+
+	virtual bool handles_type(const String &p_type) const override {
+		return p_type == "Resource";
+	}
+
+	virtual String get_resource_type(const String &p_path) const override {
+		return p_path.get_extension() == "testdep" ? "Resource" : "";
+	}
+};
+
+// Saves a resource whose "dependencies" meta lists external resources at the given paths.
+static Error save_with_dependencies(const String &p_path, const Vector<String> &p_dependencies) {
+	Ref<Resource> resource = memnew(Resource);
+	Array dependencies;
+	for (int i = 0; i < p_dependencies.size(); i++) {
+		Ref<Resource> dependency = memnew(Resource);
+		dependency->set_path(p_dependencies[i]);
+		dependencies.push_back(dependency);
+	}
+	resource->set_meta("dependencies", dependencies);
+	return ResourceSaver::save(p_path, resource);
+}
+
+TEST_CASE("[ResourceFormatBinary] Parallel dependency loading") {
+	Ref<DependencyLoader> loader;
+	loader.instance();
+	ResourceLoader::add_resource_format_loader(loader, true);
+	ResourceLoader::set_parallel_dependency_loading(true);
+
+	SUBCASE("Dependencies are collected in order") {
+		// More dependencies than cores, so the number of loads in flight gets capped.
+		const int processor_count = OS::get_singleton()->get_processor_count();
+		const int dependency_count = processor_count + 4;
+		Vector<String> dependency_paths;
+		for (int i = 0; i < dependency_count; i++) {
+			dependency_paths.push_back(DependencyLoader::get_path("dep_" + itos(i)));
+		}
+		const String path = OS::get_singleton()->get_cache_path().plus_file("dependencies.res");
+		REQUIRE(save_with_dependencies(path, dependency_paths) == OK);
+
+		RES loaded = ResourceLoader::load(path);
+		REQUIRE(loaded.is_valid());
+		Array dependencies = loaded->get_meta("dependencies");
+		REQUIRE(dependencies.size() == dependency_count);
+		for (int i = 0; i < dependency_count; i++) {
+			Ref<Resource> dependency = dependencies[i];
+			REQUIRE(dependency.is_valid());
+			CHECK(dependency->get_name() == "dep_" + itos(i));
+		}
+
+		MESSAGE("Loaded ", dependency_count, " dependencies, at most ", loader->max_loading.get(), " at a time on ", processor_count, " cores.");
+		CHECK(loader->max_loading.get() <= processor_count);
+		if (processor_count > 1) {
+			CHECK_MESSAGE(loader->max_loading.get() > 1, "Dependencies should load in parallel.");
+		}
+	}
+
+	SUBCASE("Cyclic dependency") {
+		// a.res depends on b.res, which depends on a.res again. The load must fail instead of hanging.
+		const String path_a = OS::get_singleton()->get_cache_path().plus_file("cyclic_a.res");
+		const String path_b = OS::get_singleton()->get_cache_path().plus_file("cyclic_b.res");
+		Vector<String> dependencies_a;
+		dependencies_a.push_back(path_b);
+		dependencies_a.push_back(DependencyLoader::get_path("cyclic_dep"));
+		Vector<String> dependencies_b;
+		dependencies_b.push_back(path_a);
+		REQUIRE(save_with_dependencies(path_a, dependencies_a) == OK);
+		REQUIRE(save_with_dependencies(path_b, dependencies_b) == OK);
+
+		ERR_PRINT_OFF;
+		RES loaded = ResourceLoader::load(path_a);
+		ERR_PRINT_ON;
+		CHECK(loaded.is_null());
+		CHECK(ResourceLoader::load_threaded_get_status(path_a) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE);
+		CHECK(ResourceLoader::load_threaded_get_status(path_b) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE);
+	}
+
+	SUBCASE("Abandoned loads are freed") {
+		// "cycle" waits for "root", which is loaded on this thread. When "root" collects "cycle",
+		// waiting would never end, so it's left to finish on its own since nobody wants it anymore.
+		ERR_PRINT_OFF;
+		RES loaded = ResourceLoader::load(DependencyLoader::get_path("root"));
+		ERR_PRINT_ON;
+		CHECK(loaded.is_valid());
+
+		for (int i = 0; i < 100 && ResourceLoader::load_threaded_get_status(DependencyLoader::get_path("cycle")) != ResourceLoader::THREAD_LOAD_INVALID_RESOURCE; i++) {
+			OS::get_singleton()->delay_usec(10000);
+		}
+		REQUIRE(ResourceLoader::load_threaded_get_status(DependencyLoader::get_path("cycle")) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE);
+		CHECK_MESSAGE(ResourceLoaderTester::get_abandoned_thread_count() == 1, "The abandoned load should leave its thread to be freed.");
+
+		// The next request frees it.
+		REQUIRE(ResourceLoader::load_threaded_request(DependencyLoader::get_path("dep_0")) == OK);
+		CHECK(ResourceLoaderTester::get_abandoned_thread_count() == 0);
+		CHECK(ResourceLoader::load_threaded_get(DependencyLoader::get_path("dep_0")).is_valid());
+	}
+
+	ResourceLoader::set_parallel_dependency_loading(false);
+	ResourceLoader::remove_resource_format_loader(loader);
+}
+
+} // namespace TestResourceFormatBinary
+
+#endif // TEST_RESOURCE_FORMAT_BINARY_H
@@ -0,0 +1,217 @@
+/*************************************************************************/
+/*  test_resource_importer_texture.h                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifdef TOOLS_ENABLED
+
+#ifndef TEST_RESOURCE_IMPORTER_TEXTURE_H
+#define TEST_RESOURCE_IMPORTER_TEXTURE_H
+
+#include "core/os/dir_access.h"
+#include "core/os/os.h"
+#include "editor/import/resource_importer_texture.h"
+
+#include "tests/test_macros.h"
+
+class ResourceImporterTextureTester {
+public:
+	static Ref<Image> load_vram_cache(const String &p_path) {
+		return ResourceImporterTexture::_load_vram_cache(p_path);
+	}
+
+	static void save_vram_cache(const String &p_path, const Ref<Image> &p_image, uint64_t p_max_size) {
+		ResourceImporterTexture::_save_vram_cache(p_path, p_image, p_max_size);
+	}
+
+	static uint64_t vram_cache_cleanup(const String &p_dir, uint64_t p_max_size) {
+		return ResourceImporterTexture::_vram_cache_cleanup(p_dir, p_max_size);
+	}
+
+	// Forgets every index, as if the editor was restarted.
+	static void save_vram_cache_indices() {
+		ResourceImporterTexture::_save_vram_cache_indices();
+	}
+};
+
+namespace TestResourceImporterTexture {
+
+static Ref<Image> make_cached_image(int p_seed) {
+	Vector<uint8_t> data;
+	data.resize(64 * 64 * 4);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = i * 31 + p_seed;
+	}
+	Ref<Image> image = memnew(Image(64, 64, false, Image::FORMAT_RGBA8, data));
+	image->generate_mipmaps();
+	return image;
+}
+
+// Cache entries are only ever written by the importer, start from an empty directory.
+static String make_empty_cache_dir(const String &p_name) {
+	const String dir = OS::get_singleton()->get_cache_path().plus_file(p_name);
+	DirAccessRef da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	da->make_dir_recursive(dir);
+	ResourceImporterTextureTester::vram_cache_cleanup(dir, 0);
+	return dir;
+}
+
+static int count_cache_entries(const String &p_dir) {
+	int count = 0;
+	DirAccessRef da = DirAccess::open(p_dir);
+	REQUIRE(da);
+	da->list_dir_begin();
+	for (String n = da->get_next(); !n.is_empty(); n = da->get_next()) {
+		if (!da->current_is_dir() && n.get_extension() == "vtex") {
+			count++;
+		}
+	}
+	da->list_dir_end();
+	return count;
+}
+
+TEST_CASE("[ResourceImporterTexture] Save and load a VRAM compression cache entry") {
+	const String dir = make_empty_cache_dir("vram_textures_test");
+	const String path = dir.plus_file("entry.vtex");
+	Ref<Image> image = make_cached_image(0);
+
+	ResourceImporterTextureTester::save_vram_cache(path, image, 1024 * 1024);
+	Ref<Image> loaded = ResourceImporterTextureTester::load_vram_cache(path);
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded->get_format() == image->get_format());
+	CHECK(loaded->get_width() == image->get_width());
+	CHECK(loaded->get_height() == image->get_height());
+	CHECK(loaded->has_mipmaps());
+	CHECK_MESSAGE(
+			loaded->get_data() == image->get_data(),
+			"A loaded cache entry should hold the data that was saved.");
+
+	CHECK_MESSAGE(
+			ResourceImporterTextureTester::load_vram_cache(dir.plus_file("missing.vtex")).is_null(),
+			"Loading a missing cache entry should fail.");
+
+	// Drop the last byte.
+	Vector<uint8_t> data = FileAccess::get_file_as_array(path);
+	{
+		FileAccessRef f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f);
+		f->store_buffer(data.ptr(), data.size() - 1);
+	}
+	CHECK_MESSAGE(
+			ResourceImporterTextureTester::load_vram_cache(path).is_null(),
+			"Loading a truncated cache entry should fail.");
+
+	DirAccess::remove_file_or_error(path);
+}
+
+TEST_CASE("[ResourceImporterTexture] VRAM compression cache size limit") {
+	const String dir = make_empty_cache_dir("vram_textures_limit_test");
+
+	// Room for two entries and a half, entries have a 20 byte header.
+	const uint64_t max_size = (20 + make_cached_image(0)->get_data().size()) * 5 / 2;
+
+	for (int i = 0; i < 4; i++) {
+		const String path = dir.plus_file(itos(i) + ".vtex");
+		ResourceImporterTextureTester::save_vram_cache(path, make_cached_image(i), max_size);
+		CHECK_MESSAGE(
+				ResourceImporterTextureTester::load_vram_cache(path).is_valid(),
+				"The entry that was just saved should never be evicted.");
+		CHECK_MESSAGE(
+				count_cache_entries(dir) <= 2,
+				"Entries over the size limit should be evicted.");
+	}
+	CHECK(count_cache_entries(dir) == 2);
+
+	ResourceImporterTextureTester::vram_cache_cleanup(dir, 0);
+	CHECK_MESSAGE(
+			count_cache_entries(dir) == 0,
+			"A size limit of zero should evict every entry.");
+}
+
+TEST_CASE("[ResourceImporterTexture] VRAM compression cache eviction order") {
+	const String dir = make_empty_cache_dir("vram_textures_order_test");
+	const uint64_t entry_size = 20 + make_cached_image(0)->get_data().size();
+	const uint64_t max_size = entry_size * 3;
+
+	for (int i = 0; i < 3; i++) {
+		ResourceImporterTextureTester::save_vram_cache(dir.plus_file(itos(i) + ".vtex"), make_cached_image(i), max_size);
+	}
+	REQUIRE(ResourceImporterTextureTester::load_vram_cache(dir.plus_file("0.vtex")).is_valid());
+
+	ResourceImporterTextureTester::save_vram_cache(dir.plus_file("3.vtex"), make_cached_image(3), max_size);
+	CHECK_MESSAGE(
+			!FileAccess::exists(dir.plus_file("1.vtex")),
+			"The least recently used entry should be evicted first.");
+	CHECK_MESSAGE(
+			FileAccess::exists(dir.plus_file("0.vtex")),
+			"Loading an entry should mark it as recently used.");
+
+	// The order survives a restart.
+	ResourceImporterTextureTester::save_vram_cache_indices();
+	REQUIRE(ResourceImporterTextureTester::load_vram_cache(dir.plus_file("2.vtex")).is_valid());
+	ResourceImporterTextureTester::save_vram_cache_indices();
+	ResourceImporterTextureTester::save_vram_cache(dir.plus_file("4.vtex"), make_cached_image(4), max_size);
+	CHECK_MESSAGE(
+			!FileAccess::exists(dir.plus_file("0.vtex")),
+			"The least recently used entry of the last session should be evicted first.");
+	CHECK(FileAccess::exists(dir.plus_file("2.vtex")));
+	CHECK(FileAccess::exists(dir.plus_file("3.vtex")));
+
+	ResourceImporterTextureTester::vram_cache_cleanup(dir, 0);
+}
+
+TEST_CASE("[ResourceImporterTexture] VRAM compression cache size is counted per directory") {
+	const String dir_a = make_empty_cache_dir("vram_textures_dir_a_test");
+	const String dir_b = make_empty_cache_dir("vram_textures_dir_b_test");
+	const uint64_t entry_size = 20 + make_cached_image(0)->get_data().size();
+
+	for (int i = 0; i < 2; i++) {
+		ResourceImporterTextureTester::save_vram_cache(dir_a.plus_file(itos(i) + ".vtex"), make_cached_image(i), entry_size * 2);
+		ResourceImporterTextureTester::save_vram_cache(dir_b.plus_file(itos(i) + ".vtex"), make_cached_image(i), entry_size * 2);
+	}
+	CHECK_MESSAGE(
+			count_cache_entries(dir_a) == 2,
+			"Entries saved to another directory should not count against this one.");
+	CHECK(count_cache_entries(dir_b) == 2);
+
+	// Saving over an entry replaces its size.
+	for (int i = 0; i < 4; i++) {
+		ResourceImporterTextureTester::save_vram_cache(dir_a.plus_file("0.vtex"), make_cached_image(i), entry_size * 2);
+	}
+	CHECK_MESSAGE(
+			count_cache_entries(dir_a) == 2,
+			"Replacing an entry should not count its previous size.");
+	CHECK(ResourceImporterTextureTester::vram_cache_cleanup(dir_a, entry_size * 2) == entry_size * 2);
+
+	ResourceImporterTextureTester::vram_cache_cleanup(dir_a, 0);
+	ResourceImporterTextureTester::vram_cache_cleanup(dir_b, 0);
+}
+} // namespace TestResourceImporterTexture
+
+#endif // TEST_RESOURCE_IMPORTER_TEXTURE_H
+#endif // TOOLS_ENABLED
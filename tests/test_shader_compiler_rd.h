@@ -0,0 +1,158 @@
+/*************************************************************************/
+/*  test_heightmap_shape_3d.h                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_SHADER_COMPILER_RD_H
+#define TEST_SHADER_COMPILER_RD_H
+
+#include "core/os/os.h"
+#include "servers/rendering/renderer_rd/shader_compiler_rd.h"
+#include "servers/rendering/shader_types.h"
+
+#include "tests/test_macros.h"
+
+namespace TestShaderCompilerRD {
+
+// Sticks to uniforms, varyings and arithmetic: builtin calls, constructors,
+// sampler uniforms and local variables check RenderingServer::is_low_end(),
+// and there is no rendering server in headless tests.
+static String make_material_shader(int p_index) {
+	String code = "shader_type spatial;\n";
+	code += (p_index % 2) ? "render_mode unshaded;\n" : "render_mode cull_disabled;\n";
+	code += "uniform vec4 albedo : hint_color;\n";
+	code += "uniform vec4 tint;\n";
+	code += "uniform float roughness : hint_range(0, 1) = 0.5;\n";
+	code += "varying vec3 world_pos;\n";
+	code += "void vertex() {\n\tworld_pos = VERTEX * " + itos(p_index + 1) + ".0;\n}\n";
+	code += "void fragment() {\n";
+	code += "\tALBEDO = albedo.rgb * tint.rgb + world_pos * " + itos(p_index % 7 + 1) + ".0;\n";
+	code += "\tROUGHNESS = roughness * " + itos(p_index) + ".0;\n";
+	code += "}\n";
+	return code;
+}
+
+static void setup_compiler(ShaderCompilerRD &r_compiler) {
+	ShaderCompilerRD::DefaultIdentifierActions actions;
+	actions.renames["VERTEX"] = "vertex";
+	actions.renames["ALBEDO"] = "albedo";
+	actions.renames["ROUGHNESS"] = "roughness";
+	actions.render_mode_defines["unshaded"] = "#define MODE_UNSHADED\n";
+	actions.render_mode_defines["cull_disabled"] = "#define DO_SIDE_CHECK\n";
+	actions.sampler_array_name = "material_samplers";
+	actions.base_texture_binding_index = 1;
+	actions.texture_layout_set = 3;
+	actions.base_uniform_string = "material.";
+	actions.base_varying_index = 10;
+	actions.default_filter = ShaderLanguage::FILTER_LINEAR_MIPMAP;
+	actions.default_repeat = ShaderLanguage::REPEAT_ENABLE;
+	actions.global_buffer_array_variable = "global_variables.data";
+	actions.instance_uniform_index_variable = "draw_call.instance_uniforms_ofs";
+	r_compiler.initialize(actions);
+}
+
+static uint64_t compile_library(ShaderCompilerRD &p_compiler, const Vector<String> &p_library, bool p_use_cache, Vector<ShaderCompilerRD::GeneratedCode> &r_gen_codes, int &r_unshaded_count) {
+	r_gen_codes.resize(p_library.size());
+	r_unshaded_count = 0;
+
+	const uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_library.size(); i++) {
+		bool unshaded = false;
+		bool uses_alpha = false;
+		Map<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+
+		if (!p_use_cache) {
+			ShaderCompilerRD::invalidate_compile_caches();
+		}
+
+		ShaderCompilerRD::IdentifierActions actions;
+		actions.entry_point_stages["vertex"] = ShaderCompilerRD::STAGE_VERTEX;
+		actions.entry_point_stages["fragment"] = ShaderCompilerRD::STAGE_FRAGMENT;
+		actions.render_mode_flags["unshaded"] = &unshaded;
+		actions.usage_flag_pointers["ALPHA"] = &uses_alpha;
+		actions.uniforms = &uniforms;
+
+		Error err = p_compiler.compile(RS::SHADER_SPATIAL, p_library[i], &actions, "", r_gen_codes.write[i]);
+		CHECK_MESSAGE(err == OK, vformat("Material shader %d should compile.", i));
+		CHECK_MESSAGE(uniforms.size() == 3, vformat("Material shader %d should report its uniforms.", i));
+		if (unshaded) {
+			r_unshaded_count++;
+		}
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin_usec;
+}
+
+TEST_CASE("[ShaderCompilerRD] Material library compile") {
+	REQUIRE_MESSAGE(ShaderTypes::get_singleton() != nullptr, "ShaderTypes should be registered with the server types.");
+
+	ShaderCompilerRD compiler;
+	setup_compiler(compiler);
+	ShaderCompilerRD::invalidate_compile_caches();
+
+	// A material library where many materials share the same shader source,
+	// like a batch of imported scenes using a handful of material templates.
+	const int unique_count = 200;
+	Vector<String> library;
+	for (int i = 0; i < unique_count * 4; i++) {
+		library.push_back(make_material_shader(i % unique_count));
+	}
+
+	// Invalidating before every compile makes each one parse and generate from scratch.
+	Vector<ShaderCompilerRD::GeneratedCode> first_pass;
+	int first_unshaded = 0;
+	const uint64_t first_usec = compile_library(compiler, library, false, first_pass, first_unshaded);
+
+	Vector<ShaderCompilerRD::GeneratedCode> second_pass;
+	int second_unshaded = 0;
+	const uint64_t second_usec = compile_library(compiler, library, true, second_pass, second_unshaded);
+
+	CHECK_MESSAGE(first_unshaded == library.size() / 2, "Render mode flags should be applied on every compile.");
+	CHECK_MESSAGE(second_unshaded == first_unshaded, "Cached compiles should apply the same render mode flags.");
+
+	for (int i = 0; i < library.size(); i++) {
+		const ShaderCompilerRD::GeneratedCode &first = first_pass[i];
+		const ShaderCompilerRD::GeneratedCode &second = second_pass[i];
+		CHECK_MESSAGE(first.uniforms == second.uniforms, vformat("Material shader %d should generate the same uniforms when cached.", i));
+		CHECK_MESSAGE(first.defines == second.defines, vformat("Material shader %d should generate the same defines when cached.", i));
+		CHECK_MESSAGE(first.texture_uniforms.size() == second.texture_uniforms.size(), vformat("Material shader %d should generate the same textures when cached.", i));
+		CHECK_MESSAGE(first.code.size() == second.code.size(), vformat("Material shader %d should generate the same stages when cached.", i));
+		for (const Map<String, String>::Element *E = first.code.front(); E; E = E->next()) {
+			CHECK_MESSAGE(second.code.has(E->key()), vformat("Material shader %d should generate the same stages when cached.", i));
+			if (second.code.has(E->key())) {
+				CHECK_MESSAGE(second.code[E->key()] == E->get(), vformat("Material shader %d should generate the same code when cached.", i));
+			}
+		}
+	}
+
+	MESSAGE(vformat("Compiled %d materials (%d unique shaders): %d usec uncached, %d usec cached.", library.size(), unique_count, first_usec, second_usec));
+	CHECK_MESSAGE(second_usec < first_usec, "Compiling a material library with shared shaders should be faster with the compile cache.");
+}
+
+} // namespace TestShaderCompilerRD
+
+#endif // TEST_SHADER_COMPILER_RD_H
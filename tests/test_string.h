@@ -107,6 +107,29 @@ TEST_CASE("[String] UTF8") {
 	CHECK(String::utf8(cs) == s);
 }
 
+TEST_CASE("[String] UTF8 length and write") {
+	static const char32_t u32str[] = { 0x0045, 0x0020, 0x304A, 0x360F, 0x3088, 0x3046, 0x1F3A4, 0 };
+	static const uint8_t u8str[] = { 0x45, 0x20, 0xE3, 0x81, 0x8A, 0xE3, 0x98, 0x8F, 0xE3, 0x82, 0x88, 0xE3, 0x81, 0x86, 0xF0, 0x9F, 0x8E, 0xA4 };
+	String s = u32str;
+	CHECK(s.utf8_length() == sizeof(u8str));
+	CHECK(s.utf8_length() == s.utf8().length());
+
+	uint8_t buffer[sizeof(u8str) + 1];
+	buffer[sizeof(u8str)] = 0xFF;
+	s.utf8_write(buffer);
+	CHECK(memcmp(buffer, u8str, sizeof(u8str)) == 0);
+	CHECK_MESSAGE(buffer[sizeof(u8str)] == 0xFF, "No trailing zero is written.");
+
+	CHECK(String().utf8_length() == 0);
+
+	// Constructors replace invalid codepoints, so write one in place.
+	String invalid = "EE";
+	invalid.set(1, 0xD800);
+	ERR_PRINT_OFF
+	CHECK(invalid.utf8_length() == 0);
+	ERR_PRINT_ON
+}
+
 TEST_CASE("[String] UTF16") {
 	/* how can i embed UTF in here? */
 	static const char32_t u32str[] = { 0x0045, 0x0020, 0x304A, 0x360F, 0x3088, 0x3046, 0x1F3A4, 0 };
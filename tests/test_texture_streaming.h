@@ -0,0 +1,354 @@
+/*************************************************************************/
+/*  test_texture_streaming.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_TEXTURE_STREAMING_H
+#define TEST_TEXTURE_STREAMING_H
+
+#include "core/config/project_settings.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+#include "drivers/dummy/rasterizer_dummy.h"
+#include "scene/resources/texture.h"
+#include "scene/resources/texture_streaming.h"
+#include "servers/rendering/rendering_server_default.h"
+
+#include "tests/test_macros.h"
+
+namespace TestTextureStreaming {
+
+static uint64_t mipmap_chain_size(int p_size) {
+	return Image::get_image_data_size(p_size, p_size, Image::FORMAT_RGBA8, true);
+}
+
+TEST_CASE("[TextureStreaming] Mipmap for size") {
+	CHECK(TextureStreamingBudget::get_mipmap_for_size(256, 256, 8, 0) == 0);
+	CHECK(TextureStreamingBudget::get_mipmap_for_size(256, 256, 8, 1000) == 0);
+	CHECK(TextureStreamingBudget::get_mipmap_for_size(256, 256, 8, 128) == 1);
+	CHECK(TextureStreamingBudget::get_mipmap_for_size(256, 128, 8, 64) == 2);
+	CHECK(TextureStreamingBudget::get_mipmap_for_size(256, 256, 8, 1) == 8);
+	CHECK_MESSAGE(
+			TextureStreamingBudget::get_mipmap_for_size(256, 256, 4, 1) == 4,
+			"The smallest available mipmap should be used if none fits.");
+}
+
+TEST_CASE("[TextureStreaming] Stream in requested mipmaps") {
+	TextureStreamingBudget budget;
+	budget.set_budget(mipmap_chain_size(1024));
+
+	budget.add(1, 256, 256, Image::FORMAT_RGBA8, 8, 1);
+	CHECK(budget.has(1));
+	CHECK(budget.get_resident_mipmap(1) == 1);
+	CHECK(budget.get_memory_used() == mipmap_chain_size(128));
+
+	LocalVector<TextureStreamingBudget::Change> changes;
+	budget.update(changes);
+	REQUIRE(changes.size() == 1);
+	CHECK(changes[0].id == 1);
+	CHECK(changes[0].mipmap == 0);
+	CHECK(changes[0].width == 256);
+	CHECK(changes[0].height == 256);
+	CHECK(budget.get_resident_mipmap(1) == 0);
+	CHECK(budget.get_memory_used() == mipmap_chain_size(256));
+
+	changes.clear();
+	budget.update(changes);
+	CHECK_MESSAGE(changes.size() == 0, "Nothing should change once the requested mipmaps are resident.");
+
+	budget.remove(1);
+	CHECK(!budget.has(1));
+	CHECK(budget.get_memory_used() == 0);
+}
+
+TEST_CASE("[TextureStreaming] Evict least recently used textures") {
+	TextureStreamingBudget budget;
+	budget.set_budget(mipmap_chain_size(256) + mipmap_chain_size(128));
+
+	budget.add(1, 256, 256, Image::FORMAT_RGBA8, 8, 1);
+	budget.add(2, 256, 256, Image::FORMAT_RGBA8, 8, 1);
+
+	LocalVector<TextureStreamingBudget::Change> changes;
+	budget.update(changes);
+	CHECK_MESSAGE(changes.size() == 1, "Only one texture should fit in the budget at full resolution.");
+	CHECK_MESSAGE(budget.get_resident_mipmap(2) == 0, "The most recently used texture should be streamed in first.");
+	CHECK(budget.get_resident_mipmap(1) == 1);
+	CHECK(budget.get_memory_used() <= budget.get_budget());
+
+	budget.touch(1);
+	changes.clear();
+	budget.update(changes);
+	CHECK(changes.size() == 2);
+	CHECK_MESSAGE(budget.get_resident_mipmap(1) == 0, "The texture used last should be streamed in.");
+	CHECK_MESSAGE(budget.get_resident_mipmap(2) == 1, "The other texture should go back to its lowest mipmap.");
+	CHECK(budget.get_memory_used() == mipmap_chain_size(256) + mipmap_chain_size(128));
+}
+
+TEST_CASE("[TextureStreaming] Pinned textures are not evicted") {
+	TextureStreamingBudget budget;
+	budget.set_budget(mipmap_chain_size(256) + mipmap_chain_size(128));
+
+	budget.add(1, 256, 256, Image::FORMAT_RGBA8, 8, 1);
+	budget.set_pinned(1, true);
+	budget.add(2, 256, 256, Image::FORMAT_RGBA8, 8, 1);
+
+	LocalVector<TextureStreamingBudget::Change> changes;
+	budget.update(changes);
+	CHECK_MESSAGE(budget.get_resident_mipmap(1) == 0, "Pinned textures should be streamed in first.");
+	CHECK(budget.get_resident_mipmap(2) == 1);
+
+	// Using the other texture later doesn't make it take the pinned one's memory.
+	budget.touch(2);
+	changes.clear();
+	budget.update(changes);
+	CHECK(changes.size() == 0);
+	CHECK(budget.get_resident_mipmap(1) == 0);
+	CHECK(budget.get_resident_mipmap(2) == 1);
+	CHECK(budget.get_memory_used() <= budget.get_budget());
+}
+
+TEST_CASE("[TextureStreaming] Unpinned textures can be evicted again") {
+	TextureStreamingBudget budget;
+	budget.set_budget(mipmap_chain_size(256) + mipmap_chain_size(128));
+
+	budget.add(1, 256, 256, Image::FORMAT_RGBA8, 8, 1);
+	budget.set_pinned(1, true);
+	budget.add(2, 256, 256, Image::FORMAT_RGBA8, 8, 1);
+
+	LocalVector<TextureStreamingBudget::Change> changes;
+	budget.update(changes);
+	CHECK(budget.get_resident_mipmap(1) == 0);
+
+	// Once the last holder is gone, the texture goes back to being ordered by use.
+	budget.set_pinned(1, false);
+	budget.touch(2);
+	changes.clear();
+	budget.update(changes);
+	CHECK(budget.get_resident_mipmap(1) == 1);
+	CHECK(budget.get_resident_mipmap(2) == 0);
+	CHECK(budget.get_memory_used() <= budget.get_budget());
+}
+
+TEST_CASE("[TextureStreaming] Evict unrequested mipmaps first") {
+	TextureStreamingBudget budget;
+	budget.set_budget(mipmap_chain_size(256) + mipmap_chain_size(128));
+
+	budget.add(1, 256, 256, Image::FORMAT_RGBA8, 8, 1);
+	budget.request(1, 1);
+	budget.add(2, 256, 256, Image::FORMAT_RGBA8, 8, 1);
+
+	LocalVector<TextureStreamingBudget::Change> changes;
+	budget.update(changes);
+	CHECK(budget.get_resident_mipmap(2) == 0);
+
+	// Texture 2 is used more recently, but doesn't need its full resolution anymore.
+	budget.request(1, 0);
+	budget.request(2, 1);
+	changes.clear();
+	budget.update(changes);
+	CHECK(budget.get_resident_mipmap(1) == 0);
+	CHECK(budget.get_resident_mipmap(2) == 1);
+	CHECK(budget.get_memory_used() <= budget.get_budget());
+}
+
+TEST_CASE("[TextureStreaming] Settle for smaller mipmaps when over budget") {
+	TextureStreamingBudget budget;
+	budget.set_budget(mipmap_chain_size(128));
+
+	budget.add(1, 256, 256, Image::FORMAT_RGBA8, 8, 2);
+
+	LocalVector<TextureStreamingBudget::Change> changes;
+	budget.update(changes);
+	REQUIRE(changes.size() == 1);
+	CHECK(changes[0].mipmap == 1);
+	CHECK(changes[0].width == 128);
+	CHECK(budget.get_memory_used() == mipmap_chain_size(128));
+}
+
+TEST_CASE("[TextureStreaming] Load time") {
+	TextureStreamingBudget budget;
+	CHECK(budget.get_load_count() == 0);
+	CHECK(budget.get_load_time_usec() == 0);
+
+	budget.record_load(100);
+	budget.record_load(50);
+	CHECK(budget.get_load_count() == 2);
+	CHECK(budget.get_load_time_usec() == 150);
+}
+
+// Each mipmap gets its own values, so the loaded data shows which ones were read.
+static Ref<Image> create_mipmapped_image(int p_size) {
+	const int mipmaps = Image::get_image_required_mipmaps(p_size, p_size, Image::FORMAT_RGBA8);
+	Vector<uint8_t> data;
+	data.resize(Image::get_image_data_size(p_size, p_size, Image::FORMAT_RGBA8, true));
+	uint8_t *w = data.ptrw();
+	for (int i = 0; i <= mipmaps; i++) {
+		int begin = Image::get_image_mipmap_offset(p_size, p_size, Image::FORMAT_RGBA8, i);
+		int end = i < mipmaps ? Image::get_image_mipmap_offset(p_size, p_size, Image::FORMAT_RGBA8, i + 1) : data.size();
+		for (int j = begin; j < end; j++) {
+			w[j] = uint8_t((i + 1) * 20 + (j - begin) % 13);
+		}
+	}
+
+	Ref<Image> image;
+	image.instance();
+	image->create(p_size, p_size, true, Image::FORMAT_RGBA8, data);
+	return image;
+}
+
+static Vector<uint8_t> get_mipmap_chain_data(const Ref<Image> &p_image, int p_mipmap) {
+	int begin = Image::get_image_mipmap_offset(p_image->get_width(), p_image->get_height(), p_image->get_format(), p_mipmap);
+	return p_image->get_data().subarray(begin, -1);
+}
+
+// Same layout as ResourceImporterTexture with streaming enabled, but without a custom size,
+// so the texture size has to come from the image header.
+static void save_streamed_texture(const String &p_path, const Ref<Image> &p_image, bool p_lossless) {
+	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f);
+	f->store_8('G');
+	f->store_8('S');
+	f->store_8('T');
+	f->store_8('2');
+	f->store_32(StreamTexture2D::FORMAT_VERSION);
+	f->store_32(0);
+	f->store_32(0);
+	f->store_32(StreamTexture2D::FORMAT_BIT_STREAM | StreamTexture2D::FORMAT_BIT_HAS_MIPMAPS);
+	f->store_32(0);
+	f->store_32(0);
+	f->store_32(0);
+	f->store_32(0);
+
+	f->store_32(p_lossless ? StreamTexture2D::DATA_FORMAT_LOSSLESS : StreamTexture2D::DATA_FORMAT_IMAGE);
+	f->store_16(p_image->get_width());
+	f->store_16(p_image->get_height());
+	f->store_32(p_image->get_mipmap_count());
+	f->store_32(p_image->get_format());
+	if (p_lossless) {
+		for (int i = 0; i <= p_image->get_mipmap_count(); i++) {
+			Vector<uint8_t> data = Image::lossless_packer(p_image->get_image_from_mipmap(i));
+			f->store_32(data.size());
+			f->store_buffer(data.ptr(), data.size());
+		}
+	} else {
+		Vector<uint8_t> data = p_image->get_data();
+		f->store_buffer(data.ptr(), data.size());
+	}
+	memdelete(f);
+}
+
+static Ref<Image> load_image_with_size_limit(const String &p_path, int p_size_limit) {
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	REQUIRE(f);
+	f->seek(9 * 4); // Header, version, custom size, flags, mipmap limit and reserved.
+	Ref<Image> image = StreamTexture2D::load_image_from_file(f, p_size_limit);
+	memdelete(f);
+	return image;
+}
+
+TEST_CASE("[TextureStreaming] Load streamed textures") {
+	RasterizerDummy::make_current();
+	RenderingServer *rendering_server = memnew(RenderingServerDefault);
+	rendering_server->init();
+
+	bool lossless = false;
+	SUBCASE("Uncompressed") {
+		lossless = false;
+	}
+	SUBCASE("Lossless") {
+		REQUIRE(Image::lossless_packer);
+		lossless = true;
+	}
+
+	const int size = 64;
+	Ref<Image> source = create_mipmapped_image(size);
+	const String path = OS::get_singleton()->get_cache_path().plus_file("streamed.stex");
+	save_streamed_texture(path, source, lossless);
+
+	// Only the largest mipmap fitting the limit and the smaller ones after it are read.
+	Ref<Image> image = load_image_with_size_limit(path, 16);
+	REQUIRE(image.is_valid());
+	CHECK(image->get_width() == 16);
+	CHECK(image->get_height() == 16);
+	CHECK(image->has_mipmaps());
+	CHECK(image->get_data() == get_mipmap_chain_data(source, 2));
+
+	image = load_image_with_size_limit(path, 20);
+	REQUIRE(image.is_valid());
+	CHECK_MESSAGE(image->get_width() == 16, "Mipmaps larger than the limit should be skipped.");
+
+	image = load_image_with_size_limit(path, 1);
+	REQUIRE(image.is_valid());
+	CHECK(image->get_width() == 1);
+	CHECK(!image->has_mipmaps());
+	CHECK(image->get_data() == get_mipmap_chain_data(source, source->get_mipmap_count()));
+
+	image = load_image_with_size_limit(path, 0);
+	REQUIRE(image.is_valid());
+	CHECK(image->get_width() == size);
+	CHECK(image->get_data() == source->get_data());
+
+	ProjectSettings::get_singleton()->set_setting("rendering/textures/streaming/enabled", true);
+	ProjectSettings::get_singleton()->set_setting("rendering/textures/streaming/initial_size", 16);
+
+	{
+		Ref<StreamTexture2D> texture;
+		texture.instance();
+		REQUIRE(texture->load(path) == OK);
+		CHECK_MESSAGE(texture->get_width() == size, "The size should be the stored one, not the one of the loaded mipmap.");
+		CHECK(texture->get_height() == size);
+		CHECK(texture->is_streaming());
+
+		image = texture->get_image();
+		REQUIRE(image.is_valid());
+		CHECK(image->get_width() == 16);
+		CHECK(image->get_data() == get_mipmap_chain_data(source, 2));
+
+		// The rest is loaded on the streaming thread, then uploaded from the main thread.
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		while (texture->get_image()->get_width() < size && OS::get_singleton()->get_ticks_usec() - begin < 5000000) {
+			OS::get_singleton()->delay_usec(1000);
+			StreamTexture2D::flush_streaming();
+		}
+		CHECK(texture->get_streaming_resident_size() == Size2i(size, size));
+		CHECK(texture->get_image()->get_data() == source->get_data());
+		CHECK(StreamTexture2D::get_streaming_memory_used() == uint64_t(source->get_data().size()));
+	}
+
+	CHECK_MESSAGE(StreamTexture2D::get_streaming_memory_used() == 0, "Freed textures should give their memory back.");
+
+	ProjectSettings::get_singleton()->set_setting("rendering/textures/streaming/enabled", false);
+	ProjectSettings::get_singleton()->set_setting("rendering/textures/streaming/initial_size", 128);
+
+	rendering_server->finish();
+	memdelete(rendering_server);
+}
+
+} // namespace TestTextureStreaming
+
+#endif // TEST_TEXTURE_STREAMING_H
@@ -31,6 +31,7 @@
 #ifndef TEST_VARIANT_H
 #define TEST_VARIANT_H
 
+#include "core/os/os.h"
 #include "core/variant/variant.h"
 #include "core/variant/variant_parser.h"
 
@@ -106,6 +107,49 @@ TEST_CASE("[Variant] Writer and parser float") {
 	CHECK_MESSAGE(b64_float_parsed == 340282001837565597733306976381245063168.0, "Should not overflow.");
 }
 
+TEST_CASE("[Variant] Parser with input larger than the read ahead buffer") {
+	Array array;
+	for (int i = 0; i < 1000; i++) {
+		array.push_back(vformat("entry_%d", i));
+		array.push_back(Vector2(i, -i));
+	}
+	array.push_back(String::utf8("h\xc3\xa9llo w\xc3\xb6rld"));
+
+	String text;
+	VariantWriter::write_to_string(array, text);
+	REQUIRE(text.length() > 8192);
+
+	String errs;
+	int line;
+
+	VariantParser::StreamString ss;
+	ss.s = text;
+	Variant parsed;
+	CHECK(VariantParser::parse(&ss, parsed, errs, line) == OK);
+	String parsed_text;
+	VariantWriter::write_to_string(parsed, parsed_text);
+	CHECK_MESSAGE(parsed_text == text, "Should parse back from a string.");
+
+	const String path = OS::get_singleton()->get_cache_path().plus_file("variant_parser_readahead.txt");
+	{
+		FileAccessRef f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f);
+		f->store_string(text);
+	}
+
+	FileAccessRef f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(f);
+	VariantParser::StreamFile sf;
+	sf.f = f;
+	Variant parsed_file;
+	CHECK(VariantParser::parse(&sf, parsed_file, errs, line) == OK);
+	String parsed_file_text;
+	VariantWriter::write_to_string(parsed_file, parsed_file_text);
+	CHECK_MESSAGE(parsed_file_text == text, "Should parse back from a UTF-8 file.");
+	Array parsed_array = parsed_file;
+	CHECK(parsed_array.back() == Variant(String::utf8("h\xc3\xa9llo w\xc3\xb6rld")));
+}
+
 TEST_CASE("[Variant] Assignment To Bool from Int,Float,String,Vec2,Vec2i,Vec3,Vec3i and Color") {
 	Variant int_v = 0;
 	Variant bool_v = true;